@@ -0,0 +1,70 @@
+// File: bench/AudioBench.cpp
+// Command latency and underruns of AudioSystem at several device buffer sizes.
+// Runs without sound hardware on SDL's "dummy" (default) or "disk" audio driver.
+
+#include "BenchCommon.h"
+#include "audio/AudioSystem.h"
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+const int RUN_MS = 3000;               // Per buffer size
+const Uint32 FRAME_MS = 16;            // Simulated game frames issuing the commands
+const int BEEPS_PER_FRAME = 2;         // A step and a menu move landing on the same frame
+const int BEEP_MS = 40;
+const float BEEP_HZ = 1760.0f;
+
+std::vector<int16_t> makeBeep() {
+    std::vector<int16_t> samples(AUDIO_SAMPLE_RATE * BEEP_MS / 1000);
+    for (size_t i = 0; i < samples.size(); ++i) {
+        samples[i] = static_cast<int16_t>(12000.0f * std::sin(2.0f * 3.14159265f * BEEP_HZ * i / AUDIO_SAMPLE_RATE));
+    }
+    return samples;
+}
+
+} // end anonymous namespace
+
+int runAudioBench(int argc, char* argv[]) {
+    const char* driver = "dummy";
+    std::vector<int> bufferSizes;
+    for (int i = 0; i < argc; ++i) {
+        if (std::atoi(argv[i]) > 0) bufferSizes.push_back(std::atoi(argv[i]));
+        else driver = argv[i];
+    }
+    if (bufferSizes.empty()) bufferSizes = {128, 256, 512, 1024};
+
+    // Must be set before the audio subsystem starts; "disk" writes to SDL_DISKAUDIOFILE (sdlaudio.raw)
+    SDL_setenv("SDL_AUDIODRIVER", driver, 1);
+    if (SDL_Init(SDL_INIT_TIMER) < 0) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Bench SDL Init Error: %s", SDL_GetError()); return 1; }
+
+    const std::vector<int16_t> beep = makeBeep();
+    SoundClip clip;
+    clip.samples = beep.data();
+    clip.frames = static_cast<uint32_t>(beep.size());
+
+    std::printf("driver: %s\n", driver);
+    std::printf("%-8s %10s %10s %10s %12s %10s %10s %10s %8s\n", "buffer", "buffer_ms", "avg_ms", "max_ms", "output_ms", "mix_ms", "callbacks", "underruns", "dropped");
+    for (int bufferFrames : bufferSizes) {
+        AudioSystem audio;
+        if (!audio.init(bufferFrames)) { SDL_Quit(); return 1; }
+
+        const Uint32 start = SDL_GetTicks();
+        int beepIndex = 0;
+        while (SDL_GetTicks() - start < static_cast<Uint32>(RUN_MS)) {
+            for (int i = 0; i < BEEPS_PER_FRAME; ++i, ++beepIndex) {
+                audio.play(&clip, 0.5f, (beepIndex % 3 - 1) * 0.5f);
+            }
+            SDL_Delay(FRAME_MS);
+        }
+        const AudioStats stats = audio.getStats();
+        audio.shutdown();
+        std::printf("%-8d %10.2f %10.3f %10.3f %12.3f %10.4f %10llu %10llu %8llu\n", bufferFrames, stats.bufferMs, stats.avgLatencyMs, stats.maxLatencyMs,
+                    stats.avgLatencyMs + stats.bufferMs, stats.maxMixMs, (unsigned long long)stats.callbacks, (unsigned long long)stats.underruns,
+                    (unsigned long long)stats.droppedCommands);
+    }
+    SDL_Quit();
+    return 0;
+}
@@ -0,0 +1,50 @@
+// File: bench/BenchCommon.h
+#pragma once
+
+#include "platform/pc/pc_display.h"
+#include "core/AssetManager.h"
+#include <SDL.h>
+#include <SDL_log.h>
+#include <cstdio>
+
+// Shared setup for DigiviceBench scenarios: SDL with the dummy video driver,
+// a headless software-rendered display and an AssetManager bound to it.
+struct BenchContext {
+    PCDisplay display;
+    AssetManager assets;
+    bool ok = false;
+
+    BenchContext(int width = 466, int height = 466) {
+        SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy");
+        if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_TIMER) < 0) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Bench SDL Init Error: %s", SDL_GetError()); return; }
+        if (!display.initHeadless(width, height)) { return; }
+        if (!assets.init(display.getRenderer())) { return; }
+        ok = true;
+    }
+    ~BenchContext() {
+        assets.shutdown();
+        display.close();
+        SDL_Quit();
+    }
+};
+
+// Wall-clock stopwatch on SDL's performance counter
+class BenchTimer {
+public:
+    BenchTimer() : start_(SDL_GetPerformanceCounter()) {}
+    void restart() { start_ = SDL_GetPerformanceCounter(); }
+    double elapsedMs() const {
+        return (SDL_GetPerformanceCounter() - start_) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+    }
+private:
+    Uint64 start_;
+};
+
+// Scenario entry points (one per bench/*.cpp), dispatched by BenchMain.cpp
+int runEntityBench(int argc, char* argv[]);
+int runMenuBench(int argc, char* argv[]);
+int runWidgetBench(int argc, char* argv[]);
+int runFrameBench(int argc, char* argv[]);
+int runParticleBench(int argc, char* argv[]);
+int runAudioBench(int argc, char* argv[]);
+int runCaptureBench(int argc, char* argv[]);
@@ -0,0 +1,44 @@
+// File: bench/BenchMain.cpp
+// DigiviceBench: scenario benchmarks that exercise whole engine subsystems headlessly.
+// Usage: DigiviceBench <scenario> [scenario args...]
+
+#include "BenchCommon.h"
+#include <cstring>
+
+namespace {
+
+struct Scenario {
+    const char* name;
+    int (*run)(int argc, char* argv[]);
+    const char* help;
+};
+
+const Scenario SCENARIOS[] = {
+    { "entities", runEntityBench, "[count...]  Wandering Digimon crowd (default 1000 2500 5000 10000)" },
+    { "menu",     runMenuBench,   "[count]     Open/scroll/filter a virtualized menu list (default 5000)" },
+    { "widgets",  runWidgetBench, "[frames]    Cached panel clean/dirty frames; fails if a re-shown widget is lost (default 10000)" },
+    { "frames",   runFrameBench,  "[frames]    Frame clock/parallax/animation/transition math + sequence hash (default 200000)" },
+    { "particles", runParticleBench, "[count...]  Sustained particle fountain, update + batched draw (default 50000 100000)" },
+    { "audio",    runAudioBench,  "[driver] [buffer...]  Beep command latency/underruns (default dummy; 128 256 512 1024 frames)" },
+    { "capture",  runCaptureBench, "[png|raw] [frames]  Frame capture cost on the render thread and drops (default raw 600)" },
+};
+
+void printUsage() {
+    std::printf("Usage: DigiviceBench <scenario> [args]\n");
+    for (const Scenario& s : SCENARIOS) std::printf("  %-10s %s\n", s.name, s.help);
+}
+
+} // end anonymous namespace
+
+int main(int argc, char* argv[]) {
+    SDL_LogSetAllPriority(SDL_LOG_PRIORITY_WARN); // Keep engine logging out of the timings
+    if (argc < 2) { printUsage(); return 1; }
+    for (const Scenario& s : SCENARIOS) {
+        if (std::strcmp(argv[1], s.name) == 0) {
+            return s.run(argc - 2, argv + 2);
+        }
+    }
+    std::printf("Unknown scenario '%s'\n", argv[1]);
+    printUsage();
+    return 1;
+}
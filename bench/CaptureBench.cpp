@@ -0,0 +1,59 @@
+// File: bench/CaptureBench.cpp
+// Render-thread cost and drop rate of FrameCapture on the headless software display.
+
+#include "BenchCommon.h"
+#include "graphics/FrameCapture.h"
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+namespace {
+
+const Uint32 FRAME_MS = 16; // Paced like the game loop, so the encoder sees a realistic frame rate
+const int BOX_COUNT = 64;   // Something that changes every frame, so PNGs aren't trivially small
+
+} // end anonymous namespace
+
+int runCaptureBench(int argc, char* argv[]) {
+    CaptureFormat format = CaptureFormat::RAW_VIDEO;
+    int frames = 600;
+    for (int i = 0; i < argc; ++i) {
+        if (std::strcmp(argv[i], "png") == 0) format = CaptureFormat::PNG_SEQUENCE;
+        else if (std::strcmp(argv[i], "raw") == 0) format = CaptureFormat::RAW_VIDEO;
+        else if (std::atoi(argv[i]) > 0) frames = std::atoi(argv[i]);
+    }
+
+    BenchContext ctx;
+    if (!ctx.ok) return 1;
+    int screenW = 0, screenH = 0;
+    ctx.display.getWindowSize(screenW, screenH);
+
+    const std::string output = format == CaptureFormat::PNG_SEQUENCE ? "capture_bench_frames" : "capture_bench.bgra";
+    FrameCapture capture;
+    if (!capture.start(&ctx.display, output, format)) return 1;
+
+    double frameMs = 0.0;
+    BenchTimer timer;
+    for (int frameNo = 0; frameNo < frames; ++frameNo) {
+        const Uint32 frameStart = SDL_GetTicks();
+        ctx.display.clear(0x0000);
+        for (int b = 0; b < BOX_COUNT; ++b) {
+            const SDL_Rect box = { (b * 53 + frameNo * 3) % screenW, (b * 97 + frameNo) % screenH, 24, 24 };
+            ctx.display.fillRect(&box, SDL_Color{ static_cast<Uint8>(b * 4), static_cast<Uint8>(frameNo), 200, 255 });
+        }
+        timer.restart();
+        capture.captureFrame(&ctx.display);
+        frameMs += timer.elapsedMs();
+        ctx.display.present();
+        const Uint32 spent = SDL_GetTicks() - frameStart;
+        if (spent < FRAME_MS) SDL_Delay(FRAME_MS - spent);
+    }
+    capture.stop();
+
+    const CaptureStats stats = capture.getStats();
+    std::printf("%-6s %8s %10s %10s %10s %12s %12s %12s\n", "format", "frames", "captured", "written", "dropped", "capture_ms", "grab_avg_ms", "grab_max_ms");
+    std::printf("%-6s %8d %10llu %10llu %10llu %12.4f %12.4f %12.4f\n", format == CaptureFormat::PNG_SEQUENCE ? "png" : "raw", frames,
+                (unsigned long long)stats.captured, (unsigned long long)stats.written, (unsigned long long)stats.dropped,
+                frameMs / frames, stats.avgGrabMs, stats.maxGrabMs);
+    return 0;
+}
@@ -0,0 +1,328 @@
+// File: bench/EngineMicroBench.cpp
+// Micro-benchmarks for the per-frame and load-time paths the game leans on.
+// Run from the output directory so the copied assets folder is found.
+
+#include "MicroBench.h"
+#include "BenchCommon.h"
+#include "core/Game.h"
+#include "core/JobSystem.h"
+#include "core/TimerWheel.h"
+#include "graphics/Animation.h"
+#include "graphics/PalettedSheet.h"
+#include "graphics/ParallaxLayer.h"
+#include "graphics/SurfaceScale.h"
+#include "input/StepDetector.h"
+#include "audio/AudioSystem.h"
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+const char* SHEET_IDS[] = { "agumon_sheet", "gabumon_sheet", "biyomon_sheet", "gatomon_sheet", "gomamon_sheet", "palmon_sheet", "tentomon_sheet", "patamon_sheet" };
+const size_t SHEET_COUNT = sizeof(SHEET_IDS) / sizeof(SHEET_IDS[0]);
+const char* SHEET_JSON_PATH = "assets/sprites/agumon_sheet.json";
+const char* SCENE_PATH = "assets/scenes/castle.json";
+// Plain texture for whole-texture draws (indexed sheets only expand single frames here)
+const char* BACKGROUND_ID = "menu_bg_blue";
+const char* BACKGROUND_PATH = "assets/ui/backgrounds/menu_base_blue.png";
+const Scalar FRAME_DT = scalarFromTicks(17); // ~1/60 s in whole ticks, as Game::run produces
+
+// One headless display + asset set shared by every benchmark, loaded like Game::init does
+BenchContext& sharedContext() {
+    static BenchContext ctx;
+    static bool loaded = false;
+    if (ctx.ok && !loaded) {
+        loaded = true;
+        for (const char* id : SHEET_IDS) {
+            if (!ctx.assets.loadPalettedSheet(id, std::string("assets/sprites/") + id + ".png")) { ctx.ok = false; break; }
+        }
+        if (ctx.ok && !ctx.assets.loadTexture(BACKGROUND_ID, BACKGROUND_PATH)) ctx.ok = false;
+    }
+    return ctx;
+}
+
+// Started on first use from the bench thread, which becomes its thread 0
+JobSystem& sharedJobs() {
+    static JobSystem jobs;
+    if (!jobs.isInitialized()) jobs.init();
+    return jobs;
+}
+
+// Pushed and popped by the state-stack benchmark; does nothing per frame
+class NullState : public GameState {
+public:
+    void handle_input() override {}
+    void update(Scalar) override {}
+    void render() override {}
+};
+
+} // end anonymous namespace
+
+
+// --- AssetManager ---
+void BM_AssetManager_GetTexture_Hit(MicroState& state) {
+    BenchContext& ctx = sharedContext();
+    if (!ctx.ok) { state.skipWithError("headless context or sprite sheets unavailable"); return; }
+    std::vector<std::string> ids(SHEET_IDS, SHEET_IDS + SHEET_COUNT);
+    size_t i = 0;
+    while (state.keepRunning()) {
+        doNotOptimize(ctx.assets.getTexture(ids[i]));
+        if (++i == ids.size()) i = 0;
+    }
+}
+DIGIVICE_MICROBENCH(BM_AssetManager_GetTexture_Hit);
+
+void BM_AssetManager_GetTexture_Miss(MicroState& state) {
+    BenchContext& ctx = sharedContext();
+    if (!ctx.ok) { state.skipWithError("headless context or sprite sheets unavailable"); return; }
+    const std::string missingId = "missing_sheet"; // Includes the warning the miss path logs
+    while (state.keepRunning()) {
+        doNotOptimize(ctx.assets.getTexture(missingId));
+    }
+}
+DIGIVICE_MICROBENCH(BM_AssetManager_GetTexture_Miss);
+
+
+// --- Sheet Parsing (RosterSheets::decodeSheet, per Digimon; rects plus trim and pivot) ---
+void BM_SheetJson_Parse(MicroState& state) {
+    std::vector<SpriteFrame> frames;
+    if (!loadSpriteSheetFrames(SHEET_JSON_PATH, frames)) { state.skipWithError("could not read sprite sheet JSON"); return; }
+    while (state.keepRunning()) {
+        loadSpriteSheetFrames(SHEET_JSON_PATH, frames);
+        doNotOptimize(frames.data());
+    }
+    state.setItemsProcessed(state.iterations() * (int64_t)frames.size());
+}
+DIGIVICE_MICROBENCH(BM_SheetJson_Parse);
+
+
+// --- Animation Stepping (AdventureState::update) ---
+void BM_Animation_Step(MicroState& state) {
+    SDL_Texture* fakeSheet = reinterpret_cast<SDL_Texture*>(&state); // Never dereferenced
+    std::vector<SDL_Rect> rects = { {0, 0, 32, 32}, {32, 0, 32, 32}, {64, 0, 32, 32}, {96, 0, 32, 32} };
+    Animation walk = createAnimationFromIndices(fakeSheet, rects, {2, 3, 2, 3}, {300, 300, 300, 300}, true);
+    size_t frameIdx = 0;
+    Scalar elapsed = 0;
+    while (state.keepRunning()) {
+        doNotOptimize(stepAnimation(walk, frameIdx, elapsed, FRAME_DT));
+    }
+}
+DIGIVICE_MICROBENCH(BM_Animation_Step);
+
+
+// --- Parallax Offset Math ---
+void BM_Parallax_Update(MicroState& state) {
+    BenchContext& ctx = sharedContext();
+    if (!ctx.ok) { state.skipWithError("headless context unavailable"); return; }
+    ParallaxBackground background;
+    if (!background.loadFromJson(SCENE_PATH, &ctx.assets)) { state.skipWithError("could not load castle scene"); return; }
+    while (state.keepRunning()) {
+        background.update(FRAME_DT);
+    }
+    doNotOptimize(background.getLayer(0).offset);
+    state.setItemsProcessed(state.iterations() * (int64_t)background.getLayerCount());
+}
+DIGIVICE_MICROBENCH(BM_Parallax_Update);
+
+
+// --- PCDisplay::drawTexture on the software renderer ---
+// The sheets are indexed here, so a sprite draw includes expanding its frame
+void BM_PCDisplay_DrawTexture_Sprite(MicroState& state) {
+    BenchContext& ctx = sharedContext();
+    if (!ctx.ok) { state.skipWithError("headless context or sprite sheets unavailable"); return; }
+    std::vector<SDL_Rect> rects;
+    if (!loadSpriteSheetFrameRects(SHEET_JSON_PATH, rects)) { state.skipWithError("could not read sprite sheet JSON"); return; }
+    SDL_Texture* sheet = ctx.assets.getTexture(SHEET_IDS[0]);
+    const SDL_Rect src = rects[0];
+    const SDL_Rect dst = { 233 - src.w / 2, 233 - src.h / 2, src.w, src.h };
+    while (state.keepRunning()) {
+        ctx.display.drawTexture(sheet, &src, &dst);
+    }
+    state.setItemsProcessed(state.iterations());
+}
+DIGIVICE_MICROBENCH(BM_PCDisplay_DrawTexture_Sprite);
+
+void BM_PCDisplay_DrawTexture_FullScreen(MicroState& state) {
+    BenchContext& ctx = sharedContext();
+    if (!ctx.ok) { state.skipWithError("headless context or sprite sheets unavailable"); return; }
+    SDL_Texture* background = ctx.assets.getTexture(BACKGROUND_ID);
+    const SDL_Rect dst = { 0, 0, 466, 466 }; // Scaled like a background layer
+    while (state.keepRunning()) {
+        ctx.display.drawTexture(background, nullptr, &dst);
+    }
+    state.setItemsProcessed(state.iterations());
+}
+DIGIVICE_MICROBENCH(BM_PCDisplay_DrawTexture_FullScreen);
+
+
+// --- Palette swaps ---
+// Cost of one recolour. The headless renderer is software, so this is the palette
+// lookup rebuild; GPU renderers also expand the whole sheet into its texture.
+void BM_PalettedSheet_SetPalette(MicroState& state) {
+    BenchContext& ctx = sharedContext();
+    if (!ctx.ok) { state.skipWithError("headless context or sprite sheets unavailable"); return; }
+    PalettedSheet* sheet = ctx.assets.getPalettedSheet(SHEET_IDS[0]);
+    if (!sheet) { state.skipWithError("sprite sheet is not 8-bit indexed"); return; }
+    const Palette flash = makeFlashPalette(sheet->getBasePalette(), SDL_Color{255, 255, 255, 255});
+    bool flashing = false;
+    while (state.keepRunning()) {
+        flashing = !flashing;
+        sheet->setPalette(flashing ? flash : sheet->getBasePalette());
+        sheet->applyPalette();
+    }
+    sheet->resetPalette();
+    sheet->applyPalette();
+    state.setItemsProcessed(state.iterations() * (int64_t)sheet->getWidth() * sheet->getHeight());
+}
+DIGIVICE_MICROBENCH(BM_PalettedSheet_SetPalette);
+
+
+// --- Display Profile Variants ---
+// Load-time cost of making a 240x160 ("gba") scenery layer from full-size art
+void BM_SurfaceScale_BoxThird(MicroState& state) {
+    SDL_Surface* source = SDL_CreateRGBSurfaceWithFormat(0, 1421, 474, 32, SDL_PIXELFORMAT_ARGB8888);
+    if (!source) { state.skipWithError("surface creation failed"); return; }
+    Uint32* pixels = static_cast<Uint32*>(source->pixels);
+    for (int i = 0; i < source->w * source->h; ++i) pixels[i] = 0xFF000000u | (i * 2654435761u >> 8); // Noise, fully opaque
+    while (state.keepRunning()) {
+        SDL_Surface* scaled = downscaleSurface(source, 3, ScaleFilter::BOX);
+        doNotOptimize(scaled);
+        SDL_FreeSurface(scaled);
+    }
+    state.setItemsProcessed(state.iterations() * (int64_t)source->w * source->h);
+    SDL_FreeSurface(source);
+}
+DIGIVICE_MICROBENCH(BM_SurfaceScale_BoxThird);
+
+
+// --- Game State Stack ---
+void BM_Game_ApplyStateChanges_PushPop(MicroState& state) {
+    Game game; // Never initialised; only the state stack is used
+    game.requestPushState(makeState<NullState>()); // Base state, like AdventureState
+    game.applyStateChanges();
+    while (state.keepRunning()) {
+        game.requestPushState(makeState<NullState>());
+        game.applyStateChanges();
+        game.requestPopState();
+        game.applyStateChanges();
+    }
+    state.setItemsProcessed(state.iterations() * 2);
+}
+DIGIVICE_MICROBENCH(BM_Game_ApplyStateChanges_PushPop);
+
+
+// --- JobSystem ---
+// Per-job scheduling cost: one root with N empty children, run and waited on
+void BM_JobSystem_EmptyJobs(MicroState& state) {
+    JobSystem& jobs = sharedJobs();
+    const int childCount = 256;
+    while (state.keepRunning()) {
+        Job* root = jobs.createJob([]() {});
+        for (int i = 0; i < childCount; ++i) jobs.run(jobs.createChildJob(root, []() {}));
+        jobs.run(root);
+        jobs.wait(root);
+    }
+    state.setItemsProcessed(state.iterations() * (childCount + 1));
+}
+DIGIVICE_MICROBENCH(BM_JobSystem_EmptyJobs);
+
+void BM_JobSystem_ParallelFor(MicroState& state) {
+    JobSystem& jobs = sharedJobs();
+    std::vector<float> values(1 << 16, 1.0f);
+    while (state.keepRunning()) {
+        jobs.parallelFor(values.size(), 4096, [&values](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) values[i] = values[i] * 0.999f + 0.001f;
+        });
+    }
+    doNotOptimize(values[0]);
+    state.setItemsProcessed(state.iterations() * (int64_t)values.size());
+}
+DIGIVICE_MICROBENCH(BM_JobSystem_ParallelFor);
+
+
+// --- TimerWheel ---
+// One 60 Hz frame with thousands of timers pending but none due: should cost the same as an empty wheel
+void BM_TimerWheel_AdvanceIdleFrame(MicroState& state) {
+    const int pendingCount = 10000;
+    TimerWheel timers;
+    int fired = 0;
+    const TimerCallback count = [](void* context) { ++*static_cast<int*>(context); };
+    for (int i = 0; i < pendingCount; ++i) timers.schedule(TICKS_PER_SECOND * 3600 + i * 37, count, &fired); // Due in an hour and later
+    while (state.keepRunning()) {
+        timers.advance(17);
+    }
+    doNotOptimize(fired);
+    state.setLabel(std::to_string(timers.getPendingCount()) + " pending");
+    state.setItemsProcessed(state.iterations());
+}
+DIGIVICE_MICROBENCH(BM_TimerWheel_AdvanceIdleFrame);
+
+// Schedule-and-fire churn: 4096 timers spread over four seconds, each replaced as it fires (~17 a frame)
+void BM_TimerWheel_ScheduleFire(MicroState& state) {
+    const int liveCount = 4096;
+    TimerWheel timers;
+    int fired = 0;
+    const TimerCallback count = [](void* context) { ++*static_cast<int*>(context); };
+    uint32_t seed = 1;
+    for (int i = 0; i < liveCount; ++i) { seed = seed * 1664525u + 1013904223u; timers.schedule(seed % 4096, count, &fired); }
+    while (state.keepRunning()) {
+        const int before = fired;
+        timers.advance(17);
+        for (int i = before; i < fired; ++i) { seed = seed * 1664525u + 1013904223u; timers.schedule(1 + seed % 4096, count, &fired); }
+    }
+    doNotOptimize(fired);
+    state.setItemsProcessed(fired);
+}
+DIGIVICE_MICROBENCH(BM_TimerWheel_ScheduleFire);
+
+
+// --- Step Detection ---
+// One 100 Hz frame's worth of accelerometer samples (2 per 60 Hz frame), as the frame loop drains them
+void BM_StepDetector_Process(MicroState& state) {
+    const size_t sampleCount = 6000; // 60 s of walking at 1.8 steps/s
+    std::vector<AccelSample> samples(sampleCount);
+    for (size_t i = 0; i < sampleCount; ++i) {
+        const float phase = 2.0f * 3.14159265f * 1.8f * (i / 100.0f);
+        samples[i].timeMs = static_cast<uint32_t>(i * 10);
+        samples[i].x = 3.0f * std::sin(phase);
+        samples[i].y = 0.5f * std::sin(2.0f * phase);
+        samples[i].z = 9.81f + 4.0f * std::sin(phase);
+    }
+    StepDetector detector;
+    const size_t batch = 2;
+    size_t next = 0;
+    int steps = 0;
+    while (state.keepRunning()) {
+        steps += detector.process(&samples[next], batch);
+        next = (next + batch) % sampleCount;
+    }
+    doNotOptimize(steps);
+    state.setItemsProcessed(state.iterations() * (int64_t)batch);
+}
+DIGIVICE_MICROBENCH(BM_StepDetector_Process);
+
+
+// --- AudioMixer ---
+// One 5.3 ms device buffer with every voice playing: the audio callback's worst case
+void BM_AudioMixer_MixFullVoices(MicroState& state) {
+    const size_t blockFrames = AudioSystem::DEFAULT_BUFFER_FRAMES;
+    std::vector<int16_t> clip(AUDIO_SAMPLE_RATE); // 1 s, so voices outlast a run's first iterations
+    for (size_t i = 0; i < clip.size(); ++i) clip[i] = static_cast<int16_t>(20000.0f * std::sin(i * 0.23f));
+    std::vector<int16_t> out(blockFrames * AUDIO_OUTPUT_CHANNELS);
+    AudioMixer mixer;
+    AudioCommand play;
+    play.samples = clip.data();
+    play.frames = static_cast<uint32_t>(clip.size());
+    play.gainLeft = play.gainRight = 24000;
+    uint64_t mixed = 0;
+    while (state.keepRunning()) {
+        while (mixer.getVoiceCount() < AudioMixer::MAX_VOICES) { ++play.voice; mixer.apply(play); } // Replace finished voices
+        mixer.mix(out.data(), blockFrames);
+        mixed += static_cast<uint16_t>(out[0]);
+    }
+    doNotOptimize(mixed);
+    state.setItemsProcessed(state.iterations() * (int64_t)(blockFrames * AudioMixer::MAX_VOICES));
+}
+DIGIVICE_MICROBENCH(BM_AudioMixer_MixFullVoices);
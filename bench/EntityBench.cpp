@@ -0,0 +1,83 @@
+// File: bench/EntityBench.cpp
+// Renders crowds of wandering Digimon through DigimonPool on the software renderer.
+
+#include "BenchCommon.h"
+#include "entities/Digimon.h"
+#include "graphics/Animation.h"
+#include <vector>
+#include <string>
+#include <cstdlib>
+
+namespace {
+
+const char* SHEET_NAMES[] = { "agumon", "gabumon", "biyomon", "gatomon", "gomamon", "palmon", "tentomon", "patamon" };
+const std::vector<int> WALK_INDICES = {2, 3, 2, 3};
+const std::vector<Uint32> WALK_DURATIONS = {300, 300, 300, 300};
+const int FRAMES_PER_RUN = 300;
+const float FRAME_DT = 1.0f / 60.0f;
+
+} // end anonymous namespace
+
+int runEntityBench(int argc, char* argv[]) {
+    std::vector<int> counts;
+    for (int i = 0; i < argc; ++i) counts.push_back(std::atoi(argv[i]));
+    if (counts.empty()) counts = {1000, 2500, 5000, 10000};
+
+    BenchContext ctx;
+    if (!ctx.ok) return 1;
+
+    // Build one looping walk clip per sheet
+    std::vector<Animation> walkAnims;
+    for (const char* name : SHEET_NAMES) {
+        std::string id = std::string(name) + "_sheet";
+        std::string base = std::string("assets/sprites/") + name + "_sheet";
+        if (!ctx.assets.loadTexture(id, base + ".png")) continue;
+        std::vector<SpriteFrame> frames;
+        if (!loadSpriteSheetFrames(base + ".json", frames)) continue;
+        walkAnims.push_back(createAnimationFromIndices(ctx.assets.getTexture(id), frames, WALK_INDICES, WALK_DURATIONS, true));
+    }
+    if (walkAnims.empty()) { std::printf("entities: no sprite sheets loaded (run from the directory containing assets/)\n"); return 1; }
+
+    int screenW = 0, screenH = 0;
+    ctx.display.getWindowSize(screenW, screenH);
+    std::printf("%-8s %12s %12s %12s\n", "count", "update_ms", "emit_ms", "draw_ms");
+
+    for (int count : counts) {
+        DigimonPool pool;
+        pool.setBounds({0, 0, screenW, screenH});
+        pool.setWanderParams(0.5f, 3.0f, 60.0f);
+        std::vector<AnimClipId> clips;
+        for (const Animation& anim : walkAnims) clips.push_back(pool.addClip(anim));
+        pool.reserve(count);
+        for (int i = 0; i < count; ++i) {
+            float x = static_cast<float>((i * 37) % screenW);
+            float y = static_cast<float>((i * 91) % screenH);
+            pool.spawn(x, y, 0.0f, 0.0f, clips[i % clips.size()]);
+        }
+
+        std::vector<DrawCommand> drawList;
+        drawList.reserve(count);
+        double updateMs = 0.0, emitMs = 0.0, drawMs = 0.0;
+        BenchTimer timer;
+        for (int frameNo = 0; frameNo < FRAMES_PER_RUN; ++frameNo) {
+            timer.restart();
+            pool.updateWander(FRAME_DT);
+            pool.updateMovement(FRAME_DT);
+            pool.updateAnimation(FRAME_DT);
+            updateMs += timer.elapsedMs();
+
+            timer.restart();
+            drawList.clear();
+            pool.emitDrawCommands(drawList);
+            emitMs += timer.elapsedMs();
+
+            timer.restart();
+            ctx.display.clear(0x0000);
+            ctx.display.drawCommands(drawList.data(), drawList.size());
+            ctx.display.present();
+            drawMs += timer.elapsedMs();
+        }
+        std::printf("%-8d %12.4f %12.4f %12.4f\n", count, updateMs / FRAMES_PER_RUN, emitMs / FRAMES_PER_RUN, drawMs / FRAMES_PER_RUN);
+    }
+    return 0;
+}
@@ -0,0 +1,83 @@
+// File: bench/MicroBench.h
+#pragma once
+
+#include <SDL.h>
+#include <cstdint>
+#include <string>
+
+// Minimal Google-Benchmark-style harness for digivice_microbench.
+// A benchmark is a function taking a MicroState and looping while keepRunning():
+//
+//     void BM_Something(MicroState& state) {
+//         setup();
+//         while (state.keepRunning()) { doNotOptimize(work()); }
+//         state.setItemsProcessed(state.iterations());
+//     }
+//     DIGIVICE_MICROBENCH(BM_Something);
+//
+// The runner grows the iteration count until a run lasts --benchmark_min_time
+// and writes results in Google Benchmark's JSON layout, so its compare.py (or a
+// plain diff) works across commits.
+class MicroState {
+public:
+    explicit MicroState(int64_t iterations) : maxIterations_(iterations) {}
+
+    // True until the requested iteration count is reached. The first call starts the clock.
+    bool keepRunning() {
+        if (!started_) { started_ = true; remaining_ = maxIterations_; resumeTiming(); }
+        if (remaining_ > 0) { --remaining_; return true; }
+        if (running_) pauseTiming();
+        return false;
+    }
+
+    // Excludes per-iteration setup from the measurement
+    void pauseTiming() {
+        realTicks_ += SDL_GetPerformanceCounter() - realStart_;
+        cpuTicks_ += cpuNow() - cpuStart_;
+        running_ = false;
+    }
+    void resumeTiming() {
+        running_ = true;
+        cpuStart_ = cpuNow();
+        realStart_ = SDL_GetPerformanceCounter();
+    }
+
+    void setItemsProcessed(int64_t items) { itemsProcessed_ = items; }
+    void setLabel(const std::string& label) { label_ = label; }
+    // Marks the run as failed (e.g. missing assets); the loop body is not entered
+    void skipWithError(const std::string& message) { error_ = message; remaining_ = 0; started_ = true; maxIterations_ = 0; }
+
+    int64_t iterations() const { return maxIterations_; }
+    int64_t itemsProcessed() const { return itemsProcessed_; }
+    const std::string& label() const { return label_; }
+    const std::string& error() const { return error_; }
+    double realSeconds() const { return realTicks_ / (double)SDL_GetPerformanceFrequency(); }
+    double cpuSeconds() const { return cpuTicks_ * 1e-9; }
+
+private:
+    static uint64_t cpuNow(); // Process CPU time in ns (MicroBenchMain.cpp)
+
+    int64_t maxIterations_;
+    int64_t remaining_ = 0;
+    bool started_ = false;
+    bool running_ = false;
+    Uint64 realStart_ = 0;
+    Uint64 realTicks_ = 0;
+    uint64_t cpuStart_ = 0;
+    uint64_t cpuTicks_ = 0;
+    int64_t itemsProcessed_ = 0;
+    std::string label_;
+    std::string error_;
+};
+
+using MicroBenchFn = void (*)(MicroState&);
+
+// Adds a benchmark to the global list; used through DIGIVICE_MICROBENCH
+bool registerMicroBench(const char* name, MicroBenchFn fn);
+
+// Keeps the optimizer from discarding a computed value
+void microBenchEscape(const volatile void* p);
+template <typename T>
+inline void doNotOptimize(const T& value) { microBenchEscape(&value); }
+
+#define DIGIVICE_MICROBENCH(fn) static const bool fn##_registered_ = registerMicroBench(#fn, fn)
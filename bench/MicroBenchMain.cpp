@@ -0,0 +1,215 @@
+// File: bench/MicroBenchMain.cpp
+// digivice_microbench: per-function timings of the engine's hot paths.
+// Usage: digivice_microbench [--benchmark_filter=<regex>] [--benchmark_min_time=<sec>]
+//                            [--benchmark_out=<file.json>] [--benchmark_list_tests]
+
+#include "MicroBench.h"
+#include <SDL_log.h>
+#include "vendor/nlohmann/json.hpp"
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <regex>
+#include <string>
+#include <thread>
+#include <vector>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+using json = nlohmann::json;
+
+namespace {
+
+struct MicroBench {
+    const char* name;
+    MicroBenchFn fn;
+};
+
+std::vector<MicroBench>& registry() {
+    static std::vector<MicroBench> benches; // Function-local so registration order across files doesn't matter
+    return benches;
+}
+
+const int64_t MAX_ITERATIONS = 1000000000;
+const double DEFAULT_MIN_TIME_SEC = 0.5;
+
+struct MicroResult {
+    std::string name;
+    int64_t iterations = 0;
+    double realNs = 0.0;  // Per iteration
+    double cpuNs = 0.0;   // Per iteration
+    double itemsPerSecond = 0.0;
+    std::string label;
+    std::string error;
+};
+
+// Same growth rule as Google Benchmark: aim 40% past the target, at most 10x per step
+MicroResult runOne(const MicroBench& bench, double minTimeSec) {
+    MicroResult result;
+    result.name = bench.name;
+    int64_t iterations = 1;
+    for (;;) {
+        MicroState state(iterations);
+        bench.fn(state);
+        if (!state.error().empty()) { result.error = state.error(); return result; }
+
+        const double seconds = state.realSeconds();
+        if (seconds >= minTimeSec || iterations >= MAX_ITERATIONS) {
+            result.iterations = state.iterations();
+            result.realNs = seconds * 1e9 / (double)iterations;
+            result.cpuNs = state.cpuSeconds() * 1e9 / (double)iterations;
+            if (state.itemsProcessed() > 0 && seconds > 0.0) result.itemsPerSecond = state.itemsProcessed() / seconds;
+            result.label = state.label();
+            return result;
+        }
+        double multiplier = (seconds > 1e-9) ? minTimeSec * 1.4 / seconds : 10.0;
+        if (multiplier > 10.0) multiplier = 10.0;
+        int64_t next = (int64_t)(iterations * multiplier);
+        iterations = (next > iterations) ? (next < MAX_ITERATIONS ? next : MAX_ITERATIONS) : iterations + 1;
+    }
+}
+
+json makeContext(const char* executable) {
+    char date[64] = {0};
+    std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+    json context;
+    context["date"] = date;
+    context["executable"] = executable;
+    context["num_cpus"] = std::thread::hardware_concurrency();
+    context["mhz_per_cpu"] = 0;
+    context["cpu_scaling_enabled"] = false;
+#ifdef NDEBUG
+    context["library_build_type"] = "release";
+#else
+    context["library_build_type"] = "debug";
+#endif
+    return context;
+}
+
+json makeEntry(const MicroResult& r, size_t familyIndex) {
+    json entry;
+    entry["name"] = r.name;
+    entry["family_index"] = familyIndex;
+    entry["per_family_instance_index"] = 0;
+    entry["run_name"] = r.name;
+    entry["run_type"] = "iteration";
+    entry["repetitions"] = 1;
+    entry["repetition_index"] = 0;
+    entry["threads"] = 1;
+    entry["iterations"] = r.iterations;
+    entry["real_time"] = r.realNs;
+    entry["cpu_time"] = r.cpuNs;
+    entry["time_unit"] = "ns";
+    if (r.itemsPerSecond > 0.0) entry["items_per_second"] = r.itemsPerSecond;
+    if (!r.label.empty()) entry["label"] = r.label;
+    if (!r.error.empty()) { entry["error_occurred"] = true; entry["error_message"] = r.error; }
+    return entry;
+}
+
+// Engine warnings (e.g. the AssetManager miss path) are still formatted, just not printed
+void discardLog(void*, int, SDL_LogPriority, const char*) {}
+
+const char* flagValue(const char* arg, const char* flag) {
+    const size_t len = std::strlen(flag);
+    return (std::strncmp(arg, flag, len) == 0 && arg[len] == '=') ? arg + len + 1 : nullptr;
+}
+
+} // end anonymous namespace
+
+
+bool registerMicroBench(const char* name, MicroBenchFn fn) {
+    registry().push_back({ name, fn });
+    return true;
+}
+
+// Written through a global (not a function-local static) so the store is never "set but unused"
+const volatile void* volatile g_microBenchSink = nullptr;
+
+void microBenchEscape(const volatile void* p) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r"(p) : "memory");
+#else
+    g_microBenchSink = p;
+#endif
+}
+
+uint64_t MicroState::cpuNow() {
+#ifdef _WIN32
+    FILETIME creation, exitTime, kernel, user;
+    if (!GetProcessTimes(GetCurrentProcess(), &creation, &exitTime, &kernel, &user)) return 0;
+    const uint64_t k = ((uint64_t)kernel.dwHighDateTime << 32) | kernel.dwLowDateTime;
+    const uint64_t u = ((uint64_t)user.dwHighDateTime << 32) | user.dwLowDateTime;
+    return (k + u) * 100; // 100ns units
+#else
+    timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+
+int main(int argc, char* argv[]) {
+    std::string filter = ".";
+    std::string outPath;
+    double minTimeSec = DEFAULT_MIN_TIME_SEC;
+    bool listOnly = false;
+    for (int i = 1; i < argc; ++i) {
+        if (const char* v = flagValue(argv[i], "--benchmark_filter")) filter = v;
+        else if (const char* v = flagValue(argv[i], "--benchmark_min_time")) minTimeSec = std::atof(v); // "0.5" or "0.5s"
+        else if (const char* v = flagValue(argv[i], "--benchmark_out")) outPath = v;
+        else if (std::strcmp(argv[i], "--benchmark_list_tests") == 0) listOnly = true;
+        else { std::printf("Unknown argument '%s'\n", argv[i]); return 1; }
+    }
+    if (minTimeSec <= 0.0) minTimeSec = DEFAULT_MIN_TIME_SEC;
+
+    std::regex filterRe;
+    try { filterRe = std::regex(filter); }
+    catch (const std::regex_error& e) { std::printf("Invalid --benchmark_filter '%s': %s\n", filter.c_str(), e.what()); return 1; }
+
+    std::vector<const MicroBench*> selected;
+    for (const MicroBench& bench : registry()) {
+        if (std::regex_search(bench.name, filterRe)) selected.push_back(&bench);
+    }
+    if (listOnly) {
+        for (const MicroBench* bench : selected) std::printf("%s\n", bench->name);
+        return 0;
+    }
+
+    SDL_LogSetAllPriority(SDL_LOG_PRIORITY_WARN);
+    SDL_LogSetOutputFunction(discardLog, nullptr);
+
+    std::printf("%-40s %15s %15s %12s\n", "Benchmark", "Time", "CPU", "Iterations");
+    std::printf("%s\n", std::string(85, '-').c_str());
+    json benchmarks = json::array();
+    int failures = 0;
+    for (size_t i = 0; i < selected.size(); ++i) {
+        MicroResult r = runOne(*selected[i], minTimeSec);
+        if (!r.error.empty()) {
+            std::printf("%-40s ERROR: %s\n", r.name.c_str(), r.error.c_str());
+            ++failures;
+        } else {
+            std::printf("%-40s %12.1f ns %12.1f ns %12lld", r.name.c_str(), r.realNs, r.cpuNs, (long long)r.iterations);
+            if (r.itemsPerSecond > 0.0) std::printf(" items/s=%.3g", r.itemsPerSecond);
+            if (!r.label.empty()) std::printf(" %s", r.label.c_str());
+            std::printf("\n");
+        }
+        benchmarks.push_back(makeEntry(r, i));
+    }
+
+    if (!outPath.empty()) {
+        json report;
+        report["context"] = makeContext(argv[0]);
+        report["benchmarks"] = benchmarks;
+        std::ofstream out(outPath);
+        if (!out.is_open()) { std::printf("Failed to open '%s' for writing\n", outPath.c_str()); return 1; }
+        out << report.dump(2) << "\n";
+        std::printf("Wrote %zu results to %s\n", selected.size(), outPath.c_str());
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,70 @@
+// File: bench/ParticleBench.cpp
+// Sustains large particle counts through ParticleSystem on the software renderer.
+
+#include "BenchCommon.h"
+#include "graphics/ParticleSystem.h"
+#include <vector>
+#include <cstdlib>
+
+namespace {
+
+const int WARMUP_FRAMES = 120;  // Long enough for the live count to reach its steady state
+const int FRAMES_PER_RUN = 300;
+const Scalar FRAME_DT = scalarFromTicks(17); // ~1/60 s in whole ticks, as Game::run produces
+const float PARTICLE_LIFE = 1.0f; // Seconds; with rate = count this keeps ~count particles alive
+
+} // end anonymous namespace
+
+int runParticleBench(int argc, char* argv[]) {
+    std::vector<int> counts;
+    for (int i = 0; i < argc; ++i) counts.push_back(std::atoi(argv[i]));
+    if (counts.empty()) counts = {50000, 100000};
+
+    BenchContext ctx;
+    if (!ctx.ok) return 1;
+
+    int screenW = 0, screenH = 0;
+    ctx.display.getWindowSize(screenW, screenH);
+    std::printf("%-8s %10s %12s %12s %10s %10s\n", "count", "live", "update_ms", "render_ms", "draws", "dropped");
+
+    for (int count : counts) {
+        ParticleSystem particles;
+        if (!particles.init(ctx.display.getRenderer(), &ctx.assets, static_cast<size_t>(count))) return 1;
+
+        // One fountain per built-in texture, so a frame is two batches and two draws
+        ParticleEmitterDesc fountain;
+        fountain.rate = static_cast<float>(count) / 2.0f / PARTICLE_LIFE;
+        fountain.duration = (WARMUP_FRAMES + FRAMES_PER_RUN) * scalarToFloat(FRAME_DT) * 2.0f;
+        fountain.lifeMin = fountain.lifeMax = PARTICLE_LIFE;
+        fountain.speedMin = 40.0f; fountain.speedMax = 160.0f;
+        fountain.gravity = 60.0f;
+        fountain.drag = 0.5f;
+        fountain.sizeStart = 6.0f; fountain.sizeEnd = 1.0f;
+        std::vector<ParticleEmitterDesc> emitters(2, fountain);
+        emitters[0].texture = "@glow";
+        emitters[1].texture = "@dot";
+        ParticleEffectId effect = particles.addEffect("fountain", emitters);
+        particles.start(effect, screenW / 2.0f, screenH / 2.0f);
+
+        for (int frameNo = 0; frameNo < WARMUP_FRAMES; ++frameNo) particles.update(FRAME_DT);
+
+        double updateMs = 0.0, renderMs = 0.0;
+        size_t liveTotal = 0;
+        BenchTimer timer;
+        for (int frameNo = 0; frameNo < FRAMES_PER_RUN; ++frameNo) {
+            timer.restart();
+            particles.update(FRAME_DT);
+            updateMs += timer.elapsedMs();
+            liveTotal += particles.getParticleCount();
+
+            timer.restart();
+            ctx.display.clear(0x0000);
+            particles.render(&ctx.display);
+            ctx.display.present();
+            renderMs += timer.elapsedMs();
+        }
+        std::printf("%-8d %10zu %12.4f %12.4f %10zu %10zu\n", count, liveTotal / FRAMES_PER_RUN,
+                    updateMs / FRAMES_PER_RUN, renderMs / FRAMES_PER_RUN, particles.getBatchCount(), particles.getDroppedCount());
+    }
+    return 0;
+}
@@ -0,0 +1,95 @@
+# Python Script: cook_transition_borders.py
+# Measures the visible band of each transition border frame and writes it back
+# into the atlas JSON, so BorderRenderer only draws the band instead of the
+# whole mostly-transparent 466x466 frame.
+#   "band":   rows/columns that carry any real coverage (frame-local)
+#   "opaque": largest fully opaque rectangle inside the band (drawn without blending)
+
+import os
+import json
+from PIL import Image
+
+# --- Configuration ---
+atlas_json = "assets/ui/transition/transition_borders.json"
+
+# Which axis each frame's band runs along
+horizontal_frames = ["border_top", "border_bottom"]
+vertical_frames = ["border_left", "border_right"]
+
+# A row/column belongs to the band when at least this fraction of it has alpha > 0
+# (filters out the faint bleed lines the packer left along frame edges)
+band_coverage = 0.5
+# ---------------------
+
+def measure_band(px, fx, fy, fw, fh, horizontal):
+    lines = range(fh) if horizontal else range(fw)
+    length = fw if horizontal else fh
+    covered = []
+    for i in lines:
+        count = 0
+        for j in range(length):
+            x, y = (fx + j, fy + i) if horizontal else (fx + i, fy + j)
+            if px[x, y][3] > 0: count += 1
+        if count >= band_coverage * length: covered.append(i)
+    if not covered: return None
+    start, end = covered[0], covered[-1] + 1
+    if horizontal: return [0, start, fw, end - start]
+    return [start, 0, end - start, fh]
+
+def measure_opaque(px, fx, fy, band):
+    # Peel the edge line with the most non-opaque pixels until the rect is solid
+    x, y, w, h = band
+    def misses(line):
+        return sum(1 for (lx, ly) in line if px[fx + lx, fy + ly][3] < 255)
+    while w > 0 and h > 0:
+        edges = {
+            "top": misses([(x + i, y) for i in range(w)]),
+            "bottom": misses([(x + i, y + h - 1) for i in range(w)]),
+            "left": misses([(x, y + i) for i in range(h)]),
+            "right": misses([(x + w - 1, y + i) for i in range(h)]),
+        }
+        worst = max(edges, key=edges.get)
+        if edges[worst] == 0: break
+        if worst == "top": y += 1; h -= 1
+        elif worst == "bottom": h -= 1
+        elif worst == "left": x += 1; w -= 1
+        else: w -= 1
+    return [x, y, max(w, 0), max(h, 0)]
+
+def as_rect(values):
+    return {"x": values[0], "y": values[1], "w": values[2], "h": values[3]}
+
+try:
+    script_dir = os.path.dirname(os.path.abspath(__file__))
+    json_path = os.path.join(script_dir, atlas_json)
+    with open(json_path) as f:
+        data = json.load(f)
+
+    image_path = os.path.join(os.path.dirname(json_path), data["meta"]["image"])
+    print(f"Measuring borders in: {os.path.abspath(image_path)}")
+    img = Image.open(image_path).convert("RGBA")
+    px = img.load()
+
+    for name in horizontal_frames + vertical_frames:
+        if name not in data["frames"]:
+            print(f"  Warning: '{name}' not in atlas, skipping")
+            continue
+        entry = data["frames"][name]
+        frame = entry["frame"]
+        band = measure_band(px, frame["x"], frame["y"], frame["w"], frame["h"], name in horizontal_frames)
+        if band is None:
+            print(f"  Warning: '{name}' is fully transparent, skipping")
+            continue
+        opaque = measure_opaque(px, frame["x"], frame["y"], band)
+        entry["band"] = as_rect(band)
+        entry["opaque"] = as_rect(opaque)
+        print(f"  {name}: band {band}, opaque {opaque}")
+
+    with open(json_path, "w") as f:
+        json.dump(data, f, indent=2)
+    print(f"Updated {json_path}")
+
+except FileNotFoundError as e:
+    print(f"Error: {e}")
+except Exception as e:
+    print(f"Unexpected error: {e}")
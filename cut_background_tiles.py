@@ -0,0 +1,55 @@
+# Python Script: cut_background_tiles.py
+# Cuts a wide background strip into fixed-width PNG tiles plus a JSON manifest
+# that TiledBackground streams at runtime (see include/graphics/TiledBackground.h).
+
+import os
+import json
+from PIL import Image
+
+# --- Configuration ---
+# Wide panorama to cut (any width; GPUs usually cap single textures at 4096-16384 px)
+input_image = "route_input/route_panorama.png"
+
+# Output folder for tiles and the manifest
+output_folder = "../DigiviceRefactor/assets/backgrounds/route"
+
+# Width of each tile in pixels (the last tile may be narrower)
+tile_width = 512
+# ---------------------
+
+try:
+    script_dir = os.path.dirname(os.path.abspath(__file__))
+    input_path = os.path.join(script_dir, input_image)
+    output_dir_path = os.path.join(script_dir, output_folder)
+    os.makedirs(output_dir_path, exist_ok=True)
+
+    print(f"Cutting: {os.path.abspath(input_path)}")
+    print(f"Output folder: {os.path.abspath(output_dir_path)}")
+
+    img = Image.open(input_path).convert("RGBA")
+    width, height = img.size
+    base_name = os.path.splitext(os.path.basename(input_path))[0]
+
+    tile_names = []
+    for index, left in enumerate(range(0, width, tile_width)):
+        right = min(left + tile_width, width)
+        tile_name = f"{base_name}_{index:04d}.png"
+        img.crop((left, 0, right, height)).save(os.path.join(output_dir_path, tile_name))
+        tile_names.append(tile_name)
+        print(f"  Wrote {tile_name} ({right - left}x{height})")
+
+    manifest = {
+        "tile_width": tile_width,
+        "height": height,
+        "width": width,
+        "tiles": tile_names,
+    }
+    manifest_path = os.path.join(output_dir_path, f"{base_name}.json")
+    with open(manifest_path, "w") as f:
+        json.dump(manifest, f, indent=2)
+    print(f"Wrote manifest {manifest_path} ({len(tile_names)} tiles)")
+
+except FileNotFoundError as e:
+    print(f"Error: {e}")
+except Exception as e:
+    print(f"Unexpected error: {e}")
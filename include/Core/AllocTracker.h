@@ -0,0 +1,54 @@
+// File: include/core/AllocTracker.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Phases of one Game::run iteration, used to attribute heap allocations
+enum class FramePhase {
+    OUTSIDE_FRAME,  // Loading, shutdown, anything not inside the loop
+    EVENTS,
+    INPUT,
+    UPDATE,
+    STATE_CHANGES,
+    RENDER,
+    LOADING,        // Deferred assets and partner-sheet streaming; loaders allocate, as at init
+    COUNT
+};
+
+struct FrameAllocStats {
+    uint32_t count[static_cast<size_t>(FramePhase::COUNT)] = {};
+    size_t bytes[static_cast<size_t>(FramePhase::COUNT)] = {};
+
+    uint32_t totalCount() const;
+    size_t totalBytes() const;
+};
+
+// Counts global operator new calls made by the frame thread, per FramePhase.
+// Frame work that runs as a job (the pipelined simulation) brackets itself with
+// beginJob()/endJob() on whichever thread picks it up, and the frame thread
+// merges the result before endFrame().
+// The counting operator new/delete are only compiled in when
+// DIGIVICE_TRACK_ALLOCATIONS is defined; otherwise every call here is a no-op
+// and isEnabled() returns false.
+class AllocTracker {
+public:
+    static bool isEnabled();
+
+    // Binds tracking to the calling thread and clears the frame's counters.
+    // Allocations from other threads (e.g. the tile decoder) are not counted.
+    static void beginFrame();
+    static void setPhase(FramePhase phase);
+    static FramePhase getPhase(); // So a nested phase (e.g. LOADING) can put back the one it interrupted
+    static FrameAllocStats endFrame();
+
+    // Counts the calling thread's allocations into a fresh tally until endJob(),
+    // which returns it and restores what the thread was doing before (the frame's
+    // own counters, when the job ran inline on the frame thread). Does not nest.
+    static void beginJob();
+    static FrameAllocStats endJob();
+    // Adds a job's tally to the frame's; call on the frame thread before endFrame()
+    static void mergeJob(const FrameAllocStats& job);
+
+    static const char* getPhaseName(FramePhase phase);
+};
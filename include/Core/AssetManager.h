@@ -1,26 +1,75 @@
 #pragma once
 
 #include <string>
-#include <map>
+#include <memory>     // std::unique_ptr
 #include <SDL.h> // <<< CORRECTED SDL Include >>>
+#include "core/MemoryBudget.h" // AssetTable, MAX_TEXTURES
+#include "audio/AudioSystem.h" // SoundClip
+#include "platform/DisplayProfile.h" // Load-time variants
+#if defined(DIGIVICE_NO_HEAP)
+#include "graphics/PalettedSheet.h" // Stored inline
+#endif
 
 // Forward declare SDL_Texture and SDL_Renderer
 struct SDL_Texture;
 struct SDL_Renderer;
+class PalettedSheet; // graphics/PalettedSheet.h
 
 class AssetManager {
 public:
-    AssetManager() = default;
+    AssetManager();
     ~AssetManager();
 
     bool init(SDL_Renderer* renderer);
-    bool loadTexture(const std::string& textureId, const std::string& filePath);
+    // Images loaded with a filter other than NONE are held at this profile's size
+    // (graphics/SurfaceScale.h); set it before loading. Defaults to full size.
+    void setDisplayProfile(const DisplayProfile* profile) { profile_ = profile; }
+    const DisplayProfile& getDisplayProfile() const { return profile_ ? *profile_ : getDefaultDisplayProfile(); }
+    bool loadTexture(const std::string& textureId, const std::string& filePath, ScaleFilter filter = ScaleFilter::NONE);
     SDL_Texture* getTexture(const std::string& textureId) const;
+    SDL_Texture* getTexture(const char* textureId) const; // Literal ids look up without building a std::string
+    // Loads an 8-bit indexed PNG as a PalettedSheet so it can be recoloured at runtime.
+    // getTexture(textureId) returns its texture like any other (a handle PCDisplay
+    // expands from on the software renderer). Non-indexed images
+    // fall back to a plain texture (and getPalettedSheet returns null for them).
+    // A downscaled sheet needs its frame rects scaled to match (scaleSpriteFrames).
+    bool loadPalettedSheet(const std::string& textureId, const std::string& filePath, ScaleFilter filter = ScaleFilter::NONE);
+    PalettedSheet* getPalettedSheet(const char* textureId) const;
+    // Applies palettes picked with PalettedSheet::setPalette since the last call.
+    // Game calls it on the render thread before each frame is drawn.
+    void applyPaletteChanges();
+    // As loadPalettedSheet, from a surface decoded (and scaled) elsewhere, e.g. by a
+    // job. Main thread only, like every other load; the caller still owns 'surface'.
+    bool addPalettedSheet(const std::string& textureId, SDL_Surface* surface);
+    // Frees a texture or paletted sheet; pointers to it must be dropped first.
+    void unloadTexture(const char* textureId);
+    // Loads a WAV effect into RAM, converted to the mixer's format (mono, AUDIO_SAMPLE_RATE).
+    // The returned clip stays valid until shutdown(); pass it to AudioSystem::play.
+    bool loadSound(const std::string& soundId, const std::string& filePath);
+    const SoundClip* getSound(const char* soundId) const;
+    SDL_Renderer* getRenderer() const { return renderer_ptr; }
     void shutdown();
 
 private:
     SDL_Renderer* renderer_ptr = nullptr;
-    std::map<std::string, SDL_Texture*> textures_;
+    const DisplayProfile* profile_ = nullptr; // Non-owning; null = full size
+    // Transparent compare: find() takes const char* too. Fixed-capacity flat maps in no-heap builds.
+    AssetTable<SDL_Texture*, MAX_TEXTURES> textures_;
+#if defined(DIGIVICE_NO_HEAP)
+    AssetTable<PalettedSheet*, MAX_PALETTED_SHEETS> palettedSheets_; // Into sheetStorage_
+    StaticVector<PalettedSheet, MAX_PALETTED_SHEETS> sheetStorage_;
+#else
+    AssetTable<std::unique_ptr<PalettedSheet>, MAX_PALETTED_SHEETS> palettedSheets_;
+#endif
+    AssetTable<SoundClip, MAX_SOUNDS> sounds_; // Samples are SDL_malloc'd; freed in shutdown()
+
+    // Logs and returns false if 'table' has no room for another id (no-heap builds)
+    template <typename Table>
+    bool hasRoomFor(const Table& table, const std::string& textureId) const;
+
+    SDL_Surface* loadSurface(const std::string& textureId, const std::string& filePath) const;
+    // loadSurface at the profile's size: a shipped variant, or the full image downscaled
+    SDL_Surface* loadSurfaceForProfile(const std::string& textureId, const std::string& filePath, ScaleFilter filter) const;
 
     AssetManager(const AssetManager&) = delete;
     AssetManager& operator=(const AssetManager&) = delete;
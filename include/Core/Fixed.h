@@ -0,0 +1,63 @@
+// File: include/core/Fixed.h
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+// Signed fixed-point number: IntBits integer bits (sign included) and FracBits
+// fraction bits packed in an int32_t. Every operation is integer-only, so it costs
+// a few instructions on MCUs without an FPU instead of a soft-float library call.
+//
+// Products round towards negative infinity and quotients towards zero. Overflow
+// wraps. Floating-point values don't convert implicitly (a stray 0.5f must not
+// silently pull soft-float back into a fixed-point build); use fromDouble() for
+// constants and load-time data.
+template <int IntBits, int FracBits>
+class Fixed {
+    static_assert(IntBits >= 2 && FracBits >= 0 && IntBits + FracBits == 32, "Fixed<I, F> is stored in 32 bits");
+
+public:
+    using Raw = int32_t;
+    static const int FRACTION_BITS = FracBits;
+    static const Raw ONE = Raw(1) << FracBits;
+
+    constexpr Fixed() = default;
+    template <typename I, typename std::enable_if<std::is_integral<I>::value, int>::type = 0>
+    constexpr Fixed(I value) : raw_(static_cast<Raw>(static_cast<uint32_t>(value) << FracBits)) {}
+    template <typename F, typename std::enable_if<std::is_floating_point<F>::value, int>::type = 0>
+    Fixed(F value) = delete;
+
+    static constexpr Fixed fromRaw(Raw raw) { Fixed f; f.raw_ = raw; return f; }
+    // Rounds to the nearest representable value
+    static constexpr Fixed fromDouble(double value) {
+        return fromRaw(static_cast<Raw>(value * ONE + (value < 0.0 ? -0.5 : 0.5)));
+    }
+
+    constexpr Raw raw() const { return raw_; }
+    constexpr int floorToInt() const { return raw_ >> FracBits; }
+    constexpr double toDouble() const { return static_cast<double>(raw_) / ONE; }
+    constexpr float toFloat() const { return static_cast<float>(raw_) / ONE; }
+
+    // --- Arithmetic ---
+    friend constexpr Fixed operator+(Fixed a, Fixed b) { return fromRaw(static_cast<Raw>(static_cast<uint32_t>(a.raw_) + static_cast<uint32_t>(b.raw_))); }
+    friend constexpr Fixed operator-(Fixed a, Fixed b) { return fromRaw(static_cast<Raw>(static_cast<uint32_t>(a.raw_) - static_cast<uint32_t>(b.raw_))); }
+    friend constexpr Fixed operator*(Fixed a, Fixed b) { return fromRaw(static_cast<Raw>((static_cast<int64_t>(a.raw_) * b.raw_) >> FracBits)); }
+    friend constexpr Fixed operator/(Fixed a, Fixed b) { return fromRaw(static_cast<Raw>(static_cast<int64_t>(a.raw_) * ONE / b.raw_)); }
+    constexpr Fixed operator-() const { return fromRaw(static_cast<Raw>(0u - static_cast<uint32_t>(raw_))); }
+
+    Fixed& operator+=(Fixed other) { return *this = *this + other; }
+    Fixed& operator-=(Fixed other) { return *this = *this - other; }
+    Fixed& operator*=(Fixed other) { return *this = *this * other; }
+    Fixed& operator/=(Fixed other) { return *this = *this / other; }
+
+    // --- Comparison ---
+    friend constexpr bool operator==(Fixed a, Fixed b) { return a.raw_ == b.raw_; }
+    friend constexpr bool operator!=(Fixed a, Fixed b) { return a.raw_ != b.raw_; }
+    friend constexpr bool operator<(Fixed a, Fixed b) { return a.raw_ < b.raw_; }
+    friend constexpr bool operator<=(Fixed a, Fixed b) { return a.raw_ <= b.raw_; }
+    friend constexpr bool operator>(Fixed a, Fixed b) { return a.raw_ > b.raw_; }
+    friend constexpr bool operator>=(Fixed a, Fixed b) { return a.raw_ >= b.raw_; }
+
+private:
+    Raw raw_ = 0;
+};
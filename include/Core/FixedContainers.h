@@ -0,0 +1,182 @@
+// File: include/core/FixedContainers.h
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <functional> // std::less<>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Containers whose storage is part of the object, sized at compile time. They
+// never touch the heap: a full container refuses the insert (push_back and
+// insert_or_assign return false) and the caller decides what to log. Used by
+// DIGIVICE_NO_HEAP builds through the aliases in core/MemoryBudget.h.
+
+// --- StaticVector ---
+// A std::vector subset over an inline array of N elements. Elements are
+// constructed in place, so T needs neither a default constructor nor copying.
+template <typename T, size_t N>
+class StaticVector {
+public:
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    StaticVector() = default;
+    StaticVector(const StaticVector& other) { for (const T& item : other) emplace_back(item); }
+    StaticVector& operator=(const StaticVector& other) {
+        if (this != &other) { clear(); for (const T& item : other) emplace_back(item); }
+        return *this;
+    }
+    StaticVector(StaticVector&& other) noexcept(std::is_nothrow_move_constructible<T>::value) {
+        for (T& item : other) emplace_back(std::move(item));
+        other.clear();
+    }
+    StaticVector& operator=(StaticVector&& other) noexcept(std::is_nothrow_move_constructible<T>::value) {
+        if (this != &other) { clear(); for (T& item : other) emplace_back(std::move(item)); other.clear(); }
+        return *this;
+    }
+    ~StaticVector() { clear(); }
+
+    template <typename... Args>
+    bool emplace_back(Args&&... args) {
+        if (size_ == N) return false;
+        new (slot(size_)) T(std::forward<Args>(args)...);
+        ++size_;
+        return true;
+    }
+    bool push_back(const T& value) { return emplace_back(value); }
+    bool push_back(T&& value) { return emplace_back(std::move(value)); }
+    void pop_back() { if (size_ > 0) data()[--size_].~T(); }
+    void clear() { while (size_ > 0) pop_back(); }
+    // Shrinks, or grows with value-initialised elements; past N it returns false and changes nothing
+    bool resize(size_t count) {
+        if (count > N) return false;
+        while (size_ > count) pop_back();
+        while (size_ < count) emplace_back();
+        return true;
+    }
+
+    size_t size() const { return size_; }
+    static constexpr size_t max_size() { return N; }
+    static constexpr size_t capacity() { return N; }
+    bool empty() const { return size_ == 0; }
+
+    T* data() { return std::launder(reinterpret_cast<T*>(storage_)); }
+    const T* data() const { return std::launder(reinterpret_cast<const T*>(storage_)); }
+    T& operator[](size_t index) { return data()[index]; }
+    const T& operator[](size_t index) const { return data()[index]; }
+    T& back() { return data()[size_ - 1]; }
+    const T& back() const { return data()[size_ - 1]; }
+
+    iterator begin() { return data(); }
+    iterator end() { return data() + size_; }
+    const_iterator begin() const { return data(); }
+    const_iterator end() const { return data() + size_; }
+
+    // Removes the element at 'pos', shifting the rest down
+    iterator erase(iterator pos) {
+        for (iterator it = pos; it + 1 != end(); ++it) *it = std::move(*(it + 1));
+        pop_back();
+        return pos;
+    }
+
+private:
+    void* slot(size_t index) { return storage_ + index * sizeof(T); }
+
+    alignas(T) unsigned char storage_[N * sizeof(T)];
+    size_t size_ = 0;
+};
+
+
+// --- FixedString ---
+// A NUL-terminated string of at most MaxLength chars, stored inline. Longer
+// input is truncated; check fits() first where that matters (e.g. map keys).
+template <size_t MaxLength>
+class FixedString {
+public:
+    static const size_t MAX_LENGTH = MaxLength;
+
+    FixedString() = default;
+    FixedString(const char* text) { assign(text); }
+
+    static bool fits(const char* text) { return text && std::strlen(text) <= MaxLength; }
+    void assign(const char* text) {
+        size_t length = 0;
+        if (text) while (length < MaxLength && text[length] != '\0') { chars_[length] = text[length]; ++length; }
+        chars_[length] = '\0';
+    }
+
+    const char* c_str() const { return chars_; }
+    size_t size() const { return std::strlen(chars_); }
+
+    // Ordered like std::string, and comparable with C strings so FlatMap lookups don't need a key object
+    friend bool operator<(const FixedString& a, const FixedString& b) { return std::strcmp(a.chars_, b.chars_) < 0; }
+    friend bool operator<(const FixedString& a, const char* b) { return std::strcmp(a.chars_, b) < 0; }
+    friend bool operator<(const char* a, const FixedString& b) { return std::strcmp(a, b.chars_) < 0; }
+    friend bool operator==(const FixedString& a, const char* b) { return std::strcmp(a.chars_, b) == 0; }
+
+private:
+    char chars_[MaxLength + 1] = {};
+};
+
+
+// --- FlatMap ---
+// Sorted array of up to N key/value pairs: binary-search lookups, inserts shift
+// the tail. Meant for tables filled at load time and read every frame. Compare
+// must also order Key against the lookup types passed to find()/count().
+template <typename Key, typename Value, size_t N, typename Compare = std::less<>>
+class FlatMap {
+public:
+    using value_type = std::pair<Key, Value>;
+    using iterator = value_type*;
+    using const_iterator = const value_type*;
+
+    template <typename Q>
+    iterator find(const Q& key) {
+        iterator it = lowerBound(key);
+        return (it != end() && !Compare()(key, it->first)) ? it : end();
+    }
+    template <typename Q>
+    const_iterator find(const Q& key) const { return const_cast<FlatMap*>(this)->find(key); }
+    template <typename Q>
+    size_t count(const Q& key) const { return find(key) != end() ? 1 : 0; }
+
+    // Returns false (and leaves the map unchanged) when a new key doesn't fit
+    template <typename Q, typename V>
+    bool insert_or_assign(const Q& key, V&& value) {
+        iterator it = lowerBound(key);
+        if (it != end() && !Compare()(key, it->first)) { it->second = std::forward<V>(value); return true; }
+        const size_t index = static_cast<size_t>(it - begin());
+        if (!items_.emplace_back(Key(key), std::forward<V>(value))) return false;
+        for (size_t i = items_.size() - 1; i > index; --i) std::swap(items_[i], items_[i - 1]); // Rotate into place
+        return true;
+    }
+
+    // Shifts the tail down, keeping the order
+    iterator erase(iterator pos) { return items_.erase(pos); }
+    void clear() { items_.clear(); }
+    size_t size() const { return items_.size(); }
+    static constexpr size_t max_size() { return N; }
+    bool empty() const { return items_.empty(); }
+
+    iterator begin() { return items_.begin(); }
+    iterator end() { return items_.end(); }
+    const_iterator begin() const { return items_.begin(); }
+    const_iterator end() const { return items_.end(); }
+
+private:
+    template <typename Q>
+    iterator lowerBound(const Q& key) {
+        size_t low = 0, high = items_.size();
+        while (low < high) {
+            const size_t mid = (low + high) / 2;
+            if (Compare()(items_[mid].first, key)) low = mid + 1;
+            else high = mid;
+        }
+        return begin() + low;
+    }
+
+    StaticVector<value_type, N> items_;
+};
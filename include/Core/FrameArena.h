@@ -0,0 +1,82 @@
+// File: include/core/FrameArena.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+// Bump allocator for data that only lives for one frame (scratch lists, draw
+// lists, formatted text). Game::run resets it at the top of every frame, so
+// nothing allocated from it may be kept across frames. The buffer is allocated
+// once in init(); allocating is a pointer bump and freeing is a no-op.
+class FrameArena {
+public:
+    FrameArena() = default;
+    ~FrameArena();
+
+    bool init(size_t capacityBytes);
+    // Uses a caller-owned buffer instead (static storage in no-heap builds)
+    bool init(void* buffer, size_t capacityBytes);
+    void shutdown();
+
+    // Returns nullptr (and counts an overflow) once the frame's budget is used up
+    void* allocate(size_t bytes, size_t alignment = alignof(std::max_align_t));
+    bool owns(const void* ptr) const;
+    // Start of frame: everything handed out so far becomes invalid
+    void reset();
+
+    size_t getCapacity() const { return capacity_; }
+    size_t getUsed() const { return used_; }
+    size_t getHighWater() const { return highWater_; } // Largest single-frame use so far
+    size_t getOverflowCount() const { return overflowCount_; }
+
+private:
+    unsigned char* buffer_ = nullptr; // Owned unless ownsBuffer_ is false
+    bool ownsBuffer_ = false;
+    size_t capacity_ = 0;
+    size_t used_ = 0;
+    size_t highWater_ = 0;
+    size_t overflowCount_ = 0;
+    bool warnedThisFrame_ = false;
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+};
+
+// Standard allocator over a FrameArena. Falls back to the heap when the arena is
+// null or full, so callers never need a second code path.
+template <typename T>
+class FrameArenaAllocator {
+public:
+    using value_type = T;
+
+    FrameArenaAllocator(FrameArena* arena = nullptr) noexcept : arena_(arena) {}
+    template <typename U>
+    FrameArenaAllocator(const FrameArenaAllocator<U>& other) noexcept : arena_(other.getArena()) {}
+
+    T* allocate(size_t count) {
+        if (arena_) {
+            if (void* ptr = arena_->allocate(count * sizeof(T), alignof(T))) return static_cast<T*>(ptr);
+        }
+        return static_cast<T*>(::operator new(count * sizeof(T)));
+    }
+    void deallocate(T* ptr, size_t) noexcept {
+        if (arena_ && arena_->owns(ptr)) return; // Reclaimed by the next reset()
+        ::operator delete(ptr);
+    }
+
+    FrameArena* getArena() const noexcept { return arena_; }
+
+    template <typename U>
+    bool operator==(const FrameArenaAllocator<U>& other) const noexcept { return arena_ == other.getArena(); }
+    template <typename U>
+    bool operator!=(const FrameArenaAllocator<U>& other) const noexcept { return arena_ != other.getArena(); }
+
+private:
+    FrameArena* arena_;
+};
+
+// A vector whose storage comes from the frame arena: FrameVector<int> v{FrameArenaAllocator<int>(arena)};
+template <typename T>
+using FrameVector = std::vector<T, FrameArenaAllocator<T>>;
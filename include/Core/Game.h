@@ -7,8 +7,24 @@
 #include <SDL.h>
 #include "platform/pc/pc_display.h"
 #include "core/AssetManager.h"
+#include "core/AllocTracker.h"
+#include "core/FrameArena.h"
+#include "core/JobSystem.h"
+#include "core/StatePool.h"
+#include "core/TimerWheel.h"
+#include "platform/DisplayProfile.h"
+#include "entities/Roster.h"
+#include "entities/RosterSheets.h"
+#include "audio/AudioSystem.h"
+#include "input/StepPipeline.h"
+#include "ui/BitmapFont.h"
+#include "graphics/RenderList.h"
+#include "graphics/FrameCapture.h"
+#include "graphics/BorderRenderer.h"
 #include "states/GameState.h" // Include full definition
 
+class MappedSnapshot; // core/SaveSnapshot.h
+
 class Game {
 public:
     // Constructor and Destructor Declarations
@@ -18,43 +34,115 @@ public:
     // Core Functions
     bool init(const std::string& title, int width, int height);
     void run();
+    // Pipelined mode: the top state's input/update for frame N+1 runs as a job
+    // while this thread submits frame N from a recorded RenderList.
+    // Must be set before run().
+    void setPipelined(bool pipelined);
+    // Save/resume: init() resumes from this snapshot when it holds a usable one
+    // (loading only what the first frame draws, the rest over the next frames),
+    // and close() saves to it. Must be set before init(); empty disables both.
+    void setSnapshotPath(const std::string& path);
+    // The screen to lay out and size assets for (platform/DisplayProfile.h).
+    // Must be set before init(); defaults to the full-size round screen.
+    void setDisplayProfile(const DisplayProfile& profile);
+    const DisplayProfile& getDisplayProfile() const { return *display_profile_; }
+    // Atomically writes the state stack and resident assets to the snapshot path
+    bool saveSnapshot();
 
     // --- State Management Requests (Called by States) ---
-    void requestPushState(std::unique_ptr<GameState> state);
+    // Create the state with makeState<T>(...) (core/StatePool.h)
+    void requestPushState(StatePtr state);
     void requestPopState();
-    // void requestChangeState(std::unique_ptr<GameState> state); // Add later if needed
+    // Applies queued push/pop requests. Called once per frame by run(); public so
+    // headless tools can drive the stack without a window.
+    void applyStateChanges();
+    // void requestChangeState(StatePtr state); // Add later if needed
 
     // Other Public Methods
     void quit_game();
     PCDisplay* get_display();
     AssetManager* getAssetManager();
+    BitmapFont* getFont();
+    BorderRenderer* getBorders(); // Transition edge strips; check isReady()
+    FrameArena* getFrameArena(); // Reset at the start of every frame
+    JobSystem* getJobSystem();   // The engine's one thread pool
+    TimerWheel& getTimers();     // Game time; fires just before the top state's input and update
+    const Roster& getRoster() const;  // Every partner the game knows about
+    RosterSheets* getRosterSheets();  // Which partners' sheets are resident
+    StepPipeline* getStepPipeline(); // Accelerometer input; started by main()
+    AudioSystem* getAudio();         // Sound effects; silent if no device opened
+    FrameCapture* getFrameCapture(); // Frame recording; started by main()
+    int takeDetectedSteps();         // Steps detected since the last call
     GameState* getCurrentState();
 
     // <<< --- ADDED HELPER to access stack (temporary/debug) --- >>>
     // Provides access to the state stack, primarily for MenuState to find TransitionState.
     // Note: Exposing the stack directly isn't ideal encapsulation long-term.
-    std::vector<std::unique_ptr<GameState>>& DEBUG_getStack();
+    StateStack& DEBUG_getStack();
     // <<< ------------------------------------------------------- >>>
 
 
 private:
     // Private Helper Functions
     void close();
+    void checkFrameAllocations(bool settled); // Allocation-tracking builds only
+    void logStaticMemoryUse() const;          // No-heap builds only
+    // --- Save/Resume ---
+    bool loadStartupAssets(const MappedSnapshot* snapshot); // Defers what the snapshot's first frame doesn't draw
+    bool loadStartupAsset(size_t index);
+    void loadDeferredAsset();                 // One per frame until none are left
+    void loadBorders();                       // Once the border atlas is resident
+    bool restoreStates(const MappedSnapshot& snapshot);
+    void logWakeTime() const;
+    // --- Frame Steps (shared by serial and pipelined loops) ---
+    void simulate(Scalar delta_time);
+    void applyFrameStateChanges();
+    bool renderFrame(RenderList* list);
+    void kickSimulation(Scalar delta_time); // Pipelined mode
+    void waitForSimulation();
     // --- State Management (Internal - Called by run loop) ---
-    void push_state(std::unique_ptr<GameState> new_state);
+    void push_state(StatePtr new_state);
     void pop_state();
-    void applyStateChanges(); // Apply queued requests
 
     // Member Variables
     PCDisplay display;
     AssetManager assetManager;
+    BitmapFont font;
+    BorderRenderer borders_;          // Cooked once the atlas loads, shared by every transition
+    FrameArena frameArena;
+    JobSystem jobs;
+    StepPipeline stepPipeline_;
+    AudioSystem audio_;
+    FrameCapture capture_;
+    TimerWheel timers_;               // Advanced by simulate(), whichever state is on top
+    const DisplayProfile* display_profile_ = &getDefaultDisplayProfile(); // Non-owning (static table)
+    Roster roster_;
+    RosterSheets rosterSheets_;       // Uploads at the end of each frame, while no update runs
+    int detected_steps_ = 0;          // Polled every frame whichever state is on top
     bool is_running = false;
-    std::vector<std::unique_ptr<GameState>> states_; // State stack
+    StateStack states_;               // Bounded in no-heap builds (MAX_STATE_DEPTH)
     Uint32 last_frame_time = 0;
+    FrameClock frame_clock_;          // SDL milliseconds -> frame ticks
+    Uint32 frame_count_ = 0;
+    Uint32 last_disturbed_frame_ = 0; // Last frame with OS events or a state change
+
+    // --- Save/Resume ---
+    std::string snapshot_path_;
+    uint32_t resident_assets_ = 0;    // Bit i: startup asset i is loaded
+    uint32_t deferred_assets_ = 0;    // Bit i: startup asset i loads after the first frame
+    bool resumed_ = false;
+    Uint64 init_start_counter_ = 0;   // Wake time is measured from init() to the first present
+
+    // --- Pipelining ---
+    bool pipelined_ = false;
+    bool loop_running_ = false;
+    RenderList render_list_;          // Recorded while the simulation job is idle, replayed while it runs
+    Job* sim_job_ = nullptr;          // This frame's simulation job, if one is in flight
+    FrameAllocStats sim_allocs_;      // Its heap allocations, merged into the frame's on wait
 
     // --- State Change Request Flags/Data ---
     bool request_pop_ = false;
-    std::unique_ptr<GameState> request_push_ = nullptr;
+    StatePtr request_push_;
     // bool request_change_ = false;
-    // std::unique_ptr<GameState> request_change_to_ = nullptr;
+    // StatePtr request_change_to_ = nullptr;
 };
\ No newline at end of file
@@ -0,0 +1,140 @@
+// File: include/core/JobSystem.h
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+class JobSystem;
+struct Job;
+using JobFunction = void (*)(Job* job);
+
+// A unit of work. Small trivially-copyable callables (lambdas capturing
+// pointers/indices) are stored inline in 'payload', so creating a job never
+// touches the heap. A job counts as finished once it and all of its children ran.
+struct Job {
+    static const size_t PAYLOAD_BYTES = 48;
+
+    JobFunction function = nullptr;
+    Job* parent = nullptr;
+    std::atomic<int> unfinishedJobs{0};
+    alignas(std::max_align_t) unsigned char payload[PAYLOAD_BYTES];
+};
+
+// Work-stealing scheduler shared by the whole engine: one worker thread per spare
+// core, each with its own job deque. A thread pops its own newest job first and
+// steals the oldest job of another thread when it runs dry.
+//
+// Jobs come from per-thread ring pools. A slot is only handed out again once its
+// job has finished, so a long job (a sheet or tile decode) survives the ring
+// wrapping; a thread with all MAX_JOBS_PER_THREAD slots live runs other jobs until
+// one frees. Only the thread that called init() and the workers may create jobs.
+class JobSystem {
+public:
+    static const size_t MAX_JOBS_PER_THREAD = 1024;
+
+    JobSystem() = default;
+    ~JobSystem();
+
+    // workerCount 0 = one worker per hardware thread beyond the caller's.
+    // With no workers, run() executes jobs immediately on the calling thread.
+    bool init(unsigned workerCount = 0);
+    void shutdown();
+    bool isInitialized() const { return !queues_.empty(); }
+    unsigned getWorkerCount() const { return static_cast<unsigned>(workers_.size()); }
+    unsigned getThreadCount() const { return static_cast<unsigned>(queues_.size()); } // Workers + caller
+
+    Job* createJob(JobFunction function);
+    Job* createChildJob(Job* parent, JobFunction function);
+    template <typename F> Job* createJob(F&& callable) { return createChildJob(nullptr, std::forward<F>(callable)); }
+    template <typename F> Job* createChildJob(Job* parent, F&& callable);
+
+    // Queues the job on the calling thread's deque. Children must be run before
+    // waiting on their parent.
+    void run(Job* job);
+    // Executes other jobs while the given job (and its children) are unfinished
+    void wait(const Job* job);
+    bool isFinished(const Job* job) const { return job->unfinishedJobs.load(std::memory_order_acquire) <= 0; }
+
+    // Splits [0, count) into chunks of at most 'grain' items and calls
+    // body(begin, end) for each, in parallel. Returns once every chunk ran.
+    template <typename F> void parallelFor(size_t count, size_t grain, const F& body);
+
+private:
+    // Fixed-capacity deque guarded by a mutex: the owner pushes/pops at the back,
+    // thieves take from the front.
+    struct WorkQueue {
+        std::mutex mutex;
+        Job* jobs[MAX_JOBS_PER_THREAD];
+        size_t head = 0;  // Oldest (steal end)
+        size_t count = 0;
+
+        bool push(Job* job);
+        Job* pop();
+        Job* steal();
+    };
+    struct JobPool {
+        Job jobs[MAX_JOBS_PER_THREAD];
+        size_t next = 0;
+        bool warnedFull = false;
+    };
+
+    Job* allocateJob();
+    Job* getJob();
+    void execute(Job* job);
+    void finish(Job* job);
+    void workerLoop(unsigned index);
+    int currentThreadIndex() const;
+
+    std::vector<std::unique_ptr<WorkQueue>> queues_; // [0] = the thread that called init()
+    std::vector<std::unique_ptr<JobPool>> pools_;
+    std::vector<std::thread> workers_;
+    std::atomic<int> queuedJobs_{0};
+    std::atomic<int> sleepingWorkers_{0};
+    std::atomic<bool> stop_{false};
+    std::mutex wakeMutex_;
+    std::condition_variable wakeCv_;
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+};
+
+
+// --- Template implementations ---
+template <typename F>
+Job* JobSystem::createChildJob(Job* parent, F&& callable) {
+    using Callable = typename std::decay<F>::type;
+    static_assert(sizeof(Callable) <= Job::PAYLOAD_BYTES, "Job callable too large; capture a pointer to the data instead");
+    static_assert(std::is_trivially_copyable<Callable>::value && std::is_trivially_destructible<Callable>::value,
+                  "Job callables are stored by bytes; capture only pointers and plain values");
+    JobFunction thunk = [](Job* self) { (*std::launder(reinterpret_cast<Callable*>(self->payload)))(); };
+    Job* job = createChildJob(parent, thunk); // Exact match: picks the non-template overload
+    new (job->payload) Callable(std::forward<F>(callable));
+    return job;
+}
+
+template <typename F>
+void JobSystem::parallelFor(size_t count, size_t grain, const F& body) {
+    if (count == 0) return;
+    if (grain == 0) grain = 1;
+    if (count <= grain || workers_.empty()) { body(size_t(0), count); return; }
+    // Children come from this thread's ring pool; keep well inside it
+    const size_t maxChunks = MAX_JOBS_PER_THREAD / 2;
+    if ((count + grain - 1) / grain > maxChunks) grain = (count + maxChunks - 1) / maxChunks;
+
+    Job* root = createJob([]() {});
+    for (size_t begin = 0; begin < count; begin += grain) {
+        const size_t end = (begin + grain < count) ? begin + grain : count;
+        const F* bodyPtr = &body;
+        run(createChildJob(root, [bodyPtr, begin, end]() { (*bodyPtr)(begin, end); }));
+    }
+    run(root);
+    wait(root);
+}
@@ -0,0 +1,43 @@
+// File: include/core/MemoryBudget.h
+#pragma once
+
+#include "core/FixedContainers.h"
+#include <cstddef>
+#include <functional> // std::less<>
+#include <map>
+#include <string>
+#include <vector>
+
+// Compile-time capacities for the engine's containers. DIGIVICE_NO_HEAP builds
+// store them inline (core/FixedContainers.h), so the worst case is known at link
+// time and nothing is allocated or freed while the game runs; other builds use
+// the standard containers and treat the numbers as unused (except the menu filter
+// length, which bounds the typed filter everywhere).
+const size_t MAX_TEXTURES = 32;          // AssetManager plain textures
+const size_t MAX_PALETTED_SHEETS = 16;   // AssetManager indexed sheets
+const size_t MAX_SOUNDS = 16;            // AssetManager sound effects
+const size_t MAX_ASSET_ID_LENGTH = 31;   // Texture ids ("agumon_sheet", "layer_castle_0", ...)
+const size_t MAX_ANIMATION_FRAMES = 8;   // Per clip; matches SimClip::MAX_FRAMES
+const size_t MAX_STATE_DEPTH = 4;        // Adventure, transition, menu, one spare
+const size_t STATE_SLOT_BYTES = 16 * 1024; // Largest GameState (AdventureState); makeState static_asserts it
+const size_t MAX_TIMERS = 1024;          // Pending TimerWheel timers (sequence waits, device care)
+const size_t MAX_SEQUENCES = 8;          // Live coroutine sequences (core/Sequence.h)
+const size_t SEQUENCE_FRAME_BYTES = 512; // Largest sequence coroutine frame
+const size_t SHEET_SCRATCH_SIZE = 256;   // Largest frame drawn from an indexed sheet (software renderer)
+const size_t MAX_SHEET_PIXELS = 256 * 1024; // Indices per paletted sheet (partner sheets are up to 375x572)
+const size_t MAX_TEXT_RUN_CHARS = 32;    // Glyphs per laid-out text run; longer text is cut
+const size_t MAX_CACHED_TEXT_RUNS = 32;  // BitmapFont::drawText's run cache (visible menu rows, HUD)
+const size_t MAX_WIDGET_CHILDREN = 8;    // Per widget; screens own the widgets themselves
+const size_t MAX_MENU_ITEMS = 256;       // Entries per MenuIndex (roster, encyclopedia)
+const size_t MAX_MENU_FILTER_LENGTH = 24; // Typed filter characters, so also the filter history depth
+const size_t MAX_MENU_RESULTS = 4 * MAX_MENU_ITEMS; // Every filter level's results together
+
+using AssetId = FixedString<MAX_ASSET_ID_LENGTH>;
+
+#if defined(DIGIVICE_NO_HEAP)
+template <typename T, size_t N> using BoundedVector = StaticVector<T, N>;
+template <typename V, size_t N> using AssetTable = FlatMap<AssetId, V, N>;
+#else
+template <typename T, size_t N> using BoundedVector = std::vector<T>;
+template <typename V, size_t N> using AssetTable = std::map<std::string, V, std::less<>>;
+#endif
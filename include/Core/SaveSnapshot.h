@@ -0,0 +1,120 @@
+// File: include/core/SaveSnapshot.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+// Binary save files for instant resume.
+//
+// A snapshot is a 16-byte header followed by chunks, each tagged with a
+// four-character id, its own version and its size:
+//   header: magic "DGSV", format version (u16), reserved (u16), payload bytes (u32), FNV-1a of the payload (u32)
+//   chunk:  id (u32), version (u16), reserved (u16), size (u32), size bytes
+// Values are stored little-endian, field by field, never as raw structs, so a
+// snapshot survives layout changes. Readers skip chunks they don't know and
+// check each chunk's version, so adding a field means bumping one chunk rather
+// than the whole format.
+//
+// Files are written whole to "<path>.tmp", flushed to disk and renamed over the
+// old snapshot: a power cut leaves either the old file or the new one. Reading
+// maps the file instead of copying it; chunks are views into the mapping.
+
+constexpr uint32_t makeChunkId(char a, char b, char c, char d) {
+    return static_cast<uint32_t>(static_cast<uint8_t>(a)) | static_cast<uint32_t>(static_cast<uint8_t>(b)) << 8 |
+           static_cast<uint32_t>(static_cast<uint8_t>(c)) << 16 | static_cast<uint32_t>(static_cast<uint8_t>(d)) << 24;
+}
+
+const uint16_t SNAPSHOT_FORMAT_VERSION = 1;
+
+// Builds a snapshot in a fixed buffer (no allocation, so no-heap builds can save too).
+class SnapshotWriter {
+public:
+    static const size_t CAPACITY = 4096;
+
+    void beginChunk(uint32_t id, uint16_t version);
+    void endChunk();
+
+    template <typename T>
+    void write(T value) {
+        static_assert(std::is_arithmetic<T>::value, "Write fields one at a time, not whole structs");
+        uint8_t bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T)); // Little-endian targets only (PC, the device's ARM core)
+        writeBytes(bytes, sizeof(T));
+    }
+    void writeString(const char* text); // u8 length + bytes, truncated to 255
+    void writeBytes(const void* data, size_t size);
+
+    // True if anything didn't fit; writeFile() refuses to save a truncated snapshot.
+    bool hasOverflowed() const { return overflowed_; }
+    size_t getSize() const { return size_; }
+
+    // Adds the header and atomically replaces 'path'.
+    bool writeFile(const std::string& path);
+
+private:
+    static const size_t HEADER_BYTES = 16;
+    static const size_t NO_CHUNK = static_cast<size_t>(-1);
+
+    uint8_t bytes_[CAPACITY];
+    size_t size_ = HEADER_BYTES;       // Header is filled in by writeFile()
+    size_t chunkStart_ = NO_CHUNK;
+    bool overflowed_ = false;
+};
+
+// A view of one chunk inside a MappedSnapshot. Reads past the end fail (and
+// keep failing), so a truncated chunk restores nothing rather than garbage.
+class SnapshotChunk {
+public:
+    uint32_t getId() const { return id_; }
+    uint16_t getVersion() const { return version_; }
+    size_t getRemaining() const { return size_ - position_; }
+    bool isValid() const { return valid_; }
+
+    template <typename T>
+    bool read(T& value) {
+        static_assert(std::is_arithmetic<T>::value, "Read fields one at a time, not whole structs");
+        return readBytes(&value, sizeof(T));
+    }
+    // Reads a writeString() value; fails if it doesn't fit 'capacity' (including the terminator).
+    bool readString(char* text, size_t capacity);
+    bool readBytes(void* data, size_t size);
+
+private:
+    friend class MappedSnapshot;
+    uint32_t id_ = 0;
+    uint16_t version_ = 0;
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+    size_t position_ = 0;
+    bool valid_ = true;
+};
+
+class MappedSnapshot {
+public:
+    MappedSnapshot() = default;
+    ~MappedSnapshot();
+    MappedSnapshot(const MappedSnapshot&) = delete;
+    MappedSnapshot& operator=(const MappedSnapshot&) = delete;
+
+    // Maps the file and checks its header and checksum; false (quietly, if the
+    // file doesn't exist) when there is nothing usable to resume from.
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return data_ != nullptr; }
+
+    // Walks the chunks in file order; start with cursor = 0.
+    bool nextChunk(size_t& cursor, SnapshotChunk& chunk) const;
+    // First chunk with this id.
+    bool findChunk(uint32_t id, SnapshotChunk& chunk) const;
+
+private:
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+#ifdef _WIN32
+    void* file_ = nullptr;             // HANDLE
+    void* mapping_ = nullptr;          // HANDLE
+#endif
+};
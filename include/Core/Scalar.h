@@ -0,0 +1,99 @@
+// File: include/core/Scalar.h
+#pragma once
+
+#include "core/Fixed.h"
+#include <cmath>
+#include <cstdint>
+
+// Numeric policy for per-frame game math (frame timing, animation stepping,
+// parallax, transitions). Builds with DIGIVICE_FIXED_POINT use 16.16 fixed point
+// for targets without an FPU; all others use float.
+//
+// Both builds produce the same frames, bit for bit, because every value that
+// survives a frame stays on a grid both types hold exactly:
+//   - frame deltas are whole ticks of 1/1024 s (FrameClock), never 1/1000 s;
+//   - scroll speeds are whole pixels per second, so offsets move in 1/1024 px;
+//   - ratios that would need a division are done on integer ticks.
+// Sums and differences of such values never round in either representation
+// (float keeps them exact below 2^14, e.g. 16384 px or 4.4 hours of ticks).
+#if defined(DIGIVICE_FIXED_POINT)
+using Scalar = Fixed<16, 16>;
+#else
+using Scalar = float;
+#endif
+
+using FixedScalar = Fixed<16, 16>;
+
+// --- Frame Time ---
+const uint32_t TICKS_PER_SECOND = 1024;
+
+// Turns the millisecond deltas SDL reports into ticks, carrying the remainder so
+// no time is lost between frames.
+class FrameClock {
+public:
+    uint32_t advance(uint32_t deltaMs) {
+        const uint64_t scaled = static_cast<uint64_t>(deltaMs) * TICKS_PER_SECOND + remainder_;
+        remainder_ = static_cast<uint32_t>(scaled % 1000);
+        return static_cast<uint32_t>(scaled / 1000);
+    }
+    void reset() { remainder_ = 0; }
+
+private:
+    uint32_t remainder_ = 0; // Thousandths of a tick
+};
+
+// Nearest whole tick; used for authored millisecond durations
+inline uint32_t msToTicks(uint32_t ms) {
+    return static_cast<uint32_t>((static_cast<uint64_t>(ms) * TICKS_PER_SECOND + 500) / 1000);
+}
+
+// --- Conversions (both policies, so tools can compare them in one binary) ---
+inline float scalarFromTicks(uint32_t ticks, float*) { return static_cast<float>(ticks) / TICKS_PER_SECOND; }
+inline FixedScalar scalarFromTicks(uint32_t ticks, FixedScalar*) {
+    return FixedScalar::fromRaw(static_cast<FixedScalar::Raw>(ticks << (FixedScalar::FRACTION_BITS - 10)));
+}
+template <typename S = Scalar> inline S scalarFromTicks(uint32_t ticks) { return scalarFromTicks(ticks, static_cast<S*>(nullptr)); }
+template <typename S = Scalar> inline S scalarFromMs(uint32_t ms) { return scalarFromTicks<S>(msToTicks(ms)); }
+
+// Whole ticks in a non-negative duration, rounded down
+inline int64_t scalarToTicks(float seconds) { return static_cast<int64_t>(std::floor(seconds * TICKS_PER_SECOND)); }
+inline int64_t scalarToTicks(FixedScalar seconds) { return seconds.raw() >> (FixedScalar::FRACTION_BITS - 10); }
+
+// Constants and load-time data; costs a soft-float conversion once on FPU-less targets
+inline float scalarFromDouble(double value, float*) { return static_cast<float>(value); }
+inline FixedScalar scalarFromDouble(double value, FixedScalar*) { return FixedScalar::fromDouble(value); }
+template <typename S = Scalar> inline S scalarFromDouble(double value) { return scalarFromDouble(value, static_cast<S*>(nullptr)); }
+
+inline int scalarFloor(float value) { return static_cast<int>(std::floor(value)); }
+inline int scalarFloor(FixedScalar value) { return value.floorToInt(); }
+inline double scalarToDouble(float value) { return value; }
+inline double scalarToDouble(FixedScalar value) { return value.toDouble(); }
+inline float scalarToFloat(float value) { return value; }
+inline float scalarToFloat(FixedScalar value) { return value.toFloat(); }
+
+// --- Operations ---
+// Wraps into [0, period). Exact in both policies: only whole periods are removed.
+inline float scalarWrap(float value, int period) {
+    float wrapped = std::fmod(value, static_cast<float>(period));
+    if (wrapped < 0.0f) wrapped += static_cast<float>(period);
+    return wrapped;
+}
+inline FixedScalar scalarWrap(FixedScalar value, int period) {
+    const int64_t periodRaw = static_cast<int64_t>(period) << FixedScalar::FRACTION_BITS;
+    int64_t wrapped = value.raw() % periodRaw;
+    if (wrapped < 0) wrapped += periodRaw;
+    return FixedScalar::fromRaw(static_cast<FixedScalar::Raw>(wrapped));
+}
+
+// start + (end - start) * elapsed / duration, truncated towards zero like the
+// static_cast<int> of a float lerp. Worked on integer ticks so the division
+// can't round differently between policies.
+template <typename S>
+inline int scalarLerpInt(int start, int end, S elapsed, S duration) {
+    const int64_t total = scalarToTicks(duration);
+    if (total <= 0) return end;
+    int64_t done = scalarToTicks(elapsed);
+    if (done < 0) done = 0;
+    if (done > total) done = total;
+    return static_cast<int>((static_cast<int64_t>(start) * total + static_cast<int64_t>(end - start) * done) / total);
+}
@@ -0,0 +1,90 @@
+// File: include/core/Sequence.h
+#pragma once
+
+#include "core/Scalar.h"
+#include "core/TimerWheel.h"
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+
+// Timed game logic written as straight-line code (C++20 coroutines):
+//
+//     Sequence TransitionState::play() {
+//         co_await waitFor(game_ptr->getTimers(), duration_);
+//         transitionComplete_ = true;
+//         ...
+//     }
+//
+// A sequence runs from its call until its first co_await, then sleeps on a
+// TimerWheel timer: nothing polls it, and it resumes inside TimerWheel::advance()
+// on the tick it is due. The returned Sequence owns the coroutine; destroying it
+// (or the state holding it) cancels any pending wait, so a sequence never
+// resumes into a state that is gone.
+//
+// Frames come from a fixed pool of MAX_SEQUENCES blocks in no-heap builds
+// (core/MemoryBudget.h) and from the heap otherwise. If a frame can't be had the
+// call logs and returns an empty Sequence that never runs.
+class Sequence {
+public:
+    struct promise_type {
+        TimerWheel* timers = nullptr;  // Where the pending wait is scheduled, if any
+        TimerHandle wait;
+
+        Sequence get_return_object() { return Sequence(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        static Sequence get_return_object_on_allocation_failure() { return Sequence(); }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; } // Kept until the owner lets go
+        void return_void() {}
+        void unhandled_exception() { throw; } // Propagates to whoever resumed (TimerWheel::advance)
+
+        static void* operator new(size_t size) noexcept;
+        static void operator delete(void* frame, size_t size) noexcept;
+    };
+    using Handle = std::coroutine_handle<promise_type>;
+
+    Sequence() = default;
+    Sequence(Sequence&& other) noexcept : handle_(other.handle_) { other.handle_ = nullptr; }
+    Sequence& operator=(Sequence&& other) noexcept;
+    Sequence(const Sequence&) = delete;
+    Sequence& operator=(const Sequence&) = delete;
+    ~Sequence() { reset(); }
+
+    // True while the sequence has work left (waiting or not yet finished)
+    bool isRunning() const { return handle_ && !handle_.done(); }
+    // Cancels its pending wait and frees the frame
+    void reset();
+
+private:
+    explicit Sequence(Handle handle) : handle_(handle) {}
+    Handle handle_ = nullptr;
+};
+
+// co_await'ed by a sequence: resumes it once 'ticks' frame ticks have passed.
+// A zero wait resumes on the next tick. If the wheel is full the wait is
+// skipped (logged by TimerWheel) rather than sleeping forever.
+class SequenceWait {
+public:
+    SequenceWait(TimerWheel& timers, uint64_t ticks) : timers_(timers), ticks_(ticks) {}
+
+    bool await_ready() const noexcept { return false; }
+    bool await_suspend(Sequence::Handle handle) {
+        Sequence::promise_type& promise = handle.promise();
+        promise.wait = timers_.schedule(ticks_, &SequenceWait::resume, handle.address());
+        promise.timers = promise.wait.isValid() ? &timers_ : nullptr;
+        return promise.wait.isValid();
+    }
+    void await_resume() const noexcept {}
+
+private:
+    static void resume(void* address);
+
+    TimerWheel& timers_;
+    uint64_t ticks_;
+};
+
+inline SequenceWait waitTicks(TimerWheel& timers, uint64_t ticks) { return SequenceWait(timers, ticks); }
+inline SequenceWait waitFor(TimerWheel& timers, Scalar duration) {
+    const int64_t ticks = scalarToTicks(duration);
+    return SequenceWait(timers, ticks > 0 ? static_cast<uint64_t>(ticks) : 0);
+}
+inline SequenceWait waitMs(TimerWheel& timers, uint32_t ms) { return SequenceWait(timers, msToTicks(ms)); }
@@ -0,0 +1,67 @@
+// File: include/core/SpscQueue.h
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+// Bounded lock-free queue for exactly one producer thread and one consumer thread
+// (sensor/decoder threads feeding the frame loop). Neither side ever blocks or
+// allocates: push() fails when full and pop() fails when empty.
+//
+// Each side keeps a private copy of the other side's index and only re-reads the
+// shared atomic when that copy says the queue is full/empty, so in steady state a
+// push or pop touches no cache line owned by the other thread.
+template <typename T, size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "SpscQueue capacity must be a power of two");
+    static_assert(std::is_trivially_copyable<T>::value, "SpscQueue items are copied between threads as plain data");
+
+public:
+    static const size_t CAPACITY = Capacity;
+
+    // --- Producer ---
+    bool push(const T& item) {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - headCache_ == Capacity) {
+            headCache_ = head_.load(std::memory_order_acquire);
+            if (tail - headCache_ == Capacity) return false;
+        }
+        items_[tail & MASK] = item;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // --- Consumer ---
+    bool pop(T& out) { return popMany(&out, 1) == 1; }
+
+    // Pops up to maxCount items in FIFO order; returns how many were written to out.
+    size_t popMany(T* out, size_t maxCount) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        size_t available = tailCache_ - head;
+        if (available < maxCount) {
+            tailCache_ = tail_.load(std::memory_order_acquire);
+            available = tailCache_ - head;
+        }
+        const size_t count = available < maxCount ? available : maxCount;
+        for (size_t i = 0; i < count; ++i) out[i] = items_[(head + i) & MASK];
+        head_.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+    // Either side; exact only while the other side is idle
+    size_t sizeApprox() const {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+
+private:
+    static const size_t MASK = Capacity - 1;
+    static const size_t CACHE_LINE = 64;
+
+    // Indices only ever increase; the slot is index & MASK
+    alignas(CACHE_LINE) std::atomic<size_t> head_{0}; // Written by the consumer
+    size_t tailCache_ = 0;                             // Consumer's last view of tail_
+    alignas(CACHE_LINE) std::atomic<size_t> tail_{0}; // Written by the producer
+    size_t headCache_ = 0;                             // Producer's last view of head_
+    alignas(CACHE_LINE) T items_[Capacity];
+};
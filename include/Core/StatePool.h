@@ -0,0 +1,60 @@
+// File: include/core/StatePool.h
+#pragma once
+
+#include "core/MemoryBudget.h"
+#include "states/GameState.h"
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+// Owning handles for game states. Create states with makeState<T>(args...):
+// normal builds heap-allocate them; DIGIVICE_NO_HEAP builds placement-construct
+// them in one of a fixed set of static slots (the stack plus a pending push).
+#if defined(DIGIVICE_NO_HEAP)
+
+namespace StatePool {
+    const size_t SLOT_COUNT = MAX_STATE_DEPTH + 1; // + Game's pending push request
+
+    // Returns a free STATE_SLOT_BYTES slot, or nullptr (and logs) when all are in use
+    void* acquire();
+    void release(void* slot);
+    size_t getStorageBytes();
+}
+
+struct StateSlotDeleter {
+    void* slot = nullptr;
+    void operator()(GameState* state) const {
+        state->~GameState();
+        StatePool::release(slot);
+    }
+};
+
+using StatePtr = std::unique_ptr<GameState, StateSlotDeleter>;
+
+template <typename T, typename... Args>
+StatePtr makeState(Args&&... args) {
+    static_assert(sizeof(T) <= STATE_SLOT_BYTES, "State does not fit a state slot; raise STATE_SLOT_BYTES");
+    static_assert(alignof(T) <= alignof(std::max_align_t), "State is over-aligned for a state slot");
+    void* slot = StatePool::acquire();
+    if (!slot) return StatePtr();
+    try {
+        return StatePtr(new (slot) T(std::forward<Args>(args)...), StateSlotDeleter{slot});
+    } catch (...) {
+        StatePool::release(slot); // Constructors may throw (e.g. AdventureState without assets)
+        throw;
+    }
+}
+
+#else
+
+using StatePtr = std::unique_ptr<GameState>;
+
+template <typename T, typename... Args>
+StatePtr makeState(Args&&... args) {
+    return std::make_unique<T>(std::forward<Args>(args)...);
+}
+
+#endif
+
+using StateStack = BoundedVector<StatePtr, MAX_STATE_DEPTH>;
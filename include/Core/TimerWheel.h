@@ -0,0 +1,88 @@
+// File: include/core/TimerWheel.h
+#pragma once
+
+#include "core/MemoryBudget.h"
+#include <cstddef>
+#include <cstdint>
+
+// Deadlines for timed game logic, in frame ticks (1/1024 s, core/Scalar.h).
+//
+// A hierarchical timing wheel: four levels of 64 slots, each slot of level n
+// covering 64^n ticks, so the wheel spans 2^24 ticks (4.5 hours); later
+// deadlines park in the top level and are re-filed when it turns. Scheduling
+// and cancelling are O(1). advance() touches only slots that hold timers
+// (occupancy bitmaps skip the empty ones), plus one cascade per 64 ticks, so a
+// frame costs the same with ten pending timers or ten thousand: a timer costs
+// nothing until its slot comes round.
+//
+// Timers due on the same tick fire in the order they were scheduled. A
+// callback may schedule or cancel timers; anything it schedules for "now" fires
+// on the next tick, never in the same advance() loop.
+
+using TimerCallback = void (*)(void* context);
+
+struct TimerHandle {
+    uint32_t index = 0;
+    uint32_t generation = 0; // 0 never names a live timer
+    bool isValid() const { return generation != 0; }
+};
+
+class TimerWheel {
+public:
+    static const uint32_t LEVEL_BITS = 6;
+    static const uint32_t SLOTS_PER_LEVEL = 1u << LEVEL_BITS;
+    static const uint32_t LEVELS = 4;
+    static const uint64_t MAX_DELAY = (1ull << (LEVEL_BITS * LEVELS)) - 1; // Longer delays are re-filed, not truncated
+
+    TimerWheel();
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    // Calls callback(context) once 'delayTicks' have passed. Returns an invalid
+    // handle (and logs) when every timer slot is taken (no-heap builds).
+    TimerHandle schedule(uint64_t delayTicks, TimerCallback callback, void* context);
+    // False if the timer already fired or was cancelled
+    bool cancel(TimerHandle handle);
+    bool isPending(TimerHandle handle) const;
+
+    // Moves time forward and fires everything that came due, in deadline order
+    void advance(uint32_t deltaTicks);
+
+    uint64_t getNow() const { return now_; }
+    size_t getPendingCount() const { return pending_; }
+
+private:
+    static const uint32_t NONE = 0xFFFFFFFFu;
+    static const uint32_t SLOT_COUNT = SLOTS_PER_LEVEL * LEVELS;
+    static const uint32_t FIRING = SLOT_COUNT;  // List of timers taken from a slot and about to fire
+    static const uint32_t FREE = SLOT_COUNT + 1;
+
+    struct TimerNode {
+        uint64_t deadline = 0;
+        TimerCallback callback = nullptr;
+        void* context = nullptr;
+        uint32_t prev = NONE;
+        uint32_t next = NONE;
+        uint32_t list = FREE;                 // Slot index, FIRING or FREE
+        uint32_t generation = 1;
+    };
+    struct TimerList {
+        uint32_t head = NONE;
+        uint32_t tail = NONE;
+    };
+
+    void file(uint32_t index);                // Into the slot for its deadline
+    void append(uint32_t list, uint32_t index);
+    void unlink(uint32_t index);
+    void cascade(uint32_t level);             // Re-files the slot the next tick has reached
+    void fireSlot(uint32_t slot);
+    uint32_t allocate();
+    void release(uint32_t index);
+
+    BoundedVector<TimerNode, MAX_TIMERS> nodes_;
+    TimerList lists_[SLOT_COUNT + 1];         // Wheel slots, then FIRING
+    uint64_t occupied_[LEVELS] = {};          // Bit s: slot s of that level is non-empty
+    uint64_t now_ = 0;                        // Last tick processed
+    uint32_t freeHead_ = NONE;
+    size_t pending_ = 0;
+};
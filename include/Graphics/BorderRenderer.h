@@ -0,0 +1,45 @@
+// File: include/graphics/BorderRenderer.h
+#pragma once
+
+#include <SDL.h>    // SDL_Texture, SDL_Rect
+#include <string>
+#include <cstddef>
+
+// Forward declarations
+class PCDisplay;
+
+enum class BorderEdge { TOP = 0, BOTTOM, LEFT, RIGHT, COUNT };
+
+// Draws the transition border frames from transition_borders.png as edge strips.
+// Each atlas frame is a full-screen image that is mostly transparent; the cooked
+// JSON (cook_transition_borders.py) records the visible "band" and the fully
+// "opaque" rect inside it. Callers still place whole frames, but only the band is
+// drawn: the opaque core without blending, the anti-aliased fringe around it with
+// blending. load() only parses; all texture state (mods, blend modes) is set by
+// drawFrames() on the render thread, since states may load on the simulation job.
+class BorderRenderer {
+public:
+    BorderRenderer() = default;
+
+    bool load(SDL_Texture* atlas, const std::string& jsonPath);
+    bool isReady() const { return atlas_ != nullptr; }
+
+    // Draws every edge as if its whole frame were stretched into frameDst[edge].
+    // Empty destination rects are skipped. Opaque cores go first in one pass, then
+    // all fringes, so the blend mode is set twice per call rather than per quad.
+    void drawFrames(PCDisplay* display, const SDL_Rect (&frameDst)[static_cast<size_t>(BorderEdge::COUNT)]);
+
+private:
+    // Frame-local rects derived from the cooked band/opaque data
+    struct EdgeStrip {
+        SDL_Rect frame = {0, 0, 0, 0};  // Frame on the atlas
+        SDL_Rect opaque = {0, 0, 0, 0}; // Frame-local, drawn with BLENDMODE_NONE
+        SDL_Rect fringe[4] = {};        // Frame-local band minus opaque, drawn blended
+        size_t fringeCount = 0;
+    };
+
+    void drawPart(PCDisplay* display, const EdgeStrip& strip, const SDL_Rect& part, const SDL_Rect& frameDst) const;
+
+    SDL_Texture* atlas_ = nullptr; // Non-owning (AssetManager owns it)
+    EdgeStrip strips_[static_cast<size_t>(BorderEdge::COUNT)];
+};
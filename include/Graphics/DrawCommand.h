@@ -0,0 +1,13 @@
+// File: include/graphics/DrawCommand.h
+#pragma once
+
+#include <SDL.h> // For SDL_Texture, SDL_Rect, SDL_RendererFlip
+
+// A single textured quad, recorded by systems and submitted to PCDisplay in one pass.
+// Plain data so lists of these can live in contiguous arrays.
+struct DrawCommand {
+    SDL_Texture* texture = nullptr;     // Non-owning
+    SDL_Rect srcRect = {0, 0, 0, 0};    // Region on the texture
+    SDL_Rect dstRect = {0, 0, 0, 0};    // Region on screen
+    SDL_RendererFlip flip = SDL_FLIP_NONE;
+};
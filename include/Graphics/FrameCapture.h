@@ -0,0 +1,107 @@
+// File: include/graphics/FrameCapture.h
+#pragma once
+
+#include "core/SpscQueue.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+class PCDisplay;
+
+enum class CaptureFormat {
+    PNG_SEQUENCE, // <output>/frame_000000.png, ...
+    RAW_VIDEO     // One file of packed BGRA frames (ffmpeg: -f rawvideo -pixel_format bgra -video_size WxH)
+};
+
+struct CaptureStats {
+    uint64_t captured = 0; // Grabbed on the render thread
+    uint64_t written = 0;  // Encoded and saved
+    uint64_t dropped = 0;  // No free buffer (the encoder fell behind)
+    uint64_t failed = 0;   // Encode or write errors
+    double avgGrabMs = 0.0;
+    double maxGrabMs = 0.0;
+};
+
+// Records rendered frames without holding up the frame loop. The render thread
+// copies the finished frame into one of a fixed pool of buffers (one
+// PCDisplay::readPixels per frame) and hands it to an encoder thread through a
+// lock-free SPSC queue; the encoder writes it and returns the buffer through a
+// second queue. When every buffer is still waiting to be encoded the frame is
+// dropped and counted, never waited for, so a recording soak session keeps the
+// timing of an unrecorded one.
+//
+// PNG frames are independent, so they are spread round-robin over several
+// encoders, each owning its own queue pair and share of the buffers. Raw video
+// must stay in order and uses one. Encoders get their own threads rather than
+// JobSystem jobs for the same reason as StepPipeline's producer: they block on
+// file I/O, which would stall workers the frame needs.
+class FrameCapture {
+public:
+    static const size_t BUFFER_COUNT = 8; // ~130 ms of slack at 60 fps
+    static const size_t MAX_ENCODERS = 4;
+    static const size_t DEFAULT_PNG_ENCODERS = 2;
+
+    FrameCapture() = default;
+    ~FrameCapture();
+    FrameCapture(const FrameCapture&) = delete;
+    FrameCapture& operator=(const FrameCapture&) = delete;
+
+    // Allocates the buffers for the display's current size and starts the encoders.
+    // outputPath is a directory for PNG_SEQUENCE (created if missing), a file for RAW_VIDEO.
+    // everyNthFrame > 1 records a subsampled session.
+    bool start(PCDisplay* display, const std::string& outputPath, CaptureFormat format, int everyNthFrame = 1);
+    // Encodes what is already queued, then stops and logs the totals.
+    void stop();
+    bool isRecording() const { return encoderCount_ > 0; }
+
+    // Render thread: after the frame is drawn and before it is presented.
+    void captureFrame(PCDisplay* display);
+
+    CaptureStats getStats() const;
+
+private:
+    static const int IDLE_WAIT_MS = 2; // Encoder poll interval while the queue is empty
+
+    struct FrameBuffer {
+        std::vector<uint8_t> pixels; // BGRA (SDL_PIXELFORMAT_ARGB8888), tightly packed
+        uint64_t frameNumber = 0;
+    };
+
+    struct Encoder {
+        SpscQueue<uint32_t, 16> freeBuffers;   // Encoder -> render thread
+        SpscQueue<uint32_t, 16> filledBuffers; // Render thread -> encoder
+        std::thread thread;
+    };
+
+    void encoderLoop(Encoder& encoder);
+    bool encodeFrame(const FrameBuffer& frame);
+
+    FrameBuffer buffers_[BUFFER_COUNT];
+    Encoder encoders_[MAX_ENCODERS];
+    size_t encoderCount_ = 0;
+    size_t nextEncoder_ = 0;               // Render thread: round-robin position
+    // A buffer taken for a grab that failed. It stays on the render thread for the
+    // next grab, so only the encoder ever pushes onto its freeBuffers.
+    Encoder* pendingEncoder_ = nullptr;
+    uint32_t pendingIndex_ = 0;
+    std::atomic<bool> stopRequested_{false};
+
+    CaptureFormat format_ = CaptureFormat::PNG_SEQUENCE;
+    std::string outputPath_;
+    std::FILE* rawFile_ = nullptr;         // RAW_VIDEO; encoder thread only
+    int width_ = 0, height_ = 0;
+    int everyNthFrame_ = 1;
+    uint64_t frameCounter_ = 0;            // Render thread
+
+    // --- Stats ---
+    std::atomic<uint64_t> captured_{0};
+    std::atomic<uint64_t> written_{0};
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<uint64_t> failed_{0};
+    std::atomic<uint64_t> grabTicksTotal_{0}; // Performance counter
+    std::atomic<uint64_t> grabTicksMax_{0};
+};
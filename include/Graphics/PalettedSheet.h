@@ -0,0 +1,98 @@
+// File: include/graphics/PalettedSheet.h
+#pragma once
+
+#include <SDL.h>    // SDL_Texture, SDL_Renderer, SDL_Surface, SDL_Color, SDL_Rect
+#include <cstdint>
+#include <vector>
+
+// Up to 256 colours addressed by an 8-bit pixel index. Alpha lives in the entries,
+// so index 0 is normally the transparent background.
+struct Palette {
+    static const int MAX_COLORS = 256;
+
+    SDL_Color colors[MAX_COLORS] = {};
+    int count = 0;
+
+    bool operator==(const Palette& other) const;
+    bool operator!=(const Palette& other) const { return !(*this == other); }
+};
+
+// --- Palette Recolours ---
+// Multiplies every colour by 'tint' (255 = unchanged), e.g. a blue night tint.
+Palette makeTintedPalette(const Palette& base, SDL_Color tint);
+// Replaces every visible colour with 'flash', keeping alpha, e.g. a damage flash.
+Palette makeFlashPalette(const Palette& base, SDL_Color flash);
+// Swaps individual entries: entry i of 'from' becomes entry i of 'to'.
+// Variant skins recolour through a handful of these.
+Palette makeRemappedPalette(const Palette& base, const SDL_Color* from, const SDL_Color* to, int count);
+
+
+// A sprite sheet kept as 8-bit indices plus a palette (1 byte per pixel instead of 4).
+// On GPU renderers the sheet owns one streaming texture and expands the indices into
+// it whenever the palette changes; recolouring rewrites that texture instead of
+// loading a second one. The software renderer would only keep a second CPU copy in
+// that texture, so there the sheet stays indexed: getTexture() returns a 1x1 handle
+// that identifies the sheet (findIndexed) and PCDisplay expands each drawn frame
+// through the palette as it goes.
+//
+// The palette applies to the whole sheet: sprites drawn from one sheet in a frame
+// share its palette, so give simultaneous variants their own sheet. setPalette()
+// only records the choice; applyPalette() takes it up on the render thread before
+// the frame is drawn (AssetManager::applyPaletteChanges), so a swap made in
+// update() - possibly on the simulation job - never races a pipelined submit or
+// lands halfway through a recorded frame.
+class PalettedSheet {
+public:
+    PalettedSheet() = default;
+    ~PalettedSheet();
+
+    // Copies the indices and palette out of an 8-bit indexed surface (SDL_PIXELFORMAT_INDEX8).
+    // A colour key marks its index as transparent. The surface is not freed.
+    bool load(SDL_Renderer* renderer, SDL_Surface* indexedSurface);
+    void release();
+
+    // The indexed sheet behind a handle texture, or null for any other texture
+    static const PalettedSheet* findIndexed(const SDL_Texture* texture);
+    // Static index slots in no-heap builds (MAX_PALETTED_SHEETS x MAX_SHEET_PIXELS); 0 otherwise
+    static size_t getIndexStorageBytes();
+
+    bool isLoaded() const { return texture_ != nullptr; }
+    bool isIndexed() const { return indexed_; } // Drawn by expanding frames, not from the texture
+    SDL_Texture* getTexture() const { return texture_; }
+    int getWidth() const { return width_; }
+    int getHeight() const { return height_; }
+    const uint8_t* getIndices() const { return indices_; } // width_ * height_, tightly packed
+
+    const Palette& getBasePalette() const { return basePalette_; }
+    const Palette& getPalette() const { return palette_; }
+    // Picks the palette for the next frame. Re-applying the current one is free.
+    void setPalette(const Palette& palette);
+    void resetPalette() { setPalette(basePalette_); }
+    // Takes up a changed palette (rewriting the texture on GPU renderers). Render thread only.
+    bool applyPalette();
+
+    // Indexed path: expands 'srcRect' through the applied palette as ARGB8888 rows
+    // 'pitch' bytes apart. Pixels outside the sheet come out transparent.
+    void expandToARGB8888(const SDL_Rect& srcRect, void* pixels, int pitch) const;
+
+private:
+    bool uploadPalette();
+    bool allocateIndices(size_t count);
+    void freeIndices();
+
+    SDL_Texture* texture_ = nullptr; // Owned; the 1x1 handle when indexed_
+    bool indexed_ = false;
+    Uint32 lookup_[Palette::MAX_COLORS] = {}; // Applied palette as ARGB8888
+    uint8_t* indices_ = nullptr;
+#if !defined(DIGIVICE_NO_HEAP)
+    std::vector<uint8_t> indexStorage_; // Backs indices_; no-heap builds use a static slot (MAX_SHEET_PIXELS)
+#endif
+    int width_ = 0;
+    int height_ = 0;
+    Palette basePalette_;
+    Palette palette_;
+    bool uploaded_ = false;
+
+    PalettedSheet(const PalettedSheet&) = delete;
+    PalettedSheet& operator=(const PalettedSheet&) = delete;
+};
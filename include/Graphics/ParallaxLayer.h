@@ -0,0 +1,78 @@
+// File: include/graphics/ParallaxLayer.h
+#pragma once
+
+#include "graphics/TiledBackground.h" // Streamed layers
+#include "core/Scalar.h"               // Frame math policy
+#include "platform/DisplayProfile.h"   // Scene lengths on small screens
+#include <SDL.h>    // SDL_Texture
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstddef>
+
+// Forward declarations
+class AssetManager;
+class PCDisplay;
+
+// One horizontally repeating scenery layer.
+// Metrics are cached when the layer is added so neither update nor render
+// has to query the texture again.
+struct ParallaxLayer {
+    std::string textureId;
+    SDL_Texture* texture = nullptr; // Non-owning (AssetManager owns it)
+    std::unique_ptr<TiledBackground> tiles; // Set instead of 'texture' for streamed strips
+    Scalar scrollSpeed = 0;         // Whole pixels per second while scrolling
+    bool foreground = false;        // Drawn in front of the characters
+
+    // --- Cached Metrics ---
+    int texW = 0;
+    int texH = 0;
+    int wrapWidth = 0;              // Repeat period: only texture columns [0, wrapWidth) are ever visible
+
+    // --- Scroll State ---
+    Scalar offset = 0;              // Texture column at the left screen edge, kept in [0, wrapWidth)
+};
+
+// Any number of ParallaxLayers, stored back to front.
+class ParallaxBackground {
+public:
+    // Speeds are rounded to whole pixels per second.
+    // Adds a layer on top of the existing ones. wrapWidth <= 0 uses the default
+    // period of 2/3 of the texture width (the castle art repeats at that point).
+    bool addLayer(const std::string& textureId, SDL_Texture* texture, float scrollSpeed, bool foreground, int wrapWidth = 0);
+    // Adds a streamed layer from a tile manifest; it repeats over its full width.
+    bool addTiledLayer(const std::string& manifestPath, SDL_Renderer* renderer, float scrollSpeed, bool foreground);
+
+    // Loads a scene description: { "layers": [ { "texture", "path", "scroll_speed", "foreground", "wrap_width" }, ... ] }
+    // Layers are listed back to front. Textures given a 'path' are loaded through the AssetManager if needed.
+    // A layer may give "tiles": "<manifest.json>" instead of a texture to stream a long strip.
+    // Speeds and wrap widths are in design pixels; like the art, they are scaled to the
+    // AssetManager's display profile.
+    bool loadFromJson(const std::string& jsonPath, AssetManager* assets);
+    void clear();
+    // Streamed layers take their per-frame scratch lists from this arena
+    void setFrameArena(FrameArena* arena);
+    // Streamed layers decode tiles as jobs here
+    void setJobSystem(JobSystem* jobs);
+
+    // Advances every layer by its own speed
+    void update(Scalar delta_time);
+
+    // Draw the layers behind / in front of the characters, clipped to the viewport
+    void renderBackground(PCDisplay* display, int viewW, int viewH) const;
+    void renderForeground(PCDisplay* display, int viewW, int viewH) const;
+
+    size_t getLayerCount() const { return layers_.size(); }
+    const ParallaxLayer& getLayer(size_t index) const { return layers_[index]; }
+    // Restores a saved scroll position (wrapped into the layer's period)
+    void setLayerOffset(size_t index, Scalar offset);
+
+private:
+    // Draws one layer so each screen column is filled exactly once
+    void renderLayer(const ParallaxLayer& layer, PCDisplay* display, int viewW, int viewH) const;
+
+    std::vector<ParallaxLayer> layers_;
+    FrameArena* frameArena_ = nullptr; // Non-owning
+    JobSystem* jobs_ = nullptr;        // Non-owning
+    const DisplayProfile* profile_ = nullptr; // Non-owning; the AssetManager's, set by loadFromJson
+};
@@ -0,0 +1,150 @@
+// File: include/graphics/ParticleSystem.h
+#pragma once
+
+#include "core/FixedContainers.h" // Active emitter list
+#include "core/Scalar.h"          // Per-frame particle math
+#include <SDL.h>                  // SDL_Texture, SDL_Renderer, SDL_Rect, SDL_Color, SDL_Vertex
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+class AssetManager;
+class PCDisplay;
+
+// Index into ParticleSystem's effect table; -1 = none
+using ParticleEffectId = int;
+
+// One emitter of an effect, as authored in assets/effects/*.json.
+// Textures are AssetManager ids, or the built-ins "@dot" (soft alpha-blended
+// disc) and "@glow" (the same disc drawn additively).
+struct ParticleEmitterDesc {
+    std::string texture = "@glow";
+    SDL_Rect sprite = {0, 0, 0, 0};      // Region of the texture; empty = all of it
+    int burst = 0;                       // Spawned when the effect starts
+    float rate = 0.0f;                   // Spawned per second while the emitter runs
+    float duration = 0.0f;               // Seconds the rate applies
+    float lifeMin = 0.5f, lifeMax = 1.0f;
+    float speedMin = 0.0f, speedMax = 100.0f; // Pixels per second
+    float angle = 0.0f;                  // Launch direction in degrees (0 = right, 90 = down)
+    float spread = 360.0f;               // Degrees around 'angle'
+    float radius = 0.0f;                 // Spawn anywhere within this many pixels of the origin
+    float gravity = 0.0f;                // Pixels per second squared, down
+    float drag = 0.0f;                   // Velocity lost per second, as a fraction
+    float sizeStart = 8.0f, sizeEnd = 0.0f; // Quad edge in pixels, over the particle's life
+    SDL_Color colorStart = {255, 255, 255, 255};
+    SDL_Color colorEnd = {255, 255, 255, 0};
+
+    // Resolved by ParticleSystem when the effect is added
+    int batch = -1;
+    int spriteIndex = 0;
+};
+
+// Normalised texture coordinates of a particle sprite
+struct ParticleUV {
+    float u0 = 0.0f, v0 = 0.0f, u1 = 1.0f, v1 = 1.0f;
+};
+
+// Structure-of-arrays particles sharing one texture (and so one draw call).
+// Like DigimonPool, particle i is the i-th element of every column; the update
+// kernels are flat loops over these columns that the compiler vectorizes, and
+// dead particles are swap-removed afterwards.
+struct ParticleBatch {
+    SDL_Texture* texture = nullptr;      // Non-owning
+    std::vector<ParticleUV> sprites;     // Used by this batch's emitters
+
+    // --- Columns ---
+    std::vector<Scalar> posX, posY;      // Quad centre in screen pixels
+    std::vector<Scalar> velX, velY;      // Pixels per second
+    std::vector<Scalar> gravity, drag;
+    std::vector<Scalar> age, invLife;    // Seconds lived, 1 / lifetime
+    std::vector<Scalar> sizeStart, sizeDelta, size;
+    std::vector<Scalar> redStart, greenStart, blueStart, alphaStart;
+    std::vector<Scalar> redDelta, greenDelta, blueDelta, alphaDelta;
+    std::vector<uint8_t> red, green, blue, alpha; // Faded colour, written by the fade kernel
+    std::vector<uint8_t> sprite;         // Index into sprites
+
+    size_t count = 0;                    // Live particles (columns are sized to capacity)
+};
+
+// Data-driven effects (attack sparks, evolution bursts). Effects are loaded from
+// JSON and started at a point; their particles update in update() and are drawn by
+// render() as one drawGeometry call per texture.
+//
+// Every column is allocated in init(), so nothing allocates after loading: when
+// the particle budget is spent new particles are simply not spawned. The per-frame
+// kernels run on Scalar (core/Scalar.h), so fixed-point builds update particles
+// without soft-float; spawning rolls angles in float, and vertices are handed to
+// SDL as float.
+class ParticleSystem {
+public:
+    static const size_t MAX_ACTIVE_EMITTERS = 32;
+
+    ParticleSystem() = default;
+    ~ParticleSystem();
+
+    // Builds the "@dot"/"@glow" textures and sizes every batch for maxParticles
+    bool init(SDL_Renderer* renderer, AssetManager* assets, size_t maxParticles);
+    void shutdown();
+    // Adds every effect in the file ({ "effects": { "name": [ emitter, ... ] } }).
+    // Speeds, radii, gravity and sizes are scaled to the AssetManager's display profile.
+    bool loadFromJson(const std::string& jsonPath);
+    ParticleEffectId addEffect(const std::string& name, const std::vector<ParticleEmitterDesc>& emitters);
+    ParticleEffectId findEffect(const std::string& name) const;
+
+    // Spawns the effect's bursts at (x, y) and runs its rate emitters from there
+    void start(ParticleEffectId effect, float x, float y);
+    void clear(); // Drops every particle and emitter
+
+    void update(Scalar delta_time);
+    void render(PCDisplay* display);
+
+    size_t getParticleCount() const;
+    size_t getCapacity() const { return capacity_; }
+    size_t getBatchCount() const { return batches_.size(); }
+    size_t getDroppedCount() const { return dropped_; } // Spawns refused for lack of room
+
+private:
+    struct Effect {
+        std::string name;
+        std::vector<ParticleEmitterDesc> emitters;
+    };
+    struct ActiveEmitter {
+        const ParticleEmitterDesc* desc = nullptr; // Into effects_; stable once loaded
+        float x = 0.0f, y = 0.0f;
+        Scalar ratePerTick = 0;          // Per second would overflow 16.16 for big fountains
+        Scalar timeLeft = 0;
+        Scalar carry = 0;                // Fractional particle owed to the next frame
+    };
+
+    int findOrAddBatch(SDL_Texture* texture);
+    void allocateBatch(ParticleBatch& batch);
+    void spawn(const ParticleEmitterDesc& desc, float x, float y, int count);
+    float randomRange(float lo, float hi);
+    void buildQuadIndices();
+
+    // --- Kernels (one pass per concern over a batch's columns) ---
+    static void updateVelocity(ParticleBatch& batch, Scalar delta_time); // Gravity and drag
+    static void updatePosition(ParticleBatch& batch, Scalar delta_time);
+    static void updateLifetime(ParticleBatch& batch, Scalar delta_time);
+    static void updateFade(ParticleBatch& batch);                       // Size and colour over life
+    static void removeDead(ParticleBatch& batch);
+    void buildVertices(const ParticleBatch& batch);
+
+    SDL_Renderer* renderer_ = nullptr;
+    AssetManager* assets_ = nullptr;
+    SDL_Texture* dotTexture_ = nullptr;  // Owned
+    SDL_Texture* glowTexture_ = nullptr; // Owned
+    size_t capacity_ = 0;                // Per batch
+    size_t dropped_ = 0;
+    uint32_t rngState_ = 0x9E3779B9u;    // xorshift32, deterministic per start order
+
+    std::vector<Effect> effects_;
+    std::vector<ParticleBatch> batches_;
+    StaticVector<ActiveEmitter, MAX_ACTIVE_EMITTERS> emitters_;
+    std::vector<SDL_Vertex> vertices_;   // Reused for each batch's draw
+    std::vector<int> quadIndices_;       // 0,1,2, 2,1,3 per quad, for capacity_ quads
+
+    ParticleSystem(const ParticleSystem&) = delete;
+    ParticleSystem& operator=(const ParticleSystem&) = delete;
+};
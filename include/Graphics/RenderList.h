@@ -0,0 +1,71 @@
+// File: include/graphics/RenderList.h
+#pragma once
+
+#include <SDL.h>   // SDL_Texture, SDL_Rect, SDL_Vertex, SDL_Color, SDL_RendererFlip
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+enum class RenderOp : uint8_t {
+    CLEAR,
+    TEXTURE,
+    GEOMETRY,
+    FILL_RECT,
+    CLIP_RECT,
+    RENDER_TARGET
+};
+
+// Texture state that SDL keeps on the texture itself. Recorded with each draw so a
+// replay sees what the texture had at record time, not whatever it was left at.
+struct TextureState {
+    SDL_BlendMode blendMode = SDL_BLENDMODE_BLEND;
+    SDL_Color mod = {255, 255, 255, 255}; // Colour mod in r/g/b, alpha mod in a
+};
+
+// One recorded PCDisplay call. Rect pointers are stored by value; hasSrc/hasDst
+// record whether the original call passed nullptr.
+struct RenderCommand {
+    RenderOp op = RenderOp::TEXTURE;
+    SDL_Texture* texture = nullptr;     // Non-owning; must outlive the replay
+    SDL_Rect src = {0, 0, 0, 0};
+    SDL_Rect dst = {0, 0, 0, 0};        // Also the fill / clip rect
+    bool hasSrc = false;
+    bool hasDst = false;
+    bool blend = true;                  // FILL_RECT only
+    SDL_RendererFlip flip = SDL_FLIP_NONE;
+    SDL_Color color = {0, 0, 0, 0};     // FILL_RECT only
+    TextureState textureState;          // TEXTURE / GEOMETRY with a texture
+    int firstVertex = 0;                // GEOMETRY: ranges into the list's vertex/index arrays
+    int vertexCount = 0;
+    int firstIndex = 0;
+    int indexCount = 0;
+};
+
+// A frame's worth of draw calls recorded by PCDisplay::beginRecording() and
+// replayed in order by PCDisplay::submit(). Geometry is copied in, so the list
+// holds no pointers into state memory besides textures. clear() keeps the
+// capacity, so a steady frame records without allocating.
+class RenderList {
+public:
+    void clear();
+    // Grows capacity up front, so even the first busy frames record without allocating
+    void reserve(size_t commands, size_t vertices, size_t indices);
+
+    void addClear();
+    void addTexture(SDL_Texture* texture, const TextureState& state, const SDL_Rect* srcRect, const SDL_Rect* dstRect, SDL_RendererFlip flip);
+    void addGeometry(SDL_Texture* texture, const TextureState& state, const SDL_Vertex* vertices, int vertexCount, const int* indices, int indexCount);
+    void addFillRect(const SDL_Rect* rect, SDL_Color color, bool blend);
+    void addClipRect(const SDL_Rect* clipRect);
+    void addRenderTarget(SDL_Texture* target);
+
+    const std::vector<RenderCommand>& getCommands() const { return commands_; }
+    const std::vector<SDL_Vertex>& getVertices() const { return vertices_; }
+    const std::vector<int>& getIndices() const { return indices_; }
+    size_t size() const { return commands_.size(); }
+    bool empty() const { return commands_.empty(); }
+
+private:
+    std::vector<RenderCommand> commands_;
+    std::vector<SDL_Vertex> vertices_;
+    std::vector<int> indices_;
+};
@@ -0,0 +1,25 @@
+// File: include/graphics/SurfaceScale.h
+#pragma once
+
+#include "platform/DisplayProfile.h" // DisplayProfile, ScaleFilter
+#include <SDL.h>                     // SDL_Surface
+#include <string>
+
+// Load-time asset variants for small screens (platform/DisplayProfile.h).
+// Nothing here touches the renderer, so decode jobs may call it on any thread.
+
+// A new surface 1/divisor the size of 'source' (at least 1x1), or null (logged).
+// NEAREST keeps the format, palette and colour key and takes each block's centre
+// pixel. BOX averages each block in ARGB8888, weighting colour by alpha so
+// transparent pixels don't darken the edges; indexed sources fall back to NEAREST,
+// since averaging palette indices means nothing. 'source' is left alone.
+SDL_Surface* downscaleSurface(SDL_Surface* source, int divisor, ScaleFilter filter);
+
+// The file 'path' should be read from for 'profile': the pre-scaled variant
+// ("a/b.png" -> "a/b@half.png") when one ships next to it, else 'path' itself.
+// 'preScaled' is set when the returned file is already at the profile's size.
+std::string resolveProfilePath(const std::string& path, const DisplayProfile& profile, ScaleFilter filter, bool& preScaled);
+
+// Loads 'path' at the profile's size: a shipped variant as-is, otherwise the
+// full-size image downscaled with 'filter'. Null (logged) on failure.
+SDL_Surface* loadScaledSurface(const std::string& path, const DisplayProfile& profile, ScaleFilter filter);
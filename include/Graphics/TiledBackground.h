@@ -0,0 +1,98 @@
+// File: include/graphics/TiledBackground.h
+#pragma once
+
+#include <SDL.h>                // SDL_Texture, SDL_Surface, SDL_Renderer
+#include "core/FrameArena.h"     // Per-frame scratch lists
+#include "platform/DisplayProfile.h" // Tile size on small screens
+#include <string>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <cstddef>
+
+// Forward declarations
+class PCDisplay;
+class JobSystem;
+
+// A background strip too wide for one texture, cut into fixed-width tiles by
+// cut_background_tiles.py. The manifest looks like:
+//   { "tile_width": 256, "height": 474, "width": 40000, "tiles": [ "route_0000.png", ... ] }
+// Tile paths are relative to the manifest. Only the tiles around the scroll
+// position are resident; tiles ahead of the scroll direction are decoded as
+// jobs on the engine's JobSystem and uploaded on the render thread, so memory stays bounded
+// by the viewport size regardless of the route length.
+class TiledBackground {
+public:
+    TiledBackground() = default;
+    ~TiledBackground();
+
+    bool load(const std::string& manifestPath, SDL_Renderer* renderer);
+    void shutdown();
+
+    // How many tiles to keep decoded ahead of the scroll direction
+    void setPrefetchTiles(size_t count) { prefetchTiles_ = count; }
+    // Scratch lists built during updateResidency come from this arena (heap if null)
+    void setFrameArena(FrameArena* arena) { frameArena_ = arena; }
+    // Prefetch decodes run as jobs here; without one they decode synchronously
+    void setJobSystem(JobSystem* jobs) { jobs_ = jobs; }
+    // Tiles are held at this profile's size (box-filtered); set before load(). Null = full size.
+    void setDisplayProfile(const DisplayProfile* profile) { profile_ = profile; }
+
+    // Call once per frame before render(). leftColumn is the strip column at the
+    // left screen edge; direction is -1/+1 for the column order we are scrolling
+    // towards, 0 when standing still.
+    void updateResidency(int leftColumn, int viewW, int direction);
+    // Draws the strip from leftColumn, wrapping at the end of the route
+    void render(PCDisplay* display, int leftColumn, int viewW, int viewH);
+
+    int getWidth() const { return width_; }
+    int getHeight() const { return height_; }
+    int getTileWidth() const { return tileWidth_; }
+    size_t getTileCount() const { return tiles_.size(); }
+    size_t getResidentCount() const { return residentCount_; }
+
+private:
+    struct Tile {
+        std::string path;
+        SDL_Texture* texture = nullptr; // Owned
+        bool pending = false;           // Queued for (or being) decoded
+        bool wanted = false;            // Inside this frame's keep window
+        Uint32 lastWantedFrame = 0;
+    };
+    struct DecodedTile {
+        size_t index;
+        SDL_Surface* surface;           // Owned until uploaded or dropped
+    };
+
+    void queueDecode(size_t index);
+    void decodeTile(size_t index);       // Job body: any thread
+    void uploadDecoded(size_t maxUploads);
+    bool loadTileNow(size_t index);     // Synchronous fallback for a visible tile
+    bool uploadSurface(size_t index, SDL_Surface* surface);
+    void evictTile(size_t index);
+    int tileWidthAt(size_t index) const;
+    const DisplayProfile& getProfile() const { return profile_ ? *profile_ : getDefaultDisplayProfile(); }
+
+    SDL_Renderer* renderer_ = nullptr;
+    std::vector<Tile> tiles_;
+    std::vector<size_t> wanted_;        // Indices flagged 'wanted' this frame
+    int tileWidth_ = 0;
+    int width_ = 0;
+    int height_ = 0;
+    size_t prefetchTiles_ = 2;
+    size_t residentCount_ = 0;
+    Uint32 frameCounter_ = 0;
+    FrameArena* frameArena_ = nullptr;  // Non-owning
+    JobSystem* jobs_ = nullptr;         // Non-owning
+    const DisplayProfile* profile_ = nullptr; // Non-owning
+
+    // --- Decode Jobs ---
+    std::unique_ptr<std::atomic<bool>[]> decodeWanted_; // Cleared when a queued tile leaves the window
+    std::atomic<int> decodesInFlight_{0};
+    std::mutex decodedMutex_;
+    std::vector<DecodedTile> decoded_;  // Guarded by decodedMutex_; reserved to the tile count at load
+
+    TiledBackground(const TiledBackground&) = delete;
+    TiledBackground& operator=(const TiledBackground&) = delete;
+};
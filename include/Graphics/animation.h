@@ -4,26 +4,49 @@
 #include <SDL.h>     // <<< CORRECTED SDL Include (for SDL_Texture, SDL_Rect, Uint32) >>>
 #include <vector>    // Standard library - OK
 #include <cstdint>   // Standard library - OK
+#include <string>    // For sheet JSON paths
+#include "core/Scalar.h" // Playback time policy
+#include "core/MemoryBudget.h" // Frame storage (inline in no-heap builds)
 
-// Represents a single frame using a texture atlas
+// Represents a single frame using a texture atlas.
+// Trimmed sheets store only each frame's visible pixels; trimOffset and sourceSize
+// remember where that rect sat inside the original (untrimmed) cell, so the sprite
+// still lands where the full cell would have.
 struct SpriteFrame {
     SDL_Texture* texturePtr = nullptr; // Non-owning pointer to the texture atlas/sheet
     SDL_Rect sourceRect = {0, 0, 0, 0}; // Defines the frame's location and size on the texture sheet
+    SDL_Point trimOffset = {0, 0};      // Top-left of sourceRect within the untrimmed cell
+    SDL_Point sourceSize = {0, 0};      // Untrimmed cell size
+    SDL_FPoint pivot = {0.5f, 0.5f};    // Anchor point, normalised to the untrimmed cell
 
     SpriteFrame(SDL_Texture* tex = nullptr, SDL_Rect src = {0,0,0,0})
-        : texturePtr(tex), sourceRect(src) {}
+        : texturePtr(tex), sourceRect(src), sourceSize{src.w, src.h} {}
+
+    // Offset from the anchor to the top-left of the drawn (trimmed) rect
+    SDL_Point anchorOffset() const {
+        return { trimOffset.x - static_cast<int>(pivot.x * sourceSize.x),
+                 trimOffset.y - static_cast<int>(pivot.y * sourceSize.y) };
+    }
+    // Screen rect for drawing this frame with its pivot at (anchorX, anchorY)
+    SDL_Rect placeAt(int anchorX, int anchorY) const {
+        const SDL_Point offset = anchorOffset();
+        return { anchorX + offset.x, anchorY + offset.y, sourceRect.w, sourceRect.h };
+    }
 };
 
 // Represents a sequence of frames for an animation
 class Animation {
 public:
-    std::vector<SpriteFrame> frames;
-    std::vector<Uint32> frame_durations_ms; // Duration for each frame in milliseconds
+    BoundedVector<SpriteFrame, MAX_ANIMATION_FRAMES> frames;
+    BoundedVector<Uint32, MAX_ANIMATION_FRAMES> frame_durations_ms; // Duration for each frame in milliseconds
     bool loops = true; // Does the animation loop?
 
-    void addFrame(const SpriteFrame& frame, Uint32 duration_ms) {
+    // False if the clip is already at capacity (no-heap builds)
+    bool addFrame(const SpriteFrame& frame, Uint32 duration_ms) {
+        if (frames.size() >= frames.max_size()) return false;
         frames.push_back(frame);
         frame_durations_ms.push_back(duration_ms);
+        return true;
     }
 
     const SpriteFrame* getFrame(size_t frameIndex) const {
@@ -36,4 +59,41 @@ public:
      size_t getFrameCount() const {
          return frames.size();
      }
-};
\ No newline at end of file
+};
+
+// --- Sprite Sheet Helpers (implemented in Animation.cpp) ---
+
+// Reads the frames of a TexturePacker-style sheet JSON (array or object 'frames'),
+// including the trim fields ('spriteSourceSize', 'sourceSize', 'pivot') when present.
+// texturePtr is left null. Returns false (and logs) if the file can't be read or
+// holds no usable frames.
+bool loadSpriteSheetFrames(const std::string& jsonPath, std::vector<SpriteFrame>& outFrames);
+
+// As above, but only the 'frame' rects.
+bool loadSpriteSheetFrameRects(const std::string& jsonPath, std::vector<SDL_Rect>& outRects);
+
+// Scales frames read from a full-size sheet JSON to a sheet downscaled by 'divisor'
+// (graphics/SurfaceScale.h). Pivots are normalised and stay as they are.
+void scaleSpriteFrames(std::vector<SpriteFrame>& frames, int divisor);
+
+// Builds an Animation by picking frames out of a sheet's frame list.
+Animation createAnimationFromIndices(
+    SDL_Texture* texture,
+    const std::vector<SpriteFrame>& allFrames,
+    const std::vector<int>& indices,
+    const std::vector<Uint32>& durations,
+    bool loops);
+
+// Same, for untrimmed sheets described by their rects alone.
+Animation createAnimationFromIndices(
+    SDL_Texture* texture,
+    const std::vector<SDL_Rect>& allFrameRects,
+    const std::vector<int>& indices,
+    const std::vector<Uint32>& durations,
+    bool loops);
+
+// Advances a playback position (frame index + seconds into that frame) by delta_time.
+// Frame durations are rounded to whole ticks (core/Scalar.h).
+// Looping animations wrap to frame 0; others hold their last frame.
+// Returns true if the last frame finished during this step.
+bool stepAnimation(const Animation& anim, size_t& frameIdx, Scalar& elapsedSec, Scalar delta_time);
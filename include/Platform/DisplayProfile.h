@@ -0,0 +1,39 @@
+// File: include/platform/DisplayProfile.h
+#pragma once
+
+#include <cstdint>
+
+// Every layout constant and full-size asset is authored for this screen
+const int DESIGN_WIDTH = 466;
+const int DESIGN_HEIGHT = 466;
+
+// How a downscaled asset variant is made (graphics/SurfaceScale.h)
+enum class ScaleFilter : uint8_t {
+    NONE,    // Always full size: atlases whose rects live in data files, art stretched to fit anyway
+    NEAREST, // One source pixel per block: pixel-art sprites and indexed sheets
+    BOX,     // Alpha-weighted block average: painted scenery and backgrounds
+};
+
+// A screen the game can run on. On smaller screens every scalable asset and
+// layout length is divided by 'divisor' once, at load time, so each draw copies
+// just the pixels the panel can show instead of scaling full-size art every
+// frame. Integer divisors keep sheet cells and tile seams on whole pixels.
+struct DisplayProfile {
+    const char* name;           // --profile=<name>
+    int width;                  // Window / panel size
+    int height;
+    int divisor;                // Design pixels per screen pixel
+    const char* variantSuffix;  // Pre-scaled files ship as <stem>@<suffix>.png; null at full size
+
+    bool isFullSize() const { return divisor <= 1; }
+    // Design lengths and positions to screen pixels (offsets keep their sign)
+    int scale(int designPixels) const { return divisor > 1 ? designPixels / divisor : designPixels; }
+    float scale(float designPixels) const { return divisor > 1 ? designPixels / divisor : designPixels; }
+    // Sizes and text scales never shrink to nothing
+    int scaleSize(int designPixels) const { const int pixels = scale(designPixels); return (designPixels > 0 && pixels < 1) ? 1 : pixels; }
+};
+
+// The shipped 466x466 round screen, at full size
+const DisplayProfile& getDefaultDisplayProfile();
+// Looks a profile up by name; null (and logs the known names) if there is none
+const DisplayProfile* findDisplayProfile(const char* name);
@@ -2,11 +2,15 @@
 
 #include "platform/idisplay.h" // <<< CORRECTED path relative to include dir
 #include <SDL.h>               // <<< CORRECTED SDL Include >>>
+#include <cstddef>             // For size_t
 
 // Forward declare SDL types used as pointers/references
 struct SDL_Window;
 struct SDL_Renderer;
 struct SDL_Texture; // For drawTexture method added in Phase 2
+struct DrawCommand; // graphics/DrawCommand.h
+class RenderList;   // graphics/RenderList.h
+class PalettedSheet; // graphics/PalettedSheet.h
 
 class PCDisplay : public IDisplay {
 public:
@@ -14,6 +18,9 @@ public:
     ~PCDisplay() override;
 
     bool init(const char* title, int width, int height) override;
+    // Window-less init: renders into an offscreen surface with SDL's software renderer.
+    // Used by benchmarks and tools that have no display attached.
+    bool initHeadless(int width, int height);
     void clear(uint16_t color) override;
     // Keep drawPixels definition for IDisplay interface
     void drawPixels(int dstX, int dstY,
@@ -26,6 +33,32 @@ public:
     // Added for AssetManager and texture rendering
     SDL_Renderer* getRenderer() const;
     void drawTexture(SDL_Texture* texture, const SDL_Rect* srcRect, const SDL_Rect* dstRect, SDL_RendererFlip flip = SDL_FLIP_NONE);
+    // Submits a whole list of recorded quads in one pass.
+    void drawCommands(const DrawCommand* commands, size_t count);
+    // Solid fill; nullptr fills the whole target. blend=false writes the colour (alpha included) as-is.
+    void fillRect(const SDL_Rect* rect, SDL_Color color, bool blend = true);
+    // Offscreen targets for cached UI. createRenderTarget returns an owned, blendable texture.
+    bool supportsRenderTargets() const;
+    SDL_Texture* createRenderTarget(int width, int height);
+    SDL_Texture* getRenderTarget() const;
+    bool setRenderTarget(SDL_Texture* target); // nullptr = back to the window
+    // Restricts drawing to clipRect (nullptr clears it).
+    void setClipRect(const SDL_Rect* clipRect);
+    // Submits indexed triangles in one call (text runs, batched quads).
+    void drawGeometry(SDL_Texture* texture, const SDL_Vertex* vertices, int vertexCount, const int* indices, int indexCount);
+    // Copies the frame drawn so far (call before present) as ARGB8888 into 'pixels'.
+    // Headless displays copy their surface directly; windowed ones read the renderer back.
+    bool readPixels(void* pixels, int pitch, int width, int height);
+
+
+    // --- Recording (pipelined frames) ---
+    // Between begin/endRecording every draw, clip, fill and target call above is
+    // appended to 'list' instead of reaching SDL. submit() replays a list on the
+    // thread that owns the renderer.
+    void beginRecording(RenderList* list);
+    void endRecording();
+    bool isRecording() const { return recording_ != nullptr; }
+    void submit(const RenderList& list);
 
 
     // Optional helpers, keep if used
@@ -41,7 +74,14 @@ public:
 private:
     SDL_Window* window_ = nullptr;
     SDL_Renderer* renderer_ = nullptr;
+    SDL_Surface* headlessSurface_ = nullptr; // Render target when running without a window
     bool initialized_ = false;
+    RenderList* recording_ = nullptr;         // Non-owning; set while recording
+    SDL_Texture* recordedTarget_ = nullptr;   // What getRenderTarget() reports while recording
+    SDL_Texture* sheetScratch_ = nullptr;     // Software renderer: indexed sheet frames expand here
+    bool warnedScratch_ = false;
+    void createSheetScratch();
+    void drawIndexed(const PalettedSheet& sheet, SDL_Texture* handle, const SDL_Rect* srcRect, const SDL_Rect* dstRect, SDL_RendererFlip flip);
     // Keep helper if drawPixels implementation needs it
     SDL_Color convert_rgb565_to_sdl_color(uint16_t color565);
 };
\ No newline at end of file
@@ -3,81 +3,90 @@
 
 #include "states/GameState.h"       // Base class
 #include "graphics/Animation.h"     // Animation definition
+#include "graphics/ParallaxLayer.h" // Scrolling scenery
+#include "graphics/ParticleSystem.h" // Attack and evolution effects
+#include "sim/DeviceSim.h"          // Step/walk/evolution rules
+#include "core/SaveSnapshot.h"      // makeChunkId
+#include "entities/Roster.h"        // DigimonId
 #include <SDL.h>                    // SDL types (SDL_Texture*, Uint32 etc.)
 #include <vector>                   // Standard library container
 #include <cmath>                    // Standard library math functions
 #include <cstdint>                  // Standard library integer types
-#include <map>                      // Standard library map container
 #include <cstddef>                  // For size_t type
 
 // Forward declaration for Game pointer
 class Game;
 
-// Enums specific to AdventureState logic
-enum PlayerState { STATE_IDLE, STATE_WALKING };
-enum DigimonType {
-    DIGI_AGUMON, DIGI_GABUMON, DIGI_BIYOMON, DIGI_GATOMON,
-    DIGI_GOMAMON, DIGI_PALMON, DIGI_TENTOMON, DIGI_PATAMON,
-    DIGI_COUNT // Helper to get the number of digimon types
-};
-
 class AdventureState : public GameState {
 public:
+    static constexpr uint32_t SNAPSHOT_ID = makeChunkId('A', 'D', 'V', 'S');
+
     // Constructor & Destructor
     AdventureState(Game* game);
     ~AdventureState() override;
 
     // Core state functions override
     void handle_input() override;
-    void update(float delta_time) override;
+    void update(Scalar delta_time) override;
     void render() override;
 
+    // Save/resume: partner and device progress, animation cursors, scroll offsets
+    uint32_t getSnapshotId() const override { return SNAPSHOT_ID; }
+    void saveSnapshot(SnapshotWriter& writer) const override;
+    bool restoreSnapshot(SnapshotChunk& chunk) override;
+
 private:
     // --- Data Members ---
 
     // Animation Storage
-    std::map<DigimonType, Animation> idleAnimations_;
-    std::map<DigimonType, Animation> walkAnimations_;
-    // Add maps for other animations (attack, etc.) here later
-
-    // Background Textures (Non-owning pointers)
-    SDL_Texture* bgTexture0_ = nullptr; // Foreground
-    SDL_Texture* bgTexture1_ = nullptr; // Middleground
-    SDL_Texture* bgTexture2_ = nullptr; // Background
-
-    // Current State Tracking
-    DigimonType current_digimon_ = DIGI_AGUMON; // Currently selected partner
-    PlayerState current_state_ = STATE_IDLE;    // Current player state (idle/walking)
-    Animation* active_anim_ = nullptr;          // Pointer to the currently playing animation object
-    size_t current_anim_frame_idx_ = 0;         // Index of the current frame within active_anim_
-    float current_frame_elapsed_time_ = 0.0f;   // Time accumulator for current frame (seconds)
-    int queued_steps_ = 0;                      // Steps waiting for walk animation cycles
+    // The current partner's clips only; empty if its sheet failed to load
+    Animation idleAnimation_;
+    Animation walkAnimation_;
+    Animation attackAnimation_;
+    DigimonId builtPartner_ = NO_DIGIMON;   // Whose sheet the clips point into
+    DigimonId pendingPartner_ = NO_DIGIMON; // Picked, switched to once its sheet is resident
+
+    // Attack playback (plays over the device's idle/walk clip, then hands back)
+    bool attacking_ = false;
+    size_t attackFrame_ = 0;
+    Scalar attackElapsed_ = 0;
 
-    // Background Scrolling
-    float bg_scroll_offset_0_ = 0.0f;
-    float bg_scroll_offset_1_ = 0.0f;
-    float bg_scroll_offset_2_ = 0.0f;
+    // Evolution flash: the partner's sheet blinks white through its palette
+    int flashPhasesLeft_ = 0; // Odd while lit
+    Scalar flashElapsed_ = 0;
+
+    // Effects layer (drawn over the scenery, under the HUD)
+    ParticleSystem particles_;
+    ParticleEffectId attackEffect_ = -1;
+    ParticleEffectId evolveEffect_ = -1;
+
+    // Scenery layers (loaded from a scene description)
+    ParallaxBackground background_;
+
+    // Device logic (render-free; shared with headless simulations)
+    SimConfig simConfig_ = defaultSimConfig();
+    std::vector<Uint32> idleDurations_;         // simConfig_'s clip timings, built once so a partner switch allocates nothing
+    std::vector<Uint32> walkDurations_;
+    DeviceState device_;                        // Partner, idle/walking, queued steps, frame
+    Animation* active_anim_ = nullptr;          // Pointer to the currently playing animation object
 
     // --- Transition Logic Members --- <<< REMOVED >>>
     // bool transitioningToMenu_ = false;      // REMOVED
     // const float MENU_TRANSITION_DURATION = 1.0f; // REMOVED (Will be passed to TransitionState constructor)
     // --- END REMOVED ---
 
-    // --- Constants --- (Consider moving to a separate constants file/namespace later)
-    const int MAX_QUEUED_STEPS = 2;
-    // Scroll speeds defined in Pixels Per Second
-    const float SCROLL_SPEED_0 = 3.0f * 60.0f; // ~180 pixels/sec
-    const float SCROLL_SPEED_1 = 1.0f * 60.0f; // ~60 pixels/sec
-    const float SCROLL_SPEED_2 = 0.5f * 60.0f; // ~30 pixels/sec
-    // Window dimensions (Temporary - get from Game/Display later)
-    // NOTE: These should ideally come from the display/game config
-    const int WINDOW_WIDTH = 466;
-    const int WINDOW_HEIGHT = 466;
-    // --- End Constants ---
-
 
     // --- Private Helper Methods ---
-    void setActiveAnimation();      // Sets active_anim_ based on state/digimon
-    void initializeAnimations();    // Loads animation definitions (called by constructor)
+    void setActiveAnimation();      // Sets active_anim_ based on device mode/partner
+    void ensurePartnerAnimations(); // Loads the partner's sheet on the spot if it isn't built yet
+    bool buildAnimations();         // The partner's clips; false (and empty) unless its sheet is resident
+    void requestPartner(DigimonId id); // Switches now if the sheet is resident, else once it is
+    void switchPartner(DigimonId id);
+    void updateWantedSheets();      // Partner, pending pick and likely next picks
+    void initializeEffects();       // Loads the particle effects (called by constructor)
+    void startAttack();
+    void startEvolveFlash();
+    void updateEvolveFlash(Scalar delta_time);
+    void showFlash(bool lit);       // Swaps the partner sheet's palette (applied before the next render)
 
 }; // End of AdventureState class definition
\ No newline at end of file
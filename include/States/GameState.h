@@ -1,17 +1,41 @@
 // File: include/states/GameState.h
 #pragma once
 #include <memory> // Standard Library - OK
+#include <cstdint>
+#include "core/Scalar.h" // Frame math policy (float or fixed point)
 
 class Game; // Forward declaration - OK (defined in core/Game.h)
+union SDL_Event; // Defined in SDL_events.h
+class SnapshotWriter; // core/SaveSnapshot.h
+class SnapshotChunk;
 
 class GameState {
 public:
     virtual ~GameState() = default;
 
     virtual void handle_input() = 0;
-    virtual void update(float delta_time) = 0;
+    // Called for each OS event before handle_input (text entry, key repeats). Optional.
+    virtual void handle_event(const SDL_Event& event) { (void)event; }
+    // In pipelined mode handle_input/update run on the simulation thread while the
+    // previous frame is submitted, so they must not call the renderer. render() and
+    // handle_event() always run on the main thread.
+    virtual void update(Scalar delta_time) = 0; // Whole ticks of 1/1024 s
     virtual void render() = 0;
 
+    // --- Save/Resume (core/SaveSnapshot.h) ---
+    // States that survive a restart return a non-zero chunk id and save one chunk
+    // under it. Others (transitions, menus) are left out of the snapshot, so a
+    // resumed game lands on the state beneath them.
+    virtual uint32_t getSnapshotId() const { return 0; }
+    virtual void saveSnapshot(SnapshotWriter& writer) const { (void)writer; }
+    // Called on a freshly constructed state; false keeps its fresh-start values.
+    virtual bool restoreSnapshot(SnapshotChunk& chunk) { (void)chunk; return false; }
+    // True if the first frame after resuming draws this asset, so it has to load
+    // before that frame; everything else loads in the frames after it.
+    virtual bool needsAssetForFirstFrame(const char* assetId) const { (void)assetId; return false; }
+    // An asset whose load was deferred past the first frame has arrived.
+    virtual void onAssetLoaded(const char* assetId) { (void)assetId; }
+
 protected:
     Game* game_ptr = nullptr; // Non-owning pointer to access Game resources
 };
\ No newline at end of file
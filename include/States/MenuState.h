@@ -1,38 +1,47 @@
 #pragma once
 
 #include "states/GameState.h"
-#include <vector>
-#include <string>
+#include "ui/Menu.h"   // MenuIndex
+#include "ui/Widget.h" // Retained layout
+#include <memory>
 #include <SDL.h> // For rendering types
 
 class Game; // Forward declare
 
 class MenuState : public GameState {
 public:
-    // Constructor takes the owning Game and the list of menu options
-    MenuState(Game* game, const std::vector<std::string>& options);
+    // Lists the entries of 'index'. Build the index when its data loads and share
+    // it, so opening a menu allocates nothing (the widgets are members).
+    MenuState(Game* game, std::shared_ptr<const MenuIndex> index);
     ~MenuState() override;
 
     void handle_input() override;
-    void update(float delta_time) override;
+    void handle_event(const SDL_Event& event) override;
+    void update(Scalar delta_time) override;
     void render() override;
 
 private:
-    // Menu drawing parameters (customize later)
-    const int MENU_START_X = 50;
-    const int MENU_START_Y = 100;
+    // Menu layout parameters in design pixels, scaled per display profile (positions come from the widget tree)
+    const int MENU_SAFE_INSET = 50;  // Keeps content inside the round screen
+    const int MENU_SPACING = 8;
     const int MENU_ITEM_HEIGHT = 30; // Spacing between items
+    const int MENU_TEXT_SCALE = 2;
+    const int MENU_TITLE_SCALE = 3;
     SDL_Texture* backgroundTexture_ = nullptr; // Already declared correctly
 
-    // Menu data
-    std::vector<std::string> menuOptions_;
-    size_t currentSelection_ = 0; // Index of the currently selected item
+    // Widget tree: root -> { header (cached): title, filter line } + list
+    Panel root_;
+    Panel header_;
+    Label title_;
+    Label filterLabel_;
+    ListWidget list_;                // Only visible rows are drawn
 
-    // Assets (need font later)
-    SDL_Texture* fontTexture_ = nullptr; // Placeholder for bitmap font
+    // Assets
     SDL_Texture* cursorTexture_ = nullptr; // Placeholder for selection cursor
     // Need to load these via AssetManager...
 
-    // Helper for drawing text (to be implemented later)
-    void drawText(const std::string& text, int x, int y);
-};
\ No newline at end of file
+    void buildWidgets();
+    void refreshFilterLabel();
+    void requestMenuExit();
+    void playSound(const char* soundId);
+};
@@ -2,8 +2,8 @@
 #pragma once
 
 #include "states/GameState.h"
+#include "core/Sequence.h"           // Timed wipe
 #include <SDL.h>
-#include <string>
 // No longer need algorithm or map/vector includes here if they aren't used publicly
 
 // Forward declarations
@@ -11,18 +11,19 @@ class Game;
 
 // Enum to define different transition types
 enum class TransitionType {
-    BOX_IN_TO_MENU // Only type implemented currently
-    // Add BOX_OUT_FROM_MENU later if needed
+    BOX_IN_TO_MENU,   // Borders close in, then input/update pass to the state below
+    BOX_OUT_FROM_MENU // Borders open back out over the state below, then the transition pops itself
 };
 
 class TransitionState : public GameState {
 public:
     // Constructor takes the state that will be below this one during/after transition
-    TransitionState(Game* game, GameState* belowState, float duration, TransitionType type);
+    TransitionState(Game* game, GameState* belowState, Scalar duration, TransitionType type);
     ~TransitionState() override;
 
     void handle_input() override;
-    void update(float delta_time) override;
+    void handle_event(const SDL_Event& event) override;
+    void update(Scalar delta_time) override;
     void render() override;
 
     // <<< ADDED: Function for the state below (MenuState) to signal exit >>>
@@ -30,20 +31,13 @@ public:
     void requestExit();
 
 private:
+    Sequence play();
+
     GameState* belowState_; // State underneath this transition (e.g., AdventureState or MenuState)
-    float duration_;        // How long the transition takes
-    float timer_;           // Current time elapsed in the transition
+    Scalar duration_;       // How long the transition takes
+    uint64_t startTick_ = 0; // Game::getTimers() time the wipe started; render derives elapsed from it
     TransitionType type_;   // Type of transition effect
-
-    // --- Single Atlas for Border Segments ---
-    SDL_Texture* borderAtlasTexture_ = nullptr; // Pointer to the loaded atlas texture
-
-    // --- Source Rectangles for each segment ON the atlas ---
-    SDL_Rect borderTopSrcRect_ = {0,0,0,0};
-    SDL_Rect borderBottomSrcRect_ = {0,0,0,0};
-    SDL_Rect borderLeftSrcRect_ = {0,0,0,0};
-    SDL_Rect borderRightSrcRect_ = {0,0,0,0};
-    // --- End Atlas Data ---
+    Sequence wipe_;         // Waits out duration_, then completes (and for box-out, pops)
 
     // --- State Variables for Managing Flow ---
     // Used by update/requestExit to make pop request *once* when exiting
@@ -51,7 +45,12 @@ private:
     // Tracks if the visual IN-transition animation has finished
     bool transitionComplete_ = false; // <<< ADDED: Tracks if wipe animation finished
 
-    // Helper function prototype
-    bool loadBorderRectsFromJson(const std::string& jsonPath);
+}; // End TransitionState class
 
-}; // End TransitionState class
\ No newline at end of file
+// Where the four border frames (BorderEdge order: top, bottom, left, right) are
+// stretched 'elapsed' into a box-in of length 'duration' closing on a
+// portholeW x portholeH hole in the window centre. Box-out passes closing = false
+// and plays the same motion backwards. Integer-exact, so float and fixed-point
+// builds place the borders identically.
+void computeBoxTransitionFrames(int windowW, int windowH, int portholeW, int portholeH,
+                                Scalar elapsed, Scalar duration, bool closing, SDL_Rect outFrames[4]);
\ No newline at end of file
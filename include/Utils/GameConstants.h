@@ -5,14 +5,12 @@
 
 namespace Constants {
 
-    // Define your standard background dimensions here
-    // Replace 240 and 160 with the actual width and height you intend to use!
+    // Define your standard background dimensions here (full-size art, design pixels)
     static constexpr int BACKGROUND_WIDTH = 1421;
     static constexpr int BACKGROUND_HEIGHT = 474;
 
     // You can add other game-wide constants here later if needed
-    // static constexpr int SCREEN_WIDTH = 240;
-    // static constexpr int SCREEN_HEIGHT = 160;
+    // Screen sizes (466x466 design, 240x160 and others) live in platform/DisplayProfile.h
 
 } // namespace Constants
 
@@ -0,0 +1,140 @@
+// File: include/audio/AudioSystem.h
+#pragma once
+
+#include "core/SpscQueue.h"
+#include <SDL.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Engine output format. Effects are converted to mono AUDIO_S16SYS at this rate
+// when AssetManager loads them, so mixing never resamples.
+const int AUDIO_SAMPLE_RATE = 48000;
+const int AUDIO_OUTPUT_CHANNELS = 2;
+
+// A short effect held in RAM (AssetManager::loadSound). The samples are owned by
+// AssetManager and stay put until it shuts down.
+struct SoundClip {
+    const int16_t* samples = nullptr; // Mono
+    uint32_t frames = 0;
+};
+
+// Identifies one playback; 0 = none. Ids are never reused within a run.
+using AudioVoiceId = uint32_t;
+
+// Game thread -> audio thread. Copied through the queue as plain data; the clip's
+// samples are referenced, not copied.
+struct AudioCommand {
+    enum Type : uint8_t { PLAY, STOP, STOP_ALL };
+    Type type = PLAY;
+    AudioVoiceId voice = 0;
+    const int16_t* samples = nullptr;
+    uint32_t frames = 0;
+    int32_t gainLeft = 0, gainRight = 0; // Q15 (32768 = unity)
+    uint64_t issuedAt = 0;               // SDL performance counter at play()
+};
+
+// Sums up to MAX_VOICES mono voices into interleaved 16-bit stereo. Voices are
+// accumulated into planar 32-bit left/right columns, one straight loop per voice
+// that compilers vectorise, and a final pass clamps to int16 while interleaving.
+// Audio thread only; never locks or allocates.
+class AudioMixer {
+public:
+    static const size_t MAX_VOICES = 16;
+    static const size_t MAX_BLOCK_FRAMES = 1024; // mix() splits longer requests
+
+    void apply(const AudioCommand& command);
+    void mix(int16_t* out, size_t frames);
+
+    size_t getVoiceCount() const { return voiceCount_; }
+    uint64_t getStolenVoices() const { return stolenVoices_; } // Plays that evicted the oldest voice
+
+private:
+    struct Voice {
+        AudioVoiceId id = 0;
+        const int16_t* samples = nullptr;
+        uint32_t frames = 0, position = 0;
+        int32_t gainLeft = 0, gainRight = 0;
+    };
+
+    void mixBlock(int16_t* out, size_t frames);
+    static void accumulate(int32_t* left, int32_t* right, const int16_t* src, size_t frames, int32_t gainLeft, int32_t gainRight);
+    static void saturate(const int32_t* left, const int32_t* right, int16_t* out, size_t frames);
+
+    Voice voices_[MAX_VOICES];
+    size_t voiceCount_ = 0;
+    uint64_t stolenVoices_ = 0;
+    int32_t left_[MAX_BLOCK_FRAMES];
+    int32_t right_[MAX_BLOCK_FRAMES];
+};
+
+// Counters for tuning the device buffer; readable from any thread.
+struct AudioStats {
+    double bufferMs = 0.0;        // One device buffer; output latency is roughly this plus the command latency
+    double avgLatencyMs = 0.0;    // play() -> first mixed sample
+    double maxLatencyMs = 0.0;
+    double maxMixMs = 0.0;        // Slowest callback
+    uint64_t callbacks = 0;
+    uint64_t underruns = 0;       // Callbacks that came more than half a buffer late
+    uint64_t droppedCommands = 0; // Queue full
+    uint64_t stolenVoices = 0;
+};
+
+// Sound effects on SDL's audio thread. The game side queues play/stop commands
+// through a lock-free SPSC queue; the device callback drains it, mixes and
+// writes the buffer, so it never waits on the game and the game never waits on
+// it. A small buffer keeps beeps within a few milliseconds of the step or menu
+// move that caused them.
+//
+// Producer side: one thread at a time (the simulation, like StepPipeline::poll).
+class AudioSystem {
+public:
+    static const size_t QUEUE_CAPACITY = 64;
+    static const int DEFAULT_BUFFER_FRAMES = 256; // 5.3 ms at 48 kHz
+
+    AudioSystem() = default;
+    ~AudioSystem();
+    AudioSystem(const AudioSystem&) = delete;
+    AudioSystem& operator=(const AudioSystem&) = delete;
+
+    // Opens the default output device (SDL_AUDIODRIVER picks the driver).
+    bool init(int bufferFrames = DEFAULT_BUFFER_FRAMES);
+    void shutdown(); // Before the clips' owner (AssetManager) shuts down
+    bool isOpen() const { return device_ != 0; }
+
+    // volume 0..1, pan -1 (left) .. 1 (right). Returns 0 if the clip is missing,
+    // the device is closed or the queue is full.
+    AudioVoiceId play(const SoundClip* clip, float volume = 1.0f, float pan = 0.0f);
+    void stop(AudioVoiceId voice);
+    void stopAll();
+
+    AudioStats getStats() const;
+
+private:
+    static const size_t COMMAND_BATCH = 16;
+
+    static void SDLCALL audioCallback(void* userdata, Uint8* stream, int len);
+    void renderAudio(int16_t* out, size_t frames);
+    bool pushCommand(const AudioCommand& command);
+
+    SDL_AudioDeviceID device_ = 0;
+    bool subsystemStarted_ = false;
+    int bufferFrames_ = 0;
+    AudioVoiceId nextVoice_ = 1;
+    SpscQueue<AudioCommand, QUEUE_CAPACITY> queue_;
+
+    // --- Audio thread ---
+    AudioMixer mixer_;
+    AudioCommand commandBatch_[COMMAND_BATCH];
+    uint64_t lastCallbackAt_ = 0;
+
+    // --- Stats (written by the audio thread unless noted) ---
+    std::atomic<uint64_t> callbacks_{0};
+    std::atomic<uint64_t> underruns_{0};
+    std::atomic<uint64_t> droppedCommands_{0}; // Producer
+    std::atomic<uint64_t> stolenVoices_{0};
+    std::atomic<uint64_t> latencyTotal_{0};    // Performance counter ticks
+    std::atomic<uint64_t> latencyCount_{0};
+    std::atomic<uint64_t> latencyMax_{0};
+    std::atomic<uint64_t> mixMax_{0};
+};
@@ -0,0 +1,73 @@
+// File: include/entities/Digimon.h
+#pragma once
+
+#include "graphics/Animation.h"   // Clips are flattened from Animation objects
+#include "graphics/DrawCommand.h" // Output of the render pass
+#include <SDL.h>                  // SDL_Texture, SDL_Rect
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Index into DigimonPool's clip table
+using AnimClipId = uint16_t;
+
+// An animation flattened into a contiguous range of the pool's frame table
+struct AnimClip {
+    uint32_t firstFrame = 0;
+    uint32_t frameCount = 0;
+    bool loops = true;
+};
+
+// Structure-of-arrays storage for many wandering, animated Digimon.
+// Each per-entity field lives in its own contiguous column so the systems below
+// are simple indexed loops the compiler can vectorize. Entity i is the i-th element
+// of every column; despawning swaps the last entity into the hole.
+class DigimonPool {
+public:
+    DigimonPool() = default;
+
+    // --- Setup ---
+    AnimClipId addClip(const Animation& anim); // Copies frames into the frame table
+    size_t spawn(float x, float y, float vx, float vy, AnimClipId clip);
+    void despawn(size_t index);
+    void clear();
+    void reserve(size_t count);
+    size_t size() const { return posX.size(); }
+
+    // Play area used by the movement system (entities bounce off its edges)
+    void setBounds(const SDL_Rect& bounds) { bounds_ = bounds; }
+    // How often (seconds) an entity picks a new random heading, and how fast it walks
+    void setWanderParams(float minInterval, float maxInterval, float maxSpeed);
+
+    // --- Systems (call once per frame, in this order) ---
+    void updateWander(float delta_time);    // Re-rolls headings whose timer ran out
+    void updateMovement(float delta_time);  // Integrates position, bounces off bounds
+    void updateAnimation(float delta_time); // Advances frame cursors
+    // Appends one DrawCommand per entity, in pool order.
+    void emitDrawCommands(std::vector<DrawCommand>& out) const;
+
+    // --- Columns ---
+    std::vector<float> posX, posY;          // Sprite centre in screen pixels
+    std::vector<float> velX, velY;          // Pixels per second
+    std::vector<float> wanderTimer;         // Seconds until the next heading change
+    std::vector<AnimClipId> clip;           // Which clip is playing
+    std::vector<uint32_t> frame;            // Frame within the clip
+    std::vector<float> frameTime;           // Seconds spent on the current frame
+    std::vector<SDL_Texture*> sheet;        // Sheet handle (non-owning), cached from the clip
+
+private:
+    // Clip/frame tables shared by all entities
+    std::vector<AnimClip> clips_;
+    std::vector<SDL_Rect> frameRects_;
+    std::vector<SDL_Point> frameOffsets_;   // Sprite centre -> top-left of the (trimmed) rect
+    std::vector<float> frameDurations_;     // Seconds
+    std::vector<SDL_Texture*> clipSheets_;  // One sheet per clip
+
+    SDL_Rect bounds_ = {0, 0, 466, 466};
+    float wanderMin_ = 1.0f;
+    float wanderMax_ = 4.0f;
+    float maxSpeed_ = 40.0f;
+    uint32_t rngState_ = 0x2545F491u;       // xorshift32 state for wander rolls
+
+    float randomRange(float lo, float hi);
+};
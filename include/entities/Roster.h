@@ -0,0 +1,48 @@
+// File: include/entities/Roster.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Index into the Roster; stable for one run of the game, not across manifest edits
+using DigimonId = uint16_t;
+const DigimonId NO_DIGIMON = 0xFFFF;
+
+// One Digimon the player can partner with
+struct RosterEntry {
+    std::string key;                    // Stable name ("agumon"); saves refer to partners by it
+    std::string name;                   // Shown to the player
+    std::string textureId;              // AssetManager id of its sheet while resident
+    std::string sheetPath;              // 8-bit indexed PNG
+    std::string framesPath;             // TexturePacker-style frame JSON
+    std::vector<DigimonId> evolvesTo;   // Likely next partners after this one
+};
+
+// Every Digimon the game knows about, read from a manifest like:
+//   { "digimon": [
+//       { "id": "agumon", "name": "Agumon", "texture": "agumon_sheet",
+//         "path": "assets/sprites/agumon_sheet.png", "frames": "assets/sprites/agumon_sheet.json",
+//         "evolves_to": [ "greymon" ] }, ... ] }
+// Entries are stored in manifest order in one flat array, so a DigimonId is
+// just an index. Only the manifest is loaded here; sheets are made resident on
+// demand by RosterSheets (entities/RosterSheets.h).
+class Roster {
+public:
+    // Replaces the current roster; false (and logs) if no usable entry was found
+    bool loadFromJson(const std::string& jsonPath);
+
+    size_t size() const { return entries_.size(); }
+    bool isValid(DigimonId id) const { return id < entries_.size(); }
+    const RosterEntry& get(DigimonId id) const { return entries_[id]; }
+    // NO_DIGIMON if the key isn't in this roster
+    DigimonId find(const char* key) const;
+
+    // Neighbours in manifest order (the order number keys and paging walk), wrapping
+    DigimonId next(DigimonId id) const;
+    DigimonId previous(DigimonId id) const;
+
+private:
+    std::vector<RosterEntry> entries_;
+};
@@ -0,0 +1,89 @@
+// File: include/entities/RosterSheets.h
+#pragma once
+
+#include "entities/Roster.h"
+#include "graphics/Animation.h" // SpriteFrame
+#include <SDL.h>                // SDL_Texture, SDL_Surface
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+class AssetManager;
+class JobSystem;
+
+// Keeps the sheets of a few roster Digimon resident: the one on screen plus the
+// ones the player is likely to pick next. Everything else stays on disk, so the
+// roster can list hundreds without their sheets costing any memory.
+//
+// Missing sheets are decoded (PNG and frame JSON, downscaled for the
+// AssetManager's display profile) as jobs on the engine's JobSystem and uploaded
+// by updateResidency() on the main thread, a few per frame, the way
+// TiledBackground streams tiles. A sheet that is wanted before its
+// job finishes can be loaded on the spot with loadNow(); that blocks, so it is
+// meant for the first frame only.
+class RosterSheets {
+public:
+    static const size_t MAX_WANTED = 8; // Partner, pending pick, neighbours, evolution targets
+
+    RosterSheets() = default;
+    ~RosterSheets();
+
+    // Without a job system sheets decode synchronously inside updateResidency()
+    void init(const Roster* roster, AssetManager* assets, JobSystem* jobs);
+    // Waits for queued decodes and unloads every resident sheet
+    void shutdown();
+
+    // The sheets that should be resident, most important first; replaces the
+    // previous set (extras beyond MAX_WANTED are ignored). Frame thread; takes
+    // effect at the next updateResidency().
+    void setWanted(const DigimonId* ids, size_t count);
+    // Main thread, once per frame while no state update runs: queues decodes for
+    // wanted sheets, uploads at most 'maxUploads' finished ones and unloads the
+    // sheets no longer wanted. Returns true if a sheet was uploaded or unloaded.
+    bool updateResidency(size_t maxUploads);
+    // Main thread: makes 'id' resident now, decoding it here if need be
+    bool loadNow(DigimonId id);
+
+    bool isResident(DigimonId id) const;
+    bool hasFailed(DigimonId id) const;          // Its files are missing or broken; not retried
+    SDL_Texture* getTexture(DigimonId id) const; // Null unless resident
+    // Parsed frames of a resident sheet (texturePtr is left null, like loadSpriteSheetFrames)
+    const std::vector<SpriteFrame>& getFrames(DigimonId id) const;
+    size_t getResidentCount() const { return resident_.size(); }
+
+private:
+    enum class SheetStatus : uint8_t { UNLOADED, LOADING, RESIDENT, FAILED };
+    struct Sheet {
+        SheetStatus status = SheetStatus::UNLOADED;
+        bool wanted = false;
+        SDL_Texture* texture = nullptr;  // Owned by the AssetManager
+        std::vector<SpriteFrame> frames;
+    };
+    struct DecodedSheet {
+        DigimonId id;
+        SDL_Surface* surface;            // Owned until uploaded or dropped; null if decoding failed
+        std::vector<SpriteFrame> frames;
+    };
+
+    void queueDecode(DigimonId id);
+    DecodedSheet decodeSheet(DigimonId id) const; // Job body: any thread; roster entries are immutable
+    bool upload(DecodedSheet& decoded);
+    void unload(DigimonId id);
+
+    const Roster* roster_ = nullptr;    // Non-owning
+    AssetManager* assets_ = nullptr;    // Non-owning
+    JobSystem* jobs_ = nullptr;         // Non-owning
+    std::vector<Sheet> sheets_;         // Indexed by DigimonId
+    DigimonId wanted_[MAX_WANTED] = {};
+    size_t wantedCount_ = 0;
+    std::vector<DigimonId> resident_;   // Scanned for evictions instead of the whole roster
+
+    // --- Decode Jobs ---
+    std::atomic<int> decodesInFlight_{0};
+    std::mutex decodedMutex_;
+    std::vector<DecodedSheet> decoded_; // Guarded by decodedMutex_
+
+    RosterSheets(const RosterSheets&) = delete;
+    RosterSheets& operator=(const RosterSheets&) = delete;
+};
@@ -0,0 +1,68 @@
+// File: include/input/StepDetector.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// One accelerometer reading. Axes are in m/s^2 and include gravity, as SDL's
+// SDL_SENSOR_ACCEL reports them; the device may be held in any orientation.
+struct AccelSample {
+    uint32_t timeMs = 0; // Capture time; only differences matter (wraps after ~49 days)
+    float x = 0.0f;
+    float y = 0.0f;
+    float z = 0.0f;
+};
+
+struct StepDetectorConfig {
+    float minPeak = 1.5f;          // m/s^2 above the gravity baseline a stride must reach
+    float peakRatio = 0.5f;        // Adaptive threshold: this fraction of recent stride peaks
+    float baselineAlpha = 0.02f;   // Gravity tracking per sample (~0.5 s time constant at 100 Hz)
+    uint32_t minStepMs = 250;      // Faster than 4 steps/s is one stride ringing twice
+    uint32_t maxStepMs = 2000;     // Longer pauses end the walk and reset the adaptive threshold
+};
+
+// Counts steps in an accelerometer stream. Works on the acceleration magnitude, so
+// orientation doesn't matter: each stride shows up as one peak above gravity.
+//
+// Samples are processed in batches. The per-sample math (magnitude, smoothing) runs
+// as straight loops over the batch that compilers vectorise; only the gravity
+// tracker and the peak state machine walk the batch serially, and those are a
+// handful of compares per sample. State carries across batches, so splitting a
+// stream differently never changes the steps found.
+class StepDetector {
+public:
+    explicit StepDetector(const StepDetectorConfig& config = StepDetectorConfig());
+
+    void setConfig(const StepDetectorConfig& config) { config_ = config; }
+    const StepDetectorConfig& getConfig() const { return config_; }
+    void reset();
+
+    // Feeds samples in time order. Returns the number of steps detected; when
+    // stepTimesMs is given, the first maxStepTimes step times are written to it.
+    int process(const AccelSample* samples, size_t count, uint32_t* stepTimesMs = nullptr, size_t maxStepTimes = 0);
+
+    uint64_t getSamplesProcessed() const { return samplesProcessed_; }
+
+private:
+    static const size_t BLOCK = 128;     // Samples per vectorised block
+    static const int SMOOTH_TAPS = 4;    // Box filter length (40 ms at 100 Hz)
+
+    int processBlock(const AccelSample* samples, size_t count, uint32_t* stepTimesMs, size_t maxStepTimes, size_t& stepTimesWritten);
+
+    StepDetectorConfig config_;
+
+    // Block scratch; the magnitude buffer keeps the previous block's tail in front
+    float magnitude_[SMOOTH_TAPS - 1 + BLOCK];
+    float smoothed_[BLOCK];
+
+    // --- Streaming State ---
+    bool primed_ = false;        // Baseline and filter history seeded from the first sample
+    float baseline_ = 0.0f;      // Tracked gravity magnitude
+    bool abovePeak_ = false;     // Inside a stride peak
+    float peakValue_ = 0.0f;
+    uint32_t peakTimeMs_ = 0;
+    bool walking_ = false;       // A step was counted within maxStepMs
+    uint32_t lastStepMs_ = 0;
+    float peakAverage_ = 0.0f;   // Running mean of counted stride peaks
+    uint64_t samplesProcessed_ = 0;
+};
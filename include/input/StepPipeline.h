@@ -0,0 +1,128 @@
+// File: include/input/StepPipeline.h
+#pragma once
+
+#include "core/SpscQueue.h"
+#include "input/StepDetector.h"
+#include <SDL.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Where accelerometer samples come from. A source is opened, read and closed on
+// the pipeline's producer thread only.
+class AccelSource {
+public:
+    virtual ~AccelSource() = default;
+    virtual bool open() = 0;
+    // Blocks until the next sample is due. Returns false at the end of the stream
+    // or on an unrecoverable error.
+    virtual bool read(AccelSample& out) = 0;
+    virtual void close() {}
+    virtual const char* getName() const = 0;
+    // Live sources drop samples when the consumer falls behind; recorded ones wait.
+    virtual bool isLive() const = 0;
+
+protected:
+    // Sleeps until 'when'; returns false early if the owning pipeline is stopping,
+    // so gaps in a trace never hold up StepPipeline::stop().
+    bool sleepUntil(std::chrono::steady_clock::time_point when);
+
+private:
+    friend class StepPipeline;
+    static const int STOP_CHECK_MS = 50;
+    const std::atomic<bool>* stopRequested_ = nullptr;
+};
+
+// Replays a recorded trace. Two formats are accepted (chosen by content):
+//   CSV    - one "time_ms,x,y,z" line per sample; a non-numeric header line is skipped
+//   Binary - "DACC" magic, uint32 version (1), uint32 sample count, then packed
+//            little-endian { uint32 time_ms; float x, y, z; } records
+// In real time the source sleeps until each sample's recorded offset; otherwise it
+// returns samples as fast as they are read (offline runs).
+class TraceAccelSource : public AccelSource {
+public:
+    explicit TraceAccelSource(const std::string& path, bool realTime = true);
+    bool open() override;
+    bool read(AccelSample& out) override;
+    const char* getName() const override { return "trace"; }
+    bool isLive() const override { return false; }
+
+    // Loads a whole trace; used by open() and by offline tools.
+    static bool loadTrace(const std::string& path, std::vector<AccelSample>& samples);
+
+private:
+    std::string path_;
+    bool realTime_;
+    std::vector<AccelSample> samples_;
+    size_t next_ = 0;
+    std::chrono::steady_clock::time_point startTime_;
+};
+
+// Polls the platform accelerometer through SDL's sensor API at a fixed rate.
+// The sensor subsystem is initialised and updated on the producer thread (SDL
+// requires SDL_SensorUpdate on the initialising thread), and sensor events are
+// disabled so the main event loop doesn't update it concurrently.
+class SensorAccelSource : public AccelSource {
+public:
+    explicit SensorAccelSource(int rateHz = 100);
+    bool open() override;
+    bool read(AccelSample& out) override;
+    void close() override;
+    const char* getName() const override { return "sensor"; }
+    bool isLive() const override { return true; }
+
+private:
+    int rateHz_;
+    SDL_Sensor* sensor_ = nullptr;
+    bool subsystemStarted_ = false;
+    std::chrono::steady_clock::time_point nextPoll_;
+};
+
+// Accelerometer -> step counts. A producer thread reads the source and pushes raw
+// samples into a lock-free SPSC queue; the frame loop calls poll(), which drains
+// whatever arrived since the last frame through the StepDetector in one batch.
+// The producer mostly sleeps (samples arrive at 100 Hz), and the consumer side
+// costs a few hundred nanoseconds per frame.
+//
+// The producer gets its own thread rather than a job: it blocks on the sensor and
+// the clock, which would starve a JobSystem worker.
+class StepPipeline {
+public:
+    static const size_t QUEUE_CAPACITY = 1024; // ~10 s of samples at 100 Hz
+
+    StepPipeline() = default;
+    ~StepPipeline();
+    StepPipeline(const StepPipeline&) = delete;
+    StepPipeline& operator=(const StepPipeline&) = delete;
+
+    // Takes ownership of the source and starts the producer thread.
+    bool start(std::unique_ptr<AccelSource> source);
+    void stop();
+    bool isRunning() const { return thread_.joinable(); }
+    bool isSourceFinished() const { return sourceFinished_.load(std::memory_order_acquire); }
+
+    // Consumer side: one thread at a time (the frame loop, or the pipelined update
+    // job, which is always waited on before the next one starts).
+    // Returns the steps detected since the previous call.
+    int poll();
+
+    StepDetector& getDetector() { return detector_; }
+    uint64_t getDroppedSamples() const { return droppedSamples_.load(std::memory_order_relaxed); }
+
+private:
+    static const size_t POLL_BATCH = 256;
+
+    void producerLoop();
+
+    SpscQueue<AccelSample, QUEUE_CAPACITY> queue_;
+    std::unique_ptr<AccelSource> source_;
+    std::thread thread_;
+    std::atomic<bool> stopRequested_{false};
+    std::atomic<bool> sourceFinished_{false};
+    std::atomic<uint64_t> droppedSamples_{0}; // Live queue full: the frame loop stalled for seconds
+    StepDetector detector_;
+    AccelSample batch_[POLL_BATCH];
+};
@@ -0,0 +1,52 @@
+// File: include/net/NetEmulator.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+class UdpSocket;
+
+struct NetConditions {
+    uint32_t latencyMs = 0;  // One way
+    uint32_t jitterMs = 0;   // Extra 0..jitterMs per datagram; reorders packets like a real link
+    float lossPercent = 0.0f;
+};
+
+// Sits between a sender and its socket and makes loopback behave like a poor
+// link: each datagram is dropped or held back for the configured delay, then
+// sent once pump() sees it is due. The random draws come from a seeded
+// generator, so a run with the same seed loses the same packets.
+class NetEmulator {
+public:
+    static const size_t MAX_IN_FLIGHT = 256;  // Datagrams held at once; more are counted as lost
+    static const size_t MAX_DATAGRAM_BYTES = 256;
+
+    void configure(const NetConditions& conditions, uint64_t seed);
+
+    // Takes an outgoing datagram at time nowMs (any monotonic millisecond clock).
+    void send(const uint8_t* data, size_t size, uint64_t nowMs);
+    // Sends every held datagram that is due by nowMs.
+    void pump(UdpSocket& socket, uint64_t nowMs);
+
+    uint64_t getSent() const { return sent_; }
+    uint64_t getDropped() const { return dropped_; }
+
+private:
+    struct Datagram {
+        uint64_t dueMs = 0;
+        uint64_t sequence = 0;  // Send order; breaks ties between equal due times
+        uint16_t size = 0;
+        bool used = false;
+        uint8_t bytes[MAX_DATAGRAM_BYTES];
+    };
+
+    uint32_t nextRandom(); // Below 2^32
+
+    NetConditions conditions_;
+    uint64_t rng_ = 1;
+    Datagram inFlight_[MAX_IN_FLIGHT];
+    size_t inFlightCount_ = 0;
+    uint64_t nextSequence_ = 0;
+    uint64_t sent_ = 0;
+    uint64_t dropped_ = 0;
+};
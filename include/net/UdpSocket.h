@@ -0,0 +1,30 @@
+// File: include/net/UdpSocket.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Non-blocking UDP between two devices on the same machine (127.0.0.1). Link
+// play only ever talks to one peer, so the peer's port is fixed at open() and
+// datagrams from anyone else are ignored.
+class UdpSocket {
+public:
+    UdpSocket() = default;
+    ~UdpSocket();
+    UdpSocket(const UdpSocket&) = delete;
+    UdpSocket& operator=(const UdpSocket&) = delete;
+
+    bool open(uint16_t localPort, uint16_t peerPort);
+    void close();
+    bool isOpen() const { return open_; }
+
+    // Fire and forget; returns false if the OS refused the datagram.
+    bool send(const uint8_t* data, size_t size);
+    // Returns the datagram's size, 0 when nothing is waiting, -1 on error.
+    int receive(uint8_t* buffer, size_t capacity);
+
+private:
+    uintptr_t handle_ = 0; // SOCKET on Windows, a file descriptor elsewhere
+    bool open_ = false;
+    uint16_t peerPort_ = 0;
+};
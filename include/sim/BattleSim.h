@@ -0,0 +1,73 @@
+// File: include/sim/BattleSim.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Two-device link battle rules. Like DeviceSim everything lives in plain structs,
+// but battles advance in whole frames with integer math only, so two devices fed
+// the same inputs reach bit-identical states. That is what link play relies on:
+// only inputs cross the wire, and a snapshot is a plain copy of BattleState.
+
+// One frame of a player's buttons (BattleInputBits)
+using BattleInput = uint8_t;
+
+enum BattleInputBits : uint8_t {
+    BATTLE_INPUT_NONE = 0,
+    BATTLE_INPUT_ATTACK = 1u << 0,  // Quick hit; builds charge
+    BATTLE_INPUT_GUARD = 1u << 1,   // Held: blocks most of a hit
+    BATTLE_INPUT_SPECIAL = 1u << 2, // Spends a full charge on a heavy hit
+};
+
+struct BattleFighter {
+    int16_t hp = 0;
+    uint8_t charge = 0;             // 0..BattleConfig::maxCharge
+    uint8_t cooldown = 0;           // Frames until the next attack may start
+    uint8_t stun = 0;               // Frames of hit reaction; no input while > 0
+    uint8_t guarding = 0;           // 1 while GUARD is held (and not stunned)
+    uint8_t partner = 0;            // Roster id in the game (the first 256 can battle)
+    uint8_t wins = 0;
+};
+
+// No implicit padding: snapshots are compared and delta-encoded byte for byte
+struct BattleState {
+    uint32_t frame = 0;
+    uint32_t rng = 0;               // xorshift32; only the sim draws from it
+    BattleFighter fighters[2];
+    uint16_t round = 0;
+    uint8_t roundOverFrames = 0;    // > 0 between a KO and the next round
+    uint8_t lastWinner = 0xFF;      // Fighter index, 0xFF before the first KO
+};
+static_assert(sizeof(BattleState) == 28, "BattleState must stay free of padding");
+
+struct BattleConfig {
+    int16_t maxHp = 200;
+    uint8_t maxCharge = 5;
+    uint8_t attackCooldown = 18;    // Frames
+    uint8_t attackDamage = 9;       // Before the random +0..3
+    uint8_t specialDamage = 40;
+    uint8_t hitStun = 8;
+    uint8_t guardDivisor = 4;       // Guarded hits deal damage / guardDivisor
+    uint8_t roundOverFrames = 90;   // Pause after a KO
+};
+
+// stepBattle() result bits
+enum BattleEvent : uint32_t {
+    BATTLE_EVENT_NONE = 0,
+    BATTLE_EVENT_HIT = 1u << 0,
+    BATTLE_EVENT_GUARDED = 1u << 1,
+    BATTLE_EVENT_SPECIAL = 1u << 2,
+    BATTLE_EVENT_KO = 1u << 3,
+    BATTLE_EVENT_ROUND_START = 1u << 4,
+};
+
+// Fresh battle between two partners; seed makes the damage rolls differ per match
+BattleState startBattle(const BattleConfig& config, uint8_t partnerA, uint8_t partnerB, uint32_t seed);
+// Advances one frame; returns BattleEvent bits
+uint32_t stepBattle(const BattleConfig& config, BattleState& state, const BattleInput inputs[2]);
+// FNV-1a over the state's bytes; equal on both devices while they agree
+uint32_t hashBattleState(const BattleState& state);
+
+// A reproducible stand-in for a player's thumbs (tools, benchmarks): bursts of
+// attacks, guard holds and the occasional special, decided by (seed, player, frame).
+BattleInput scriptedBattleInput(uint32_t seed, int player, uint32_t frame);
@@ -0,0 +1,111 @@
+// File: include/sim/DeviceSim.h
+#pragma once
+
+#include "core/Scalar.h" // TICKS_PER_SECOND
+#include <cstddef>
+#include <cstdint>
+
+class JobSystem; // core/JobSystem.h
+
+// Render-free Digivice logic. Everything a device needs between frames lives in
+// plain structs, so the game (AdventureState) and headless balance runs step the
+// exact same rules, and large batches of devices can be laid out in flat arrays.
+//
+// Time is counted in whole ticks of 1/TICKS_PER_SECOND s, the game's frame grid, so
+// the rules stay integer-only in fixed-point builds. Advancing by one big delta
+// gives exactly the same state as many small ones, which is what lets tools
+// fast-forward weeks of play; they convert to seconds only at their edges.
+
+enum class DeviceMode : uint8_t { IDLE, WALKING };
+
+// Frame timings of one animation clip; the sim only needs when frames end.
+struct SimClip {
+    static const int MAX_FRAMES = 8;
+
+    uint32_t frameMs[MAX_FRAMES] = {};
+    uint8_t frameCount = 0;
+    bool loops = true;
+};
+
+struct SimConfig {
+    static const int STAGE_COUNT = 5; // Baby I, Baby II, Rookie, Champion, Ultimate
+    static const int MAX_QUEUE_LIMIT = UINT8_MAX; // DeviceState::queuedSteps is one byte
+
+    SimClip idle;                      // Loops while no steps are queued
+    SimClip walk;                      // One play-through per counted step
+    int maxQueuedSteps = 2;            // Step inputs beyond this are dropped (1..MAX_QUEUE_LIMIT)
+    uint32_t stepsToEvolve[STAGE_COUNT - 1] = {}; // Steps spent in stage i before evolving
+};
+
+// The rules the shipped game uses
+SimConfig defaultSimConfig();
+
+struct DeviceState {
+    uint16_t partner = 0;              // Roster id in the game (entities/Roster.h)
+    DeviceMode mode = DeviceMode::IDLE;
+    uint8_t queuedSteps = 0;
+    uint8_t animFrame = 0;             // Frame within the current mode's clip
+    uint32_t animTicks = 0;            // Time into animFrame
+    uint8_t stage = 0;
+    uint32_t stageSteps = 0;           // Steps counted since the last evolution
+    uint64_t totalSteps = 0;           // Steps counted (walk cycles completed)
+    uint64_t clockTicks = 0;           // Device time advanced so far
+};
+
+// advanceDevice() result bits
+enum DeviceEvent : uint32_t {
+    DEVICE_EVENT_NONE = 0,
+    DEVICE_EVENT_STEP = 1u << 0,        // At least one step was counted
+    DEVICE_EVENT_MODE_CHANGED = 1u << 1,// Idle <-> walking; restart the clip
+    DEVICE_EVENT_EVOLVED = 1u << 2,
+};
+
+// --- Single Device ---
+// Queues one step input; returns false (and ignores it) when the queue is full.
+bool offerStep(const SimConfig& config, DeviceState& device);
+// Switches partner, dropping queued steps and returning to idle.
+void selectPartner(DeviceState& device, uint16_t partner);
+// Advances the device clock by deltaTicks; returns DeviceEvent bits.
+uint32_t advanceDevice(const SimConfig& config, DeviceState& device, uint64_t deltaTicks);
+
+
+// --- Walkers (simulated players) ---
+// How a population of players walks. Each device draws its own habits from these.
+// Walkers only run in host tools, so they keep their schedule in seconds.
+struct WalkerProfile {
+    float stepsPerDay = 6000.0f;       // Population mean
+    float stepsPerDaySpread = 0.5f;    // Per-device multiplier in [1 - spread, 1 + spread]
+    float sessionsPerDay = 6.0f;       // Walks per waking day
+    float cadence = 1.8f;              // Steps per second while walking
+    float cadenceSpread = 0.2f;
+    int wakeHour = 7;                  // Walks only start between wake and sleep
+    int sleepHour = 23;
+};
+
+struct WalkerState {
+    uint64_t rng = 0;
+    float cadence = 0.0f;              // This walker's steps per second
+    float sessionMeanSec = 0.0f;
+    float gapMeanSec = 0.0f;
+    float sessionLeftSec = 0.0f;       // > 0 while walking
+    float stepCarry = 0.0f;            // Fractional step owed to the next interval
+    double nextSessionSec = 0.0;       // Device clock time the next walk starts
+    uint64_t stepsOffered = 0;
+    uint64_t stepsDropped = 0;         // Offered while the device's queue was full
+};
+
+struct SimDevice {
+    DeviceState device;
+    WalkerState walker;
+    double stageReachedSec[SimConfig::STAGE_COUNT] = {}; // < 0 = not reached yet
+};
+
+// --- Batches ---
+// Seeds devices [0, count). A device's rolls depend only on (seed, firstIndex + i),
+// so results don't change with thread count or batch splits.
+void initSimDevices(SimDevice* devices, size_t count, uint64_t seed, const WalkerProfile& profile, size_t firstIndex = 0);
+// Plays 'ticks' of walker input into every device, spread over the job system's
+// workers (inline when jobs is null).
+void simulateDevices(JobSystem* jobs, const SimConfig& config, const WalkerProfile& profile, SimDevice* devices, size_t count, uint64_t ticks);
+// Advances bare device states in lockstep with no input (e.g. headless replays).
+void advanceDevices(JobSystem* jobs, const SimConfig& config, DeviceState* devices, size_t count, uint64_t deltaTicks);
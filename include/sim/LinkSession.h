@@ -0,0 +1,120 @@
+// File: include/sim/LinkSession.h
+#pragma once
+
+#include "sim/BattleSim.h"
+#include <cstddef>
+#include <cstdint>
+
+struct LinkStats {
+    uint64_t frames = 0;           // Frames simulated forward (not counting re-simulation)
+    uint64_t rollbacks = 0;        // Times a misprediction sent us back
+    uint64_t rolledBackFrames = 0; // Frames re-simulated by those rollbacks
+    uint32_t maxRollback = 0;      // Deepest single rollback, in frames
+    uint64_t stalls = 0;           // Ticks spent waiting because prediction ran too far ahead
+    uint64_t packetsSent = 0;
+    uint64_t packetsReceived = 0;
+    uint64_t packetsRejected = 0;  // Malformed or from another protocol version
+    uint64_t bytesSent = 0;        // Payload only; add UDP/IP headers for wire size
+    uint64_t bytesReceived = 0;
+    uint64_t syncBytesSent = 0;    // Share of bytesSent spent on state deltas
+    uint64_t syncsChecked = 0;     // Host states compared against our own
+    uint64_t desyncs = 0;          // ...that differed; we adopted the host's state
+    uint64_t syncsSkipped = 0;     // Host state arrived for a frame we no longer hold
+};
+
+// One side of a two-device link battle, independent of the transport.
+//
+// Only inputs travel. Each device schedules its own input INPUT_DELAY frames
+// ahead, and for frames whose remote input hasn't arrived it predicts "same as
+// the last one we got" and keeps going. Every frame's starting state is kept in
+// a snapshot ring (BattleState is a 28-byte plain copy), so when a real input
+// turns out to differ from the guess, the session restores the snapshot of the
+// first wrong frame and re-simulates to the present before the next tick. A
+// device only waits when it would run more than MAX_PREDICTION frames past the
+// last input it has confirmed.
+//
+// Packets carry every local input the other side hasn't acknowledged yet, so a
+// lost packet costs nothing once the next one lands. Player 0 is the host: every
+// SYNC_INTERVAL frames it also sends a confirmed state, encoded as a run-length
+// XOR delta against the previous state the peer acknowledged. The peer compares
+// it with its own state for that frame and, if a bug or bit flip made them
+// differ, adopts the host's state and re-simulates from there.
+class LinkSession {
+public:
+    static const uint32_t INPUT_DELAY = 2;       // Frames (33 ms) of latency hidden without prediction
+    static const uint32_t MAX_PREDICTION = 12;   // Frames we may run ahead of the remote's inputs
+    static const uint32_t HISTORY = 64;          // Snapshot and input ring size; a power of two
+    static const uint32_t SYNC_INTERVAL = 30;    // Host state check every half second
+    static const uint32_t MAX_PACKET_INPUTS = 32;
+    static const size_t MAX_PACKET_BYTES = 128;
+
+    LinkSession() = default;
+
+    // Both devices must start from the same state (same startBattle() arguments).
+    void start(const BattleConfig& config, const BattleState& initial, int localPlayer);
+
+    // One 60 Hz tick: applies pending rollbacks, then simulates one frame with
+    // localInput scheduled INPUT_DELAY frames ahead. Returns false (and ignores
+    // the input) while stalled waiting for the remote.
+    bool advance(BattleInput localInput);
+    // Applies pending rollbacks and state checks without advancing; call before
+    // reading a state that has to be final.
+    void resolve();
+
+    // Builds the next packet; returns its size (0 if capacity is too small).
+    size_t writePacket(uint8_t* out, size_t capacity);
+    // Takes a packet from the other device; returns false if it was rejected.
+    bool readPacket(const uint8_t* data, size_t size);
+
+    const BattleState& getState() const { return state_; }
+    uint32_t getFrame() const { return frame_; }
+    // Frames up to this one used only real inputs: their states are final
+    uint32_t getConfirmedFrame() const { return remoteReceived_ < frame_ ? remoteReceived_ : frame_; }
+    int getLocalPlayer() const { return localPlayer_; }
+    const LinkStats& getStats() const { return stats_; }
+
+    // Test hook: flips a bit in the current state and every snapshot, the way a
+    // non-deterministic bug would. Only the host's sync can repair it.
+    void injectDesync();
+
+private:
+    static const uint32_t NO_FRAME = 0xFFFFFFFFu;
+    static const uint32_t SYNC_SLOTS = 4;        // Host states kept as delta baselines
+
+    struct SyncRecord {
+        uint32_t frame = NO_FRAME;
+        BattleState state;
+    };
+
+    uint32_t slot(uint32_t frame) const { return frame & (HISTORY - 1); }
+    BattleInput remoteInputFor(uint32_t frame) const;
+    void simulateFrame();
+    void rollback();
+    void captureSync();
+    void checkPendingSync();
+    const SyncRecord* findSync(uint32_t frame) const;
+    void storeSync(uint32_t frame, const BattleState& state);
+
+    BattleConfig config_;
+    int localPlayer_ = 0;
+    BattleState state_;                          // State at frame_
+    uint32_t frame_ = 0;
+    BattleState snapshots_[HISTORY];             // snapshots_[slot(f)]: state at the start of frame f
+    BattleInput usedRemote_[HISTORY] = {};       // Remote input frame f was simulated with
+    BattleInput localInputs_[HISTORY] = {};
+    BattleInput remoteInputs_[HISTORY] = {};
+    uint32_t localQueued_ = 0;                   // Local inputs exist for frames below this
+    uint32_t remoteReceived_ = 0;                // Remote inputs exist for frames below this
+    uint32_t remoteAcked_ = 0;                   // The remote holds our inputs below this
+    uint32_t rollbackFrom_ = NO_FRAME;           // Earliest frame simulated with a wrong guess
+
+    // --- State Sync ---
+    SyncRecord syncHistory_[SYNC_SLOTS];         // Host: states sent; peer: states received
+    uint32_t nextSyncFrame_ = SYNC_INTERVAL;     // Host: next frame to capture
+    uint32_t syncSending_ = NO_FRAME;            // Host: frame being repeated until acked
+    uint32_t syncAcked_ = NO_FRAME;              // Host: last frame the peer acknowledged
+    uint32_t syncReceived_ = NO_FRAME;           // Peer: last frame received (sent back as the ack)
+    uint32_t syncPending_ = NO_FRAME;            // Peer: received but not yet confirmed locally
+
+    LinkStats stats_;
+};
@@ -0,0 +1,95 @@
+// File: include/ui/BitmapFont.h
+#pragma once
+
+#include "core/MemoryBudget.h" // BoundedVector, MAX_TEXT_RUN_CHARS, MAX_CACHED_TEXT_RUNS
+#include <SDL.h>      // SDL_Texture, SDL_Vertex, SDL_Color
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+
+// Forward declarations
+class PCDisplay;
+
+// How a run of text is drawn. Glyphs are scaled by an integer factor so the
+// pixel font stays crisp with nearest-neighbour filtering.
+struct TextStyle {
+    int scale = 1;
+    SDL_Color color = {255, 255, 255, 255};
+};
+
+// Laid-out text: one textured quad per visible glyph, positioned relative to the
+// run's top-left corner. Owners keep a run around and call BitmapFont::updateRun
+// every frame; the vertices are only rebuilt when the text or style changes.
+// No-heap builds store both inline and keep the first MAX_TEXT_RUN_CHARS characters.
+struct TextRun {
+#if defined(DIGIVICE_NO_HEAP)
+    FixedString<MAX_TEXT_RUN_CHARS> text;
+#else
+    std::string text;
+#endif
+    TextStyle style;
+    BoundedVector<SDL_Vertex, MAX_TEXT_RUN_CHARS * 4> vertices; // 4 per quad, indexed by BitmapFont's shared quad indices
+    int width = 0;
+    int height = 0;
+    bool built = false;
+};
+
+// Fixed-width pixel font. All glyphs live in one atlas texture, so each run is a
+// single SDL_RenderGeometry call.
+class BitmapFont {
+public:
+    BitmapFont() = default;
+    ~BitmapFont();
+
+    // Packs the built-in 5x7 ASCII glyphs (0x20-0x7E) into an atlas texture
+    bool loadBuiltin(SDL_Renderer* renderer);
+    void shutdown();
+    bool isLoaded() const { return atlas_ != nullptr; }
+
+    // --- Metrics (pixels, at the given scale) ---
+    int getGlyphAdvance(int scale) const { return GLYPH_ADVANCE * scale; }
+    int getLineHeight(int scale) const { return LINE_HEIGHT * scale; }
+    int measureText(const char* text, int scale) const;
+
+    // --- Runs ---
+    // Rebuilds 'run' only if text/style differ from what it holds. Returns true if it rebuilt.
+    bool updateRun(TextRun& run, const char* text, const TextStyle& style) const;
+    void drawRun(PCDisplay* display, const TextRun& run, int x, int y);
+
+    // Convenience: draws through an internal run cache keyed by text and style,
+    // so repeated strings are laid out once.
+    void drawText(PCDisplay* display, const char* text, int x, int y, const TextStyle& style = TextStyle());
+    // Digit fast path for counters that change every frame: lays out straight into
+    // a fixed buffer with no allocation and no cache entry.
+    void drawNumber(PCDisplay* display, long long value, int x, int y, const TextStyle& style = TextStyle());
+
+private:
+    static const int GLYPH_WIDTH = 5;
+    static const int GLYPH_HEIGHT = 8;   // 7 rows plus descender row
+    static const int GLYPH_ADVANCE = 6;  // One column of spacing
+    static const int LINE_HEIGHT = 10;
+    static const int FIRST_CHAR = 0x20;
+    static const int CHAR_COUNT = 95;
+    static const int ATLAS_COLUMNS = 16;
+    static const size_t MAX_NUMBER_CHARS = 20; // Sign + 19 digits of a 64-bit value
+    static const size_t MAX_CACHED_RUNS = 256; // No-heap builds hold MAX_CACHED_TEXT_RUNS
+
+    // Appends the 4 vertices of one glyph quad
+    void emitGlyph(SDL_Vertex* out, unsigned char c, float x, float y, const TextStyle& style) const;
+    void submit(PCDisplay* display, const SDL_Vertex* vertices, size_t quadCount, int x, int y);
+    void ensureQuadIndices(size_t quadCount);
+
+    SDL_Texture* atlas_ = nullptr; // Owned
+    int atlasW_ = 0;
+    int atlasH_ = 0;
+
+    std::vector<int> quadIndices_;         // 0,1,2, 2,1,3 per quad; shared by all runs
+    std::vector<SDL_Vertex> scratch_;      // Translated copy of the run being drawn
+#if defined(DIGIVICE_NO_HEAP)
+    FlatMap<uint64_t, TextRun, MAX_CACHED_TEXT_RUNS> runCache_; // Keyed by hash of text + style
+#else
+    std::unordered_map<uint64_t, TextRun> runCache_;
+#endif
+};
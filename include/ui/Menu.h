@@ -0,0 +1,119 @@
+// File: include/ui/Menu.h
+#pragma once
+
+#include "core/MemoryBudget.h" // BoundedVector, FixedString, MAX_MENU_*
+#include "ui/BitmapFont.h" // TextStyle
+#include <SDL.h>           // SDL_Rect
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+
+// Forward declarations
+class PCDisplay;
+
+// Immutable search index over a list of entry names. Built once when the data
+// loads and shared by every MenuList showing it, so opening a menu costs nothing.
+//  - Prefix index: item ids sorted by lowercased name; a prefix query is one
+//    binary-search range.
+//  - Trigram index: one flat array of (trigram, item) pairs sorted by trigram;
+//    substring queries of 3+ chars only verify items in the rarest trigram's postings.
+// Matching is case-insensitive (ASCII). Results list prefix matches first, then
+// other substring matches, each group in alphabetical order.
+// Queries write into caller storage and allocate nothing. No-heap builds keep the
+// first MAX_MENU_ITEMS entries, so a full result list fits MenuList's fixed pool.
+class MenuIndex {
+public:
+    explicit MenuIndex(std::vector<std::string> items);
+
+    size_t size() const { return items_.size(); }
+    const std::string& getItem(uint32_t id) const { return items_[id]; }
+
+    // Full search (lowercase query). Writes matching item ids to 'out', which needs
+    // room for size() ids; returns how many it wrote.
+    size_t search(std::string_view lowerQuery, uint32_t* out) const;
+    // Keeps only the 'count' ids in 'previous' that match 'lowerQuery'; valid when the
+    // previous results came from a query that is a prefix of this one. 'out' needs
+    // room for 'count' ids and must not overlap 'previous'; returns how many it wrote.
+    size_t narrow(const uint32_t* previous, size_t count, std::string_view lowerQuery, uint32_t* out) const;
+
+private:
+    struct Posting {
+        uint32_t trigram;
+        uint32_t id;
+        bool operator<(const Posting& other) const { return trigram != other.trigram ? trigram < other.trigram : id < other.id; }
+    };
+
+    void sortByRank(uint32_t* first, uint32_t* last) const;
+    bool isPrefixOf(std::string_view lowerQuery, uint32_t id) const;
+
+    std::vector<std::string> items_;
+    std::vector<std::string> lower_;  // Lowercased items_, same ids
+    std::vector<uint32_t> sorted_;    // Ids in alphabetical order of lower_
+    std::vector<uint32_t> rank_;      // rank_[id] = position of id in sorted_
+    std::vector<Posting> trigrams_;
+};
+
+// A scrollable, filterable view of a MenuIndex. Only the rows inside the viewport
+// are laid out and drawn; scrolling eases towards keeping the selection in view.
+// Filters keep a history stack, so typing narrows the previous results and
+// backspacing pops back to them without searching again. The filter is at most
+// MAX_MENU_FILTER_LENGTH characters, and every level's results share one pool
+// (MAX_MENU_RESULTS in no-heap builds; when it fills, the stack restarts from a
+// full search), so filtering allocates nothing there.
+class MenuList {
+public:
+    explicit MenuList(std::shared_ptr<const MenuIndex> index);
+
+    // --- Filtering ---
+    void setFilter(const char* query);   // Longer queries are cut to MAX_MENU_FILTER_LENGTH
+    void appendToFilter(const char* text);
+    void popFilterChar();
+    const char* getFilter() const { return displayFilter_.c_str(); }
+    bool hasFilter() const { return getFilter()[0] != '\0'; }
+
+    // --- Selection ---
+    size_t getRowCount() const;          // Rows after filtering
+    size_t getItemAtRow(size_t row) const;
+    void moveSelection(int delta);       // Wraps at both ends
+    size_t getSelectedRow() const { return selectedRow_; }
+    const std::string* getSelectedItem() const; // Null when nothing matches
+
+    // --- Viewport ---
+    void setViewport(const SDL_Rect& area, int rowHeight);
+    void moveViewport(int x, int y) { viewport_.x = x; viewport_.y = y; } // Keeps scroll state
+    void update(float delta_time);       // Advances smooth scrolling
+    void snapScroll();                   // Jumps straight to the target scroll position
+    bool isScrolling() const { return scrollY_ != targetScrollY_; }
+    size_t getFirstVisibleRow() const;
+    size_t getVisibleRowCount() const;
+
+    // Draws the visible rows (clipped to the viewport) with a cursor beside the selection
+    void render(PCDisplay* display, BitmapFont* font, const TextStyle& style, const TextStyle& selectedStyle) const;
+
+private:
+    using FilterText = FixedString<MAX_MENU_FILTER_LENGTH>;
+    struct FilterLevel {
+        size_t queryLength;              // This level matched the first queryLength chars of lowerFilter_
+        size_t first;                    // Its ids are results_[first, first + count)
+        size_t count;
+    };
+
+    void pushFilterLevel(std::string_view lowerQuery);
+    void clampSelection();
+    void scrollToSelection();
+
+    std::shared_ptr<const MenuIndex> index_;
+    BoundedVector<FilterLevel, MAX_MENU_FILTER_LENGTH> filterStack_; // Each level's query extends the one below
+    BoundedVector<uint32_t, MAX_MENU_RESULTS> results_;              // Every level's ids, bottom level first
+    FilterText displayFilter_;             // As typed (original case)
+    FilterText lowerFilter_;               // Lowercased; every level's query is a prefix of it
+
+    size_t selectedRow_ = 0;
+    SDL_Rect viewport_ = {0, 0, 0, 0};
+    int rowHeight_ = 1;
+    float scrollY_ = 0.0f;                 // Pixels from the first row to the viewport top
+    float targetScrollY_ = 0.0f;
+};
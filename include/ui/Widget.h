@@ -0,0 +1,172 @@
+// File: include/ui/Widget.h
+#pragma once
+
+#include "core/MemoryBudget.h" // BoundedVector, MAX_WIDGET_CHILDREN
+#include "ui/BitmapFont.h" // Labels draw text runs
+#include "ui/Menu.h"       // ListWidget wraps a MenuList
+#include <SDL.h>           // SDL_Rect, SDL_Point, SDL_Texture, SDL_Color
+#include <memory>
+
+// Forward declarations
+class PCDisplay;
+
+// Retained-mode UI tree. Screens build their widgets once; each frame they call
+// update() and render() on the root.
+//  - Ownership: a parent only points at its children. Screens keep their widgets
+//    as members, so building a tree allocates nothing.
+//  - Layout: preferred sizes and rects are cached per widget. Changing a widget
+//    (text, size, visibility...) marks it and its ancestors layout-dirty, and the
+//    next render() re-lays out only what is dirty.
+//  - Render caching: a Panel with setCached(true) draws its subtree into a
+//    render-target texture and then blits that as one quad until something under
+//    it marks itself render-dirty.
+class Widget {
+public:
+    Widget() = default;
+    virtual ~Widget() = default;
+    Widget(const Widget&) = delete;            // Children point back at their parent
+    Widget& operator=(const Widget&) = delete;
+
+    // --- Tree ---
+    // 'child' must outlive its use in this tree (keep both in the same screen).
+    // Returns false if it already has a parent or this widget is full (MAX_WIDGET_CHILDREN).
+    bool addChild(Widget& child);
+    void clearChildren();
+    Widget* getParent() const { return parent_; }
+
+    // --- Layout Inputs ---
+    void setPosition(int x, int y);      // Used by Panels with LayoutDirection::NONE
+    void setFixedSize(int w, int h);     // 0 on an axis = size to content
+    void setFlex(bool flex);             // Take a share of the parent's leftover space
+    void setVisible(bool visible);
+    bool isVisible() const { return visible_; }
+    bool isFlex() const { return flex_; }
+    const SDL_Point& getPosition() const { return position_; }
+
+    // --- Layout ---
+    SDL_Point getPreferredSize();        // Cached until layout-dirty
+    void layout(const SDL_Rect& rect);   // Skipped for clean widgets whose rect is unchanged
+    const SDL_Rect& getRect() const { return rect_; }
+    bool isLayoutDirty() const { return layoutDirty_; }
+    void markLayoutDirty();              // Also marks render-dirty
+    void markRenderDirty();
+    bool isRenderDirty() const { return renderDirty_; }
+
+    // --- Per Frame ---
+    virtual void update(float delta_time);
+    // Lays out the tree if needed (root only), then draws. offset shifts every
+    // rect, which is how cached panels draw into their own texture.
+    void render(PCDisplay* display, int offsetX = 0, int offsetY = 0);
+
+protected:
+    virtual SDL_Point measure();                             // Content size (default: none)
+    virtual void arrange(const SDL_Rect& rect) { (void)rect; } // Place children (default: none)
+    virtual void draw(PCDisplay* display, int offsetX, int offsetY); // Default: children only
+    void drawChildren(PCDisplay* display, int offsetX, int offsetY);
+
+    BoundedVector<Widget*, MAX_WIDGET_CHILDREN> children_; // Non-owning
+
+private:
+    Widget* parent_ = nullptr;
+    SDL_Point position_ = {0, 0};
+    SDL_Point fixedSize_ = {0, 0};
+    SDL_Point preferred_ = {0, 0};
+    SDL_Rect rect_ = {0, 0, 0, 0};
+    bool flex_ = false;
+    bool visible_ = true;
+    bool layoutDirty_ = true;
+    bool renderDirty_ = true;
+};
+
+enum class LayoutDirection { VERTICAL, HORIZONTAL, NONE };
+
+// Container: optional background fill, padding, and a simple stack layout.
+// Children stretch across the cross axis; flex children share the leftover main-axis space.
+class Panel : public Widget {
+public:
+    explicit Panel(LayoutDirection direction = LayoutDirection::VERTICAL);
+    ~Panel() override;
+
+    void setDirection(LayoutDirection direction);
+    void setPadding(int padding);
+    void setSpacing(int spacing);
+    void setBackground(SDL_Color color);     // Alpha 0 = no fill
+    void setCached(bool cached);             // Draw the subtree through a render target
+
+protected:
+    SDL_Point measure() override;
+    void arrange(const SDL_Rect& rect) override;
+    void draw(PCDisplay* display, int offsetX, int offsetY) override;
+
+private:
+    bool redrawCache(PCDisplay* display);
+
+    LayoutDirection direction_;
+    int padding_ = 0;
+    int spacing_ = 0;
+    SDL_Color background_ = {0, 0, 0, 0};
+    bool cached_ = false;
+    SDL_Texture* cacheTexture_ = nullptr;    // Owned
+    int cacheW_ = 0;
+    int cacheH_ = 0;
+    bool cacheValid_ = false;
+};
+
+// One line of text. The layout run is rebuilt only when the text or style changes.
+class Label : public Widget {
+public:
+    Label(BitmapFont* font, const char* text, const TextStyle& style = TextStyle());
+
+    void setText(const char* text);
+    void setStyle(const TextStyle& style);
+    const char* getText() const { return run_.text.c_str(); }
+
+protected:
+    SDL_Point measure() override;
+    void draw(PCDisplay* display, int offsetX, int offsetY) override;
+
+private:
+    BitmapFont* font_;                       // Non-owning (Game owns it)
+    TextRun run_;
+};
+
+// A virtualized, filterable list (see MenuList). Fills the rect it is given; it
+// redraws every frame while scrolling, so keep it outside cached panels.
+class ListWidget : public Widget {
+public:
+    ListWidget(BitmapFont* font, std::shared_ptr<const MenuIndex> index, int rowHeight);
+
+    MenuList& getList() { return list_; }
+    void setStyles(const TextStyle& style, const TextStyle& selectedStyle);
+    void update(float delta_time) override;
+
+protected:
+    void arrange(const SDL_Rect& rect) override;
+    void draw(PCDisplay* display, int offsetX, int offsetY) override;
+
+private:
+    BitmapFont* font_;                       // Non-owning
+    MenuList list_;
+    int rowHeight_;
+    TextStyle style_;
+    TextStyle selectedStyle_;
+    size_t lastSelectedRow_ = 0;             // To notice selection/filter changes in update()
+    size_t lastRowCount_ = 0;
+};
+
+// A texture region drawn at an integer scale.
+class Icon : public Widget {
+public:
+    Icon(SDL_Texture* texture, const SDL_Rect& srcRect, int scale = 1);
+
+    void setImage(SDL_Texture* texture, const SDL_Rect& srcRect);
+
+protected:
+    SDL_Point measure() override;
+    void draw(PCDisplay* display, int offsetX, int offsetY) override;
+
+private:
+    SDL_Texture* texture_;                   // Non-owning (AssetManager owns it)
+    SDL_Rect srcRect_;
+    int scale_;
+};
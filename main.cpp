@@ -2,19 +2,62 @@
 
 #include "core/Game.h" // <<< CORRECTED path relative to include dir >>>
 #include <SDL_log.h>   // <<< CORRECTED SDL Include >>>
+#include <cstring>     // strcmp for command-line flags
+#include <cstdlib>     // atoi for numeric flags
+#include <memory>      // make_unique for the step source
 
-// --- Window Dimensions ---
-const int WINDOW_WIDTH = 466;
-const int WINDOW_HEIGHT = 466;
+// Resume snapshot, saved on exit (relative to the working directory, like the assets)
+const char* const DEFAULT_SNAPSHOT_PATH = "digivice.sav";
 
 int main(int argc, char* argv[]) {
     SDL_LogSetAllPriority(SDL_LOG_PRIORITY_DEBUG);
     SDL_Log("--- Creating Game Instance ---");
 
+#if defined(DIGIVICE_NO_HEAP)
+    static Game digivice_game; // In .bss, so the linker map accounts for it
+#else
     Game digivice_game; // Needs full definition from core/Game.h
+#endif
+    const char* accel_trace = nullptr;
+    bool accel_sensor = true;
+    const char* capture_path = nullptr;
+    CaptureFormat capture_format = CaptureFormat::PNG_SEQUENCE;
+    int capture_every = 1;
+    const char* snapshot_path = DEFAULT_SNAPSHOT_PATH;
+    const DisplayProfile* profile = &getDefaultDisplayProfile();
+    for (int i = 1; i < argc; ++i) {
+        // --pipelined: update the next frame on a worker thread while this one is presented
+        if (std::strcmp(argv[i], "--pipelined") == 0) digivice_game.setPipelined(true);
+        // --accel-trace=<file>: replay a recorded accelerometer trace (CSV or binary) instead of the sensor
+        else if (std::strncmp(argv[i], "--accel-trace=", 14) == 0) accel_trace = argv[i] + 14;
+        // --no-accel: steps come from the keyboard only
+        else if (std::strcmp(argv[i], "--no-accel") == 0) accel_sensor = false;
+        // --capture=<dir>: save every rendered frame as a PNG; --record=<file>: one raw BGRA video stream
+        else if (std::strncmp(argv[i], "--capture=", 10) == 0) { capture_path = argv[i] + 10; capture_format = CaptureFormat::PNG_SEQUENCE; }
+        else if (std::strncmp(argv[i], "--record=", 9) == 0) { capture_path = argv[i] + 9; capture_format = CaptureFormat::RAW_VIDEO; }
+        // --capture-every=<n>: keep every nth frame (long soak sessions)
+        else if (std::strncmp(argv[i], "--capture-every=", 16) == 0) capture_every = std::atoi(argv[i] + 16);
+        // --save=<file>: resume from and save to this snapshot; --no-save: always start fresh, save nothing
+        else if (std::strncmp(argv[i], "--save=", 7) == 0) snapshot_path = argv[i] + 7;
+        else if (std::strcmp(argv[i], "--no-save") == 0) snapshot_path = nullptr;
+        // --profile=<name>: window size, with assets and layout scaled down for it (round466, round240, gba)
+        else if (std::strncmp(argv[i], "--profile=", 10) == 0) {
+            profile = findDisplayProfile(argv[i] + 10); // Logs the known names
+            if (!profile) return 1;
+        }
+    }
+
+    if (snapshot_path) digivice_game.setSnapshotPath(snapshot_path);
+    digivice_game.setDisplayProfile(*profile);
 
     SDL_Log("--- Initializing Game ---");
-    if (digivice_game.init("Digivice Sim - Refactored", WINDOW_WIDTH, WINDOW_HEIGHT)) {
+    if (digivice_game.init("Digivice Sim - Refactored", profile->width, profile->height)) {
+        // Step input; without a source (or sensor) the SPACE key still adds steps
+        if (accel_trace) digivice_game.getStepPipeline()->start(std::make_unique<TraceAccelSource>(accel_trace));
+        else if (accel_sensor) digivice_game.getStepPipeline()->start(std::make_unique<SensorAccelSource>());
+
+        if (capture_path) digivice_game.getFrameCapture()->start(digivice_game.get_display(), capture_path, capture_format, capture_every);
+
         SDL_Log("--- Starting Game Loop ---");
         digivice_game.run();
     } else {
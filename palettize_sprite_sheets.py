@@ -0,0 +1,55 @@
+# Python Script: palettize_sprite_sheets.py
+# Rewrites the Digimon sprite sheets as 8-bit indexed PNGs (palette + tRNS) so
+# AssetManager::loadPalettedSheet can keep them at 1 byte per pixel and recolour
+# them at runtime. Index 0 is always the transparent background; the remaining
+# entries are sorted dark to light so variant palettes are easy to hand-edit.
+# Run after trim_sprite_sheets.py (which writes RGBA). Already-indexed sheets are
+# simply re-sorted.
+
+import os
+import glob
+from PIL import Image
+
+# --- Configuration ---
+sprites_folder = "assets/sprites"
+sheet_pattern = "*_sheet.png"
+# ---------------------
+
+def luminance(color):
+    r, g, b, a = color
+    return (299 * r + 587 * g + 114 * b, a)
+
+def palettize(image_path):
+    img = Image.open(image_path).convert("RGBA")
+    pixels = [p if p[3] > 0 else (0, 0, 0, 0) for p in img.getdata()]
+
+    colors = sorted(set(p for p in pixels if p[3] > 0), key=luminance)
+    if len(colors) > 255:
+        print(f"  Skipping {os.path.basename(image_path)}: {len(colors)} colours (max 255 plus transparent)")
+        return
+    palette = [(0, 0, 0, 0)] + colors
+    index_of = {c: i for i, c in enumerate(palette)}
+
+    indexed = Image.new("P", img.size, 0)
+    indexed.putpalette([channel for c in palette for channel in c[:3]])
+    indexed.putdata([index_of[p] for p in pixels])
+    indexed.save(image_path, transparency=bytes(c[3] for c in palette))
+
+    print(f"  {os.path.basename(image_path)}: {len(palette)} palette entries, "
+          f"{img.size[0] * img.size[1]} bytes of indices (was {img.size[0] * img.size[1] * 4} as RGBA)")
+
+try:
+    script_dir = os.path.dirname(os.path.abspath(__file__))
+    folder = os.path.join(script_dir, sprites_folder)
+    sheets = sorted(glob.glob(os.path.join(folder, sheet_pattern)))
+    if not sheets:
+        print(f"Error: No sheets matching '{sheet_pattern}' in '{os.path.abspath(folder)}'")
+    else:
+        print(f"Palettizing {len(sheets)} sheet(s) in {os.path.abspath(folder)}")
+    for image_path in sheets:
+        palettize(image_path)
+
+except FileNotFoundError as e:
+    print(f"Error: {e}")
+except Exception as e:
+    print(f"Unexpected error: {e}")
@@ -0,0 +1,230 @@
+// File: src/BitmapFont.cpp
+
+#include "ui/BitmapFont.h"          // Include own header
+#include "platform/pc/pc_display.h" // To draw
+#include <SDL_log.h>                // SDL logging
+#include <algorithm>                // std::max
+#include <cstring>                  // std::strlen, std::strncmp
+
+namespace {
+    // Classic 5x7 LCD font, ASCII 0x20-0x7E. Five column bytes per glyph,
+    // bit 0 is the top row; bit 7 is used by descenders.
+    const uint8_t GLYPH_COLUMNS[95][5] = {
+        {0x00,0x00,0x00,0x00,0x00}, {0x00,0x00,0x5F,0x00,0x00}, {0x00,0x07,0x00,0x07,0x00}, {0x14,0x7F,0x14,0x7F,0x14}, // ' ' ! " #
+        {0x24,0x2A,0x7F,0x2A,0x12}, {0x23,0x13,0x08,0x64,0x62}, {0x36,0x49,0x56,0x20,0x50}, {0x00,0x08,0x07,0x03,0x00}, // $ % & '
+        {0x00,0x1C,0x22,0x41,0x00}, {0x00,0x41,0x22,0x1C,0x00}, {0x2A,0x1C,0x7F,0x1C,0x2A}, {0x08,0x08,0x3E,0x08,0x08}, // ( ) * +
+        {0x00,0x80,0x70,0x30,0x00}, {0x08,0x08,0x08,0x08,0x08}, {0x00,0x00,0x60,0x60,0x00}, {0x20,0x10,0x08,0x04,0x02}, // , - . /
+        {0x3E,0x51,0x49,0x45,0x3E}, {0x00,0x42,0x7F,0x40,0x00}, {0x72,0x49,0x49,0x49,0x46}, {0x21,0x41,0x49,0x4D,0x33}, // 0 1 2 3
+        {0x18,0x14,0x12,0x7F,0x10}, {0x27,0x45,0x45,0x45,0x39}, {0x3C,0x4A,0x49,0x49,0x31}, {0x41,0x21,0x11,0x09,0x07}, // 4 5 6 7
+        {0x36,0x49,0x49,0x49,0x36}, {0x46,0x49,0x49,0x29,0x1E}, {0x00,0x00,0x14,0x00,0x00}, {0x00,0x40,0x34,0x00,0x00}, // 8 9 : ;
+        {0x00,0x08,0x14,0x22,0x41}, {0x14,0x14,0x14,0x14,0x14}, {0x00,0x41,0x22,0x14,0x08}, {0x02,0x01,0x59,0x09,0x06}, // < = > ?
+        {0x3E,0x41,0x5D,0x59,0x4E}, {0x7C,0x12,0x11,0x12,0x7C}, {0x7F,0x49,0x49,0x49,0x36}, {0x3E,0x41,0x41,0x41,0x22}, // @ A B C
+        {0x7F,0x41,0x41,0x41,0x3E}, {0x7F,0x49,0x49,0x49,0x41}, {0x7F,0x09,0x09,0x09,0x01}, {0x3E,0x41,0x41,0x51,0x73}, // D E F G
+        {0x7F,0x08,0x08,0x08,0x7F}, {0x00,0x41,0x7F,0x41,0x00}, {0x20,0x40,0x41,0x3F,0x01}, {0x7F,0x08,0x14,0x22,0x41}, // H I J K
+        {0x7F,0x40,0x40,0x40,0x40}, {0x7F,0x02,0x1C,0x02,0x7F}, {0x7F,0x04,0x08,0x10,0x7F}, {0x3E,0x41,0x41,0x41,0x3E}, // L M N O
+        {0x7F,0x09,0x09,0x09,0x06}, {0x3E,0x41,0x51,0x21,0x5E}, {0x7F,0x09,0x19,0x29,0x46}, {0x26,0x49,0x49,0x49,0x32}, // P Q R S
+        {0x03,0x01,0x7F,0x01,0x03}, {0x3F,0x40,0x40,0x40,0x3F}, {0x1F,0x20,0x40,0x20,0x1F}, {0x3F,0x40,0x38,0x40,0x3F}, // T U V W
+        {0x63,0x14,0x08,0x14,0x63}, {0x03,0x04,0x78,0x04,0x03}, {0x61,0x59,0x49,0x4D,0x43}, {0x00,0x7F,0x41,0x41,0x41}, // X Y Z [
+        {0x02,0x04,0x08,0x10,0x20}, {0x00,0x41,0x41,0x41,0x7F}, {0x04,0x02,0x01,0x02,0x04}, {0x40,0x40,0x40,0x40,0x40}, // \ ] ^ _
+        {0x00,0x03,0x07,0x08,0x00}, {0x20,0x54,0x54,0x78,0x40}, {0x7F,0x28,0x44,0x44,0x38}, {0x38,0x44,0x44,0x44,0x28}, // ` a b c
+        {0x38,0x44,0x44,0x28,0x7F}, {0x38,0x54,0x54,0x54,0x18}, {0x00,0x08,0x7E,0x09,0x02}, {0x18,0xA4,0xA4,0x9C,0x78}, // d e f g
+        {0x7F,0x08,0x04,0x04,0x78}, {0x00,0x44,0x7D,0x40,0x00}, {0x20,0x40,0x40,0x3D,0x00}, {0x7F,0x10,0x28,0x44,0x00}, // h i j k
+        {0x00,0x41,0x7F,0x40,0x00}, {0x7C,0x04,0x78,0x04,0x78}, {0x7C,0x08,0x04,0x04,0x78}, {0x38,0x44,0x44,0x44,0x38}, // l m n o
+        {0xFC,0x18,0x24,0x24,0x18}, {0x18,0x24,0x24,0x18,0xFC}, {0x7C,0x08,0x04,0x04,0x08}, {0x48,0x54,0x54,0x54,0x24}, // p q r s
+        {0x04,0x04,0x3F,0x44,0x24}, {0x3C,0x40,0x40,0x20,0x7C}, {0x1C,0x20,0x40,0x20,0x1C}, {0x3C,0x40,0x30,0x40,0x3C}, // t u v w
+        {0x44,0x28,0x10,0x28,0x44}, {0x4C,0x90,0x90,0x90,0x7C}, {0x44,0x64,0x54,0x4C,0x44}, {0x00,0x08,0x36,0x41,0x00}, // x y z {
+        {0x00,0x00,0x77,0x00,0x00}, {0x00,0x41,0x36,0x08,0x00}, {0x02,0x01,0x02,0x04,0x02},                             // | } ~
+    };
+
+    uint64_t hashRun(const char* text, const TextStyle& style) {
+        // FNV-1a over the text, then the style fields
+        uint64_t hash = 1469598103934665603ull;
+        auto mix = [&hash](uint8_t byte) { hash ^= byte; hash *= 1099511628211ull; };
+        for (const char* c = text; *c; ++c) mix(static_cast<uint8_t>(*c));
+        mix(0xFF); // Separator so "ab"+scale can't alias "a"+other bytes
+        mix(static_cast<uint8_t>(style.scale)); mix(static_cast<uint8_t>(style.scale >> 8));
+        mix(style.color.r); mix(style.color.g); mix(style.color.b); mix(style.color.a);
+        return hash;
+    }
+
+    bool sameStyle(const TextStyle& a, const TextStyle& b) {
+        return a.scale == b.scale && a.color.r == b.color.r && a.color.g == b.color.g && a.color.b == b.color.b && a.color.a == b.color.a;
+    }
+} // end anonymous namespace
+
+
+BitmapFont::~BitmapFont() {
+    shutdown();
+}
+
+bool BitmapFont::loadBuiltin(SDL_Renderer* renderer) {
+    if (!renderer) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "BitmapFont: Cannot build atlas without a renderer."); return false; }
+    shutdown();
+
+    // One glyph per GLYPH_ADVANCE x GLYPH_HEIGHT cell; the spare column keeps
+    // linear filtering (if ever enabled) from bleeding between glyphs
+    const int rows = (CHAR_COUNT + ATLAS_COLUMNS - 1) / ATLAS_COLUMNS;
+    atlasW_ = ATLAS_COLUMNS * GLYPH_ADVANCE;
+    atlasH_ = rows * GLYPH_HEIGHT;
+    std::vector<Uint32> pixels(static_cast<size_t>(atlasW_) * atlasH_, 0u);
+    for (int glyph = 0; glyph < CHAR_COUNT; ++glyph) {
+        const int cellX = (glyph % ATLAS_COLUMNS) * GLYPH_ADVANCE;
+        const int cellY = (glyph / ATLAS_COLUMNS) * GLYPH_HEIGHT;
+        for (int col = 0; col < GLYPH_WIDTH; ++col) {
+            const uint8_t bits = GLYPH_COLUMNS[glyph][col];
+            for (int row = 0; row < GLYPH_HEIGHT; ++row) {
+                // White with full alpha; vertex colours tint it
+                if (bits & (1u << row)) pixels[static_cast<size_t>(cellY + row) * atlasW_ + cellX + col] = 0xFFFFFFFFu;
+            }
+        }
+    }
+
+    atlas_ = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, atlasW_, atlasH_);
+    if (!atlas_) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "BitmapFont: SDL_CreateTexture failed: %s", SDL_GetError()); return false; }
+    if (SDL_UpdateTexture(atlas_, nullptr, pixels.data(), atlasW_ * static_cast<int>(sizeof(Uint32))) != 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "BitmapFont: SDL_UpdateTexture failed: %s", SDL_GetError());
+        shutdown();
+        return false;
+    }
+    SDL_SetTextureBlendMode(atlas_, SDL_BLENDMODE_BLEND);
+
+    // Indices and scratch for the digit path and any run that fits MAX_TEXT_RUN_CHARS
+    // up front, so drawing never allocates (longer runs in heap builds still grow them)
+    ensureQuadIndices(std::max(MAX_NUMBER_CHARS, MAX_TEXT_RUN_CHARS));
+    scratch_.reserve(MAX_TEXT_RUN_CHARS * 4);
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "BitmapFont: Built %dx%d glyph atlas (%d glyphs).", atlasW_, atlasH_, CHAR_COUNT);
+    return true;
+}
+
+void BitmapFont::shutdown() {
+    if (atlas_) {
+        SDL_DestroyTexture(atlas_);
+        atlas_ = nullptr;
+    }
+    runCache_.clear();
+}
+
+int BitmapFont::measureText(const char* text, int scale) const {
+    return text ? static_cast<int>(std::strlen(text)) * GLYPH_ADVANCE * scale : 0;
+}
+
+
+// --- Layout ---
+void BitmapFont::emitGlyph(SDL_Vertex* out, unsigned char c, float x, float y, const TextStyle& style) const {
+    const int glyph = (c >= FIRST_CHAR && c < FIRST_CHAR + CHAR_COUNT) ? c - FIRST_CHAR : '?' - FIRST_CHAR;
+    const float u0 = static_cast<float>((glyph % ATLAS_COLUMNS) * GLYPH_ADVANCE) / atlasW_;
+    const float v0 = static_cast<float>((glyph / ATLAS_COLUMNS) * GLYPH_HEIGHT) / atlasH_;
+    const float u1 = u0 + static_cast<float>(GLYPH_WIDTH) / atlasW_;
+    const float v1 = v0 + static_cast<float>(GLYPH_HEIGHT) / atlasH_;
+    const float w = static_cast<float>(GLYPH_WIDTH * style.scale);
+    const float h = static_cast<float>(GLYPH_HEIGHT * style.scale);
+
+    out[0] = { { x,     y     }, style.color, { u0, v0 } };
+    out[1] = { { x + w, y     }, style.color, { u1, v0 } };
+    out[2] = { { x,     y + h }, style.color, { u0, v1 } };
+    out[3] = { { x + w, y + h }, style.color, { u1, v1 } };
+}
+
+bool BitmapFont::updateRun(TextRun& run, const char* text, const TextStyle& style) const {
+    if (!text) text = "";
+#if defined(DIGIVICE_NO_HEAP)
+    const bool sameText = std::strncmp(run.text.c_str(), text, MAX_TEXT_RUN_CHARS) == 0; // The run holds only this much
+#else
+    const bool sameText = run.text == text;
+#endif
+    if (run.built && sameText && sameStyle(run.style, style)) return false;
+
+    if (run.text.c_str() != text) run.text.assign(text); // Restyling passes the run's own text
+    run.style = style;
+    run.vertices.clear();
+    const float advance = static_cast<float>(GLYPH_ADVANCE * style.scale);
+    float penX = 0.0f;
+    for (const char* glyph = run.text.c_str(); *glyph; ++glyph) {
+        const char c = *glyph;
+        // Spaces advance the pen but need no quad
+        if (c != ' ') {
+            run.vertices.resize(run.vertices.size() + 4);
+            emitGlyph(&run.vertices[run.vertices.size() - 4], static_cast<unsigned char>(c), penX, 0.0f, style);
+        }
+        penX += advance;
+    }
+    run.width = measureText(run.text.c_str(), style.scale);
+    run.height = getLineHeight(style.scale);
+    run.built = true;
+    return true;
+}
+
+
+// --- Drawing ---
+void BitmapFont::ensureQuadIndices(size_t quadCount) {
+    const size_t have = quadIndices_.size() / 6;
+    if (have >= quadCount) return;
+    quadIndices_.reserve(quadCount * 6);
+    for (size_t q = have; q < quadCount; ++q) {
+        const int base = static_cast<int>(q * 4);
+        const int quad[6] = { base, base + 1, base + 2, base + 2, base + 1, base + 3 };
+        quadIndices_.insert(quadIndices_.end(), quad, quad + 6);
+    }
+}
+
+void BitmapFont::submit(PCDisplay* display, const SDL_Vertex* vertices, size_t quadCount, int x, int y) {
+    if (quadCount == 0) return;
+    ensureQuadIndices(quadCount);
+    const SDL_Vertex* source = vertices;
+    if (x != 0 || y != 0) {
+        // Runs are stored at the origin; translate into the reused scratch buffer
+        scratch_.resize(quadCount * 4);
+        const float dx = static_cast<float>(x);
+        const float dy = static_cast<float>(y);
+        for (size_t i = 0; i < quadCount * 4; ++i) {
+            scratch_[i] = vertices[i];
+            scratch_[i].position.x += dx;
+            scratch_[i].position.y += dy;
+        }
+        source = scratch_.data();
+    }
+    display->drawGeometry(atlas_, source, static_cast<int>(quadCount * 4), quadIndices_.data(), static_cast<int>(quadCount * 6));
+}
+
+void BitmapFont::drawRun(PCDisplay* display, const TextRun& run, int x, int y) {
+    if (!display || !atlas_ || !run.built) return;
+    submit(display, run.vertices.data(), run.vertices.size() / 4, x, y);
+}
+
+void BitmapFont::drawText(PCDisplay* display, const char* text, int x, int y, const TextStyle& style) {
+    if (!display || !atlas_ || !text || !*text) return;
+    const uint64_t key = hashRun(text, style);
+    auto it = runCache_.find(key);
+    if (it == runCache_.end()) {
+        // Screens show a bounded set of strings; a full reset is cheaper than LRU bookkeeping
+        if (runCache_.size() >= MAX_CACHED_RUNS || runCache_.size() == runCache_.max_size()) runCache_.clear();
+        runCache_.insert_or_assign(key, TextRun());
+        it = runCache_.find(key);
+    }
+    updateRun(it->second, text, style); // No-op on a hit; rebuilds on a hash collision
+    drawRun(display, it->second, x, y);
+}
+
+void BitmapFont::drawNumber(PCDisplay* display, long long value, int x, int y, const TextStyle& style) {
+    if (!display || !atlas_) return;
+    char digits[MAX_NUMBER_CHARS];
+    size_t count = 0;
+    // Work in the negative range so LLONG_MIN needs no special case
+    const bool negative = value < 0;
+    long long rest = negative ? value : -value;
+    do {
+        digits[count++] = static_cast<char>('0' - static_cast<int>(rest % 10));
+        rest /= 10;
+    } while (rest != 0 && count < MAX_NUMBER_CHARS - 1);
+    if (negative) digits[count++] = '-';
+
+    SDL_Vertex vertices[MAX_NUMBER_CHARS * 4];
+    const float advance = static_cast<float>(GLYPH_ADVANCE * style.scale);
+    float penX = static_cast<float>(x);
+    for (size_t i = 0; i < count; ++i) {
+        emitGlyph(&vertices[i * 4], static_cast<unsigned char>(digits[count - 1 - i]), penX, static_cast<float>(y), style);
+        penX += advance;
+    }
+    // Already in screen space, so this skips the scratch copy
+    display->drawGeometry(atlas_, vertices, static_cast<int>(count * 4), quadIndices_.data(), static_cast<int>(count * 6));
+}
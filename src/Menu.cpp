@@ -0,0 +1,286 @@
+// File: src/Menu.cpp
+
+#include "ui/Menu.h"                // Include own header
+#include "platform/pc/pc_display.h" // To draw
+#include <SDL_log.h>                // SDL logging
+#include <algorithm>                // std::sort, std::lower_bound, std::partition_point, std::copy
+#include <cctype>                   // std::tolower
+#include <cmath>                    // std::fabs
+#include <cstdio>                   // std::snprintf
+#include <cstring>                  // std::memcpy
+
+namespace {
+    const float SCROLL_RATE = 14.0f;      // Fraction of the remaining distance covered per second (x dt)
+    const float SCROLL_SNAP_PX = 0.5f;    // Close enough to stop easing
+    const char* const CURSOR_TEXT = ">";
+    static_assert(MAX_MENU_RESULTS >= MAX_MENU_ITEMS, "A full search must fit MenuList's result pool");
+
+    char toLowerAscii(char c) {
+        return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+
+    std::string toLowerAscii(const std::string& text) {
+        std::string lower(text);
+        for (char& c : lower) c = toLowerAscii(c);
+        return lower;
+    }
+
+    uint32_t packTrigram(const char* chars) {
+        return (static_cast<uint32_t>(static_cast<unsigned char>(chars[0])) << 16) |
+               (static_cast<uint32_t>(static_cast<unsigned char>(chars[1])) << 8) |
+                static_cast<uint32_t>(static_cast<unsigned char>(chars[2]));
+    }
+} // end anonymous namespace
+
+
+// --- MenuIndex ---
+MenuIndex::MenuIndex(std::vector<std::string> items) : items_(std::move(items)) {
+#if defined(DIGIVICE_NO_HEAP)
+    if (items_.size() > MAX_MENU_ITEMS) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "MenuIndex: %zu items; keeping the first %zu (MAX_MENU_ITEMS).", items_.size(), MAX_MENU_ITEMS);
+        items_.resize(MAX_MENU_ITEMS);
+    }
+#endif
+    const uint32_t count = static_cast<uint32_t>(items_.size());
+    lower_.reserve(count);
+    for (const std::string& item : items_) lower_.push_back(toLowerAscii(item));
+
+    sorted_.resize(count);
+    for (uint32_t id = 0; id < count; ++id) sorted_[id] = id;
+    std::sort(sorted_.begin(), sorted_.end(), [this](uint32_t a, uint32_t b) {
+        int order = lower_[a].compare(lower_[b]);
+        return order != 0 ? order < 0 : a < b;
+    });
+    rank_.resize(count);
+    for (uint32_t r = 0; r < count; ++r) rank_[sorted_[r]] = r;
+
+    std::vector<uint32_t> itemTrigrams;
+    for (uint32_t id = 0; id < count; ++id) {
+        const std::string& name = lower_[id];
+        if (name.size() < 3) continue;
+        itemTrigrams.clear();
+        for (size_t i = 0; i + 3 <= name.size(); ++i) itemTrigrams.push_back(packTrigram(name.data() + i));
+        std::sort(itemTrigrams.begin(), itemTrigrams.end());
+        itemTrigrams.erase(std::unique(itemTrigrams.begin(), itemTrigrams.end()), itemTrigrams.end());
+        for (uint32_t trigram : itemTrigrams) trigrams_.push_back({ trigram, id });
+    }
+    std::sort(trigrams_.begin(), trigrams_.end());
+    SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "MenuIndex: Indexed %u items (%zu trigram postings).", count, trigrams_.size());
+}
+
+bool MenuIndex::isPrefixOf(std::string_view lowerQuery, uint32_t id) const {
+    return lower_[id].compare(0, lowerQuery.size(), lowerQuery) == 0;
+}
+
+void MenuIndex::sortByRank(uint32_t* first, uint32_t* last) const {
+    std::sort(first, last, [this](uint32_t a, uint32_t b) { return rank_[a] < rank_[b]; });
+}
+
+size_t MenuIndex::search(std::string_view lowerQuery, uint32_t* out) const {
+    const size_t n = lowerQuery.size();
+    if (n == 0) return 0;
+
+    // Prefix matches: one contiguous range of the sorted ids
+    auto first = std::lower_bound(sorted_.begin(), sorted_.end(), lowerQuery,
+                                  [this](uint32_t id, std::string_view q) { return std::string_view(lower_[id]) < q; });
+    auto last = std::partition_point(first, sorted_.end(),
+                                     [this, lowerQuery, n](uint32_t id) { return lower_[id].compare(0, n, lowerQuery) <= 0; });
+    uint32_t* end = std::copy(first, last, out);
+
+    // Other substring matches
+    uint32_t* const substringStart = end;
+    if (n >= 3) {
+        // Only items containing every trigram can match; the rarest one gives the fewest candidates
+        auto bestFirst = trigrams_.end(), bestLast = trigrams_.end();
+        size_t bestCount = static_cast<size_t>(-1);
+        for (size_t i = 0; i + 3 <= n; ++i) {
+            const uint32_t trigram = packTrigram(lowerQuery.data() + i);
+            auto lo = std::lower_bound(trigrams_.begin(), trigrams_.end(), trigram, [](const Posting& p, uint32_t t) { return p.trigram < t; });
+            auto hi = std::upper_bound(lo, trigrams_.end(), trigram, [](uint32_t t, const Posting& p) { return t < p.trigram; });
+            const size_t count = static_cast<size_t>(hi - lo);
+            if (count < bestCount) { bestCount = count; bestFirst = lo; bestLast = hi; }
+            if (count == 0) break;
+        }
+        for (auto it = bestFirst; it != bestLast; ++it) {
+            if (!isPrefixOf(lowerQuery, it->id) && lower_[it->id].find(lowerQuery) != std::string::npos) *end++ = it->id;
+        }
+        sortByRank(substringStart, end);
+    } else {
+        // Too short for trigrams; a scan in sorted order is cheap and already ranked
+        for (uint32_t id : sorted_) {
+            if (!isPrefixOf(lowerQuery, id) && lower_[id].find(lowerQuery) != std::string::npos) *end++ = id;
+        }
+    }
+    return static_cast<size_t>(end - out);
+}
+
+size_t MenuIndex::narrow(const uint32_t* previous, size_t count, std::string_view lowerQuery, uint32_t* out) const {
+    // New prefix matches all come from the old prefix group, which is already sorted.
+    // Substring matches fill 'out' from the back until the prefix count is known.
+    uint32_t* prefixEnd = out;
+    uint32_t* substringFirst = out + count;
+    for (size_t i = 0; i < count; ++i) {
+        const uint32_t id = previous[i];
+        if (isPrefixOf(lowerQuery, id)) *prefixEnd++ = id;
+        else if (lower_[id].find(lowerQuery) != std::string::npos) *--substringFirst = id;
+    }
+    // ...but substring matches can come from both old groups
+    uint32_t* end = prefixEnd + (out + count - substringFirst);
+    if (prefixEnd != substringFirst) std::copy(substringFirst, out + count, prefixEnd);
+    sortByRank(prefixEnd, end);
+    return static_cast<size_t>(end - out);
+}
+
+
+// --- MenuList ---
+MenuList::MenuList(std::shared_ptr<const MenuIndex> index) : index_(std::move(index)) {
+    if (!index_) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "MenuList: Created without an index; using an empty list.");
+        static const MenuIndex emptyIndex{ std::vector<std::string>() };
+        index_ = std::shared_ptr<const MenuIndex>(std::shared_ptr<const MenuIndex>(), &emptyIndex); // Non-owning: no control block
+    }
+}
+
+void MenuList::setFilter(const char* query) {
+    displayFilter_.assign(query);
+    char lower[MAX_MENU_FILTER_LENGTH + 1];
+    size_t length = 0;
+    for (const char* c = displayFilter_.c_str(); *c; ++c) lower[length++] = toLowerAscii(*c);
+    lower[length] = '\0';
+    const std::string_view lowerQuery(lower, length);
+
+    // Drop levels the new query no longer extends (backspace, or an edited query)
+    const std::string_view previous(lowerFilter_.c_str());
+    while (!filterStack_.empty()) {
+        const FilterLevel& top = filterStack_.back();
+        if (lowerQuery.substr(0, top.queryLength) == previous.substr(0, top.queryLength)) break;
+        results_.resize(top.first);
+        filterStack_.pop_back();
+    }
+    if (length > 0 && (filterStack_.empty() || filterStack_.back().queryLength != length)) pushFilterLevel(lowerQuery);
+    lowerFilter_.assign(lower);
+
+    selectedRow_ = 0;
+    scrollToSelection();
+    snapScroll();
+}
+
+// Searches the index, or narrows the top level, into the end of the pool
+void MenuList::pushFilterLevel(std::string_view lowerQuery) {
+    size_t room = filterStack_.empty() ? index_->size() : filterStack_.back().count;
+    if (results_.size() + room > results_.max_size()) {
+        // Pool full (no-heap builds): start over from a full search, which always fits
+        filterStack_.clear();
+        results_.clear();
+        room = index_->size();
+    }
+    const size_t first = results_.size();
+    results_.resize(first + room);
+    uint32_t* out = results_.data() + first;
+    const size_t count = filterStack_.empty()
+        ? index_->search(lowerQuery, out)
+        : index_->narrow(results_.data() + filterStack_.back().first, filterStack_.back().count, lowerQuery, out);
+    results_.resize(first + count);
+    filterStack_.push_back({ lowerQuery.size(), first, count });
+}
+
+void MenuList::appendToFilter(const char* text) {
+    char combined[MAX_MENU_FILTER_LENGTH + 1];
+    std::snprintf(combined, sizeof(combined), "%s%s", displayFilter_.c_str(), text ? text : ""); // Cut to the limit
+    setFilter(combined);
+}
+
+void MenuList::popFilterChar() {
+    const size_t length = displayFilter_.size();
+    if (length == 0) return;
+    char shorter[MAX_MENU_FILTER_LENGTH + 1];
+    std::memcpy(shorter, displayFilter_.c_str(), length - 1);
+    shorter[length - 1] = '\0';
+    setFilter(shorter);
+}
+
+size_t MenuList::getRowCount() const {
+    return filterStack_.empty() ? index_->size() : filterStack_.back().count;
+}
+
+size_t MenuList::getItemAtRow(size_t row) const {
+    return filterStack_.empty() ? row : results_[filterStack_.back().first + row];
+}
+
+const std::string* MenuList::getSelectedItem() const {
+    if (selectedRow_ >= getRowCount()) return nullptr;
+    return &index_->getItem(static_cast<uint32_t>(getItemAtRow(selectedRow_)));
+}
+
+void MenuList::moveSelection(int delta) {
+    const size_t count = getRowCount();
+    if (count == 0) return;
+    const long long wrapped = (static_cast<long long>(selectedRow_) + delta % static_cast<long long>(count) + static_cast<long long>(count)) % static_cast<long long>(count);
+    selectedRow_ = static_cast<size_t>(wrapped);
+    scrollToSelection();
+}
+
+void MenuList::clampSelection() {
+    const size_t count = getRowCount();
+    if (selectedRow_ >= count) selectedRow_ = count > 0 ? count - 1 : 0;
+}
+
+
+// --- Viewport ---
+void MenuList::setViewport(const SDL_Rect& area, int rowHeight) {
+    viewport_ = area;
+    rowHeight_ = rowHeight > 0 ? rowHeight : 1;
+    clampSelection();
+    scrollToSelection();
+    snapScroll();
+}
+
+void MenuList::scrollToSelection() {
+    const float rowTop = static_cast<float>(selectedRow_) * rowHeight_;
+    const float viewH = static_cast<float>(viewport_.h);
+    if (rowTop < targetScrollY_) targetScrollY_ = rowTop;
+    if (rowTop + rowHeight_ > targetScrollY_ + viewH) targetScrollY_ = rowTop + rowHeight_ - viewH;
+    const float maxScroll = std::max(0.0f, static_cast<float>(getRowCount()) * rowHeight_ - viewH);
+    targetScrollY_ = std::min(std::max(targetScrollY_, 0.0f), maxScroll);
+}
+
+void MenuList::update(float delta_time) {
+    const float remaining = targetScrollY_ - scrollY_;
+    if (std::fabs(remaining) < SCROLL_SNAP_PX) { scrollY_ = targetScrollY_; return; }
+    scrollY_ += remaining * std::min(1.0f, delta_time * SCROLL_RATE);
+}
+
+void MenuList::snapScroll() {
+    scrollY_ = targetScrollY_;
+}
+
+size_t MenuList::getFirstVisibleRow() const {
+    const size_t first = static_cast<size_t>(std::max(0.0f, scrollY_) / rowHeight_);
+    return std::min(first, getRowCount());
+}
+
+size_t MenuList::getVisibleRowCount() const {
+    // One extra row covers the partially visible row at the bottom while scrolling
+    const size_t fit = static_cast<size_t>(viewport_.h / rowHeight_) + 2;
+    return std::min(fit, getRowCount() - getFirstVisibleRow());
+}
+
+void MenuList::render(PCDisplay* display, BitmapFont* font, const TextStyle& style, const TextStyle& selectedStyle) const {
+    if (!display || !font || !font->isLoaded()) return;
+    const int textX = viewport_.x + font->getGlyphAdvance(selectedStyle.scale) * 2; // Room for the cursor
+    const size_t first = getFirstVisibleRow();
+    const size_t last = first + getVisibleRowCount();
+
+    display->setClipRect(&viewport_);
+    for (size_t row = first; row < last; ++row) {
+        const int y = viewport_.y + static_cast<int>(static_cast<float>(row) * rowHeight_ - scrollY_);
+        const std::string& item = index_->getItem(static_cast<uint32_t>(getItemAtRow(row)));
+        if (row == selectedRow_) {
+            font->drawText(display, CURSOR_TEXT, viewport_.x, y, selectedStyle);
+            font->drawText(display, item.c_str(), textX, y, selectedStyle);
+        } else {
+            font->drawText(display, item.c_str(), textX, y, style);
+        }
+    }
+    display->setClipRect(nullptr);
+}
@@ -0,0 +1,344 @@
+// File: src/Widget.cpp
+
+#include "ui/Widget.h"              // Include own header
+#include "platform/pc/pc_display.h" // To draw
+#include <SDL_log.h>                // SDL logging
+#include <algorithm>                // std::max
+
+// --- Widget: Tree ---
+bool Widget::addChild(Widget& child) {
+    if (child.parent_ || &child == this) { SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Widget::addChild: Child already in a tree; ignored."); return false; }
+    if (children_.size() == children_.max_size()) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Widget::addChild: More than %zu children (MAX_WIDGET_CHILDREN).", children_.max_size()); return false; }
+    child.parent_ = this;
+    children_.push_back(&child);
+    markLayoutDirty();
+    return true;
+}
+
+void Widget::clearChildren() {
+    for (Widget* child : children_) child->parent_ = nullptr;
+    children_.clear();
+    markLayoutDirty();
+}
+
+
+// --- Widget: Layout Inputs ---
+void Widget::setPosition(int x, int y) {
+    if (position_.x == x && position_.y == y) return;
+    position_ = { x, y };
+    markLayoutDirty();
+}
+
+void Widget::setFixedSize(int w, int h) {
+    if (fixedSize_.x == w && fixedSize_.y == h) return;
+    fixedSize_ = { w, h };
+    markLayoutDirty();
+}
+
+void Widget::setFlex(bool flex) {
+    if (flex_ == flex) return;
+    flex_ = flex;
+    markLayoutDirty();
+}
+
+void Widget::setVisible(bool visible) {
+    if (visible_ == visible) return;
+    visible_ = visible;
+    // arrange() and render() skip hidden subtrees, so this widget may still be dirty
+    // under clean ancestors; walk the whole chain instead of stopping early
+    for (Widget* w = this; w; w = w->parent_) {
+        w->layoutDirty_ = true;
+        w->renderDirty_ = true;
+    }
+}
+
+
+// --- Widget: Layout ---
+void Widget::markLayoutDirty() {
+    // A widget's preferred size feeds its parent's, so dirtiness runs up to the root
+    for (Widget* w = this; w && !w->layoutDirty_; w = w->parent_) w->layoutDirty_ = true;
+    markRenderDirty();
+}
+
+void Widget::markRenderDirty() {
+    // Invariant: a dirty widget's ancestors are already dirty, so we can stop early.
+    // Hidden subtrees are the exception; setVisible() re-marks the full chain.
+    for (Widget* w = this; w && !w->renderDirty_; w = w->parent_) w->renderDirty_ = true;
+}
+
+SDL_Point Widget::getPreferredSize() {
+    if (layoutDirty_) {
+        const SDL_Point content = measure();
+        preferred_.x = fixedSize_.x > 0 ? fixedSize_.x : content.x;
+        preferred_.y = fixedSize_.y > 0 ? fixedSize_.y : content.y;
+    }
+    return preferred_;
+}
+
+SDL_Point Widget::measure() {
+    return { 0, 0 };
+}
+
+void Widget::layout(const SDL_Rect& rect) {
+    const bool moved = rect.x != rect_.x || rect.y != rect_.y || rect.w != rect_.w || rect.h != rect_.h;
+    if (!layoutDirty_ && !moved) return;
+    getPreferredSize(); // Refresh while still flagged dirty
+    rect_ = rect;
+    arrange(rect_);
+    layoutDirty_ = false;
+    if (moved) markRenderDirty();
+}
+
+
+// --- Widget: Per Frame ---
+void Widget::update(float delta_time) {
+    for (Widget* child : children_) {
+        if (child->visible_) child->update(delta_time);
+    }
+}
+
+void Widget::render(PCDisplay* display, int offsetX, int offsetY) {
+    if (!display || !visible_) return;
+    // Only the root lays itself out; children were placed by their parent's arrange()
+    if (!parent_ && layoutDirty_) {
+        const SDL_Point size = getPreferredSize();
+        layout({ position_.x, position_.y, size.x, size.y });
+    }
+    draw(display, offsetX, offsetY);
+    renderDirty_ = false;
+}
+
+void Widget::draw(PCDisplay* display, int offsetX, int offsetY) {
+    drawChildren(display, offsetX, offsetY);
+}
+
+void Widget::drawChildren(PCDisplay* display, int offsetX, int offsetY) {
+    for (Widget* child : children_) child->render(display, offsetX, offsetY);
+}
+
+
+// --- Panel ---
+Panel::Panel(LayoutDirection direction) : direction_(direction) {}
+
+Panel::~Panel() {
+    if (cacheTexture_) SDL_DestroyTexture(cacheTexture_);
+}
+
+void Panel::setDirection(LayoutDirection direction) { if (direction_ != direction) { direction_ = direction; markLayoutDirty(); } }
+void Panel::setPadding(int padding) { if (padding_ != padding) { padding_ = padding; markLayoutDirty(); } }
+void Panel::setSpacing(int spacing) { if (spacing_ != spacing) { spacing_ = spacing; markLayoutDirty(); } }
+
+void Panel::setBackground(SDL_Color color) {
+    background_ = color;
+    markRenderDirty();
+}
+
+void Panel::setCached(bool cached) {
+    cached_ = cached;
+    cacheValid_ = false;
+    markRenderDirty();
+}
+
+SDL_Point Panel::measure() {
+    SDL_Point size = { 0, 0 };
+    int visibleCount = 0;
+    for (Widget* child : children_) {
+        if (!child->isVisible()) continue;
+        const SDL_Point childSize = child->getPreferredSize();
+        if (direction_ == LayoutDirection::VERTICAL) {
+            size.x = std::max(size.x, childSize.x);
+            size.y += childSize.y;
+        } else if (direction_ == LayoutDirection::HORIZONTAL) {
+            size.x += childSize.x;
+            size.y = std::max(size.y, childSize.y);
+        } else {
+            size.x = std::max(size.x, child->getPosition().x + childSize.x);
+            size.y = std::max(size.y, child->getPosition().y + childSize.y);
+        }
+        ++visibleCount;
+    }
+    if (direction_ != LayoutDirection::NONE && visibleCount > 1) {
+        (direction_ == LayoutDirection::VERTICAL ? size.y : size.x) += spacing_ * (visibleCount - 1);
+    }
+    size.x += padding_ * 2;
+    size.y += padding_ * 2;
+    return size;
+}
+
+void Panel::arrange(const SDL_Rect& rect) {
+    const SDL_Rect content = { rect.x + padding_, rect.y + padding_, std::max(0, rect.w - padding_ * 2), std::max(0, rect.h - padding_ * 2) };
+
+    if (direction_ == LayoutDirection::NONE) {
+        for (Widget* child : children_) {
+            if (!child->isVisible()) continue;
+            const SDL_Point size = child->getPreferredSize();
+            child->layout({ content.x + child->getPosition().x, content.y + child->getPosition().y, size.x, size.y });
+        }
+        return;
+    }
+
+    // Fixed children take their preferred length; flex children split what is left
+    const bool vertical = direction_ == LayoutDirection::VERTICAL;
+    int fixedLength = 0;
+    int flexCount = 0;
+    int visibleCount = 0;
+    for (Widget* child : children_) {
+        if (!child->isVisible()) continue;
+        ++visibleCount;
+        if (child->isFlex()) { ++flexCount; continue; }
+        const SDL_Point size = child->getPreferredSize();
+        fixedLength += vertical ? size.y : size.x;
+    }
+    const int mainLength = vertical ? content.h : content.w;
+    const int leftover = std::max(0, mainLength - fixedLength - spacing_ * std::max(0, visibleCount - 1));
+
+    int cursor = vertical ? content.y : content.x;
+    int flexIndex = 0;
+    for (Widget* child : children_) {
+        if (!child->isVisible()) continue;
+        int length;
+        if (child->isFlex()) {
+            // Hand the rounding remainder to the last flex child
+            length = leftover / flexCount + ((++flexIndex == flexCount) ? leftover % flexCount : 0);
+        } else {
+            const SDL_Point size = child->getPreferredSize();
+            length = vertical ? size.y : size.x;
+        }
+        if (vertical) child->layout({ content.x, cursor, content.w, length });
+        else          child->layout({ cursor, content.y, length, content.h });
+        cursor += length + spacing_;
+    }
+}
+
+bool Panel::redrawCache(PCDisplay* display) {
+    const SDL_Rect& rect = getRect();
+    if (!cacheTexture_ || cacheW_ != rect.w || cacheH_ != rect.h) {
+        if (cacheTexture_) SDL_DestroyTexture(cacheTexture_);
+        cacheTexture_ = display->createRenderTarget(rect.w, rect.h);
+        cacheW_ = rect.w;
+        cacheH_ = rect.h;
+        if (!cacheTexture_) return false;
+    }
+
+    SDL_Texture* previousTarget = display->getRenderTarget();
+    if (!display->setRenderTarget(cacheTexture_)) return false;
+    display->fillRect(nullptr, { 0, 0, 0, 0 }, false);    // Clear to transparent
+    // Draw as if the panel sat at the texture origin
+    if (background_.a > 0) display->fillRect(nullptr, background_, false);
+    drawChildren(display, -rect.x, -rect.y);
+    display->setRenderTarget(previousTarget);
+    cacheValid_ = true;
+    return true;
+}
+
+void Panel::draw(PCDisplay* display, int offsetX, int offsetY) {
+    const SDL_Rect& rect = getRect();
+    if (rect.w <= 0 || rect.h <= 0) return;
+    SDL_Rect dst = { rect.x + offsetX, rect.y + offsetY, rect.w, rect.h };
+
+    if (cached_ && display->supportsRenderTargets()) {
+        // Rebuild only when something underneath changed (or the size did)
+        bool ready = cacheValid_ && !isRenderDirty();
+        if (!ready) ready = redrawCache(display);
+        if (ready) {
+            display->drawTexture(cacheTexture_, nullptr, &dst);
+            return;
+        }
+        SDL_LogWarn(SDL_LOG_CATEGORY_RENDER, "Panel: Render target unavailable, drawing uncached.");
+        cached_ = false;
+    }
+
+    if (background_.a > 0) display->fillRect(&dst, background_, background_.a < 255);
+    drawChildren(display, offsetX, offsetY);
+}
+
+
+// --- Label ---
+Label::Label(BitmapFont* font, const char* text, const TextStyle& style) : font_(font) {
+    if (font_) font_->updateRun(run_, text, style);
+    else { run_.text.assign(text ? text : ""); run_.style = style; }
+}
+
+void Label::setText(const char* text) {
+    if (!font_ || !font_->updateRun(run_, text, run_.style)) return;
+    markLayoutDirty(); // Width may have changed
+}
+
+void Label::setStyle(const TextStyle& style) {
+    if (!font_) { run_.style = style; return; }
+    if (font_->updateRun(run_, run_.text.c_str(), style)) markLayoutDirty();
+}
+
+SDL_Point Label::measure() {
+    return { run_.width, run_.height };
+}
+
+void Label::draw(PCDisplay* display, int offsetX, int offsetY) {
+    if (!font_) return;
+    const SDL_Rect& rect = getRect();
+    font_->drawRun(display, run_, rect.x + offsetX, rect.y + offsetY);
+}
+
+
+// --- ListWidget ---
+ListWidget::ListWidget(BitmapFont* font, std::shared_ptr<const MenuIndex> index, int rowHeight) :
+    font_(font),
+    list_(std::move(index)),
+    rowHeight_(rowHeight)
+{
+    setFlex(true);
+}
+
+void ListWidget::setStyles(const TextStyle& style, const TextStyle& selectedStyle) {
+    style_ = style;
+    selectedStyle_ = selectedStyle;
+    markRenderDirty();
+}
+
+void ListWidget::update(float delta_time) {
+    // Scrolling, selection and filtering change pixels without changing layout
+    if (list_.isScrolling() || list_.getSelectedRow() != lastSelectedRow_ || list_.getRowCount() != lastRowCount_) {
+        markRenderDirty();
+        lastSelectedRow_ = list_.getSelectedRow();
+        lastRowCount_ = list_.getRowCount();
+    }
+    list_.update(delta_time);
+}
+
+void ListWidget::arrange(const SDL_Rect& rect) {
+    list_.setViewport(rect, rowHeight_);
+}
+
+void ListWidget::draw(PCDisplay* display, int offsetX, int offsetY) {
+    const SDL_Rect& rect = getRect();
+    list_.moveViewport(rect.x + offsetX, rect.y + offsetY);
+    list_.render(display, font_, style_, selectedStyle_);
+}
+
+
+// --- Icon ---
+Icon::Icon(SDL_Texture* texture, const SDL_Rect& srcRect, int scale) :
+    texture_(texture),
+    srcRect_(srcRect),
+    scale_(scale > 0 ? scale : 1)
+{
+}
+
+void Icon::setImage(SDL_Texture* texture, const SDL_Rect& srcRect) {
+    const bool resized = srcRect.w != srcRect_.w || srcRect.h != srcRect_.h;
+    texture_ = texture;
+    srcRect_ = srcRect;
+    if (resized) markLayoutDirty();
+    else markRenderDirty();
+}
+
+SDL_Point Icon::measure() {
+    return { srcRect_.w * scale_, srcRect_.h * scale_ };
+}
+
+void Icon::draw(PCDisplay* display, int offsetX, int offsetY) {
+    if (!texture_) return;
+    const SDL_Rect& rect = getRect();
+    SDL_Rect dst = { rect.x + offsetX, rect.y + offsetY, srcRect_.w * scale_, srcRect_.h * scale_ };
+    display->drawTexture(texture_, &srcRect_, &dst);
+}
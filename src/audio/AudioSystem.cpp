@@ -0,0 +1,243 @@
+// File: src/audio/AudioSystem.cpp
+
+#include "audio/AudioSystem.h" // Include own header
+#include <SDL_log.h>
+#include <cstring>
+
+namespace {
+    const int32_t UNITY_GAIN = 32768; // Q15
+    const int32_t SAMPLE_MIN = -32768;
+    const int32_t SAMPLE_MAX = 32767;
+
+    int32_t toGain(float gain) {
+        if (gain <= 0.0f) return 0;
+        if (gain >= 1.0f) return UNITY_GAIN;
+        return static_cast<int32_t>(gain * UNITY_GAIN + 0.5f);
+    }
+
+    void storeMax(std::atomic<uint64_t>& target, uint64_t value) {
+        uint64_t current = target.load(std::memory_order_relaxed);
+        while (value > current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+    }
+} // end anonymous namespace
+
+
+// --- AudioMixer ---
+void AudioMixer::apply(const AudioCommand& command) {
+    switch (command.type) {
+    case AudioCommand::PLAY: {
+        if (!command.samples || command.frames == 0) return;
+        Voice* voice = nullptr;
+        if (voiceCount_ < MAX_VOICES) {
+            voice = &voices_[voiceCount_++];
+        } else {
+            // Full: the voice closest to its end is the least missed
+            voice = &voices_[0];
+            for (size_t i = 1; i < voiceCount_; ++i) {
+                if (voices_[i].frames - voices_[i].position < voice->frames - voice->position) voice = &voices_[i];
+            }
+            ++stolenVoices_;
+        }
+        voice->id = command.voice;
+        voice->samples = command.samples;
+        voice->frames = command.frames;
+        voice->position = 0;
+        voice->gainLeft = command.gainLeft;
+        voice->gainRight = command.gainRight;
+        break;
+    }
+    case AudioCommand::STOP:
+        for (size_t i = 0; i < voiceCount_; ++i) {
+            if (voices_[i].id != command.voice) continue;
+            voices_[i] = voices_[--voiceCount_];
+            break;
+        }
+        break;
+    case AudioCommand::STOP_ALL:
+        voiceCount_ = 0;
+        break;
+    }
+}
+
+void AudioMixer::mix(int16_t* out, size_t frames) {
+    while (frames > 0) {
+        const size_t block = frames < MAX_BLOCK_FRAMES ? frames : MAX_BLOCK_FRAMES;
+        mixBlock(out, block);
+        out += block * AUDIO_OUTPUT_CHANNELS;
+        frames -= block;
+    }
+}
+
+void AudioMixer::mixBlock(int16_t* out, size_t frames) {
+    if (voiceCount_ == 0) {
+        std::memset(out, 0, frames * AUDIO_OUTPUT_CHANNELS * sizeof(int16_t));
+        return;
+    }
+    std::memset(left_, 0, frames * sizeof(int32_t));
+    std::memset(right_, 0, frames * sizeof(int32_t));
+    for (size_t i = 0; i < voiceCount_;) {
+        Voice& voice = voices_[i];
+        const uint32_t remaining = voice.frames - voice.position;
+        const size_t count = remaining < frames ? remaining : frames;
+        accumulate(left_, right_, voice.samples + voice.position, count, voice.gainLeft, voice.gainRight);
+        voice.position += static_cast<uint32_t>(count);
+        if (voice.position >= voice.frames) voices_[i] = voices_[--voiceCount_]; // Finished
+        else ++i;
+    }
+    saturate(left_, right_, out, frames);
+}
+
+void AudioMixer::accumulate(int32_t* left, int32_t* right, const int16_t* src, size_t frames, int32_t gainLeft, int32_t gainRight) {
+    for (size_t i = 0; i < frames; ++i) {
+        const int32_t sample = src[i];
+        left[i] += (sample * gainLeft) >> 15;
+        right[i] += (sample * gainRight) >> 15;
+    }
+}
+
+// Clipping, not wrapping, when loud voices overlap
+void AudioMixer::saturate(const int32_t* left, const int32_t* right, int16_t* out, size_t frames) {
+    for (size_t i = 0; i < frames; ++i) {
+        const int32_t l = left[i] < SAMPLE_MIN ? SAMPLE_MIN : (left[i] > SAMPLE_MAX ? SAMPLE_MAX : left[i]);
+        const int32_t r = right[i] < SAMPLE_MIN ? SAMPLE_MIN : (right[i] > SAMPLE_MAX ? SAMPLE_MAX : right[i]);
+        out[2 * i] = static_cast<int16_t>(l);
+        out[2 * i + 1] = static_cast<int16_t>(r);
+    }
+}
+
+
+// --- AudioSystem ---
+AudioSystem::~AudioSystem() {
+    shutdown();
+}
+
+bool AudioSystem::init(int bufferFrames) {
+    shutdown();
+    if (SDL_InitSubSystem(SDL_INIT_AUDIO) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_AUDIO, "Audio subsystem init failed: %s", SDL_GetError());
+        return false;
+    }
+    subsystemStarted_ = true;
+
+    SDL_AudioSpec desired;
+    SDL_zero(desired);
+    desired.freq = AUDIO_SAMPLE_RATE;
+    desired.format = AUDIO_S16SYS;
+    desired.channels = AUDIO_OUTPUT_CHANNELS;
+    desired.samples = static_cast<Uint16>(bufferFrames > 0 ? bufferFrames : DEFAULT_BUFFER_FRAMES);
+    desired.callback = &AudioSystem::audioCallback;
+    desired.userdata = this;
+    SDL_AudioSpec obtained;
+    // Only the buffer size may change; SDL converts anything else behind the callback
+    device_ = SDL_OpenAudioDevice(nullptr, 0, &desired, &obtained, SDL_AUDIO_ALLOW_SAMPLES_CHANGE);
+    if (device_ == 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_AUDIO, "Could not open audio device: %s", SDL_GetError());
+        shutdown();
+        return false;
+    }
+    bufferFrames_ = obtained.samples;
+
+    AudioCommand stale;
+    while (queue_.pop(stale)) {} // Commands left over from a previous device
+    mixer_.apply(AudioCommand{ AudioCommand::STOP_ALL });
+    lastCallbackAt_ = 0;
+    SDL_PauseAudioDevice(device_, 0);
+    SDL_LogInfo(SDL_LOG_CATEGORY_AUDIO, "Audio: '%s' driver, %d Hz, %d-frame buffer (%.1f ms).",
+                SDL_GetCurrentAudioDriver(), AUDIO_SAMPLE_RATE, bufferFrames_, bufferFrames_ * 1000.0 / AUDIO_SAMPLE_RATE);
+    return true;
+}
+
+void AudioSystem::shutdown() {
+    if (device_ != 0) { SDL_CloseAudioDevice(device_); device_ = 0; } // Joins the audio thread
+    if (subsystemStarted_) { SDL_QuitSubSystem(SDL_INIT_AUDIO); subsystemStarted_ = false; }
+}
+
+// --- Producer ---
+AudioVoiceId AudioSystem::play(const SoundClip* clip, float volume, float pan) {
+    if (!clip || !clip->samples || device_ == 0) return 0;
+    if (pan < -1.0f) pan = -1.0f;
+    if (pan > 1.0f) pan = 1.0f;
+    AudioCommand command;
+    command.type = AudioCommand::PLAY;
+    command.voice = nextVoice_++;
+    command.samples = clip->samples;
+    command.frames = clip->frames;
+    command.gainLeft = toGain(volume * (pan > 0.0f ? 1.0f - pan : 1.0f));
+    command.gainRight = toGain(volume * (pan < 0.0f ? 1.0f + pan : 1.0f));
+    command.issuedAt = SDL_GetPerformanceCounter();
+    return pushCommand(command) ? command.voice : 0;
+}
+
+void AudioSystem::stop(AudioVoiceId voice) {
+    if (voice == 0 || device_ == 0) return;
+    AudioCommand command;
+    command.type = AudioCommand::STOP;
+    command.voice = voice;
+    pushCommand(command);
+}
+
+void AudioSystem::stopAll() {
+    if (device_ == 0) return;
+    AudioCommand command;
+    command.type = AudioCommand::STOP_ALL;
+    pushCommand(command);
+}
+
+// A full queue means the device has stopped calling back; dropping is better than waiting
+bool AudioSystem::pushCommand(const AudioCommand& command) {
+    if (queue_.push(command)) return true;
+    droppedCommands_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+// --- Audio Thread ---
+void SDLCALL AudioSystem::audioCallback(void* userdata, Uint8* stream, int len) {
+    AudioSystem* self = static_cast<AudioSystem*>(userdata);
+    const size_t frames = static_cast<size_t>(len) / (sizeof(int16_t) * AUDIO_OUTPUT_CHANNELS);
+    self->renderAudio(reinterpret_cast<int16_t*>(stream), frames);
+}
+
+void AudioSystem::renderAudio(int16_t* out, size_t frames) {
+    const uint64_t start = SDL_GetPerformanceCounter();
+    const uint64_t frequency = SDL_GetPerformanceFrequency();
+    if (lastCallbackAt_ != 0) {
+        const uint64_t period = frequency * frames / AUDIO_SAMPLE_RATE;
+        if (start - lastCallbackAt_ > period + period / 2) underruns_.fetch_add(1, std::memory_order_relaxed);
+    }
+    lastCallbackAt_ = start;
+
+    size_t count;
+    while ((count = queue_.popMany(commandBatch_, COMMAND_BATCH)) > 0) {
+        // Stamped after the pop: commands pushed since 'start' would otherwise underflow
+        const uint64_t poppedAt = SDL_GetPerformanceCounter();
+        for (size_t i = 0; i < count; ++i) {
+            const AudioCommand& command = commandBatch_[i];
+            mixer_.apply(command);
+            if (command.type != AudioCommand::PLAY) continue;
+            const uint64_t latency = poppedAt > command.issuedAt ? poppedAt - command.issuedAt : 0; // Counters may disagree across cores
+            latencyTotal_.fetch_add(latency, std::memory_order_relaxed);
+            latencyCount_.fetch_add(1, std::memory_order_relaxed);
+            storeMax(latencyMax_, latency);
+        }
+    }
+    mixer_.mix(out, frames);
+
+    stolenVoices_.store(mixer_.getStolenVoices(), std::memory_order_relaxed);
+    callbacks_.fetch_add(1, std::memory_order_relaxed);
+    storeMax(mixMax_, SDL_GetPerformanceCounter() - start);
+}
+
+AudioStats AudioSystem::getStats() const {
+    const double msPerTick = 1000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+    AudioStats stats;
+    stats.bufferMs = bufferFrames_ * 1000.0 / AUDIO_SAMPLE_RATE;
+    const uint64_t latencyCount = latencyCount_.load(std::memory_order_relaxed);
+    if (latencyCount > 0) stats.avgLatencyMs = latencyTotal_.load(std::memory_order_relaxed) * msPerTick / latencyCount;
+    stats.maxLatencyMs = latencyMax_.load(std::memory_order_relaxed) * msPerTick;
+    stats.maxMixMs = mixMax_.load(std::memory_order_relaxed) * msPerTick;
+    stats.callbacks = callbacks_.load(std::memory_order_relaxed);
+    stats.underruns = underruns_.load(std::memory_order_relaxed);
+    stats.droppedCommands = droppedCommands_.load(std::memory_order_relaxed);
+    stats.stolenVoices = stolenVoices_.load(std::memory_order_relaxed);
+    return stats;
+}
@@ -0,0 +1,130 @@
+// File: src/core/AllocTracker.cpp
+
+#include "core/AllocTracker.h" // Include own header
+#include <cstdlib>             // std::malloc / std::free
+#include <new>                 // std::bad_alloc, std::nothrow_t
+
+namespace {
+    const char* const PHASE_NAMES[] = { "outside", "events", "input", "update", "state_changes", "render", "loading" };
+    static_assert(sizeof(PHASE_NAMES) / sizeof(PHASE_NAMES[0]) == static_cast<size_t>(FramePhase::COUNT), "PHASE_NAMES out of sync with FramePhase");
+
+#ifdef DIGIVICE_TRACK_ALLOCATIONS
+    // Per thread: the frame thread and any thread inside beginJob()/endJob() count;
+    // the rest (e.g. the tile decoder) see g_isTracking == false
+    thread_local bool g_isTracking = false;
+    thread_local FramePhase g_phase = FramePhase::OUTSIDE_FRAME;
+    thread_local FrameAllocStats g_stats;
+    // What beginJob() interrupted, put back by endJob()
+    thread_local bool g_savedTracking = false;
+    thread_local FramePhase g_savedPhase = FramePhase::OUTSIDE_FRAME;
+    thread_local FrameAllocStats g_savedStats;
+
+    void recordAllocation(size_t bytes) {
+        if (!g_isTracking) return;
+        const size_t phase = static_cast<size_t>(g_phase);
+        ++g_stats.count[phase];
+        g_stats.bytes[phase] += bytes;
+    }
+
+    void* trackedAlloc(size_t bytes) {
+        recordAllocation(bytes);
+        return std::malloc(bytes ? bytes : 1);
+    }
+#endif
+} // end anonymous namespace
+
+
+uint32_t FrameAllocStats::totalCount() const {
+    uint32_t total = 0;
+    for (uint32_t c : count) total += c;
+    return total;
+}
+
+size_t FrameAllocStats::totalBytes() const {
+    size_t total = 0;
+    for (size_t b : bytes) total += b;
+    return total;
+}
+
+const char* AllocTracker::getPhaseName(FramePhase phase) {
+    const size_t index = static_cast<size_t>(phase);
+    return index < static_cast<size_t>(FramePhase::COUNT) ? PHASE_NAMES[index] : "unknown";
+}
+
+#ifdef DIGIVICE_TRACK_ALLOCATIONS
+
+bool AllocTracker::isEnabled() { return true; }
+
+void AllocTracker::beginFrame() {
+    g_isTracking = true;
+    g_stats = FrameAllocStats();
+    g_phase = FramePhase::OUTSIDE_FRAME;
+}
+
+void AllocTracker::setPhase(FramePhase phase) {
+    if (g_isTracking) g_phase = phase; // Untracked jobs running shared frame code leave it alone
+}
+
+FramePhase AllocTracker::getPhase() { return g_phase; }
+
+FrameAllocStats AllocTracker::endFrame() {
+    g_phase = FramePhase::OUTSIDE_FRAME;
+    return g_stats;
+}
+
+void AllocTracker::beginJob() {
+    g_savedTracking = g_isTracking;
+    g_savedPhase = g_phase;
+    g_savedStats = g_stats;
+    g_isTracking = true;
+    g_stats = FrameAllocStats();
+    g_phase = FramePhase::OUTSIDE_FRAME;
+}
+
+FrameAllocStats AllocTracker::endJob() {
+    const FrameAllocStats job = g_stats;
+    g_isTracking = g_savedTracking;
+    g_phase = g_savedPhase;
+    g_stats = g_savedStats;
+    return job;
+}
+
+void AllocTracker::mergeJob(const FrameAllocStats& job) {
+    for (size_t i = 0; i < static_cast<size_t>(FramePhase::COUNT); ++i) {
+        g_stats.count[i] += job.count[i];
+        g_stats.bytes[i] += job.bytes[i];
+    }
+}
+
+
+// --- Global operator new/delete replacements ---
+void* operator new(size_t bytes) {
+    if (void* ptr = trackedAlloc(bytes)) return ptr;
+    throw std::bad_alloc();
+}
+void* operator new[](size_t bytes) {
+    if (void* ptr = trackedAlloc(bytes)) return ptr;
+    throw std::bad_alloc();
+}
+void* operator new(size_t bytes, const std::nothrow_t&) noexcept { return trackedAlloc(bytes); }
+void* operator new[](size_t bytes, const std::nothrow_t&) noexcept { return trackedAlloc(bytes); }
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+
+#else
+
+bool AllocTracker::isEnabled() { return false; }
+void AllocTracker::beginFrame() {}
+void AllocTracker::setPhase(FramePhase) {}
+FramePhase AllocTracker::getPhase() { return FramePhase::OUTSIDE_FRAME; }
+FrameAllocStats AllocTracker::endFrame() { return FrameAllocStats(); }
+void AllocTracker::beginJob() {}
+FrameAllocStats AllocTracker::endJob() { return FrameAllocStats(); }
+void AllocTracker::mergeJob(const FrameAllocStats&) {}
+
+#endif
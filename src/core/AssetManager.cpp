@@ -1,12 +1,16 @@
 // File: src/core/AssetManager.cpp
 
 #include "core/AssetManager.h" // Include own header
+#include "graphics/PalettedSheet.h" // Indexed sheets
+#include "graphics/SurfaceScale.h" // Small-screen variants
 #include <SDL_image.h>         // For IMG_Load, IMG_Init, IMG_Quit, IMG_GetError
 #include <SDL_render.h>        // For SDL_CreateTextureFromSurface, SDL_DestroyTexture
 #include <SDL_surface.h>       // For SDL_Surface, SDL_FreeSurface
+#include <SDL_audio.h>         // For SDL_LoadWAV, SDL_BuildAudioCVT
 #include <SDL_log.h>           // For logging
 #include <fstream>             // <<< ADDED for std::ifstream >>>
 
+AssetManager::AssetManager() = default; // Out of line: PalettedSheet is incomplete in the header
 
 AssetManager::~AssetManager() {
     shutdown();
@@ -28,16 +32,56 @@ bool AssetManager::init(SDL_Renderer* renderer) {
     return true;
 }
 
-bool AssetManager::loadTexture(const std::string& textureId, const std::string& filePath) {
+bool AssetManager::loadTexture(const std::string& textureId, const std::string& filePath, ScaleFilter filter) {
     if (!renderer_ptr) {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Cannot load texture '%s': AssetManager not initialized.", textureId.c_str());
         return false;
     }
-    if (textures_.count(textureId)) {
+    if (textures_.count(textureId.c_str())) {
         SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Texture '%s' already loaded. Skipping.", textureId.c_str());
         return true;
     }
 
+    if (!hasRoomFor(textures_, textureId)) return false;
+
+    SDL_Surface* loadedSurface = loadSurfaceForProfile(textureId, filePath, filter);
+    if (!loadedSurface) return false; // Logs its own errors
+
+    // --- Convert surface to hardware-accelerated texture ---
+    SDL_Texture* newTexture = SDL_CreateTextureFromSurface(renderer_ptr, loadedSurface);
+    if (!newTexture) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unable to create texture from '%s'! SDL Error: %s", filePath.c_str(), SDL_GetError());
+    }
+
+    // --- Free the temporary surface ---
+    SDL_FreeSurface(loadedSurface);
+
+    if (!newTexture) {
+        return false; // Texture creation failed
+    }
+
+    // --- Store the successful texture ---
+    textures_.insert_or_assign(textureId.c_str(), newTexture);
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Successfully loaded texture '%s'.", textureId.c_str());
+    return true; // Success!
+}
+
+template <typename Table>
+bool AssetManager::hasRoomFor(const Table& table, const std::string& textureId) const {
+    if (table.size() >= table.max_size()) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Cannot load '%s': Asset table full (%zu entries).", textureId.c_str(), table.size());
+        return false;
+    }
+#if defined(DIGIVICE_NO_HEAP)
+    if (!AssetId::fits(textureId.c_str())) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Cannot load '%s': Ids are limited to %zu characters.", textureId.c_str(), AssetId::MAX_LENGTH);
+        return false;
+    }
+#endif
+    return true;
+}
+
+SDL_Surface* AssetManager::loadSurface(const std::string& textureId, const std::string& filePath) const {
     SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "Loading texture '%s' from '%s'", textureId.c_str(), filePath.c_str());
 
     // <<< --- ADDED BASIC FILE STREAM CHECK --- >>>
@@ -48,7 +92,7 @@ bool AssetManager::loadTexture(const std::string& textureId, const std::string&
         // IMG_GetError might not be meaningful here, but we log it just in case
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Attempted IMG_Load would likely fail. IMG_GetError() currently reports: %s", IMG_GetError());
         // testFile automatically closes when it goes out of scope here
-        return false; // Exit early
+        return nullptr; // Exit early
     }
     // If we get here, the file was successfully opened (and immediately closed)
     testFile.close();
@@ -60,45 +104,202 @@ bool AssetManager::loadTexture(const std::string& textureId, const std::string&
     if (!loadedSurface) {
         // Now log the SDL_image specific error if IMG_Load failed *after* basic check passed
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "IMG_Load failed for '%s'! SDL_image Error: %s", filePath.c_str(), IMG_GetError());
-        return false;
+        return nullptr;
     }
 
-    // --- Convert surface to hardware-accelerated texture ---
-    SDL_Texture* newTexture = SDL_CreateTextureFromSurface(renderer_ptr, loadedSurface);
-    if (!newTexture) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unable to create texture from '%s'! SDL Error: %s", filePath.c_str(), SDL_GetError());
+    return loadedSurface;
+}
+
+SDL_Surface* AssetManager::loadSurfaceForProfile(const std::string& textureId, const std::string& filePath, ScaleFilter filter) const {
+    const DisplayProfile& profile = getDisplayProfile();
+    bool preScaled = false;
+    SDL_Surface* loadedSurface = loadSurface(textureId, resolveProfilePath(filePath, profile, filter, preScaled));
+    if (!loadedSurface || preScaled) return loadedSurface;
+    SDL_Surface* scaled = downscaleSurface(loadedSurface, profile.divisor, filter);
+    SDL_FreeSurface(loadedSurface);
+    if (scaled) SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "Generated %dx%d '%s' variant of '%s'.", scaled->w, scaled->h, profile.name, textureId.c_str());
+    return scaled; // Logs its own errors
+}
+
+bool AssetManager::loadPalettedSheet(const std::string& textureId, const std::string& filePath, ScaleFilter filter) {
+    if (!renderer_ptr) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Cannot load paletted sheet '%s': AssetManager not initialized.", textureId.c_str());
+        return false;
+    }
+    if (textures_.count(textureId.c_str()) || palettedSheets_.count(textureId.c_str())) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Texture '%s' already loaded. Skipping.", textureId.c_str());
+        return true;
     }
 
-    // --- Free the temporary surface ---
+    if (!hasRoomFor(textures_, textureId) || !hasRoomFor(palettedSheets_, textureId)) return false;
+
+    SDL_Surface* loadedSurface = loadSurfaceForProfile(textureId, filePath, filter);
+    if (!loadedSurface) return false; // Logs its own errors
+    const bool added = addPalettedSheet(textureId, loadedSurface);
     SDL_FreeSurface(loadedSurface);
+    return added;
+}
 
-    if (!newTexture) {
-        return false; // Texture creation failed
+bool AssetManager::addPalettedSheet(const std::string& textureId, SDL_Surface* surface) {
+    if (!renderer_ptr || !surface) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Cannot add paletted sheet '%s': %s.", textureId.c_str(), renderer_ptr ? "No surface" : "AssetManager not initialized");
+        return false;
     }
+    if (textures_.count(textureId.c_str()) || palettedSheets_.count(textureId.c_str())) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Texture '%s' already loaded. Skipping.", textureId.c_str());
+        return true;
+    }
+    if (!hasRoomFor(textures_, textureId) || !hasRoomFor(palettedSheets_, textureId)) return false;
 
-    // --- Store the successful texture ---
-    textures_[textureId] = newTexture;
-    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Successfully loaded texture '%s'.", textureId.c_str());
-    return true; // Success!
+    if (surface->format->format != SDL_PIXELFORMAT_INDEX8) {
+        // Not cooked yet (or re-exported as true colour): still usable, just not recolourable
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "'%s' is %s, not 8-bit indexed; loading it as a plain texture.", textureId.c_str(), SDL_GetPixelFormatName(surface->format->format));
+        SDL_Texture* newTexture = SDL_CreateTextureFromSurface(renderer_ptr, surface);
+        if (!newTexture) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unable to create texture '%s'! SDL Error: %s", textureId.c_str(), SDL_GetError()); return false; }
+        textures_.insert_or_assign(textureId.c_str(), newTexture);
+        return true;
+    }
+
+#if defined(DIGIVICE_NO_HEAP)
+    // Reuse a slot freed by unloadTexture before taking a new one
+    PalettedSheet* sheet = nullptr;
+    for (PalettedSheet& slot : sheetStorage_) {
+        if (!slot.isLoaded()) { sheet = &slot; break; }
+    }
+    if (!sheet) {
+        sheetStorage_.emplace_back(); // hasRoomFor checked the capacity (both share MAX_PALETTED_SHEETS)
+        sheet = &sheetStorage_.back();
+    }
+#else
+    std::unique_ptr<PalettedSheet> sheet = std::make_unique<PalettedSheet>();
+#endif
+    if (!sheet->load(renderer_ptr, surface)) {
+        return false; // Logs its own errors; a no-heap slot stays free for the next load
+    }
+
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Successfully loaded paletted sheet '%s' (%d colours).", textureId.c_str(), sheet->getBasePalette().count);
+    palettedSheets_.insert_or_assign(textureId.c_str(), std::move(sheet));
+    return true;
+}
+
+PalettedSheet* AssetManager::getPalettedSheet(const char* textureId) const {
+    if (!textureId) return nullptr;
+    auto it = palettedSheets_.find(textureId);
+    return it != palettedSheets_.end() ? &*it->second : nullptr; // unique_ptr, or a pointer into sheetStorage_
+}
+
+void AssetManager::applyPaletteChanges() {
+    for (auto& entry : palettedSheets_) entry.second->applyPalette(); // Unchanged sheets return at once
+}
+
+bool AssetManager::loadSound(const std::string& soundId, const std::string& filePath) {
+    if (sounds_.count(soundId.c_str())) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_AUDIO, "Sound '%s' already loaded. Skipping.", soundId.c_str());
+        return true;
+    }
+    if (!hasRoomFor(sounds_, soundId)) return false;
+
+    SDL_AudioSpec spec;
+    Uint8* wavBuffer = nullptr;
+    Uint32 wavLength = 0;
+    if (!SDL_LoadWAV(filePath.c_str(), &spec, &wavBuffer, &wavLength)) {
+        SDL_LogError(SDL_LOG_CATEGORY_AUDIO, "Could not load sound '%s' from '%s': %s", soundId.c_str(), filePath.c_str(), SDL_GetError());
+        return false;
+    }
+
+    // Convert once here so the mixer only ever sees mono AUDIO_S16SYS at its own rate
+    SDL_AudioCVT cvt;
+    if (SDL_BuildAudioCVT(&cvt, spec.format, spec.channels, spec.freq, AUDIO_S16SYS, 1, AUDIO_SAMPLE_RATE) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_AUDIO, "Sound '%s' has an unsupported format: %s", filePath.c_str(), SDL_GetError());
+        SDL_FreeWAV(wavBuffer);
+        return false;
+    }
+    cvt.len = static_cast<int>(wavLength);
+    cvt.buf = static_cast<Uint8*>(SDL_malloc(static_cast<size_t>(cvt.len) * cvt.len_mult));
+    if (!cvt.buf) {
+        SDL_LogError(SDL_LOG_CATEGORY_AUDIO, "Out of memory converting sound '%s'.", filePath.c_str());
+        SDL_FreeWAV(wavBuffer);
+        return false;
+    }
+    SDL_memcpy(cvt.buf, wavBuffer, wavLength);
+    SDL_FreeWAV(wavBuffer);
+    if (cvt.needed && SDL_ConvertAudio(&cvt) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_AUDIO, "Could not convert sound '%s': %s", filePath.c_str(), SDL_GetError());
+        SDL_free(cvt.buf);
+        return false;
+    }
+
+    SoundClip clip;
+    clip.samples = reinterpret_cast<const int16_t*>(cvt.buf);
+    clip.frames = static_cast<uint32_t>((cvt.needed ? cvt.len_cvt : cvt.len) / sizeof(int16_t));
+    sounds_.insert_or_assign(soundId.c_str(), clip);
+    SDL_LogInfo(SDL_LOG_CATEGORY_AUDIO, "Successfully loaded sound '%s' (%.0f ms).", soundId.c_str(), clip.frames * 1000.0 / AUDIO_SAMPLE_RATE);
+    return true;
+}
+
+const SoundClip* AssetManager::getSound(const char* soundId) const {
+    if (!soundId) return nullptr;
+    auto it = sounds_.find(soundId);
+    if (it == sounds_.end()) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_AUDIO, "Sound '%s' not found in AssetManager.", soundId);
+        return nullptr;
+    }
+    return &it->second;
 }
 
 SDL_Texture* AssetManager::getTexture(const std::string& textureId) const {
+    return getTexture(textureId.c_str());
+}
+
+SDL_Texture* AssetManager::getTexture(const char* textureId) const {
+    if (!textureId) return nullptr;
     auto it = textures_.find(textureId);
     if (it != textures_.end()) {
         return it->second;
+    }
+    auto sheetIt = palettedSheets_.find(textureId);
+    if (sheetIt != palettedSheets_.end()) {
+        return sheetIt->second->getTexture();
     } else {
-        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Texture '%s' not found in AssetManager.", textureId.c_str());
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Texture '%s' not found in AssetManager.", textureId);
         return nullptr;
     }
 }
 
+void AssetManager::unloadTexture(const char* textureId) {
+    if (!textureId) return;
+    auto it = textures_.find(textureId);
+    if (it != textures_.end()) {
+        if (it->second) SDL_DestroyTexture(it->second);
+        textures_.erase(it);
+        SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "Unloaded texture '%s'.", textureId);
+        return;
+    }
+    auto sheetIt = palettedSheets_.find(textureId);
+    if (sheetIt != palettedSheets_.end()) {
+#if defined(DIGIVICE_NO_HEAP)
+        sheetIt->second->release(); // The slot in sheetStorage_ is reused by the next load
+#endif
+        palettedSheets_.erase(sheetIt);
+        SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "Unloaded paletted sheet '%s'.", textureId);
+    }
+}
+
 void AssetManager::shutdown() {
-    if (renderer_ptr == nullptr && textures_.empty()) { return; }
+    if (renderer_ptr == nullptr && textures_.empty() && palettedSheets_.empty() && sounds_.empty()) { return; }
     SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Shutting down AssetManager...");
     for (auto const& [id, texture] : textures_) {
         if (texture) SDL_DestroyTexture(texture);
     }
     textures_.clear();
+    palettedSheets_.clear(); // Each sheet destroys its own texture
+    for (auto const& [id, clip] : sounds_) {
+        SDL_free(const_cast<int16_t*>(clip.samples));
+    }
+    sounds_.clear();
+#if defined(DIGIVICE_NO_HEAP)
+    sheetStorage_.clear();
+#endif
     IMG_Quit();
     renderer_ptr = nullptr;
     SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "AssetManager shutdown complete.");
@@ -0,0 +1,68 @@
+// File: src/core/FrameArena.cpp
+
+#include "core/FrameArena.h" // Include own header
+#include <SDL_log.h>         // SDL logging
+#include <SDL_stdinc.h>      // SDL_malloc / SDL_free
+
+FrameArena::~FrameArena() {
+    shutdown();
+}
+
+bool FrameArena::init(size_t capacityBytes) {
+    shutdown();
+    // SDL_malloc so the arena itself never shows up in the operator new tracking
+    buffer_ = static_cast<unsigned char*>(SDL_malloc(capacityBytes));
+    if (!buffer_) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "FrameArena: Failed to reserve %zu bytes.", capacityBytes); return false; }
+    ownsBuffer_ = true;
+    capacity_ = capacityBytes;
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "FrameArena: Reserved %zu bytes.", capacityBytes);
+    return true;
+}
+
+bool FrameArena::init(void* buffer, size_t capacityBytes) {
+    shutdown();
+    if (!buffer) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "FrameArena: Null buffer."); return false; }
+    buffer_ = static_cast<unsigned char*>(buffer);
+    ownsBuffer_ = false;
+    capacity_ = capacityBytes;
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "FrameArena: Using a %zu byte external buffer.", capacityBytes);
+    return true;
+}
+
+void FrameArena::shutdown() {
+    if (buffer_) {
+        SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "FrameArena: Shutdown (high water %zu of %zu bytes, %zu overflows).", highWater_, capacity_, overflowCount_);
+        if (ownsBuffer_) SDL_free(buffer_);
+    }
+    buffer_ = nullptr;
+    ownsBuffer_ = false;
+    capacity_ = used_ = highWater_ = overflowCount_ = 0;
+}
+
+void* FrameArena::allocate(size_t bytes, size_t alignment) {
+    if (!buffer_) return nullptr;
+    const uintptr_t base = reinterpret_cast<uintptr_t>(buffer_);
+    const uintptr_t aligned = (base + used_ + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+    const size_t end = static_cast<size_t>(aligned - base) + bytes;
+    if (end > capacity_) {
+        ++overflowCount_;
+        if (!warnedThisFrame_) {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "FrameArena: Out of space (%zu of %zu bytes used, %zu requested); falling back to the heap.", used_, capacity_, bytes);
+            warnedThisFrame_ = true;
+        }
+        return nullptr;
+    }
+    used_ = end;
+    return reinterpret_cast<void*>(aligned);
+}
+
+bool FrameArena::owns(const void* ptr) const {
+    const unsigned char* p = static_cast<const unsigned char*>(ptr);
+    return buffer_ && p >= buffer_ && p < buffer_ + capacity_;
+}
+
+void FrameArena::reset() {
+    if (used_ > highWater_) highWater_ = used_;
+    used_ = 0;
+    warnedThisFrame_ = false;
+}
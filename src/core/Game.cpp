@@ -2,15 +2,72 @@
 
 #include "core/Game.h"
 #include "states/AdventureState.h" // Needed for initial state push
+#include "core/AllocTracker.h"      // Per-phase allocation counts
+#include "core/SaveSnapshot.h"      // Save/resume
 #include <SDL_log.h>
 #include <stdexcept>
 #include <filesystem> // For CWD logging
+#include <cstring>    // std::strcmp
 
 // Include standard library headers needed by this file
 #include <vector>
 #include <memory>
 #include <string>
 
+namespace {
+    const size_t FRAME_ARENA_BYTES = 256 * 1024;
+#if defined(DIGIVICE_NO_HEAP)
+    alignas(std::max_align_t) unsigned char g_frameArenaStorage[FRAME_ARENA_BYTES];
+#endif
+    // Frames after startup, input or a state change during which caches may still warm up
+    const Uint32 SETTLE_FRAMES = 120;
+    // Longer frames (debugger, window drags) are clamped to 0.1 s
+    const uint32_t MAX_FRAME_TICKS = TICKS_PER_SECOND / 10;
+    // Pipelined render list capacity, reserved before the first frame; AdventureState's
+    // step particles alone can take 2048 quads
+    const size_t RENDER_LIST_COMMANDS = 512;
+    const size_t RENDER_LIST_VERTICES = 16 * 1024;
+    const size_t RENDER_LIST_INDICES = 24 * 1024;
+
+    // --- Startup Assets ---
+    enum class StartupAssetKind : uint8_t { PALETTED_SHEET, TEXTURE, SOUND };
+    struct StartupAsset {
+        StartupAssetKind kind;
+        const char* id;
+        const char* path;
+        bool required; // init() fails without it; sound effects are optional
+        ScaleFilter filter; // How images are held on small screens (platform/DisplayProfile.h)
+    };
+    const StartupAsset STARTUP_ASSETS[] = {
+        // Partner sheets are loaded on demand by RosterSheets (assets/roster/roster.json);
+        // scenery layers by the scene description (assets/scenes/*.json)
+        { StartupAssetKind::TEXTURE, "menu_bg_blue", "assets\\ui\\backgrounds\\menu_base_blue.png", true, ScaleFilter::BOX },
+        // Border atlas rects live in its JSON, and the borders stretch to the screen anyway
+        { StartupAssetKind::TEXTURE, "transition_borders", "assets\\ui\\transition\\transition_borders.png", true, ScaleFilter::NONE },
+        // Effects are small enough to keep in RAM; missing ones just stay silent
+        { StartupAssetKind::SOUND, "step", "assets/sounds/step.wav", false, ScaleFilter::NONE },
+        { StartupAssetKind::SOUND, "menu_move", "assets/sounds/menu_move.wav", false, ScaleFilter::NONE },
+        { StartupAssetKind::SOUND, "menu_select", "assets/sounds/menu_select.wav", false, ScaleFilter::NONE },
+    };
+    const size_t STARTUP_ASSET_COUNT = sizeof(STARTUP_ASSETS) / sizeof(STARTUP_ASSETS[0]);
+    static_assert(STARTUP_ASSET_COUNT <= 32, "Startup assets are tracked in 32-bit masks");
+    // The border atlas (a startup asset) is cut into edge strips by this cooked JSON
+    const char* const BORDERS_ID = "transition_borders";
+    const char* const BORDERS_JSON_PATH = "assets/ui/transition/transition_borders.json";
+    // Every partner the player can pick; only the manifest is read at startup
+    const char* const ROSTER_PATH = "assets/roster/roster.json";
+    // Partner sheets uploaded per frame; prefetches rarely finish more than one at a time
+    const size_t MAX_SHEET_UPLOADS_PER_FRAME = 1;
+
+    // --- Snapshot Chunks ---
+    const uint32_t STACK_CHUNK_ID = makeChunkId('S', 'T', 'C', 'K');  // u8 count, u32 state ids bottom to top
+    const uint32_t ASSETS_CHUNK_ID = makeChunkId('A', 'S', 'S', 'T'); // u8 count, { string id, u8 flags }
+    const uint16_t STACK_CHUNK_VERSION = 1;
+    const uint16_t ASSETS_CHUNK_VERSION = 1;
+    const uint8_t ASSET_FIRST_FRAME = 1u << 0;
+    // Deep sleep to first frame; a resume slower than this is logged as a warning
+    const double WAKE_BUDGET_MS = 200.0;
+} // end anonymous namespace
 
 Game::Game() : is_running(false), last_frame_time(0), request_pop_(false) {
     SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "Game constructor called.");
@@ -22,6 +79,7 @@ Game::~Game() {
 }
 
 bool Game::init(const std::string& title, int width, int height) {
+    init_start_counter_ = SDL_GetPerformanceCounter();
     SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Initializing Game systems...");
     if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_TIMER) < 0) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL Init Error: %s", SDL_GetError()); return false; }
     // Set texture filtering to nearest neighbor
@@ -35,7 +93,8 @@ bool Game::init(const std::string& title, int width, int height) {
 
     // Initialize asset manager
     if (!assetManager.init(display.getRenderer())) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "AssetManager Init Error"); display.close(); SDL_Quit(); return false; }
-    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "AssetManager Initialized.");
+    assetManager.setDisplayProfile(display_profile_);
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "AssetManager Initialized (display profile '%s', assets at 1/%d).", display_profile_->name, display_profile_->divisor);
 
     // Log Current Working Directory
     try {
@@ -43,39 +102,57 @@ bool Game::init(const std::string& title, int width, int height) {
          SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Current Working Directory: %s", cwd.string().c_str());
     } catch (const std::filesystem::filesystem_error& e) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Error getting CWD using std::filesystem: %s", e.what()); }
 
+    // A usable snapshot is read straight from the mapping; it is unmapped once the states are restored
+    MappedSnapshot snapshot;
+    const bool resuming = !snapshot_path_.empty() && snapshot.open(snapshot_path_);
+
     // Load initial assets
     SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Attempting to load initial assets...");
-     bool assets_ok = true;
-     assets_ok &= assetManager.loadTexture("agumon_sheet", "assets\\sprites\\agumon_sheet.png");
-     assets_ok &= assetManager.loadTexture("gabumon_sheet", "assets\\sprites\\gabumon_sheet.png");
-     assets_ok &= assetManager.loadTexture("biyomon_sheet", "assets\\sprites\\biyomon_sheet.png");
-     assets_ok &= assetManager.loadTexture("gatomon_sheet", "assets\\sprites\\gatomon_sheet.png");
-     assets_ok &= assetManager.loadTexture("gomamon_sheet", "assets\\sprites\\gomamon_sheet.png");
-     assets_ok &= assetManager.loadTexture("palmon_sheet", "assets\\sprites\\palmon_sheet.png");
-     assets_ok &= assetManager.loadTexture("tentomon_sheet", "assets\\sprites\\tentomon_sheet.png");
-     assets_ok &= assetManager.loadTexture("patamon_sheet", "assets\\sprites\\patamon_sheet.png");
-     assets_ok &= assetManager.loadTexture("castle_bg_0", "assets\\backgrounds\\castlebackground0.png");
-     assets_ok &= assetManager.loadTexture("castle_bg_1", "assets\\backgrounds\\castlebackground1.png");
-     assets_ok &= assetManager.loadTexture("castle_bg_2", "assets\\backgrounds\\castlebackground2.png");
-     assets_ok &= assetManager.loadTexture("menu_bg_blue", "assets\\ui\\backgrounds\\menu_base_blue.png");
-     assets_ok &= assetManager.loadTexture("transition_borders", "assets\\ui\\transition\\transition_borders.png");
-
-     if (!assets_ok) {
-         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "One or more essential assets failed to load!");
-         assetManager.shutdown(); display.close(); SDL_Quit();
-         return false;
-     }
-     SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Finished loading initial assets attempt.");
-
-    // Push initial state (AdventureState)
+    if (!loadStartupAssets(resuming ? &snapshot : nullptr)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "One or more essential assets failed to load!");
+        assetManager.shutdown(); display.close(); SDL_Quit();
+        return false;
+    }
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Finished loading initial assets attempt.");
+    loadBorders(); // Deferred on resume; loadDeferredAsset() retries once the atlas is in
+    if (!roster_.loadFromJson(ROSTER_PATH)) { // Logs its own errors
+        assetManager.shutdown(); display.close(); SDL_Quit();
+        return false;
+    }
+
+    // Sound is optional: without an output device the game plays silently
+    if (!audio_.init()) { SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "AudioSystem init failed; sound is disabled."); }
+
+    // Shared worker threads (tile decoding, parallel systems, pipelined updates)
+    if (!jobs.init()) { SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "JobSystem init failed; jobs will run inline."); }
+    rosterSheets_.init(&roster_, &assetManager, &jobs);
+
+    // Per-frame scratch memory
+#if defined(DIGIVICE_NO_HEAP)
+    if (!frameArena.init(g_frameArenaStorage, sizeof(g_frameArenaStorage))) { SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "FrameArena init failed; per-frame data will use the heap."); }
+#else
+    if (!frameArena.init(FRAME_ARENA_BYTES)) { SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "FrameArena init failed; per-frame data will use the heap."); }
+#endif
+
+    // Text is optional: states skip drawing it if the atlas failed to build
+    if (!font.loadBuiltin(display.getRenderer())) { SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "BitmapFont failed to load; text will not be drawn."); }
+
+    // Push initial state (AdventureState), or the saved stack
     try {
-       states_.push_back(std::make_unique<AdventureState>(this));
-       SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Initial AdventureState created and added.");
+       resumed_ = resuming && restoreStates(snapshot);
+       if (!resumed_) {
+           states_.clear();
+           states_.push_back(makeState<AdventureState>(this));
+           SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Initial AdventureState created and added.");
+       }
     } catch (const std::exception& e) {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create initial state: %s", e.what());
-        assetManager.shutdown(); display.close(); SDL_Quit(); return false;
+        audio_.shutdown(); assetManager.shutdown(); display.close(); SDL_Quit(); return false;
     }
 
+    snapshot.close();
+
+    logStaticMemoryUse();
     is_running = true;
     last_frame_time = SDL_GetTicks(); // Initialize frame timer
     SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Game Initialization Successful.");
@@ -88,61 +165,83 @@ void Game::run() {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Game::run() called in invalid state (not initialized or no initial state).");
         return;
     }
-    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Entering main game loop.");
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Entering main game loop (%s).", pipelined_ ? "pipelined" : "serial");
     last_frame_time = SDL_GetTicks(); // Ensure timer starts correctly
+    frame_clock_.reset();
+    if (pipelined_) render_list_.reserve(RENDER_LIST_COMMANDS, RENDER_LIST_VERTICES, RENDER_LIST_INDICES);
+    loop_running_ = true;
 
     while (is_running) {
-        // Calculate delta time
+        // Nothing allocated from the arena survives a frame
+        frameArena.reset();
+        AllocTracker::beginFrame();
+        ++frame_count_;
+        const size_t stackSizeBefore = states_.size();
+        GameState* topStateBefore = getCurrentState();
+
+        // Calculate delta time in whole ticks, so float and fixed-point builds see identical deltas
         Uint32 current_time = SDL_GetTicks();
-        float delta_time = (current_time - last_frame_time) / 1000.0f;
+        uint32_t delta_ticks = frame_clock_.advance(current_time - last_frame_time);
         // Clamp delta time to prevent large jumps if debugging/pausing
-        if (delta_time > 0.1f) delta_time = 0.1f;
+        if (delta_ticks > MAX_FRAME_TICKS) delta_ticks = MAX_FRAME_TICKS;
+        const Scalar delta_time = scalarFromTicks(delta_ticks);
         last_frame_time = current_time;
 
         // --- Process OS Events ---
+        AllocTracker::setPhase(FramePhase::EVENTS);
         SDL_Event event;
         while (SDL_PollEvent(&event)) {
+            last_disturbed_frame_ = frame_count_;
             if (event.type == SDL_QUIT) {
                 quit_game(); // Request quit
+            } else if (!states_.empty() && states_.back()) {
+                states_.back()->handle_event(event); // Text entry etc.; held keys are still polled in handle_input
             }
-            // TODO: Pass relevant events down to current state's handle_input if needed
         }
 
-        // --- Update Top State (if any) ---
-        if (!states_.empty()) {
-            GameState* currentStatePtr = states_.back().get();
-            if (currentStatePtr) {
-                currentStatePtr->handle_input(); // State handles direct polling for now
-                currentStatePtr->update(delta_time);
-            } else {
-                SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "RunLoop Update: Top state pointer is NULL despite non-empty stack!");
-                is_running = false; // Treat as critical error
+        if (!pipelined_) {
+            // --- Serial: update, state changes, render, present ---
+            simulate(delta_time);
+            applyFrameStateChanges();
+            if (states_.size() != stackSizeBefore || getCurrentState() != topStateBefore) last_disturbed_frame_ = frame_count_;
+
+            AllocTracker::setPhase(FramePhase::RENDER);
+            assetManager.applyPaletteChanges();
+            if (renderFrame(nullptr)) {
+                capture_.captureFrame(&display);
+                display.present();
             }
         } else {
-            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "RunLoop Update: State stack unexpectedly empty.");
-            is_running = false; // No states left, stop running
+            // --- Pipelined: the simulation job is idle here, so the states are ours ---
+            // Apply what the previous frame's update requested, record this frame,
+            // then let a worker update the next frame while we submit.
+            applyFrameStateChanges();
+            if (states_.size() != stackSizeBefore || getCurrentState() != topStateBefore) last_disturbed_frame_ = frame_count_;
+
+            AllocTracker::setPhase(FramePhase::RENDER);
+            assetManager.applyPaletteChanges(); // The simulation job is idle; nothing else touches the sheets
+            const bool recorded = renderFrame(&render_list_);
+            if (is_running) kickSimulation(delta_time);
+            if (recorded) {
+                display.submit(render_list_);
+                capture_.captureFrame(&display);
+                display.present();
+            }
+            waitForSimulation();
         }
 
-        // --- Apply Pending State Changes ---
-        SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "RunLoop: Before applyStateChanges. Stack size = %zu", states_.size());
-        applyStateChanges();
-        SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "RunLoop: After applyStateChanges. Stack size = %zu", states_.size());
-
-        // --- Render Top State (if any) ---
-        if (!states_.empty()) {
-             GameState* currentStateForRender = getCurrentState();
-             if (currentStateForRender) {
-                 display.clear(0x0000); // Clear screen (to black)
-                 currentStateForRender->render(); // Render the current state
-                 display.present(); // Show the result on screen
-             } else {
-                 SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "RunLoop: Render phase - getCurrentState returned NULL despite non-empty stack?");
-             }
-        } else {
-             // If stack becomes empty after state changes, maybe log info and stop
-             SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION,"RunLoop: Render phase - State stack empty, skipping render and stopping.");
-             is_running = false;
+        if (frame_count_ == 1) logWakeTime();
+        // Streaming allocates like init does, and is counted apart from the frame's own work
+        AllocTracker::setPhase(FramePhase::LOADING);
+        // Resumed games load what the first frame didn't draw, one asset per frame
+        if (deferred_assets_ != 0) {
+            loadDeferredAsset();
+            last_disturbed_frame_ = frame_count_;
         }
+        // Partner sheets the states asked for this frame; uploads and evictions allocate
+        if (rosterSheets_.updateResidency(MAX_SHEET_UPLOADS_PER_FRAME)) last_disturbed_frame_ = frame_count_;
+
+        checkFrameAllocations(frame_count_ > SETTLE_FRAMES && frame_count_ - last_disturbed_frame_ > SETTLE_FRAMES);
 
         // --- Check Running Flag ---
         if (!is_running) {
@@ -158,15 +257,292 @@ void Game::run() {
         // }
     }
     SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Exited main game loop.");
+    waitForSimulation();
+    loop_running_ = false;
     close(); // Perform cleanup after loop ends
 }
 
+// --- Frame Steps ---
+// Input + update for the top state. Runs as a job in pipelined mode,
+// so it must not call the renderer.
+void Game::simulate(Scalar delta_time) {
+    AllocTracker::setPhase(FramePhase::INPUT);
+    detected_steps_ += stepPipeline_.poll(); // Drained even while menus are open
+    timers_.advance(static_cast<uint32_t>(scalarToTicks(delta_time))); // Sequences and other timed logic
+    if (!states_.empty()) {
+        GameState* currentStatePtr = states_.back().get();
+        if (currentStatePtr) {
+            AllocTracker::setPhase(FramePhase::INPUT);
+            currentStatePtr->handle_input(); // State handles direct polling for now
+            AllocTracker::setPhase(FramePhase::UPDATE);
+            currentStatePtr->update(delta_time);
+        } else {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "RunLoop Update: Top state pointer is NULL despite non-empty stack!");
+            is_running = false; // Treat as critical error
+        }
+    } else {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "RunLoop Update: State stack unexpectedly empty.");
+        is_running = false; // No states left, stop running
+    }
+}
+
+void Game::applyFrameStateChanges() {
+    AllocTracker::setPhase(FramePhase::STATE_CHANGES);
+    SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "RunLoop: Before applyStateChanges. Stack size = %zu", states_.size());
+    applyStateChanges();
+    SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "RunLoop: After applyStateChanges. Stack size = %zu", states_.size());
+}
+
+// Draws the top state straight to the display, or into 'list' when given.
+// Returns false when there was nothing to draw.
+bool Game::renderFrame(RenderList* list) {
+    if (states_.empty()) {
+        // If stack becomes empty after state changes, maybe log info and stop
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION,"RunLoop: Render phase - State stack empty, skipping render and stopping.");
+        is_running = false;
+        return false;
+    }
+    GameState* currentStateForRender = getCurrentState();
+    if (!currentStateForRender) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "RunLoop: Render phase - getCurrentState returned NULL despite non-empty stack?");
+        return false;
+    }
+    if (list) {
+        list->clear();
+        display.beginRecording(list);
+    }
+    display.clear(0x0000); // Clear screen (to black)
+    currentStateForRender->render(); // Render the current state
+    if (list) display.endRecording();
+    return true;
+}
+
+
+// --- Simulation Job (pipelined mode) ---
+void Game::setPipelined(bool pipelined) {
+    if (loop_running_) { SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Game::setPipelined ignored while the loop is running."); return; }
+    pipelined_ = pipelined;
+}
+
+void Game::kickSimulation(Scalar delta_time) {
+    // Counted on whichever thread runs it; waitForSimulation() adds it to the frame
+    sim_job_ = jobs.createJob([this, delta_time]() {
+        AllocTracker::beginJob();
+        simulate(delta_time);
+        sim_allocs_ = AllocTracker::endJob();
+    });
+    jobs.run(sim_job_); // Runs inline when there are no workers
+}
+
+void Game::waitForSimulation() {
+    if (!sim_job_) return;
+    jobs.wait(sim_job_); // Helps with other queued jobs meanwhile
+    sim_job_ = nullptr;
+    AllocTracker::mergeJob(sim_allocs_); // Before checkFrameAllocations() reads the frame
+}
+
+// --- Allocation Tracking ---
+// A settled frame (no input, no state change, caches warm) must not touch the heap;
+// per-frame data belongs in frameArena. No-heap builds hold every frame to that,
+// input and state changes included; only asset streaming (LOADING) may allocate.
+void Game::checkFrameAllocations(bool settled) {
+    FrameAllocStats stats = AllocTracker::endFrame();
+#if defined(DIGIVICE_NO_HEAP)
+    const size_t loading = static_cast<size_t>(FramePhase::LOADING);
+    stats.count[loading] = 0;
+    stats.bytes[loading] = 0;
+    settled = true;
+#endif
+    if (!settled || stats.totalCount() == 0) return;
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Frame %u: %u heap allocations (%zu bytes) after init.", frame_count_, stats.totalCount(), stats.totalBytes());
+    for (size_t i = 0; i < static_cast<size_t>(FramePhase::COUNT); ++i) {
+        if (stats.count[i] == 0) continue;
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "  %-13s %u allocations, %zu bytes", AllocTracker::getPhaseName(static_cast<FramePhase>(i)), stats.count[i], stats.bytes[i]);
+    }
+    SDL_assert(stats.totalCount() == 0 && "Frame allocated after init; see the log for the phase");
+}
+
+// Fixed-capacity storage is part of the Game object, the state slots and the
+// frame arena; the linker map has the rest (see DIGIVICE_NO_HEAP in CMakeLists.txt)
+void Game::logStaticMemoryUse() const {
+#if defined(DIGIVICE_NO_HEAP)
+    const size_t stateSlots = StatePool::getStorageBytes();
+    const size_t arena = sizeof(g_frameArenaStorage);
+    const size_t sheetIndices = PalettedSheet::getIndexStorageBytes();
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Static memory: Game %zu bytes (assets %zu, state stack %zu), state slots %zu, frame arena %zu, sheet indices %zu; total %zu bytes.",
+                sizeof(Game), sizeof(AssetManager), sizeof(StateStack), stateSlots, arena, sheetIndices, sizeof(Game) + stateSlots + arena + sheetIndices);
+#endif
+}
+
+// --- Save/Resume ---
+void Game::setSnapshotPath(const std::string& path) {
+    if (is_running) { SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Game::setSnapshotPath ignored after init."); return; }
+    snapshot_path_ = path;
+}
+
+void Game::setDisplayProfile(const DisplayProfile& profile) {
+    if (is_running) { SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Game::setDisplayProfile ignored after init."); return; }
+    display_profile_ = &profile;
+}
+
+// Fresh starts load everything. Resumes load only the assets the snapshot marks
+// as drawn by its first frame; the rest wait for loadDeferredAsset().
+bool Game::loadStartupAssets(const MappedSnapshot* snapshot) {
+    uint32_t firstFrame = ~0u;
+    SnapshotChunk chunk;
+    if (snapshot && snapshot->findChunk(ASSETS_CHUNK_ID, chunk) && chunk.getVersion() == ASSETS_CHUNK_VERSION) {
+        firstFrame = 0;
+        uint8_t count = 0;
+        chunk.read(count);
+        for (uint8_t i = 0; i < count; ++i) {
+            char id[MAX_ASSET_ID_LENGTH + 1];
+            uint8_t flags = 0;
+            if (!chunk.readString(id, sizeof(id)) || !chunk.read(flags)) break;
+            if (!(flags & ASSET_FIRST_FRAME)) continue;
+            for (size_t a = 0; a < STARTUP_ASSET_COUNT; ++a) {
+                if (std::strcmp(STARTUP_ASSETS[a].id, id) == 0) firstFrame |= 1u << a;
+            }
+        }
+    }
+
+    bool ok = true;
+    bool soundsOk = true;
+    size_t deferred = 0;
+    for (size_t i = 0; i < STARTUP_ASSET_COUNT; ++i) {
+        if (!(firstFrame & (1u << i))) {
+            deferred_assets_ |= 1u << i;
+            ++deferred;
+            continue;
+        }
+        if (loadStartupAsset(i)) continue;
+        if (STARTUP_ASSETS[i].required) ok = false;
+        else soundsOk = false;
+    }
+    if (!soundsOk) { SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "One or more sound effects failed to load."); }
+    if (deferred > 0) { SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Resume: %zu asset(s) deferred until after the first frame.", deferred); }
+    return ok;
+}
+
+bool Game::loadStartupAsset(size_t index) {
+    const StartupAsset& asset = STARTUP_ASSETS[index];
+    bool loaded = false;
+    switch (asset.kind) {
+        case StartupAssetKind::PALETTED_SHEET: loaded = assetManager.loadPalettedSheet(asset.id, asset.path, asset.filter); break;
+        case StartupAssetKind::TEXTURE: loaded = assetManager.loadTexture(asset.id, asset.path, asset.filter); break;
+        case StartupAssetKind::SOUND: loaded = assetManager.loadSound(asset.id, asset.path); break;
+    }
+    if (loaded) resident_assets_ |= 1u << index;
+    return loaded;
+}
+
+void Game::loadDeferredAsset() {
+    size_t index = 0;
+    while (!(deferred_assets_ & (1u << index))) ++index;
+    deferred_assets_ &= ~(1u << index);
+    const StartupAsset& asset = STARTUP_ASSETS[index];
+    if (!loadStartupAsset(index)) {
+        if (asset.required) SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Deferred asset '%s' failed to load!", asset.id);
+        return;
+    }
+    if (std::strcmp(asset.id, BORDERS_ID) == 0) loadBorders();
+    for (StatePtr& state : states_) state->onAssetLoaded(asset.id);
+}
+
+// Cooked once, so a transition parses nothing when it starts
+void Game::loadBorders() {
+    SDL_Texture* atlas = assetManager.getTexture(BORDERS_ID);
+    if (!atlas) return; // Deferred, or already reported by loadStartupAssets()
+    if (!borders_.load(atlas, BORDERS_JSON_PATH)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Border strips failed to load from '%s'! Transitions will not draw them.", BORDERS_JSON_PATH);
+    }
+}
+
+// Rebuilds the saved stack bottom to top. States are matched to their chunks in
+// file order; an unknown state id ends the restore there (resuming on the states below).
+bool Game::restoreStates(const MappedSnapshot& snapshot) {
+    SnapshotChunk stack;
+    uint8_t count = 0;
+    if (!snapshot.findChunk(STACK_CHUNK_ID, stack) || stack.getVersion() != STACK_CHUNK_VERSION || !stack.read(count)) return false;
+    size_t cursor = 0;
+    for (uint8_t i = 0; i < count; ++i) {
+        uint32_t id = 0;
+        if (!stack.read(id)) break;
+        StatePtr state;
+        if (id == AdventureState::SNAPSHOT_ID) state = makeState<AdventureState>(this);
+        if (!state) { SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Resume: Unknown state in snapshot; resuming below it."); break; }
+
+        SnapshotChunk chunk;
+        bool found = false;
+        while (!found && snapshot.nextChunk(cursor, chunk)) found = chunk.getId() == id;
+        if (!found || !state->restoreSnapshot(chunk)) { SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Resume: A state could not be restored; it starts fresh."); }
+        states_.push_back(std::move(state));
+    }
+    if (states_.empty()) return false;
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Resume: Restored %zu state(s) from '%s'.", states_.size(), snapshot_path_.c_str());
+    return true;
+}
+
+bool Game::saveSnapshot() {
+    if (snapshot_path_.empty()) return false;
+    const Uint64 start = SDL_GetPerformanceCounter();
+
+    // Only states that can be restored are saved; the last of them draws the first frame on resume
+    uint8_t count = 0;
+    GameState* top = nullptr;
+    for (const StatePtr& state : states_) {
+        if (state->getSnapshotId() == 0) continue;
+        ++count;
+        top = state.get();
+    }
+    if (!top) { SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Game: Nothing to save."); return false; }
+
+    SnapshotWriter writer;
+    writer.beginChunk(STACK_CHUNK_ID, STACK_CHUNK_VERSION);
+    writer.write(count);
+    for (const StatePtr& state : states_) {
+        if (state->getSnapshotId() != 0) writer.write(state->getSnapshotId());
+    }
+    writer.beginChunk(ASSETS_CHUNK_ID, ASSETS_CHUNK_VERSION);
+    uint8_t resident = 0;
+    for (size_t i = 0; i < STARTUP_ASSET_COUNT; ++i) {
+        if (resident_assets_ & (1u << i)) ++resident;
+    }
+    writer.write(resident);
+    for (size_t i = 0; i < STARTUP_ASSET_COUNT; ++i) {
+        if (!(resident_assets_ & (1u << i))) continue;
+        writer.writeString(STARTUP_ASSETS[i].id);
+        writer.write(static_cast<uint8_t>(top->needsAssetForFirstFrame(STARTUP_ASSETS[i].id) ? ASSET_FIRST_FRAME : 0));
+    }
+    writer.endChunk();
+    for (const StatePtr& state : states_) {
+        if (state->getSnapshotId() != 0) state->saveSnapshot(writer);
+    }
+    if (!writer.writeFile(snapshot_path_)) return false; // Logs its own errors
+
+    const double ms = (SDL_GetPerformanceCounter() - start) * 1000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Game: Saved %zu-byte snapshot to '%s' in %.2f ms.", writer.getSize(), snapshot_path_.c_str(), ms);
+    return true;
+}
+
+void Game::logWakeTime() const {
+    const double ms = (SDL_GetPerformanceCounter() - init_start_counter_) * 1000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+    if (resumed_ && ms > WAKE_BUDGET_MS) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Resume: First frame after %.1f ms, over the %.0f ms wake budget.", ms, WAKE_BUDGET_MS);
+    } else {
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "%s: First frame after %.1f ms (wake budget %.0f ms).", resumed_ ? "Resume" : "Start", ms, WAKE_BUDGET_MS);
+    }
+}
+
 // --- State Management - Actual Push/Pop ---
-void Game::push_state(std::unique_ptr<GameState> new_state) {
+void Game::push_state(StatePtr new_state) {
     if (!new_state) {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "push_state called with null state!");
         return;
     }
+    if (states_.size() >= states_.max_size()) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "push_state: State stack is full (%zu states); dropping the push.", states_.size());
+        return;
+    }
     SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Executing push_state for state %p...", (void*)new_state.get());
     states_.push_back(std::move(new_state));
     SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "push_state complete. New stack size: %zu", states_.size());
@@ -176,7 +552,7 @@ void Game::pop_state() {
     if (!states_.empty()) {
          GameState* stateToPop = states_.back().get();
          SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Executing pop_state for state %p...", (void*)stateToPop);
-         // unique_ptr handles destruction when popped
+         // StatePtr handles destruction (and frees the slot) when popped
          states_.pop_back();
          SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "pop_state complete. New stack size: %zu", states_.size());
     } else {
@@ -185,7 +561,7 @@ void Game::pop_state() {
 }
 
 // --- State Management - Requests ---
-void Game::requestPushState(std::unique_ptr<GameState> state) {
+void Game::requestPushState(StatePtr state) {
     if (!state) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Attempted to request push of NULL state!"); return; }
     // If a push is already pending, the new one replaces it
     if (request_push_) { SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Overwriting previous push request."); }
@@ -212,7 +588,7 @@ void Game::applyStateChanges() {
     if (request_push_) {
         SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "ApplyStateChanges: Applying Push request for state %p.", (void*)request_push_.get());
         push_state(std::move(request_push_)); // push_state moves ownership
-        request_push_.reset(); // Clear the pending request unique_ptr
+        request_push_.reset(); // Clear the pending request
     }
     SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "ApplyStateChanges: End. Stack size = %zu", states_.size());
 }
@@ -239,13 +615,67 @@ AssetManager* Game::getAssetManager() {
     return &assetManager;
 }
 
+BitmapFont* Game::getFont() {
+    return &font;
+}
+
+BorderRenderer* Game::getBorders() {
+    return &borders_;
+}
+
+FrameArena* Game::getFrameArena() {
+    return &frameArena;
+}
+
+JobSystem* Game::getJobSystem() {
+    return &jobs;
+}
+
+const Roster& Game::getRoster() const {
+    return roster_;
+}
+
+RosterSheets* Game::getRosterSheets() {
+    return &rosterSheets_;
+}
+
+TimerWheel& Game::getTimers() {
+    return timers_;
+}
+
+StepPipeline* Game::getStepPipeline() {
+    return &stepPipeline_;
+}
+
+AudioSystem* Game::getAudio() {
+    return &audio_;
+}
+
+FrameCapture* Game::getFrameCapture() {
+    return &capture_;
+}
+
+int Game::takeDetectedSteps() {
+    const int steps = detected_steps_;
+    detected_steps_ = 0;
+    return steps;
+}
+
 // --- close ---
 void Game::close() {
     SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Shutting down Game systems...");
-    // Clear state stack (unique_ptrs handle deletion)
+    if (!snapshot_path_.empty()) saveSnapshot(); // While the states still exist
+    // Clear state stack (StatePtrs handle deletion)
     states_.clear();
     SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "State stack cleared.");
+    capture_.stop();      // Flushes queued frames while the display is still open
+    stepPipeline_.stop(); // Closes the sensor before SDL_Quit
+    audio_.shutdown();    // Stops the callback before AssetManager frees the clips
+    rosterSheets_.shutdown(); // Waits for its decodes, then frees the sheets
+    jobs.shutdown(); // After the states, which may still be waiting on jobs
     // Shutdown subsystems
+    font.shutdown();
+    frameArena.shutdown();
     assetManager.shutdown();
     SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "AssetManager shutdown.");
     display.close();
@@ -255,7 +685,7 @@ void Game::close() {
 }
 
 // <<< --- ADDED IMPLEMENTATION for stack access --- >>>
-std::vector<std::unique_ptr<GameState>>& Game::DEBUG_getStack() {
+StateStack& Game::DEBUG_getStack() {
     return states_; // Return reference to the stack
 }
 // <<< --------------------------------------------- >>>
\ No newline at end of file
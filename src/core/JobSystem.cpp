@@ -0,0 +1,199 @@
+// File: src/core/JobSystem.cpp
+
+#include "core/JobSystem.h" // Include own header
+#include <SDL_log.h>        // SDL logging
+
+namespace {
+    // Index into JobSystem::queues_ for the current thread; -1 = not a job thread.
+    // Keyed by owner so a second JobSystem (tests, tools) doesn't see our index.
+    thread_local const JobSystem* t_owner = nullptr;
+    thread_local int t_threadIndex = -1;
+    thread_local unsigned t_stealSeed = 0x9E3779B9u;
+
+    unsigned nextStealVictim(unsigned threadCount) {
+        // xorshift32: cheap per-thread victim selection
+        t_stealSeed ^= t_stealSeed << 13;
+        t_stealSeed ^= t_stealSeed >> 17;
+        t_stealSeed ^= t_stealSeed << 5;
+        return t_stealSeed % threadCount;
+    }
+} // end anonymous namespace
+
+
+// --- WorkQueue ---
+bool JobSystem::WorkQueue::push(Job* job) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (count == MAX_JOBS_PER_THREAD) return false;
+    jobs[(head + count) % MAX_JOBS_PER_THREAD] = job;
+    ++count;
+    return true;
+}
+
+Job* JobSystem::WorkQueue::pop() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (count == 0) return nullptr;
+    --count;
+    return jobs[(head + count) % MAX_JOBS_PER_THREAD];
+}
+
+Job* JobSystem::WorkQueue::steal() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (count == 0) return nullptr;
+    Job* job = jobs[head];
+    head = (head + 1) % MAX_JOBS_PER_THREAD;
+    --count;
+    return job;
+}
+
+
+// --- Setup ---
+JobSystem::~JobSystem() {
+    shutdown();
+}
+
+bool JobSystem::init(unsigned workerCount) {
+    if (isInitialized()) { SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "JobSystem::init called when already initialized."); return true; }
+    if (workerCount == 0) {
+        const unsigned hardwareThreads = std::thread::hardware_concurrency();
+        workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+    }
+
+    const unsigned threadCount = workerCount + 1;
+    for (unsigned i = 0; i < threadCount; ++i) {
+        queues_.push_back(std::make_unique<WorkQueue>());
+        pools_.push_back(std::make_unique<JobPool>());
+    }
+    t_owner = this;
+    t_threadIndex = 0;
+    stop_ = false;
+    for (unsigned i = 1; i < threadCount; ++i) {
+        workers_.emplace_back(&JobSystem::workerLoop, this, i);
+    }
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "JobSystem: Started %u worker thread(s).", workerCount);
+    return true;
+}
+
+void JobSystem::shutdown() {
+    if (!isInitialized()) return;
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+        stop_ = true;
+    }
+    wakeCv_.notify_all();
+    for (std::thread& worker : workers_) worker.join();
+    workers_.clear();
+    queues_.clear();
+    pools_.clear();
+    queuedJobs_ = 0;
+    if (t_owner == this) { t_owner = nullptr; t_threadIndex = -1; }
+}
+
+int JobSystem::currentThreadIndex() const {
+    return (t_owner == this) ? t_threadIndex : -1;
+}
+
+
+// --- Jobs ---
+Job* JobSystem::allocateJob() {
+    const int index = currentThreadIndex();
+    if (index < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "JobSystem: Jobs can only be created on the main thread or a worker.");
+        return nullptr;
+    }
+    JobPool& pool = *pools_[index];
+    for (;;) {
+        // Skip slots whose job is still queued or running
+        for (size_t tries = 0; tries < MAX_JOBS_PER_THREAD; ++tries) {
+            Job* job = &pool.jobs[pool.next];
+            pool.next = (pool.next + 1) % MAX_JOBS_PER_THREAD;
+            if (isFinished(job)) return job;
+        }
+        if (!pool.warnedFull) {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "JobSystem: All %zu job slots of thread %d are live; helping until one frees.", MAX_JOBS_PER_THREAD, index);
+            pool.warnedFull = true;
+        }
+        if (Job* other = getJob()) execute(other);
+        else std::this_thread::yield();
+    }
+}
+
+Job* JobSystem::createJob(JobFunction function) {
+    return createChildJob(nullptr, function);
+}
+
+Job* JobSystem::createChildJob(Job* parent, JobFunction function) {
+    Job* job = allocateJob();
+    if (!job) return nullptr;
+    job->function = function;
+    job->parent = parent;
+    job->unfinishedJobs.store(1, std::memory_order_relaxed);
+    if (parent) parent->unfinishedJobs.fetch_add(1, std::memory_order_relaxed);
+    return job;
+}
+
+void JobSystem::run(Job* job) {
+    if (!job) return;
+    const int index = currentThreadIndex();
+    if (workers_.empty() || index < 0 || !queues_[index]->push(job)) {
+        execute(job); // No one to hand it to (or our deque is full): do it now
+        return;
+    }
+    queuedJobs_.fetch_add(1);
+    if (sleepingWorkers_.load() > 0) {
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+        wakeCv_.notify_one();
+    }
+}
+
+void JobSystem::wait(const Job* job) {
+    if (!job) return;
+    while (!isFinished(job)) {
+        if (Job* next = getJob()) execute(next);
+        else std::this_thread::yield();
+    }
+}
+
+Job* JobSystem::getJob() {
+    const int index = currentThreadIndex();
+    if (index < 0) return nullptr;
+    Job* job = queues_[index]->pop();
+    if (!job) {
+        const unsigned threadCount = getThreadCount();
+        const unsigned victim = nextStealVictim(threadCount);
+        for (unsigned i = 0; i < threadCount && !job; ++i) {
+            const unsigned other = (victim + i) % threadCount;
+            if (other != static_cast<unsigned>(index)) job = queues_[other]->steal();
+        }
+    }
+    if (job) queuedJobs_.fetch_sub(1);
+    return job;
+}
+
+void JobSystem::execute(Job* job) {
+    job->function(job);
+    finish(job);
+}
+
+void JobSystem::finish(Job* job) {
+    // The last of a job and its children to complete finishes the parent in turn.
+    // Read the parent first: once the count hits zero the slot may be handed out again.
+    Job* parent = job->parent;
+    const int remaining = job->unfinishedJobs.fetch_sub(1, std::memory_order_acq_rel) - 1;
+    if (remaining == 0 && parent) finish(parent);
+}
+
+
+// --- Workers ---
+void JobSystem::workerLoop(unsigned index) {
+    t_owner = this;
+    t_threadIndex = static_cast<int>(index);
+    t_stealSeed ^= index * 0x85EBCA6Bu;
+    while (!stop_.load()) {
+        if (Job* job = getJob()) { execute(job); continue; }
+        // Sleep until something is queued anywhere
+        std::unique_lock<std::mutex> lock(wakeMutex_);
+        sleepingWorkers_.fetch_add(1);
+        wakeCv_.wait(lock, [this] { return stop_.load() || queuedJobs_.load() > 0; });
+        sleepingWorkers_.fetch_sub(1);
+    }
+}
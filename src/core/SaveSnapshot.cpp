@@ -0,0 +1,219 @@
+// File: src/core/SaveSnapshot.cpp
+
+#include "core/SaveSnapshot.h" // Include own header
+#include <SDL_log.h>
+#include <cstdio>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <io.h>     // _commit, _fileno
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    const uint32_t SNAPSHOT_MAGIC = makeChunkId('D', 'G', 'S', 'V');
+    const size_t HEADER_BYTES = 16;
+    const size_t CHUNK_HEADER_BYTES = 12;
+
+    void put16(uint8_t* out, uint16_t value) { out[0] = static_cast<uint8_t>(value); out[1] = static_cast<uint8_t>(value >> 8); }
+    void put32(uint8_t* out, uint32_t value) { put16(out, static_cast<uint16_t>(value)); put16(out + 2, static_cast<uint16_t>(value >> 16)); }
+    uint16_t get16(const uint8_t* in) { return static_cast<uint16_t>(in[0] | in[1] << 8); }
+    uint32_t get32(const uint8_t* in) { return get16(in) | static_cast<uint32_t>(get16(in + 2)) << 16; }
+
+    uint32_t checksum(const uint8_t* data, size_t size) {
+        uint32_t hash = 2166136261u; // FNV-1a
+        for (size_t i = 0; i < size; ++i) { hash ^= data[i]; hash *= 16777619u; }
+        return hash;
+    }
+
+    // Flushes the file's data to the storage device, not just the OS cache
+    bool syncToDisk(std::FILE* file) {
+        if (std::fflush(file) != 0) return false;
+#ifdef _WIN32
+        return _commit(_fileno(file)) == 0;
+#else
+        return fsync(fileno(file)) == 0;
+#endif
+    }
+
+    bool replaceFile(const std::string& from, const std::string& to) {
+#ifdef _WIN32
+        return MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+        if (std::rename(from.c_str(), to.c_str()) != 0) return false;
+        // Make the rename itself durable
+        const size_t slash = to.find_last_of('/');
+        const std::string directory = slash == std::string::npos ? "." : (slash == 0 ? "/" : to.substr(0, slash));
+        const int fd = ::open(directory.c_str(), O_RDONLY);
+        if (fd >= 0) { fsync(fd); ::close(fd); }
+        return true;
+#endif
+    }
+} // end anonymous namespace
+
+
+// --- Writing ---
+void SnapshotWriter::beginChunk(uint32_t id, uint16_t version) {
+    if (chunkStart_ != NO_CHUNK) endChunk();
+    chunkStart_ = size_;
+    uint8_t header[CHUNK_HEADER_BYTES] = {};
+    put32(header, id);
+    put16(header + 4, version);
+    writeBytes(header, sizeof(header)); // Size is patched in by endChunk()
+}
+
+void SnapshotWriter::endChunk() {
+    if (chunkStart_ == NO_CHUNK) return;
+    if (!overflowed_) put32(bytes_ + chunkStart_ + 8, static_cast<uint32_t>(size_ - chunkStart_ - CHUNK_HEADER_BYTES));
+    chunkStart_ = NO_CHUNK;
+}
+
+void SnapshotWriter::writeString(const char* text) {
+    const size_t length = text ? std::strlen(text) : 0;
+    const uint8_t stored = static_cast<uint8_t>(length < 255 ? length : 255);
+    write(stored);
+    writeBytes(text, stored);
+}
+
+void SnapshotWriter::writeBytes(const void* data, size_t size) {
+    if (overflowed_ || size > CAPACITY - size_) { overflowed_ = true; return; }
+    if (size > 0) std::memcpy(bytes_ + size_, data, size);
+    size_ += size;
+}
+
+bool SnapshotWriter::writeFile(const std::string& path) {
+    endChunk();
+    if (overflowed_) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SaveSnapshot: Snapshot exceeds %zu bytes; not saved.", CAPACITY); return false; }
+    put32(bytes_, SNAPSHOT_MAGIC);
+    put16(bytes_ + 4, SNAPSHOT_FORMAT_VERSION);
+    put16(bytes_ + 6, 0);
+    put32(bytes_ + 8, static_cast<uint32_t>(size_ - HEADER_BYTES));
+    put32(bytes_ + 12, checksum(bytes_ + HEADER_BYTES, size_ - HEADER_BYTES));
+
+    const std::string tempPath = path + ".tmp";
+    std::FILE* file = std::fopen(tempPath.c_str(), "wb");
+    if (!file) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SaveSnapshot: Could not open '%s' for writing.", tempPath.c_str()); return false; }
+    const bool written = std::fwrite(bytes_, 1, size_, file) == size_ && syncToDisk(file);
+    const bool closed = std::fclose(file) == 0;
+    if (!written || !closed || !replaceFile(tempPath, path)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SaveSnapshot: Could not write '%s'; the previous snapshot is unchanged.", path.c_str());
+        std::remove(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+// --- Chunk Reading ---
+bool SnapshotChunk::readBytes(void* data, size_t size) {
+    if (!valid_ || size > size_ - position_) { valid_ = false; return false; }
+    std::memcpy(data, data_ + position_, size);
+    position_ += size;
+    return true;
+}
+
+bool SnapshotChunk::readString(char* text, size_t capacity) {
+    uint8_t length = 0;
+    if (!read(length) || length >= capacity || !readBytes(text, length)) { valid_ = false; return false; }
+    text[length] = '\0';
+    return true;
+}
+
+// --- Mapping ---
+MappedSnapshot::~MappedSnapshot() {
+    close();
+}
+
+bool MappedSnapshot::open(const std::string& path) {
+    close();
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false; // No snapshot yet
+    LARGE_INTEGER fileSize;
+    HANDLE mapping = nullptr;
+    const void* view = nullptr;
+    if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart >= static_cast<LONGLONG>(HEADER_BYTES)) {
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping) view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    }
+    if (!view) {
+        if (mapping) CloseHandle(mapping);
+        CloseHandle(file);
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "SaveSnapshot: Could not map '%s'.", path.c_str());
+        return false;
+    }
+    file_ = file;
+    mapping_ = mapping;
+    data_ = static_cast<const uint8_t*>(view);
+    size_ = static_cast<size_t>(fileSize.QuadPart);
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false; // No snapshot yet
+    struct stat info;
+    void* view = MAP_FAILED;
+    if (fstat(fd, &info) == 0 && info.st_size >= static_cast<off_t>(HEADER_BYTES)) {
+        view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    ::close(fd); // The mapping keeps the file alive
+    if (view == MAP_FAILED) { SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "SaveSnapshot: Could not map '%s'.", path.c_str()); return false; }
+    data_ = static_cast<const uint8_t*>(view);
+    size_ = static_cast<size_t>(info.st_size);
+#endif
+
+    const uint32_t payloadBytes = get32(data_ + 8);
+    const char* problem = nullptr;
+    if (get32(data_) != SNAPSHOT_MAGIC) problem = "not a snapshot";
+    else if (get16(data_ + 4) != SNAPSHOT_FORMAT_VERSION) problem = "written by an incompatible version";
+    else if (payloadBytes != size_ - HEADER_BYTES) problem = "truncated";
+    else if (get32(data_ + 12) != checksum(data_ + HEADER_BYTES, payloadBytes)) problem = "corrupt";
+    if (problem) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "SaveSnapshot: Ignoring '%s' (%s).", path.c_str(), problem);
+        close();
+        return false;
+    }
+    return true;
+}
+
+void MappedSnapshot::close() {
+    if (!data_) return;
+#ifdef _WIN32
+    UnmapViewOfFile(data_);
+    CloseHandle(static_cast<HANDLE>(mapping_));
+    CloseHandle(static_cast<HANDLE>(file_));
+    mapping_ = file_ = nullptr;
+#else
+    munmap(const_cast<uint8_t*>(data_), size_);
+#endif
+    data_ = nullptr;
+    size_ = 0;
+}
+
+bool MappedSnapshot::nextChunk(size_t& cursor, SnapshotChunk& chunk) const {
+    if (!data_) return false;
+    if (cursor < HEADER_BYTES) cursor = HEADER_BYTES;
+    if (size_ - cursor < CHUNK_HEADER_BYTES) return false;
+    const uint32_t chunkSize = get32(data_ + cursor + 8);
+    if (chunkSize > size_ - cursor - CHUNK_HEADER_BYTES) return false; // Checksum passed, so only a writer bug gets here
+    chunk = SnapshotChunk();
+    chunk.id_ = get32(data_ + cursor);
+    chunk.version_ = get16(data_ + cursor + 4);
+    chunk.data_ = data_ + cursor + CHUNK_HEADER_BYTES;
+    chunk.size_ = chunkSize;
+    cursor += CHUNK_HEADER_BYTES + chunkSize;
+    return true;
+}
+
+bool MappedSnapshot::findChunk(uint32_t id, SnapshotChunk& chunk) const {
+    size_t cursor = 0;
+    while (nextChunk(cursor, chunk)) {
+        if (chunk.getId() == id) return true;
+    }
+    return false;
+}
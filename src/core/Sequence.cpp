@@ -0,0 +1,73 @@
+// File: src/core/Sequence.cpp
+
+#include "core/Sequence.h" // Include own header
+#include "core/MemoryBudget.h"
+#include <SDL_log.h>
+#include <new>
+
+namespace {
+#if defined(DIGIVICE_NO_HEAP)
+    // Coroutine frames for the no-heap build. Sequences start and finish on the
+    // frame thread only (state update and push/pop), so the pool needs no lock.
+    struct SequenceFramePool {
+        alignas(std::max_align_t) unsigned char blocks[MAX_SEQUENCES][SEQUENCE_FRAME_BYTES];
+        bool used[MAX_SEQUENCES] = {};
+    };
+    SequenceFramePool framePool;
+#endif
+} // end anonymous namespace
+
+
+// --- Frames ---
+void* Sequence::promise_type::operator new(size_t size) noexcept {
+#if defined(DIGIVICE_NO_HEAP)
+    if (size <= SEQUENCE_FRAME_BYTES) {
+        for (size_t i = 0; i < MAX_SEQUENCES; ++i) {
+            if (!framePool.used[i]) { framePool.used[i] = true; return framePool.blocks[i]; }
+        }
+    }
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Sequence: No frame for %zu bytes (%zu blocks of %zu); sequence not started.",
+                 size, MAX_SEQUENCES, SEQUENCE_FRAME_BYTES);
+    return nullptr;
+#else
+    void* frame = ::operator new(size, std::nothrow);
+    if (!frame) SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Sequence: Out of memory for a %zu-byte frame; sequence not started.", size);
+    return frame;
+#endif
+}
+
+void Sequence::promise_type::operator delete(void* frame, size_t size) noexcept {
+#if defined(DIGIVICE_NO_HEAP)
+    (void)size;
+    for (size_t i = 0; i < MAX_SEQUENCES; ++i) {
+        if (frame == framePool.blocks[i]) { framePool.used[i] = false; return; }
+    }
+#else
+    ::operator delete(frame, size);
+#endif
+}
+
+// --- Ownership ---
+Sequence& Sequence::operator=(Sequence&& other) noexcept {
+    if (this != &other) {
+        reset();
+        handle_ = other.handle_;
+        other.handle_ = nullptr;
+    }
+    return *this;
+}
+
+void Sequence::reset() {
+    if (!handle_) return;
+    promise_type& promise = handle_.promise();
+    if (promise.timers) promise.timers->cancel(promise.wait);
+    handle_.destroy();
+    handle_ = nullptr;
+}
+
+// --- Waiting ---
+void SequenceWait::resume(void* address) {
+    Sequence::Handle handle = Sequence::Handle::from_address(address);
+    handle.promise().timers = nullptr; // The wait has fired; nothing to cancel any more
+    handle.resume();
+}
@@ -0,0 +1,38 @@
+// File: src/core/StatePool.cpp
+
+#include "core/StatePool.h" // Include own header
+#include <SDL_log.h>
+
+#if defined(DIGIVICE_NO_HEAP)
+
+namespace {
+    struct alignas(std::max_align_t) StateSlot {
+        unsigned char bytes[STATE_SLOT_BYTES];
+    };
+
+    StateSlot g_slots[StatePool::SLOT_COUNT];
+    bool g_inUse[StatePool::SLOT_COUNT] = {};
+} // end anonymous namespace
+
+void* StatePool::acquire() {
+    for (size_t i = 0; i < SLOT_COUNT; ++i) {
+        if (g_inUse[i]) continue;
+        g_inUse[i] = true;
+        return g_slots[i].bytes;
+    }
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "StatePool: All %zu state slots are in use; raise MAX_STATE_DEPTH.", SLOT_COUNT);
+    return nullptr;
+}
+
+void StatePool::release(void* slot) {
+    for (size_t i = 0; i < SLOT_COUNT; ++i) {
+        if (g_slots[i].bytes == slot) { g_inUse[i] = false; return; }
+    }
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "StatePool: Released %p, which is not a state slot.", slot);
+}
+
+size_t StatePool::getStorageBytes() {
+    return sizeof(g_slots) + sizeof(g_inUse);
+}
+
+#endif
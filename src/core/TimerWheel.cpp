@@ -0,0 +1,162 @@
+// File: src/core/TimerWheel.cpp
+
+#include "core/TimerWheel.h" // Include own header
+#include <SDL_log.h>
+#include <bit>               // std::countr_zero
+
+namespace {
+    const uint64_t SLOT_MASK = TimerWheel::SLOTS_PER_LEVEL - 1;
+
+    uint32_t slotIndex(uint32_t level, uint64_t tick) {
+        return level * TimerWheel::SLOTS_PER_LEVEL + static_cast<uint32_t>((tick >> (level * TimerWheel::LEVEL_BITS)) & SLOT_MASK);
+    }
+} // end anonymous namespace
+
+
+TimerWheel::TimerWheel() = default;
+
+// --- Scheduling ---
+TimerHandle TimerWheel::schedule(uint64_t delayTicks, TimerCallback callback, void* context) {
+    const uint32_t index = allocate();
+    if (index == NONE) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "TimerWheel: All %zu timers are pending; timer dropped.", nodes_.size());
+        return TimerHandle();
+    }
+    TimerNode& node = nodes_[index];
+    node.deadline = now_ + (delayTicks > 0 ? delayTicks : 1); // Never the tick being processed
+    node.callback = callback;
+    node.context = context;
+    file(index);
+    ++pending_;
+    TimerHandle handle;
+    handle.index = index;
+    handle.generation = node.generation;
+    return handle;
+}
+
+bool TimerWheel::cancel(TimerHandle handle) {
+    if (!isPending(handle)) return false;
+    unlink(handle.index);
+    release(handle.index);
+    --pending_;
+    return true;
+}
+
+bool TimerWheel::isPending(TimerHandle handle) const {
+    return handle.isValid() && handle.index < nodes_.size() && nodes_[handle.index].generation == handle.generation &&
+           nodes_[handle.index].list != FREE;
+}
+
+// --- Advancing ---
+void TimerWheel::advance(uint32_t deltaTicks) {
+    const uint64_t target = now_ + deltaTicks;
+    while (now_ < target) {
+        const uint64_t tick = now_ + 1;
+        const uint32_t index = static_cast<uint32_t>(tick & SLOT_MASK);
+        if (index == 0) {
+            // Level 0 wrapped: pull the next slot of each level that also wrapped down a level
+            for (uint32_t level = 1; level < LEVELS; ++level) {
+                cascade(level);
+                if (((tick >> (level * LEVEL_BITS)) & SLOT_MASK) != 0) break;
+            }
+        }
+        // Skip straight to the next non-empty slot in this turn of level 0
+        const uint64_t ahead = occupied_[0] >> index;
+        if (ahead == 0) {
+            const uint64_t turnEnd = tick | SLOT_MASK;
+            now_ = turnEnd < target ? turnEnd : target;
+            continue;
+        }
+        const uint64_t due = tick + static_cast<uint64_t>(std::countr_zero(ahead));
+        if (due > target) { now_ = target; break; }
+        now_ = due;
+        fireSlot(static_cast<uint32_t>(due & SLOT_MASK));
+    }
+}
+
+void TimerWheel::cascade(uint32_t level) {
+    const uint32_t slot = slotIndex(level, now_ + 1);
+    uint32_t index = lists_[slot].head;
+    lists_[slot] = TimerList();
+    occupied_[level] &= ~(1ull << (slot & SLOT_MASK));
+    while (index != NONE) {
+        const uint32_t next = nodes_[index].next;
+        file(index);
+        index = next;
+    }
+}
+
+void TimerWheel::fireSlot(uint32_t slot) {
+    // Detach the slot first: callbacks may schedule into it or cancel timers still waiting here
+    for (uint32_t index = lists_[slot].head; index != NONE; index = nodes_[index].next) nodes_[index].list = FIRING;
+    lists_[FIRING] = lists_[slot];
+    lists_[slot] = TimerList();
+    occupied_[0] &= ~(1ull << slot);
+    while (lists_[FIRING].head != NONE) {
+        const uint32_t index = lists_[FIRING].head;
+        const TimerCallback callback = nodes_[index].callback;
+        void* context = nodes_[index].context;
+        unlink(index);
+        release(index);
+        --pending_;
+        callback(context);
+    }
+}
+
+// --- Lists ---
+void TimerWheel::file(uint32_t index) {
+    const uint64_t base = now_ + 1;
+    uint64_t deadline = nodes_[index].deadline;
+    if (deadline < base) deadline = base;                            // Only when re-filed late; fire next tick
+    if (deadline - base > MAX_DELAY) deadline = base + MAX_DELAY;    // Parks in the top level; the real deadline is kept
+    const uint64_t delta = deadline - base;
+    uint32_t level = 0;
+    while (level + 1 < LEVELS && delta >= (1ull << ((level + 1) * LEVEL_BITS))) ++level;
+    const uint32_t slot = slotIndex(level, deadline);
+    append(slot, index);
+    occupied_[level] |= 1ull << (slot & SLOT_MASK);
+}
+
+void TimerWheel::append(uint32_t list, uint32_t index) {
+    TimerNode& node = nodes_[index];
+    node.list = list;
+    node.next = NONE;
+    node.prev = lists_[list].tail;
+    if (node.prev != NONE) nodes_[node.prev].next = index;
+    else lists_[list].head = index;
+    lists_[list].tail = index;
+}
+
+void TimerWheel::unlink(uint32_t index) {
+    TimerNode& node = nodes_[index];
+    TimerList& list = lists_[node.list];
+    if (node.prev != NONE) nodes_[node.prev].next = node.next;
+    else list.head = node.next;
+    if (node.next != NONE) nodes_[node.next].prev = node.prev;
+    else list.tail = node.prev;
+    if (list.head == NONE && node.list < SLOT_COUNT) occupied_[node.list / SLOTS_PER_LEVEL] &= ~(1ull << (node.list & SLOT_MASK));
+    node.prev = node.next = NONE;
+}
+
+// --- Node Pool ---
+uint32_t TimerWheel::allocate() {
+    if (freeHead_ != NONE) {
+        const uint32_t index = freeHead_;
+        freeHead_ = nodes_[index].next;
+        nodes_[index].next = NONE;
+        return index;
+    }
+    if (nodes_.size() >= nodes_.max_size() || nodes_.size() >= NONE) return NONE;
+    nodes_.push_back(TimerNode());
+    return static_cast<uint32_t>(nodes_.size() - 1);
+}
+
+void TimerWheel::release(uint32_t index) {
+    TimerNode& node = nodes_[index];
+    node.list = FREE;
+    node.callback = nullptr;
+    node.context = nullptr;
+    if (++node.generation == 0) node.generation = 1; // Stale handles never match a reused node
+    node.next = freeHead_;
+    freeHead_ = index;
+}
@@ -0,0 +1,205 @@
+// File: src/entities/Digimon.cpp
+
+#include "entities/Digimon.h" // Include own header
+#include <SDL_log.h>          // SDL logging
+#include <cmath>              // std::fabs, std::cos, std::sin
+#include <utility>            // std::swap
+
+namespace {
+    const float TWO_PI = 6.28318530718f;
+    const float MIN_FRAME_DURATION_SEC = 0.001f; // Zero-length frames would stall the cursor math
+} // end anonymous namespace
+
+
+// --- Setup ---
+AnimClipId DigimonPool::addClip(const Animation& anim) {
+    AnimClip newClip;
+    newClip.firstFrame = static_cast<uint32_t>(frameRects_.size());
+    newClip.frameCount = static_cast<uint32_t>(anim.getFrameCount());
+    newClip.loops = anim.loops;
+
+    SDL_Texture* clipSheet = nullptr;
+    for (size_t i = 0; i < anim.getFrameCount(); ++i) {
+        const SpriteFrame& spriteFrame = anim.frames[i];
+        if (!clipSheet) clipSheet = spriteFrame.texturePtr;
+        if (spriteFrame.texturePtr != clipSheet) {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "DigimonPool::addClip: Frame %zu uses a different sheet; pool clips draw from the first frame's sheet.", i);
+        }
+        frameRects_.push_back(spriteFrame.sourceRect);
+        frameOffsets_.push_back(spriteFrame.anchorOffset());
+        float duration_sec = (i < anim.frame_durations_ms.size()) ? anim.frame_durations_ms[i] / 1000.0f : 0.0f;
+        frameDurations_.push_back(duration_sec > MIN_FRAME_DURATION_SEC ? duration_sec : MIN_FRAME_DURATION_SEC);
+    }
+    if (newClip.frameCount == 0) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "DigimonPool::addClip: Animation has no frames; adding an empty placeholder frame.");
+        frameRects_.push_back({0, 0, 0, 0});
+        frameOffsets_.push_back({0, 0});
+        frameDurations_.push_back(1.0f);
+        newClip.frameCount = 1;
+    }
+
+    clips_.push_back(newClip);
+    clipSheets_.push_back(clipSheet);
+    return static_cast<AnimClipId>(clips_.size() - 1);
+}
+
+size_t DigimonPool::spawn(float x, float y, float vx, float vy, AnimClipId clipId) {
+    if (clipId >= clips_.size()) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "DigimonPool::spawn: Unknown clip %u.", (unsigned)clipId);
+        return static_cast<size_t>(-1);
+    }
+    posX.push_back(x);
+    posY.push_back(y);
+    velX.push_back(vx);
+    velY.push_back(vy);
+    wanderTimer.push_back(randomRange(wanderMin_, wanderMax_));
+    clip.push_back(clipId);
+    frame.push_back(0);
+    frameTime.push_back(0.0f);
+    sheet.push_back(clipSheets_[clipId]);
+    return size() - 1;
+}
+
+void DigimonPool::despawn(size_t index) {
+    if (index >= size()) { SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "DigimonPool::despawn: Index %zu out of range.", index); return; }
+    // Swap-remove keeps every column dense
+    const size_t last = size() - 1;
+    if (index != last) {
+        std::swap(posX[index], posX[last]);
+        std::swap(posY[index], posY[last]);
+        std::swap(velX[index], velX[last]);
+        std::swap(velY[index], velY[last]);
+        std::swap(wanderTimer[index], wanderTimer[last]);
+        std::swap(clip[index], clip[last]);
+        std::swap(frame[index], frame[last]);
+        std::swap(frameTime[index], frameTime[last]);
+        std::swap(sheet[index], sheet[last]);
+    }
+    posX.pop_back(); posY.pop_back();
+    velX.pop_back(); velY.pop_back();
+    wanderTimer.pop_back();
+    clip.pop_back(); frame.pop_back(); frameTime.pop_back();
+    sheet.pop_back();
+}
+
+void DigimonPool::clear() {
+    posX.clear(); posY.clear();
+    velX.clear(); velY.clear();
+    wanderTimer.clear();
+    clip.clear(); frame.clear(); frameTime.clear();
+    sheet.clear();
+}
+
+void DigimonPool::reserve(size_t count) {
+    posX.reserve(count); posY.reserve(count);
+    velX.reserve(count); velY.reserve(count);
+    wanderTimer.reserve(count);
+    clip.reserve(count); frame.reserve(count); frameTime.reserve(count);
+    sheet.reserve(count);
+}
+
+void DigimonPool::setWanderParams(float minInterval, float maxInterval, float maxSpeed) {
+    wanderMin_ = minInterval > 0.0f ? minInterval : 0.1f;
+    wanderMax_ = maxInterval > wanderMin_ ? maxInterval : wanderMin_;
+    maxSpeed_ = maxSpeed;
+}
+
+float DigimonPool::randomRange(float lo, float hi) {
+    // xorshift32: cheap and deterministic for a given spawn order
+    rngState_ ^= rngState_ << 13;
+    rngState_ ^= rngState_ >> 17;
+    rngState_ ^= rngState_ << 5;
+    return lo + (hi - lo) * ((rngState_ >> 8) * (1.0f / 16777216.0f));
+}
+
+
+// --- Systems ---
+void DigimonPool::updateWander(float delta_time) {
+    const size_t count = size();
+    float* timers = wanderTimer.data();
+    for (size_t i = 0; i < count; ++i) {
+        timers[i] -= delta_time;
+    }
+    // Re-rolls are rare per frame, so this scalar pass stays cheap
+    for (size_t i = 0; i < count; ++i) {
+        if (timers[i] > 0.0f) continue;
+        float angle = randomRange(0.0f, TWO_PI);
+        float speed = randomRange(0.0f, maxSpeed_);
+        velX[i] = std::cos(angle) * speed;
+        velY[i] = std::sin(angle) * speed;
+        timers[i] = randomRange(wanderMin_, wanderMax_);
+    }
+}
+
+void DigimonPool::updateMovement(float delta_time) {
+    const size_t count = size();
+    float* px = posX.data(); float* py = posY.data();
+    float* vx = velX.data(); float* vy = velY.data();
+    const float minX = static_cast<float>(bounds_.x);
+    const float minY = static_cast<float>(bounds_.y);
+    const float maxX = static_cast<float>(bounds_.x + bounds_.w);
+    const float maxY = static_cast<float>(bounds_.y + bounds_.h);
+
+    for (size_t i = 0; i < count; ++i) {
+        px[i] += vx[i] * delta_time;
+        py[i] += vy[i] * delta_time;
+    }
+    // Branch-free bounce: clamp to the bounds and point the velocity back inside
+    for (size_t i = 0; i < count; ++i) {
+        const float x = px[i];
+        const float y = py[i];
+        const float speedX = std::fabs(vx[i]);
+        const float speedY = std::fabs(vy[i]);
+        px[i] = x < minX ? minX : (x > maxX ? maxX : x);
+        py[i] = y < minY ? minY : (y > maxY ? maxY : y);
+        vx[i] = x < minX ? speedX : (x > maxX ? -speedX : vx[i]);
+        vy[i] = y < minY ? speedY : (y > maxY ? -speedY : vy[i]);
+    }
+}
+
+void DigimonPool::updateAnimation(float delta_time) {
+    const size_t count = size();
+    const AnimClip* clipTable = clips_.data();
+    const float* durations = frameDurations_.data();
+    const AnimClipId* clipIds = clip.data();
+    uint32_t* frames = frame.data();
+    float* times = frameTime.data();
+
+    // At most one frame advance per tick: Game clamps delta_time to 0.1s, below any real frame length
+    for (size_t i = 0; i < count; ++i) {
+        const AnimClip& c = clipTable[clipIds[i]];
+        const uint32_t current = frames[i];
+        const float t = times[i] + delta_time;
+        const float duration = durations[c.firstFrame + current];
+        const bool advance = t >= duration;
+        const uint32_t next = current + 1;
+        const uint32_t wrapped = c.loops ? 0u : c.frameCount - 1; // Non-looping clips hold their last frame
+        frames[i] = advance ? (next >= c.frameCount ? wrapped : next) : current;
+        times[i] = advance ? t - duration : t;
+    }
+}
+
+void DigimonPool::emitDrawCommands(std::vector<DrawCommand>& out) const {
+    const size_t count = size();
+    const size_t base = out.size();
+    out.resize(base + count);
+    DrawCommand* cmds = out.data() + base;
+    const AnimClip* clipTable = clips_.data();
+    const SDL_Rect* rects = frameRects_.data();
+    const SDL_Point* offsets = frameOffsets_.data();
+
+    for (size_t i = 0; i < count; ++i) {
+        const uint32_t frameIndex = clipTable[clip[i]].firstFrame + frame[i];
+        const SDL_Rect& src = rects[frameIndex];
+        const SDL_Point& offset = offsets[frameIndex];
+        DrawCommand& cmd = cmds[i];
+        cmd.texture = sheet[i];
+        cmd.srcRect = src;
+        // Sheets face left; mirror anything walking right. Mirroring the whole cell
+        // about the pivot moves a trimmed rect's left edge to -(offset.x + w).
+        const bool mirrored = velX[i] > 0.0f;
+        const int offsetX = mirrored ? -offset.x - src.w : offset.x;
+        cmd.dstRect = { static_cast<int>(posX[i]) + offsetX, static_cast<int>(posY[i]) + offset.y, src.w, src.h };
+        cmd.flip = mirrored ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE;
+    }
+}
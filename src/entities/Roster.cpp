@@ -0,0 +1,74 @@
+// File: src/entities/Roster.cpp
+
+#include "entities/Roster.h" // Include own header
+#include <SDL_log.h>
+#include <fstream>
+#include <limits>
+#include "vendor/nlohmann/json.hpp"
+
+using json = nlohmann::json;
+
+
+// --- Loading ---
+bool Roster::loadFromJson(const std::string& jsonPath) {
+    entries_.clear();
+    // Evolution targets may point forward in the file, so they resolve after every key is known
+    std::vector<std::vector<std::string>> evolutionKeys;
+    try {
+        std::ifstream jsonFile(jsonPath);
+        if (!jsonFile.is_open()) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to open roster JSON: %s", jsonPath.c_str()); return false; }
+        json data = json::parse(jsonFile);
+        jsonFile.close();
+        if (!data.contains("digimon") || !data["digimon"].is_array()) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Missing 'digimon' array in %s", jsonPath.c_str()); return false; }
+
+        const size_t maxEntries = std::numeric_limits<DigimonId>::max(); // NO_DIGIMON stays free
+        for (const auto& entryData : data["digimon"]) {
+            if (!entryData.contains("id") || !entryData.contains("texture") || !entryData.contains("path") || !entryData.contains("frames")) {
+                SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Roster entry %zu missing 'id', 'texture', 'path' or 'frames' in %s; skipped.", entries_.size(), jsonPath.c_str());
+                continue;
+            }
+            if (entries_.size() >= maxEntries) { SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Roster '%s' holds more than %zu entries; the rest are ignored.", jsonPath.c_str(), maxEntries); break; }
+            RosterEntry entry;
+            entry.key = entryData["id"].get<std::string>();
+            if (find(entry.key.c_str()) != NO_DIGIMON) { SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Roster id '%s' listed twice in %s; keeping the first.", entry.key.c_str(), jsonPath.c_str()); continue; }
+            entry.name = entryData.value("name", entry.key);
+            entry.textureId = entryData["texture"].get<std::string>();
+            entry.sheetPath = entryData["path"].get<std::string>();
+            entry.framesPath = entryData["frames"].get<std::string>();
+            evolutionKeys.push_back(entryData.value("evolves_to", std::vector<std::string>()));
+            entries_.push_back(std::move(entry));
+        }
+    } catch (json::parse_error& e) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to parse roster JSON '%s': %s (at byte %zu)", jsonPath.c_str(), e.what(), e.byte); entries_.clear(); return false; }
+      catch (const std::exception& e) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Error reading roster JSON '%s': %s", jsonPath.c_str(), e.what()); entries_.clear(); return false; }
+
+    for (size_t i = 0; i < entries_.size(); ++i) {
+        for (const std::string& key : evolutionKeys[i]) {
+            const DigimonId target = find(key.c_str());
+            if (target == NO_DIGIMON) { SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Roster: '%s' evolves to unknown '%s'; ignored.", entries_[i].key.c_str(), key.c_str()); continue; }
+            entries_[i].evolvesTo.push_back(target);
+        }
+    }
+
+    if (entries_.empty()) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Roster '%s' has no usable entries.", jsonPath.c_str()); return false; }
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Roster: Loaded %zu Digimon from '%s'.", entries_.size(), jsonPath.c_str());
+    return true;
+}
+
+// --- Lookup ---
+DigimonId Roster::find(const char* key) const {
+    if (!key) return NO_DIGIMON;
+    for (size_t i = 0; i < entries_.size(); ++i) {
+        if (entries_[i].key == key) return static_cast<DigimonId>(i);
+    }
+    return NO_DIGIMON;
+}
+
+DigimonId Roster::next(DigimonId id) const {
+    if (!isValid(id)) return NO_DIGIMON;
+    return static_cast<DigimonId>((id + 1u) % entries_.size());
+}
+
+DigimonId Roster::previous(DigimonId id) const {
+    if (!isValid(id)) return NO_DIGIMON;
+    return static_cast<DigimonId>((id + entries_.size() - 1) % entries_.size());
+}
@@ -0,0 +1,178 @@
+// File: src/entities/RosterSheets.cpp
+
+#include "entities/RosterSheets.h" // Include own header
+#include "core/AssetManager.h"     // Sheet textures
+#include "core/JobSystem.h"        // Background decodes
+#include "core/AllocTracker.h"     // Sheet loads are counted as LOADING
+#include "core/MemoryBudget.h"     // MAX_PALETTED_SHEETS
+#include "graphics/SurfaceScale.h" // Small-screen variants
+#include <SDL_log.h>               // SDL logging
+#include <thread>                  // std::this_thread::yield
+#include <utility>                 // std::move
+
+// Wanted sheets plus one loaded on the spot must fit next to the non-roster sheets
+static_assert(RosterSheets::MAX_WANTED < MAX_PALETTED_SHEETS, "Raise MAX_PALETTED_SHEETS for more wanted sheets");
+
+RosterSheets::~RosterSheets() {
+    shutdown();
+}
+
+void RosterSheets::init(const Roster* roster, AssetManager* assets, JobSystem* jobs) {
+    shutdown();
+    roster_ = roster;
+    assets_ = assets;
+    jobs_ = jobs;
+    const size_t count = roster_ ? roster_->size() : 0;
+    sheets_.resize(count);
+    // Sized up front so uploads and decode results never grow them mid-frame
+    resident_.reserve(count);
+    decoded_.reserve(count);
+}
+
+void RosterSheets::shutdown() {
+    // Queued decodes still read roster entries and push into decoded_; let them drain
+    while (decodesInFlight_.load() > 0) std::this_thread::yield();
+    for (DecodedSheet& done : decoded_) {
+        if (done.surface) SDL_FreeSurface(done.surface);
+    }
+    decoded_.clear();
+    while (!resident_.empty()) unload(resident_.back());
+    sheets_.clear();
+    wantedCount_ = 0;
+    roster_ = nullptr;
+    assets_ = nullptr;
+    jobs_ = nullptr;
+}
+
+
+// --- Residency ---
+void RosterSheets::setWanted(const DigimonId* ids, size_t count) {
+    for (size_t i = 0; i < wantedCount_; ++i) sheets_[wanted_[i]].wanted = false;
+    wantedCount_ = 0;
+    for (size_t i = 0; i < count && wantedCount_ < MAX_WANTED; ++i) {
+        if (ids[i] >= sheets_.size() || sheets_[ids[i]].wanted) continue; // Unknown or listed twice
+        sheets_[ids[i]].wanted = true;
+        wanted_[wantedCount_++] = ids[i];
+    }
+}
+
+bool RosterSheets::updateResidency(size_t maxUploads) {
+    bool changed = false;
+
+    // Most important first, so the partner's sheet is at the front of the job queue
+    for (size_t i = 0; i < wantedCount_; ++i) {
+        if (sheets_[wanted_[i]].status == SheetStatus::UNLOADED) queueDecode(wanted_[i]);
+    }
+
+    for (size_t uploads = 0; uploads < maxUploads; ++uploads) {
+        DecodedSheet done;
+        {
+            std::lock_guard<std::mutex> lock(decodedMutex_);
+            if (decoded_.empty()) break;
+            done = std::move(decoded_.back());
+            decoded_.pop_back();
+        }
+        Sheet& sheet = sheets_[done.id];
+        // loadNow() may have settled it while the job ran; only LOADING sheets take the result
+        if (sheet.status == SheetStatus::LOADING) {
+            if (!done.surface) sheet.status = SheetStatus::FAILED;
+            else if (!sheet.wanted) sheet.status = SheetStatus::UNLOADED;
+            else changed |= upload(done);
+        }
+        if (done.surface) SDL_FreeSurface(done.surface);
+    }
+
+    for (size_t i = resident_.size(); i-- > 0;) {
+        if (!sheets_[resident_[i]].wanted) { unload(resident_[i]); changed = true; }
+    }
+    return changed;
+}
+
+bool RosterSheets::loadNow(DigimonId id) {
+    if (id >= sheets_.size()) return false;
+    const SheetStatus status = sheets_[id].status;
+    if (status == SheetStatus::RESIDENT) return true;
+    if (status == SheetStatus::FAILED) return false;
+    SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "RosterSheets: Sheet '%s' needed before it was prefetched, loading synchronously.", roster_->get(id).key.c_str());
+    const FramePhase phase = AllocTracker::getPhase();
+    AllocTracker::setPhase(FramePhase::LOADING); // Decoding and uploading allocate, like any load
+    DecodedSheet done = decodeSheet(id); // A job already queued for it finds the sheet settled and is dropped
+    bool ok = false;
+    if (!done.surface) sheets_[id].status = SheetStatus::FAILED;
+    else ok = upload(done);
+    if (done.surface) SDL_FreeSurface(done.surface);
+    AllocTracker::setPhase(phase);
+    return ok;
+}
+
+bool RosterSheets::isResident(DigimonId id) const {
+    return id < sheets_.size() && sheets_[id].status == SheetStatus::RESIDENT;
+}
+
+bool RosterSheets::hasFailed(DigimonId id) const {
+    return id < sheets_.size() && sheets_[id].status == SheetStatus::FAILED;
+}
+
+SDL_Texture* RosterSheets::getTexture(DigimonId id) const {
+    return isResident(id) ? sheets_[id].texture : nullptr;
+}
+
+const std::vector<SpriteFrame>& RosterSheets::getFrames(DigimonId id) const {
+    static const std::vector<SpriteFrame> noFrames;
+    return isResident(id) ? sheets_[id].frames : noFrames;
+}
+
+
+// --- Background Decoding ---
+void RosterSheets::queueDecode(DigimonId id) {
+    sheets_[id].status = SheetStatus::LOADING;
+    decodesInFlight_.fetch_add(1);
+    auto decode = [this, id]() {
+        DecodedSheet done = decodeSheet(id);
+        {
+            std::lock_guard<std::mutex> lock(decodedMutex_);
+            decoded_.push_back(std::move(done)); // Failed decodes too, so the sheet leaves LOADING
+        }
+        decodesInFlight_.fetch_sub(1);
+    };
+    if (!jobs_) { decode(); return; }
+    jobs_->run(jobs_->createJob(decode));
+}
+
+RosterSheets::DecodedSheet RosterSheets::decodeSheet(DigimonId id) const {
+    const RosterEntry& entry = roster_->get(id);
+    const DisplayProfile& profile = assets_->getDisplayProfile(); // Set before any sheet loads
+    DecodedSheet done{ id, nullptr, {} };
+    if (!loadSpriteSheetFrames(entry.framesPath, done.frames)) return done; // Logs its own errors
+    // Pixel art keeps hard edges at small sizes; the frame rects follow the sheet down
+    done.surface = loadScaledSurface(entry.sheetPath, profile, ScaleFilter::NEAREST); // Logs its own errors
+    scaleSpriteFrames(done.frames, profile.divisor);
+    return done;
+}
+
+bool RosterSheets::upload(DecodedSheet& decoded) {
+    const RosterEntry& entry = roster_->get(decoded.id);
+    Sheet& sheet = sheets_[decoded.id];
+    SDL_Texture* texture = assets_->addPalettedSheet(entry.textureId, decoded.surface) ? assets_->getTexture(entry.textureId.c_str()) : nullptr;
+    if (!texture) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "RosterSheets: Upload failed for '%s'; it won't be retried.", entry.key.c_str());
+        sheet.status = SheetStatus::FAILED;
+        return false;
+    }
+    sheet.texture = texture;
+    sheet.frames = std::move(decoded.frames);
+    sheet.status = SheetStatus::RESIDENT;
+    resident_.push_back(decoded.id);
+    return true;
+}
+
+void RosterSheets::unload(DigimonId id) {
+    Sheet& sheet = sheets_[id];
+    sheet.texture = nullptr;
+    std::vector<SpriteFrame>().swap(sheet.frames); // Give the memory back, not just the size
+    sheet.status = SheetStatus::UNLOADED;
+    assets_->unloadTexture(roster_->get(id).textureId.c_str());
+    for (size_t i = 0; i < resident_.size(); ++i) {
+        if (resident_[i] == id) { resident_[i] = resident_.back(); resident_.pop_back(); break; }
+    }
+}
@@ -1,17 +1,182 @@
 // File: src/graphics/Animation.cpp
 
 #include "graphics/Animation.h" // Include own header
+#include <SDL_log.h>            // SDL logging
+#include <fstream>              // For reading sheet JSON files
+#include "vendor/nlohmann/json.hpp" // Path to JSON library header
+#include <algorithm>              // std::max
 
-// If the Animation class needs more complex logic (e.g., loading from file),
-// the implementation would go here.
-// For now, since it's mostly data storage defined in the header,
-// this file might be empty or contain minimal helper function implementations
-// if you add any later.
-
-// Example (if needed):
-// void Animation::calculateTotalDuration() {
-//     total_duration = 0;
-//     for(Uint32 duration : frame_durations_ms) {
-//         total_duration += duration;
-//     }
-// }
\ No newline at end of file
+// Use the nlohmann::json namespace
+using json = nlohmann::json;
+
+
+namespace {
+    bool readRect(const json& node, SDL_Rect& out) {
+        if (!node.is_object() || !node.contains("x") || !node.contains("y") || !node.contains("w") || !node.contains("h")) return false;
+        out = { node["x"].get<int>(), node["y"].get<int>(), node["w"].get<int>(), node["h"].get<int>() };
+        return true;
+    }
+
+    // Fills one frame from a sheet entry. Untrimmed entries (or ones missing the
+    // trim fields) describe a cell that is exactly the 'frame' rect.
+    bool readSpriteFrame(const json& frameData, SpriteFrame& out) {
+        if (!frameData.contains("frame") || !readRect(frameData["frame"], out.sourceRect)) return false;
+        out.trimOffset = {0, 0};
+        out.sourceSize = {out.sourceRect.w, out.sourceRect.h};
+        if (frameData.value("trimmed", false)) {
+            SDL_Rect spriteSourceSize;
+            if (frameData.contains("spriteSourceSize") && readRect(frameData["spriteSourceSize"], spriteSourceSize)) {
+                out.trimOffset = {spriteSourceSize.x, spriteSourceSize.y};
+            }
+            if (frameData.contains("sourceSize")) {
+                const auto& size = frameData["sourceSize"];
+                out.sourceSize = {size.value("w", out.sourceRect.w), size.value("h", out.sourceRect.h)};
+            }
+        }
+        if (frameData.contains("pivot")) {
+            const auto& pivot = frameData["pivot"];
+            out.pivot = {pivot.value("x", 0.5f), pivot.value("y", 0.5f)};
+        }
+        return true;
+    }
+} // end anonymous namespace
+
+
+// --- Helper Function to Create Animation from Indices ---
+Animation createAnimationFromIndices(
+    SDL_Texture* texture,
+    const std::vector<SpriteFrame>& allFrames,
+    const std::vector<int>& indices,
+    const std::vector<Uint32>& durations,
+    bool loops)
+{
+    Animation anim;
+    anim.loops = loops; // Assign loops parameter
+    if (!texture) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Cannot create animation: Null texture provided."); return anim; }
+    if (indices.size() != durations.size()) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Animation creation error: Indices count (%zu) does not match durations count (%zu).", indices.size(), durations.size()); return anim; }
+    if (allFrames.empty()) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Cannot create animation: Provided frame list is empty."); return anim; }
+
+    for (size_t i = 0; i < indices.size(); ++i) {
+        int frameIndex = indices[i];
+        Uint32 duration = durations[i];
+        if (frameIndex < 0 || static_cast<size_t>(frameIndex) >= allFrames.size()) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Anim Creation: Index %d out of bounds (%zu). Using frame 0.", frameIndex, allFrames.size());
+            frameIndex = 0; // Placeholder
+        }
+        SpriteFrame frame = allFrames[frameIndex];
+        frame.texturePtr = texture;
+        if (!anim.addFrame(frame, duration)) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Anim Creation: More than %zu frames; truncating.", anim.frames.max_size());
+            break;
+        }
+    }
+    return anim;
+}
+
+Animation createAnimationFromIndices(
+    SDL_Texture* texture,
+    const std::vector<SDL_Rect>& allFrameRects,
+    const std::vector<int>& indices,
+    const std::vector<Uint32>& durations,
+    bool loops)
+{
+    std::vector<SpriteFrame> allFrames;
+    allFrames.reserve(allFrameRects.size());
+    for (const SDL_Rect& rect : allFrameRects) allFrames.emplace_back(texture, rect);
+    return createAnimationFromIndices(texture, allFrames, indices, durations, loops);
+}
+
+
+// --- Sprite Sheet JSON Parsing ---
+bool loadSpriteSheetFrames(const std::string& jsonPath, std::vector<SpriteFrame>& outFrames) {
+    outFrames.clear();
+    try {
+        std::ifstream jsonFile(jsonPath);
+        if (!jsonFile.is_open()) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to open JSON: %s", jsonPath.c_str()); return false; }
+        json data = json::parse(jsonFile);
+        jsonFile.close();
+        if (!data.contains("frames")) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Missing 'frames' in %s", jsonPath.c_str()); return false; }
+
+        const auto& framesNode = data["frames"];
+        // --- Handle BOTH Array and Object formats ---
+        if (framesNode.is_array()) {
+            SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION,"  Parsing '%s' as ARRAY", jsonPath.c_str());
+            for (const auto& frameData : framesNode) {
+                SpriteFrame frame;
+                if (readSpriteFrame(frameData, frame)) outFrames.push_back(frame);
+                else { SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "JSON frame missing 'frame' x,y,w or h in %s (array item)", jsonPath.c_str()); }
+            }
+        } else if (framesNode.is_object()) {
+            SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION,"  Parsing '%s' as OBJECT", jsonPath.c_str());
+            for (auto it = framesNode.begin(); it != framesNode.end(); ++it) {
+                SpriteFrame frame;
+                if (readSpriteFrame(it.value(), frame)) outFrames.push_back(frame);
+                else { SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "JSON frame missing 'frame' x,y,w or h in %s (object key: %s)", jsonPath.c_str(), it.key().c_str()); }
+            }
+        } else { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "'frames' not array/object in %s", jsonPath.c_str()); return false; }
+    } catch (json::parse_error& e) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to parse JSON file '%s': %s (at byte %zu)", jsonPath.c_str(), e.what(), e.byte); (void)e; return false; } // Mark e as unused
+      catch (const std::exception& e) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Error reading/processing JSON file '%s': %s", jsonPath.c_str(), e.what()); (void)e; return false; } // Mark e as unused
+
+    if (outFrames.empty()) { SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "No frames loaded from %s.", jsonPath.c_str()); return false; }
+    return true;
+}
+
+bool loadSpriteSheetFrameRects(const std::string& jsonPath, std::vector<SDL_Rect>& outRects) {
+    outRects.clear();
+    std::vector<SpriteFrame> frames;
+    if (!loadSpriteSheetFrames(jsonPath, frames)) return false;
+    outRects.reserve(frames.size());
+    for (const SpriteFrame& frame : frames) outRects.push_back(frame.sourceRect);
+    return true;
+}
+
+void scaleSpriteFrames(std::vector<SpriteFrame>& frames, int divisor) {
+    if (divisor <= 1) return;
+    for (SpriteFrame& frame : frames) {
+        // Both edges map down so neighbouring cells still share them
+        SDL_Rect& rect = frame.sourceRect;
+        const int x1 = (rect.x + rect.w) / divisor;
+        const int y1 = (rect.y + rect.h) / divisor;
+        rect.x /= divisor;
+        rect.y /= divisor;
+        rect.w = std::max(1, x1 - rect.x);
+        rect.h = std::max(1, y1 - rect.y);
+        frame.trimOffset.x /= divisor;
+        frame.trimOffset.y /= divisor;
+        frame.sourceSize.x = std::max(1, frame.sourceSize.x / divisor);
+        frame.sourceSize.y = std::max(1, frame.sourceSize.y / divisor);
+    }
+}
+
+
+// --- Playback ---
+bool stepAnimation(const Animation& anim, size_t& frameIdx, Scalar& elapsedSec, Scalar delta_time) {
+    bool cycleFinished = false;
+    if (anim.getFrameCount() == 0) return false;
+    size_t frameCount = anim.getFrameCount();
+    if (frameIdx >= frameCount) { frameIdx = 0; elapsedSec = 0; SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Animation frame index OOB, reset."); }
+
+    if (frameIdx < anim.frame_durations_ms.size()) {
+        Scalar duration_sec = scalarFromMs(anim.frame_durations_ms[frameIdx]);
+        if (duration_sec <= 0) {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Zero duration found for frame %zu, skipping.", frameIdx);
+            frameIdx++; elapsedSec = 0;
+            if (frameIdx >= frameCount) { cycleFinished = true; frameIdx = anim.loops ? 0 : frameCount - 1; }
+        } else {
+            elapsedSec += delta_time;
+            while (elapsedSec >= duration_sec) {
+                elapsedSec -= duration_sec; frameIdx++;
+                if (frameIdx >= frameCount) {
+                    cycleFinished = true;
+                    if (anim.loops) { frameIdx = 0; }
+                    else { frameIdx = frameCount - 1; elapsedSec = duration_sec; break; }
+                }
+                if (frameIdx < anim.frame_durations_ms.size()) {
+                    duration_sec = scalarFromMs(anim.frame_durations_ms[frameIdx]);
+                    if (duration_sec <= 0) { SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Zero duration frame %zu encountered during step.", frameIdx); continue; }
+                } else { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Anim index OOB during step!"); frameIdx = 0; elapsedSec = 0; break; }
+            }
+        }
+    } else { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Anim index OOB of durations!"); frameIdx = 0; elapsedSec = 0; }
+    return cycleFinished;
+}
@@ -0,0 +1,115 @@
+// File: src/graphics/BorderRenderer.cpp
+
+#include "graphics/BorderRenderer.h" // Include own header
+#include "platform/pc/pc_display.h"  // To draw
+#include <SDL_log.h>                 // SDL logging
+#include <fstream>                   // For reading the atlas JSON
+#include "vendor/nlohmann/json.hpp"  // Path to JSON library header
+#include <cmath>                     // For std::lround
+
+// Use the nlohmann::json namespace
+using json = nlohmann::json;
+
+namespace {
+    const char* const EDGE_KEYS[] = { "border_top", "border_bottom", "border_left", "border_right" };
+
+    SDL_Rect readRect(const json& node) {
+        return { node.value("x", 0), node.value("y", 0), node.value("w", 0), node.value("h", 0) };
+    }
+} // end anonymous namespace
+
+
+bool BorderRenderer::load(SDL_Texture* atlas, const std::string& jsonPath) {
+    atlas_ = nullptr;
+    if (!atlas) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "BorderRenderer: Null atlas texture."); return false; }
+
+    try {
+        std::ifstream jsonFile(jsonPath);
+        if (!jsonFile.is_open()) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to open border JSON: %s", jsonPath.c_str()); return false; }
+        json data = json::parse(jsonFile);
+        jsonFile.close();
+        if (!data.contains("frames") || !data["frames"].is_object()) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Missing 'frames' object in %s", jsonPath.c_str()); return false; }
+        const json& frames = data["frames"];
+
+        for (size_t edge = 0; edge < static_cast<size_t>(BorderEdge::COUNT); ++edge) {
+            if (!frames.contains(EDGE_KEYS[edge]) || !frames[EDGE_KEYS[edge]].contains("frame")) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "BorderRenderer: '%s' missing from %s", EDGE_KEYS[edge], jsonPath.c_str());
+                return false;
+            }
+            const json& entry = frames[EDGE_KEYS[edge]];
+            EdgeStrip strip;
+            strip.frame = readRect(entry["frame"]);
+            if (strip.frame.w <= 0 || strip.frame.h <= 0) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "BorderRenderer: '%s' has an empty frame.", EDGE_KEYS[edge]); return false; }
+
+            // Uncooked atlases fall back to drawing the whole frame blended
+            SDL_Rect band = entry.contains("band") ? readRect(entry["band"]) : SDL_Rect{0, 0, strip.frame.w, strip.frame.h};
+            strip.opaque = entry.contains("opaque") ? readRect(entry["opaque"]) : SDL_Rect{0, 0, 0, 0};
+            if (!entry.contains("band")) {
+                SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "BorderRenderer: '%s' has no band data (run cook_transition_borders.py); drawing the full frame.", EDGE_KEYS[edge]);
+            }
+            SDL_Rect clipped;
+            if (strip.opaque.w > 0 && strip.opaque.h > 0 && SDL_IntersectRect(&strip.opaque, &band, &clipped)) strip.opaque = clipped;
+            else strip.opaque = {0, 0, 0, 0};
+
+            // Split band minus opaque into up to four fringe rects: full-width rows above and
+            // below the core, then the side pieces beside it
+            if (strip.opaque.w <= 0) {
+                strip.fringe[strip.fringeCount++] = band;
+            } else {
+                const SDL_Rect& core = strip.opaque;
+                const SDL_Rect pieces[4] = {
+                    { band.x, band.y, band.w, core.y - band.y },
+                    { band.x, core.y + core.h, band.w, (band.y + band.h) - (core.y + core.h) },
+                    { band.x, core.y, core.x - band.x, core.h },
+                    { core.x + core.w, core.y, (band.x + band.w) - (core.x + core.w), core.h },
+                };
+                for (const SDL_Rect& piece : pieces) {
+                    if (piece.w > 0 && piece.h > 0) strip.fringe[strip.fringeCount++] = piece;
+                }
+            }
+            strips_[edge] = strip;
+        }
+    } catch (json::parse_error& e) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to parse border JSON '%s': %s (at byte %zu)", jsonPath.c_str(), e.what(), e.byte); return false; }
+      catch (const std::exception& e) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Error reading border JSON '%s': %s", jsonPath.c_str(), e.what()); return false; }
+
+    // Texture state is left to drawFrames(): load() may run off the render thread
+    atlas_ = atlas;
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "BorderRenderer: Loaded edge strips from '%s'.", jsonPath.c_str());
+    return true;
+}
+
+void BorderRenderer::drawPart(PCDisplay* display, const EdgeStrip& strip, const SDL_Rect& part, const SDL_Rect& frameDst) const {
+    // Map both part edges through the frame's scale so neighbouring parts share edges exactly
+    const float scaleX = static_cast<float>(frameDst.w) / strip.frame.w;
+    const float scaleY = static_cast<float>(frameDst.h) / strip.frame.h;
+    const int x0 = frameDst.x + static_cast<int>(std::lround(part.x * scaleX));
+    const int x1 = frameDst.x + static_cast<int>(std::lround((part.x + part.w) * scaleX));
+    const int y0 = frameDst.y + static_cast<int>(std::lround(part.y * scaleY));
+    const int y1 = frameDst.y + static_cast<int>(std::lround((part.y + part.h) * scaleY));
+    if (x1 <= x0 || y1 <= y0) return;
+
+    SDL_Rect src = { strip.frame.x + part.x, strip.frame.y + part.y, part.w, part.h };
+    SDL_Rect dst = { x0, y0, x1 - x0, y1 - y0 };
+    display->drawTexture(atlas_, &src, &dst);
+}
+
+void BorderRenderer::drawFrames(PCDisplay* display, const SDL_Rect (&frameDst)[static_cast<size_t>(BorderEdge::COUNT)]) {
+    if (!display || !atlas_) return;
+    const size_t edgeCount = static_cast<size_t>(BorderEdge::COUNT);
+
+    // Set here, on the render thread, and recorded with each draw in pipelined frames
+    SDL_SetTextureColorMod(atlas_, 255, 255, 255);
+    SDL_SetTextureAlphaMod(atlas_, 255);
+    SDL_SetTextureBlendMode(atlas_, SDL_BLENDMODE_NONE);
+    for (size_t edge = 0; edge < edgeCount; ++edge) {
+        if (frameDst[edge].w <= 0 || frameDst[edge].h <= 0 || strips_[edge].opaque.w <= 0) continue;
+        drawPart(display, strips_[edge], strips_[edge].opaque, frameDst[edge]);
+    }
+
+    SDL_SetTextureBlendMode(atlas_, SDL_BLENDMODE_BLEND);
+    for (size_t edge = 0; edge < edgeCount; ++edge) {
+        if (frameDst[edge].w <= 0 || frameDst[edge].h <= 0) continue;
+        const EdgeStrip& strip = strips_[edge];
+        for (size_t i = 0; i < strip.fringeCount; ++i) drawPart(display, strip, strip.fringe[i], frameDst[edge]);
+    }
+}
@@ -0,0 +1,183 @@
+// File: src/graphics/FrameCapture.cpp
+
+#include "graphics/FrameCapture.h" // Include own header
+#include "platform/pc/pc_display.h"
+#include <SDL.h>
+#include <SDL_image.h> // IMG_SavePNG
+#include <SDL_log.h>
+#include <chrono>
+#include <filesystem>
+#include <functional> // std::ref
+#include <system_error>
+
+namespace {
+    const int BYTES_PER_PIXEL = 4; // ARGB8888
+    const char* const PNG_NAME_FORMAT = "frame_%06llu.png";
+} // end anonymous namespace
+
+
+FrameCapture::~FrameCapture() {
+    stop();
+}
+
+bool FrameCapture::start(PCDisplay* display, const std::string& outputPath, CaptureFormat format, int everyNthFrame) {
+    stop();
+    if (!display || !display->isInitialized()) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "FrameCapture: Cannot start without a display."); return false; }
+    display->getWindowSize(width_, height_);
+    if (width_ <= 0 || height_ <= 0) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "FrameCapture: Display has no size."); return false; }
+
+    format_ = format;
+    outputPath_ = outputPath;
+    everyNthFrame_ = everyNthFrame > 0 ? everyNthFrame : 1;
+    if (format_ == CaptureFormat::PNG_SEQUENCE) {
+        std::error_code error;
+        std::filesystem::create_directories(outputPath_, error);
+        if (error) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "FrameCapture: Could not create '%s': %s", outputPath_.c_str(), error.message().c_str()); return false; }
+    } else {
+        rawFile_ = std::fopen(outputPath_.c_str(), "wb");
+        if (!rawFile_) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "FrameCapture: Could not open '%s' for writing.", outputPath_.c_str()); return false; }
+    }
+
+    // All buffers up front: capturing never allocates on the render thread.
+    // Buffer i belongs to encoder i % encoderCount.
+    const size_t encoderCount = format_ == CaptureFormat::PNG_SEQUENCE ? DEFAULT_PNG_ENCODERS : 1;
+    const size_t frameBytes = static_cast<size_t>(width_) * height_ * BYTES_PER_PIXEL;
+    uint32_t stale;
+    for (Encoder& encoder : encoders_) {
+        while (encoder.freeBuffers.pop(stale)) {}
+        while (encoder.filledBuffers.pop(stale)) {}
+    }
+    for (uint32_t i = 0; i < BUFFER_COUNT; ++i) {
+        buffers_[i].pixels.assign(frameBytes, 0);
+        encoders_[i % encoderCount].freeBuffers.push(i);
+    }
+    frameCounter_ = 0;
+    nextEncoder_ = 0;
+    pendingEncoder_ = nullptr;
+    captured_.store(0, std::memory_order_relaxed);
+    written_.store(0, std::memory_order_relaxed);
+    dropped_.store(0, std::memory_order_relaxed);
+    failed_.store(0, std::memory_order_relaxed);
+    grabTicksTotal_.store(0, std::memory_order_relaxed);
+    grabTicksMax_.store(0, std::memory_order_relaxed);
+
+    stopRequested_.store(false, std::memory_order_relaxed);
+    for (encoderCount_ = 0; encoderCount_ < encoderCount; ++encoderCount_) {
+        Encoder& encoder = encoders_[encoderCount_];
+        try {
+            encoder.thread = std::thread(&FrameCapture::encoderLoop, this, std::ref(encoder));
+        } catch (const std::system_error& e) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "FrameCapture: Could not start encoder thread: %s", e.what());
+            stop();
+            if (rawFile_) { std::fclose(rawFile_); rawFile_ = nullptr; }
+            return false;
+        }
+    }
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "FrameCapture: Recording %dx%d %s to '%s' (every %d frame(s), %zu buffers, %zu encoder(s)).", width_, height_,
+                format_ == CaptureFormat::PNG_SEQUENCE ? "PNG frames" : "raw BGRA video", outputPath_.c_str(), everyNthFrame_, BUFFER_COUNT, encoderCount_);
+    return true;
+}
+
+void FrameCapture::stop() {
+    if (encoderCount_ == 0) return;
+    stopRequested_.store(true, std::memory_order_release);
+    for (size_t i = 0; i < encoderCount_; ++i) encoders_[i].thread.join();
+    encoderCount_ = 0;
+    if (rawFile_) { std::fclose(rawFile_); rawFile_ = nullptr; }
+
+    const CaptureStats stats = getStats();
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "FrameCapture: Stopped. %llu captured, %llu written, %llu dropped, %llu failed; grab avg %.3f ms, max %.3f ms.",
+                (unsigned long long)stats.captured, (unsigned long long)stats.written, (unsigned long long)stats.dropped,
+                (unsigned long long)stats.failed, stats.avgGrabMs, stats.maxGrabMs);
+    if (format_ == CaptureFormat::RAW_VIDEO && stats.written > 0) {
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "FrameCapture: Convert with: ffmpeg -f rawvideo -pixel_format bgra -video_size %dx%d -framerate %d -i \"%s\" out.mp4",
+                    width_, height_, 60 / everyNthFrame_, outputPath_.c_str());
+    }
+    for (FrameBuffer& buffer : buffers_) {
+        std::vector<uint8_t>().swap(buffer.pixels);
+    }
+}
+
+// --- Render Thread ---
+void FrameCapture::captureFrame(PCDisplay* display) {
+    if (encoderCount_ == 0 || !display) return;
+    if (frameCounter_++ % everyNthFrame_ != 0) return;
+
+    // A buffer left over from a failed grab first, else the next encoder with a free one
+    Encoder* encoder = pendingEncoder_;
+    uint32_t index = pendingIndex_;
+    pendingEncoder_ = nullptr;
+    for (size_t tried = 0; tried < encoderCount_ && !encoder; ++tried) {
+        Encoder& candidate = encoders_[nextEncoder_];
+        nextEncoder_ = (nextEncoder_ + 1) % encoderCount_;
+        if (candidate.freeBuffers.pop(index)) encoder = &candidate;
+    }
+    if (!encoder) {
+        dropped_.fetch_add(1, std::memory_order_relaxed); // Back-pressure: skip rather than stall
+        return;
+    }
+    const uint64_t start = SDL_GetPerformanceCounter();
+    FrameBuffer& buffer = buffers_[index];
+    if (!display->readPixels(buffer.pixels.data(), width_ * BYTES_PER_PIXEL, width_, height_)) {
+        pendingEncoder_ = encoder; // readPixels logged why; freeBuffers has a single producer, the encoder
+        pendingIndex_ = index;
+        failed_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    buffer.frameNumber = captured_.fetch_add(1, std::memory_order_relaxed);
+    encoder->filledBuffers.push(index); // Can't fail: there are only BUFFER_COUNT indices
+
+    const uint64_t ticks = SDL_GetPerformanceCounter() - start;
+    grabTicksTotal_.fetch_add(ticks, std::memory_order_relaxed);
+    if (ticks > grabTicksMax_.load(std::memory_order_relaxed)) grabTicksMax_.store(ticks, std::memory_order_relaxed);
+}
+
+// --- Encoder Thread ---
+void FrameCapture::encoderLoop(Encoder& encoder) {
+    for (;;) {
+        uint32_t index;
+        if (encoder.filledBuffers.pop(index)) {
+            if (encodeFrame(buffers_[index])) written_.fetch_add(1, std::memory_order_relaxed);
+            else failed_.fetch_add(1, std::memory_order_relaxed);
+            encoder.freeBuffers.push(index);
+            continue;
+        }
+        // Checked only once the queue is empty, so stop() flushes every grabbed frame
+        if (stopRequested_.load(std::memory_order_acquire)) return;
+        std::this_thread::sleep_for(std::chrono::milliseconds(IDLE_WAIT_MS));
+    }
+}
+
+bool FrameCapture::encodeFrame(const FrameBuffer& frame) {
+    if (format_ == CaptureFormat::RAW_VIDEO) {
+        if (std::fwrite(frame.pixels.data(), 1, frame.pixels.size(), rawFile_) != frame.pixels.size()) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "FrameCapture: Write to '%s' failed.", outputPath_.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    // The surface wraps the buffer; nothing is copied before the PNG encoder reads it
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormatFrom(const_cast<uint8_t*>(frame.pixels.data()), width_, height_, 32,
+                                                              width_ * BYTES_PER_PIXEL, SDL_PIXELFORMAT_ARGB8888);
+    if (!surface) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "FrameCapture: Surface error: %s", SDL_GetError()); return false; }
+    char name[32];
+    std::snprintf(name, sizeof(name), PNG_NAME_FORMAT, (unsigned long long)frame.frameNumber);
+    const std::string path = (std::filesystem::path(outputPath_) / name).string();
+    const bool saved = IMG_SavePNG(surface, path.c_str()) == 0;
+    if (!saved) SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "FrameCapture: Could not save '%s': %s", path.c_str(), IMG_GetError());
+    SDL_FreeSurface(surface);
+    return saved;
+}
+
+CaptureStats FrameCapture::getStats() const {
+    CaptureStats stats;
+    stats.captured = captured_.load(std::memory_order_relaxed);
+    stats.written = written_.load(std::memory_order_relaxed);
+    stats.dropped = dropped_.load(std::memory_order_relaxed);
+    stats.failed = failed_.load(std::memory_order_relaxed);
+    const double msPerTick = 1000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+    if (stats.captured > 0) stats.avgGrabMs = grabTicksTotal_.load(std::memory_order_relaxed) * msPerTick / stats.captured;
+    stats.maxGrabMs = grabTicksMax_.load(std::memory_order_relaxed) * msPerTick;
+    return stats;
+}
@@ -0,0 +1,234 @@
+// File: src/graphics/PalettedSheet.cpp
+
+#include "graphics/PalettedSheet.h" // Include own header
+#include "core/MemoryBudget.h"      // MAX_PALETTED_SHEETS
+#include <SDL_log.h>                // SDL logging
+#include <cstring>                  // std::memcmp, std::memcpy, std::memset
+
+namespace {
+    // Streaming texture format; the lookup table below is built to match it
+    const Uint32 SHEET_TEXTURE_FORMAT = SDL_PIXELFORMAT_ARGB8888;
+
+    Uint32 toARGB8888(SDL_Color c) {
+        return (static_cast<Uint32>(c.a) << 24) | (static_cast<Uint32>(c.r) << 16) | (static_cast<Uint32>(c.g) << 8) | c.b;
+    }
+
+    // Indexed sheets, so PCDisplay can tell their handles from real textures.
+    // Loads and draws both run on the render thread.
+    const PalettedSheet* g_indexedSheets[MAX_PALETTED_SHEETS] = {};
+    size_t g_indexedCount = 0;
+
+#if defined(DIGIVICE_NO_HEAP)
+    // One index buffer per sheet that can be loaded at once, so loading and
+    // evicting partner sheets never touches the heap
+    uint8_t g_indexSlots[MAX_PALETTED_SHEETS][MAX_SHEET_PIXELS];
+    bool g_indexSlotUsed[MAX_PALETTED_SHEETS] = {};
+#endif
+
+    bool isSoftwareRenderer(SDL_Renderer* renderer) {
+        SDL_RendererInfo info;
+        return SDL_GetRendererInfo(renderer, &info) == 0 && (info.flags & SDL_RENDERER_SOFTWARE) != 0;
+    }
+
+    Uint8 multiply(Uint8 a, Uint8 b) {
+        return static_cast<Uint8>((a * b + 127) / 255);
+    }
+} // end anonymous namespace
+
+
+// --- Palette ---
+bool Palette::operator==(const Palette& other) const {
+    return count == other.count && std::memcmp(colors, other.colors, sizeof(SDL_Color) * count) == 0;
+}
+
+Palette makeTintedPalette(const Palette& base, SDL_Color tint) {
+    Palette result = base;
+    for (int i = 0; i < result.count; ++i) {
+        SDL_Color& c = result.colors[i];
+        c.r = multiply(c.r, tint.r);
+        c.g = multiply(c.g, tint.g);
+        c.b = multiply(c.b, tint.b);
+    }
+    return result;
+}
+
+Palette makeFlashPalette(const Palette& base, SDL_Color flash) {
+    Palette result = base;
+    for (int i = 0; i < result.count; ++i) {
+        SDL_Color& c = result.colors[i];
+        if (c.a == 0) continue; // Background stays transparent
+        c.r = flash.r; c.g = flash.g; c.b = flash.b;
+    }
+    return result;
+}
+
+Palette makeRemappedPalette(const Palette& base, const SDL_Color* from, const SDL_Color* to, int count) {
+    Palette result = base;
+    for (int i = 0; i < result.count; ++i) {
+        SDL_Color& c = result.colors[i];
+        for (int j = 0; j < count; ++j) {
+            if (c.r == from[j].r && c.g == from[j].g && c.b == from[j].b) { c.r = to[j].r; c.g = to[j].g; c.b = to[j].b; break; }
+        }
+    }
+    return result;
+}
+
+
+// --- PalettedSheet ---
+PalettedSheet::~PalettedSheet() {
+    release();
+}
+
+bool PalettedSheet::load(SDL_Renderer* renderer, SDL_Surface* indexedSurface) {
+    release();
+    if (!renderer || !indexedSurface) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "PalettedSheet::load: Null renderer or surface."); return false; }
+    const SDL_PixelFormat* format = indexedSurface->format;
+    if (format->format != SDL_PIXELFORMAT_INDEX8 || !format->palette) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "PalettedSheet::load: Surface is %s, not INDEX8.", SDL_GetPixelFormatName(format->format));
+        return false;
+    }
+
+    width_ = indexedSurface->w;
+    height_ = indexedSurface->h;
+    basePalette_ = Palette();
+    basePalette_.count = format->palette->ncolors < Palette::MAX_COLORS ? format->palette->ncolors : Palette::MAX_COLORS;
+    std::memcpy(basePalette_.colors, format->palette->colors, sizeof(SDL_Color) * basePalette_.count);
+    Uint32 colorKey = 0;
+    if (SDL_GetColorKey(indexedSurface, &colorKey) == 0 && colorKey < static_cast<Uint32>(basePalette_.count)) {
+        basePalette_.colors[colorKey].a = 0; // SDL_image reports a single transparent entry as a colour key
+    }
+
+    // Drop the surface pitch padding; rows are tightly packed from here on
+    if (!allocateIndices(static_cast<size_t>(width_) * height_)) {
+        release();
+        return false;
+    }
+    if (SDL_MUSTLOCK(indexedSurface)) SDL_LockSurface(indexedSurface);
+    for (int y = 0; y < height_; ++y) {
+        std::memcpy(&indices_[static_cast<size_t>(y) * width_], static_cast<const Uint8*>(indexedSurface->pixels) + y * indexedSurface->pitch, width_);
+    }
+    if (SDL_MUSTLOCK(indexedSurface)) SDL_UnlockSurface(indexedSurface);
+
+    // The software renderer's textures live in system memory; a full ARGB copy there
+    // would cost 4 more bytes per pixel, so it gets a handle and draws expand frames
+    indexed_ = isSoftwareRenderer(renderer) && g_indexedCount < MAX_PALETTED_SHEETS;
+    const int textureW = indexed_ ? 1 : width_;
+    const int textureH = indexed_ ? 1 : height_;
+    texture_ = SDL_CreateTexture(renderer, SHEET_TEXTURE_FORMAT, indexed_ ? SDL_TEXTUREACCESS_STATIC : SDL_TEXTUREACCESS_STREAMING, textureW, textureH);
+    if (!texture_) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "PalettedSheet::load: Texture creation failed (%dx%d): %s", textureW, textureH, SDL_GetError());
+        release();
+        return false;
+    }
+    SDL_SetTextureBlendMode(texture_, SDL_BLENDMODE_BLEND);
+    if (indexed_) g_indexedSheets[g_indexedCount++] = this;
+    setPalette(basePalette_);
+    return applyPalette(); // Loads run on the main thread
+}
+
+void PalettedSheet::release() {
+    for (size_t i = 0; indexed_ && i < g_indexedCount; ++i) {
+        if (g_indexedSheets[i] != this) continue;
+        g_indexedSheets[i] = g_indexedSheets[--g_indexedCount];
+        break;
+    }
+    indexed_ = false;
+    if (texture_) SDL_DestroyTexture(texture_);
+    texture_ = nullptr;
+    freeIndices();
+    width_ = height_ = 0;
+    uploaded_ = false;
+}
+
+bool PalettedSheet::allocateIndices(size_t count) {
+#if defined(DIGIVICE_NO_HEAP)
+    if (count > MAX_SHEET_PIXELS) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "PalettedSheet::load: %dx%d sheet is over the %zu-pixel budget (MAX_SHEET_PIXELS).", width_, height_, MAX_SHEET_PIXELS);
+        return false;
+    }
+    for (size_t slot = 0; slot < MAX_PALETTED_SHEETS; ++slot) {
+        if (g_indexSlotUsed[slot]) continue;
+        g_indexSlotUsed[slot] = true;
+        indices_ = g_indexSlots[slot];
+        return true;
+    }
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "PalettedSheet::load: All %zu index slots are in use (MAX_PALETTED_SHEETS).", MAX_PALETTED_SHEETS);
+    return false;
+#else
+    indexStorage_.resize(count);
+    indices_ = indexStorage_.data();
+    return true;
+#endif
+}
+
+void PalettedSheet::freeIndices() {
+#if defined(DIGIVICE_NO_HEAP)
+    for (size_t slot = 0; indices_ && slot < MAX_PALETTED_SHEETS; ++slot) {
+        if (g_indexSlots[slot] == indices_) g_indexSlotUsed[slot] = false;
+    }
+#else
+    indexStorage_.clear();
+#endif
+    indices_ = nullptr;
+}
+
+void PalettedSheet::setPalette(const Palette& palette) {
+    if (palette == palette_) return;
+    palette_ = palette;
+    uploaded_ = false;
+}
+
+const PalettedSheet* PalettedSheet::findIndexed(const SDL_Texture* texture) {
+    for (size_t i = 0; i < g_indexedCount; ++i) {
+        if (g_indexedSheets[i]->texture_ == texture) return g_indexedSheets[i];
+    }
+    return nullptr;
+}
+
+size_t PalettedSheet::getIndexStorageBytes() {
+#if defined(DIGIVICE_NO_HEAP)
+    return sizeof(g_indexSlots);
+#else
+    return 0;
+#endif
+}
+
+bool PalettedSheet::applyPalette() {
+    if (uploaded_) return true;
+    for (int i = 0; i < Palette::MAX_COLORS; ++i) lookup_[i] = i < palette_.count ? toARGB8888(palette_.colors[i]) : 0; // Past the palette: transparent
+    if (indexed_) { uploaded_ = true; return true; } // Frames expand through lookup_ as they are drawn
+    return uploadPalette();
+}
+
+bool PalettedSheet::uploadPalette() {
+    if (!texture_) return false;
+    void* pixels = nullptr;
+    int pitch = 0;
+    if (SDL_LockTexture(texture_, nullptr, &pixels, &pitch) != 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "PalettedSheet: SDL_LockTexture failed: %s", SDL_GetError());
+        uploaded_ = false;
+        return false;
+    }
+    for (int y = 0; y < height_; ++y) {
+        const uint8_t* src = &indices_[static_cast<size_t>(y) * width_];
+        Uint32* dst = reinterpret_cast<Uint32*>(static_cast<Uint8*>(pixels) + y * pitch);
+        for (int x = 0; x < width_; ++x) dst[x] = lookup_[src[x]];
+    }
+    SDL_UnlockTexture(texture_);
+    uploaded_ = true;
+    return true;
+}
+
+void PalettedSheet::expandToARGB8888(const SDL_Rect& srcRect, void* pixels, int pitch) const {
+    if (!pixels) return;
+    for (int y = 0; y < srcRect.h; ++y) {
+        const int sy = srcRect.y + y;
+        Uint32* dst = reinterpret_cast<Uint32*>(static_cast<Uint8*>(pixels) + static_cast<size_t>(y) * pitch);
+        if (sy < 0 || sy >= height_) { std::memset(dst, 0, sizeof(Uint32) * srcRect.w); continue; }
+        const uint8_t* row = &indices_[static_cast<size_t>(sy) * width_];
+        for (int x = 0; x < srcRect.w; ++x) {
+            const int sx = srcRect.x + x;
+            dst[x] = (sx >= 0 && sx < width_) ? lookup_[row[sx]] : 0;
+        }
+    }
+}
@@ -0,0 +1,169 @@
+// File: src/graphics/ParallaxLayer.cpp
+
+#include "graphics/ParallaxLayer.h"  // Include own header
+#include "core/AssetManager.h"       // To resolve layer textures
+#include "platform/pc/pc_display.h"  // To draw
+#include <SDL_log.h>                 // SDL logging
+#include <fstream>                   // For reading scene files
+#include "vendor/nlohmann/json.hpp"  // Path to JSON library header
+#include <cmath>                     // For std::lround
+#include <algorithm>                 // For std::min
+#include <utility>                   // For std::move
+
+// Use the nlohmann::json namespace
+using json = nlohmann::json;
+
+namespace {
+    // Whole pixels per second keep offsets on a grid float and fixed point share (core/Scalar.h)
+    Scalar wholePixelSpeed(float scrollSpeed) {
+        return Scalar(static_cast<int>(std::lround(scrollSpeed)));
+    }
+} // end anonymous namespace
+
+
+bool ParallaxBackground::addLayer(const std::string& textureId, SDL_Texture* texture, float scrollSpeed, bool foreground, int wrapWidth) {
+    if (!texture) { SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "ParallaxBackground: Layer '%s' has no texture, skipping.", textureId.c_str()); return false; }
+
+    ParallaxLayer layer;
+    layer.textureId = textureId;
+    layer.texture = texture;
+    layer.scrollSpeed = wholePixelSpeed(scrollSpeed);
+    layer.foreground = foreground;
+    if (SDL_QueryTexture(texture, NULL, NULL, &layer.texW, &layer.texH) != 0 || layer.texW <= 0 || layer.texH <= 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "ParallaxBackground: Could not query texture '%s': %s", textureId.c_str(), SDL_GetError());
+        return false;
+    }
+    layer.wrapWidth = (wrapWidth > 0) ? std::min(wrapWidth, layer.texW) : layer.texW * 2 / 3;
+    if (layer.wrapWidth <= 0) layer.wrapWidth = layer.texW;
+
+    SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "ParallaxBackground: Added layer '%s' (%dx%d, wrap %d, speed %.1f, %s).",
+                 textureId.c_str(), layer.texW, layer.texH, layer.wrapWidth, scrollSpeed, foreground ? "foreground" : "background");
+    layers_.push_back(std::move(layer));
+    return true;
+}
+
+bool ParallaxBackground::addTiledLayer(const std::string& manifestPath, SDL_Renderer* renderer, float scrollSpeed, bool foreground) {
+    auto tiles = std::make_unique<TiledBackground>();
+    tiles->setFrameArena(frameArena_);
+    tiles->setJobSystem(jobs_);
+    tiles->setDisplayProfile(profile_);
+    if (!tiles->load(manifestPath, renderer)) { SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "ParallaxBackground: Tiled layer '%s' failed to load, skipping.", manifestPath.c_str()); return false; }
+
+    ParallaxLayer layer;
+    layer.textureId = manifestPath;
+    layer.scrollSpeed = wholePixelSpeed(scrollSpeed);
+    layer.foreground = foreground;
+    layer.texW = tiles->getWidth();
+    layer.texH = tiles->getHeight();
+    layer.wrapWidth = tiles->getWidth(); // Routes loop back to their start
+    layer.tiles = std::move(tiles);
+
+    SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "ParallaxBackground: Added tiled layer '%s' (%dx%d, speed %.1f, %s).",
+                 manifestPath.c_str(), layer.texW, layer.texH, scrollSpeed, foreground ? "foreground" : "background");
+    layers_.push_back(std::move(layer));
+    return true;
+}
+
+bool ParallaxBackground::loadFromJson(const std::string& jsonPath, AssetManager* assets) {
+    if (!assets) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "ParallaxBackground: Cannot load '%s' without an AssetManager.", jsonPath.c_str()); return false; }
+    clear();
+    profile_ = &assets->getDisplayProfile(); // Streamed layers size their tiles by it too
+    const DisplayProfile& profile = *profile_;
+    try {
+        std::ifstream jsonFile(jsonPath);
+        if (!jsonFile.is_open()) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to open scene JSON: %s", jsonPath.c_str()); return false; }
+        json data = json::parse(jsonFile);
+        jsonFile.close();
+        if (!data.contains("layers") || !data["layers"].is_array()) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Missing 'layers' array in %s", jsonPath.c_str()); return false; }
+
+        for (const auto& layerData : data["layers"]) {
+            if (layerData.contains("tiles")) {
+                addTiledLayer(layerData["tiles"].get<std::string>(),
+                              assets->getRenderer(),
+                              profile.scale(layerData.value("scroll_speed", 0.0f)),
+                              layerData.value("foreground", false));
+                continue;
+            }
+            if (!layerData.contains("texture")) { SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Scene layer missing 'texture' in %s", jsonPath.c_str()); continue; }
+            std::string textureId = layerData["texture"].get<std::string>();
+            if (layerData.contains("path")) {
+                assets->loadTexture(textureId, layerData["path"].get<std::string>(), ScaleFilter::BOX); // Painted art averages down cleanly
+            }
+            addLayer(textureId,
+                     assets->getTexture(textureId),
+                     profile.scale(layerData.value("scroll_speed", 0.0f)),
+                     layerData.value("foreground", false),
+                     profile.scale(layerData.value("wrap_width", 0)));
+        }
+    } catch (json::parse_error& e) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to parse scene JSON '%s': %s (at byte %zu)", jsonPath.c_str(), e.what(), e.byte); return false; }
+      catch (const std::exception& e) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Error reading scene JSON '%s': %s", jsonPath.c_str(), e.what()); return false; }
+
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "ParallaxBackground: Loaded %zu layers from '%s'.", layers_.size(), jsonPath.c_str());
+    return !layers_.empty();
+}
+
+void ParallaxBackground::clear() {
+    layers_.clear();
+}
+
+void ParallaxBackground::setJobSystem(JobSystem* jobs) {
+    jobs_ = jobs; // Applies to layers added from now on; their decode jobs are already in flight
+}
+
+void ParallaxBackground::setFrameArena(FrameArena* arena) {
+    frameArena_ = arena;
+    for (ParallaxLayer& layer : layers_) {
+        if (layer.tiles) layer.tiles->setFrameArena(arena);
+    }
+}
+
+void ParallaxBackground::update(Scalar delta_time) {
+    for (ParallaxLayer& layer : layers_) {
+        // Scenery moves right as the partner walks left; keep the offset inside one period
+        layer.offset = scalarWrap(layer.offset - layer.scrollSpeed * delta_time, layer.wrapWidth);
+    }
+}
+
+void ParallaxBackground::setLayerOffset(size_t index, Scalar offset) {
+    if (index >= layers_.size() || layers_[index].wrapWidth <= 0) return;
+    layers_[index].offset = scalarWrap(offset, layers_[index].wrapWidth);
+}
+
+void ParallaxBackground::renderBackground(PCDisplay* display, int viewW, int viewH) const {
+    for (const ParallaxLayer& layer : layers_) {
+        if (!layer.foreground) renderLayer(layer, display, viewW, viewH);
+    }
+}
+
+void ParallaxBackground::renderForeground(PCDisplay* display, int viewW, int viewH) const {
+    for (const ParallaxLayer& layer : layers_) {
+        if (layer.foreground) renderLayer(layer, display, viewW, viewH);
+    }
+}
+
+void ParallaxBackground::renderLayer(const ParallaxLayer& layer, PCDisplay* display, int viewW, int viewH) const {
+    if (!display || layer.wrapWidth <= 0) return;
+    if (layer.tiles) {
+        // Positive speeds move the viewport towards lower strip columns
+        const int direction = (layer.scrollSpeed > 0) ? -1 : ((layer.scrollSpeed < 0) ? 1 : 0);
+        const int leftColumn = scalarFloor(layer.offset);
+        layer.tiles->updateResidency(leftColumn, viewW, direction);
+        layer.tiles->render(display, leftColumn, viewW, viewH);
+        return;
+    }
+    if (!layer.texture) return;
+    const int height = std::min(layer.texH, viewH);
+
+    // Walk the viewport left to right, copying only the columns that land on screen
+    int srcX = scalarFloor(layer.offset);
+    if (srcX >= layer.wrapWidth) srcX = 0;
+    int dstX = 0;
+    while (dstX < viewW) {
+        const int span = std::min(layer.wrapWidth - srcX, viewW - dstX);
+        SDL_Rect src = { srcX, 0, span, height };
+        SDL_Rect dst = { dstX, 0, span, height };
+        display->drawTexture(layer.texture, &src, &dst);
+        dstX += span;
+        srcX = 0;
+    }
+}
@@ -0,0 +1,436 @@
+// File: src/graphics/ParticleSystem.cpp
+
+#include "graphics/ParticleSystem.h" // Include own header
+#include "core/AssetManager.h"       // Emitter textures by id
+#include "platform/pc/pc_display.h"  // drawGeometry
+#include <SDL_log.h>                 // SDL logging
+#include <cmath>                     // std::cos, std::sin, std::sqrt
+#include <fstream>                   // For reading effect JSON files
+#include "vendor/nlohmann/json.hpp"  // Path to JSON library header
+
+using json = nlohmann::json;
+
+namespace {
+    const float TWO_PI = 6.28318530718f;
+    const float DEG_TO_RAD = TWO_PI / 360.0f;
+    const float MIN_LIFE_SEC = 0.01f;
+    const int BUILTIN_TEXTURE_SIZE = 32;
+    const size_t MAX_SPRITES_PER_BATCH = 256; // ParticleBatch::sprite is a uint8_t
+
+    SDL_Color readColor(const json& node, const char* key, SDL_Color fallback) {
+        if (!node.contains(key) || !node[key].is_array() || node[key].size() < 3) return fallback;
+        const json& c = node[key];
+        return { static_cast<Uint8>(c[0].get<int>()), static_cast<Uint8>(c[1].get<int>()), static_cast<Uint8>(c[2].get<int>()),
+                 static_cast<Uint8>(c.size() > 3 ? c[3].get<int>() : 255) };
+    }
+
+    ParticleEmitterDesc readEmitter(const json& node) {
+        ParticleEmitterDesc desc;
+        desc.texture = node.value("texture", desc.texture);
+        if (node.contains("sprite")) {
+            const json& s = node["sprite"];
+            desc.sprite = { s.value("x", 0), s.value("y", 0), s.value("w", 0), s.value("h", 0) };
+        }
+        desc.burst = node.value("burst", desc.burst);
+        desc.rate = node.value("rate", desc.rate);
+        desc.duration = node.value("duration", desc.duration);
+        desc.lifeMin = node.value("life_min", desc.lifeMin);
+        desc.lifeMax = node.value("life_max", desc.lifeMax);
+        desc.speedMin = node.value("speed_min", desc.speedMin);
+        desc.speedMax = node.value("speed_max", desc.speedMax);
+        desc.angle = node.value("angle", desc.angle);
+        desc.spread = node.value("spread", desc.spread);
+        desc.radius = node.value("radius", desc.radius);
+        desc.gravity = node.value("gravity", desc.gravity);
+        desc.drag = node.value("drag", desc.drag);
+        desc.sizeStart = node.value("size_start", desc.sizeStart);
+        desc.sizeEnd = node.value("size_end", desc.sizeEnd);
+        desc.colorStart = readColor(node, "color_start", desc.colorStart);
+        desc.colorEnd = readColor(node, "color_end", desc.colorEnd);
+        return desc;
+    }
+
+    // Effect files are authored in design pixels; small screens get the same look at their size
+    void scaleEmitter(ParticleEmitterDesc& desc, const DisplayProfile& profile) {
+        float* lengths[] = { &desc.speedMin, &desc.speedMax, &desc.radius, &desc.gravity, &desc.sizeStart, &desc.sizeEnd };
+        for (float* length : lengths) *length = profile.scale(*length);
+    }
+} // end anonymous namespace
+
+
+ParticleSystem::~ParticleSystem() {
+    shutdown();
+}
+
+// --- Setup ---
+bool ParticleSystem::init(SDL_Renderer* renderer, AssetManager* assets, size_t maxParticles) {
+    if (!renderer) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "ParticleSystem: Cannot init without a renderer."); return false; }
+    shutdown();
+    renderer_ = renderer;
+    assets_ = assets;
+    capacity_ = maxParticles;
+
+    // Soft white disc, tinted by vertex colour; quadratic falloff to a transparent edge
+    std::vector<Uint32> pixels(static_cast<size_t>(BUILTIN_TEXTURE_SIZE) * BUILTIN_TEXTURE_SIZE);
+    const float radius = BUILTIN_TEXTURE_SIZE * 0.5f;
+    for (int y = 0; y < BUILTIN_TEXTURE_SIZE; ++y) {
+        for (int x = 0; x < BUILTIN_TEXTURE_SIZE; ++x) {
+            const float dx = (x + 0.5f - radius) / radius;
+            const float dy = (y + 0.5f - radius) / radius;
+            float falloff = 1.0f - std::sqrt(dx * dx + dy * dy);
+            falloff = falloff > 0.0f ? falloff * falloff : 0.0f;
+            const Uint32 alpha = static_cast<Uint32>(falloff * 255.0f + 0.5f);
+            pixels[static_cast<size_t>(y) * BUILTIN_TEXTURE_SIZE + x] = (alpha << 24) | 0x00FFFFFFu; // RGBA32 byte order: R, G, B, A
+        }
+    }
+    SDL_Texture** builtins[2] = { &dotTexture_, &glowTexture_ };
+    const SDL_BlendMode modes[2] = { SDL_BLENDMODE_BLEND, SDL_BLENDMODE_ADD };
+    for (int i = 0; i < 2; ++i) {
+        SDL_Texture* texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, BUILTIN_TEXTURE_SIZE, BUILTIN_TEXTURE_SIZE);
+        if (!texture || SDL_UpdateTexture(texture, nullptr, pixels.data(), BUILTIN_TEXTURE_SIZE * static_cast<int>(sizeof(Uint32))) != 0) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "ParticleSystem: Built-in texture creation failed: %s", SDL_GetError());
+            if (texture) SDL_DestroyTexture(texture);
+            shutdown();
+            return false;
+        }
+        SDL_SetTextureBlendMode(texture, modes[i]);
+        *builtins[i] = texture;
+    }
+
+    vertices_.reserve(capacity_ * 4);
+    buildQuadIndices();
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "ParticleSystem: Initialized for %zu particles per texture.", capacity_);
+    return true;
+}
+
+void ParticleSystem::shutdown() {
+    if (dotTexture_) { SDL_DestroyTexture(dotTexture_); dotTexture_ = nullptr; }
+    if (glowTexture_) { SDL_DestroyTexture(glowTexture_); glowTexture_ = nullptr; }
+    effects_.clear();
+    batches_.clear();
+    emitters_.clear();
+    vertices_.clear();
+    quadIndices_.clear();
+    capacity_ = 0;
+    dropped_ = 0;
+    renderer_ = nullptr;
+    assets_ = nullptr;
+}
+
+void ParticleSystem::buildQuadIndices() {
+    quadIndices_.resize(capacity_ * 6);
+    for (size_t q = 0; q < capacity_; ++q) {
+        const int base = static_cast<int>(q * 4);
+        int* quad = &quadIndices_[q * 6];
+        quad[0] = base; quad[1] = base + 1; quad[2] = base + 2;
+        quad[3] = base + 2; quad[4] = base + 1; quad[5] = base + 3;
+    }
+}
+
+void ParticleSystem::allocateBatch(ParticleBatch& batch) {
+    std::vector<Scalar>* scalarColumns[] = {
+        &batch.posX, &batch.posY, &batch.velX, &batch.velY, &batch.gravity, &batch.drag,
+        &batch.age, &batch.invLife, &batch.sizeStart, &batch.sizeDelta, &batch.size,
+        &batch.redStart, &batch.greenStart, &batch.blueStart, &batch.alphaStart,
+        &batch.redDelta, &batch.greenDelta, &batch.blueDelta, &batch.alphaDelta
+    };
+    for (std::vector<Scalar>* column : scalarColumns) column->assign(capacity_, Scalar(0));
+    std::vector<uint8_t>* byteColumns[] = { &batch.red, &batch.green, &batch.blue, &batch.alpha, &batch.sprite };
+    for (std::vector<uint8_t>* column : byteColumns) column->assign(capacity_, 0);
+    batch.count = 0;
+}
+
+int ParticleSystem::findOrAddBatch(SDL_Texture* texture) {
+    for (size_t i = 0; i < batches_.size(); ++i) {
+        if (batches_[i].texture == texture) return static_cast<int>(i);
+    }
+    batches_.emplace_back();
+    ParticleBatch& batch = batches_.back();
+    batch.texture = texture;
+    allocateBatch(batch);
+    return static_cast<int>(batches_.size() - 1);
+}
+
+ParticleEffectId ParticleSystem::addEffect(const std::string& name, const std::vector<ParticleEmitterDesc>& emitters) {
+    if (capacity_ == 0) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "ParticleSystem: Cannot add effect '%s' before init().", name.c_str()); return -1; }
+    if (findEffect(name) >= 0) { SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "ParticleSystem: Effect '%s' already loaded. Skipping.", name.c_str()); return findEffect(name); }
+
+    Effect effect;
+    effect.name = name;
+    effect.emitters = emitters;
+    for (ParticleEmitterDesc& desc : effect.emitters) {
+        SDL_Texture* texture = nullptr;
+        if (desc.texture == "@dot") texture = dotTexture_;
+        else if (desc.texture == "@glow") texture = glowTexture_;
+        else if (assets_) texture = assets_->getTexture(desc.texture);
+        if (!texture) {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "ParticleSystem: Effect '%s' texture '%s' not found; using @glow.", name.c_str(), desc.texture.c_str());
+            texture = glowTexture_;
+            desc.sprite = {0, 0, 0, 0};
+        }
+
+        // Sprite rect -> normalised UVs, shared by every emitter drawing it
+        ParticleUV uv;
+        int texW = 0, texH = 0;
+        if (desc.sprite.w > 0 && desc.sprite.h > 0 && SDL_QueryTexture(texture, nullptr, nullptr, &texW, &texH) == 0 && texW > 0 && texH > 0) {
+            uv.u0 = static_cast<float>(desc.sprite.x) / texW;
+            uv.v0 = static_cast<float>(desc.sprite.y) / texH;
+            uv.u1 = static_cast<float>(desc.sprite.x + desc.sprite.w) / texW;
+            uv.v1 = static_cast<float>(desc.sprite.y + desc.sprite.h) / texH;
+        }
+        desc.batch = findOrAddBatch(texture);
+        std::vector<ParticleUV>& sprites = batches_[desc.batch].sprites;
+        size_t spriteIndex = 0;
+        while (spriteIndex < sprites.size() && !(sprites[spriteIndex].u0 == uv.u0 && sprites[spriteIndex].v0 == uv.v0 && sprites[spriteIndex].u1 == uv.u1 && sprites[spriteIndex].v1 == uv.v1)) ++spriteIndex;
+        if (spriteIndex == sprites.size()) {
+            if (sprites.size() == MAX_SPRITES_PER_BATCH) { SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "ParticleSystem: Too many sprites on one texture; '%s' uses the first.", name.c_str()); spriteIndex = 0; }
+            else sprites.push_back(uv);
+        }
+        desc.spriteIndex = static_cast<int>(spriteIndex);
+        if (desc.lifeMin < MIN_LIFE_SEC) desc.lifeMin = MIN_LIFE_SEC;
+        if (desc.lifeMax < desc.lifeMin) desc.lifeMax = desc.lifeMin;
+    }
+    effects_.push_back(std::move(effect));
+    return static_cast<ParticleEffectId>(effects_.size() - 1);
+}
+
+ParticleEffectId ParticleSystem::findEffect(const std::string& name) const {
+    for (size_t i = 0; i < effects_.size(); ++i) {
+        if (effects_[i].name == name) return static_cast<ParticleEffectId>(i);
+    }
+    return -1;
+}
+
+bool ParticleSystem::loadFromJson(const std::string& jsonPath) {
+    size_t added = 0;
+    try {
+        std::ifstream jsonFile(jsonPath);
+        if (!jsonFile.is_open()) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to open effects JSON: %s", jsonPath.c_str()); return false; }
+        json data = json::parse(jsonFile);
+        jsonFile.close();
+        if (!data.contains("effects") || !data["effects"].is_object()) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Missing 'effects' object in %s", jsonPath.c_str()); return false; }
+
+        for (auto it = data["effects"].begin(); it != data["effects"].end(); ++it) {
+            if (!it.value().is_array()) { SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Effect '%s' in %s is not an emitter array", it.key().c_str(), jsonPath.c_str()); continue; }
+            std::vector<ParticleEmitterDesc> emitters;
+            for (const auto& emitterData : it.value()) {
+                emitters.push_back(readEmitter(emitterData));
+                if (assets_) scaleEmitter(emitters.back(), assets_->getDisplayProfile());
+            }
+            if (addEffect(it.key(), emitters) >= 0) ++added;
+        }
+    } catch (json::parse_error& e) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to parse effects JSON '%s': %s (at byte %zu)", jsonPath.c_str(), e.what(), e.byte); return false; }
+      catch (const std::exception& e) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Error reading effects JSON '%s': %s", jsonPath.c_str(), e.what()); return false; }
+
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "ParticleSystem: Loaded %zu effects from '%s' (%zu textures).", added, jsonPath.c_str(), batches_.size());
+    return added > 0;
+}
+
+
+// --- Emitters ---
+void ParticleSystem::start(ParticleEffectId effect, float x, float y) {
+    if (effect < 0 || static_cast<size_t>(effect) >= effects_.size()) return;
+    for (const ParticleEmitterDesc& desc : effects_[effect].emitters) {
+        spawn(desc, x, y, desc.burst);
+        if (desc.rate <= 0.0f || desc.duration <= 0.0f) continue;
+        ActiveEmitter emitter;
+        emitter.desc = &desc;
+        emitter.x = x;
+        emitter.y = y;
+        emitter.ratePerTick = scalarFromDouble<Scalar>(static_cast<double>(desc.rate) / TICKS_PER_SECOND);
+        emitter.timeLeft = scalarFromDouble<Scalar>(desc.duration);
+        if (!emitters_.push_back(emitter)) { SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "ParticleSystem: %zu emitters already running; '%s' loses one.", emitters_.size(), effects_[effect].name.c_str()); }
+    }
+}
+
+void ParticleSystem::clear() {
+    for (ParticleBatch& batch : batches_) batch.count = 0;
+    emitters_.clear();
+}
+
+size_t ParticleSystem::getParticleCount() const {
+    size_t total = 0;
+    for (const ParticleBatch& batch : batches_) total += batch.count;
+    return total;
+}
+
+float ParticleSystem::randomRange(float lo, float hi) {
+    // xorshift32, as in DigimonPool
+    rngState_ ^= rngState_ << 13;
+    rngState_ ^= rngState_ >> 17;
+    rngState_ ^= rngState_ << 5;
+    return lo + (hi - lo) * ((rngState_ >> 8) * (1.0f / 16777216.0f));
+}
+
+// Spawning is serial (random rolls, sin/cos), but only touches new particles
+void ParticleSystem::spawn(const ParticleEmitterDesc& desc, float x, float y, int count) {
+    if (desc.batch < 0 || count <= 0) return;
+    ParticleBatch& batch = batches_[desc.batch];
+    size_t spawnCount = static_cast<size_t>(count);
+    const size_t room = capacity_ - batch.count;
+    if (spawnCount > room) { dropped_ += spawnCount - room; spawnCount = room; }
+
+    const float baseAngle = desc.angle * DEG_TO_RAD;
+    const float halfSpread = desc.spread * 0.5f * DEG_TO_RAD;
+    const Scalar gravity = scalarFromDouble<Scalar>(desc.gravity);
+    const Scalar drag = scalarFromDouble<Scalar>(desc.drag);
+    const Scalar sizeStart = scalarFromDouble<Scalar>(desc.sizeStart);
+    const Scalar sizeDelta = scalarFromDouble<Scalar>(desc.sizeEnd - desc.sizeStart);
+    const SDL_Color& c0 = desc.colorStart;
+    const SDL_Color& c1 = desc.colorEnd;
+    for (size_t n = 0; n < spawnCount; ++n) {
+        const size_t i = batch.count++;
+        const float heading = baseAngle + randomRange(-halfSpread, halfSpread);
+        const float speed = randomRange(desc.speedMin, desc.speedMax);
+        const float offsetAngle = randomRange(0.0f, TWO_PI);
+        const float offset = desc.radius > 0.0f ? desc.radius * std::sqrt(randomRange(0.0f, 1.0f)) : 0.0f; // Uniform over the disc
+        batch.posX[i] = scalarFromDouble<Scalar>(x + std::cos(offsetAngle) * offset);
+        batch.posY[i] = scalarFromDouble<Scalar>(y + std::sin(offsetAngle) * offset);
+        batch.velX[i] = scalarFromDouble<Scalar>(std::cos(heading) * speed);
+        batch.velY[i] = scalarFromDouble<Scalar>(std::sin(heading) * speed);
+        batch.gravity[i] = gravity;
+        batch.drag[i] = drag;
+        batch.age[i] = Scalar(0);
+        batch.invLife[i] = scalarFromDouble<Scalar>(1.0f / randomRange(desc.lifeMin, desc.lifeMax));
+        batch.sizeStart[i] = sizeStart;
+        batch.sizeDelta[i] = sizeDelta;
+        batch.size[i] = sizeStart;
+        batch.redStart[i] = Scalar(c0.r);   batch.redDelta[i] = Scalar(c1.r - c0.r);
+        batch.greenStart[i] = Scalar(c0.g); batch.greenDelta[i] = Scalar(c1.g - c0.g);
+        batch.blueStart[i] = Scalar(c0.b);  batch.blueDelta[i] = Scalar(c1.b - c0.b);
+        batch.alphaStart[i] = Scalar(c0.a); batch.alphaDelta[i] = Scalar(c1.a - c0.a);
+        batch.red[i] = c0.r; batch.green[i] = c0.g; batch.blue[i] = c0.b; batch.alpha[i] = c0.a;
+        batch.sprite[i] = static_cast<uint8_t>(desc.spriteIndex);
+    }
+}
+
+
+// --- Update ---
+void ParticleSystem::update(Scalar delta_time) {
+    for (size_t e = 0; e < emitters_.size();) {
+        ActiveEmitter& emitter = emitters_[e];
+        const Scalar active = delta_time < emitter.timeLeft ? delta_time : emitter.timeLeft;
+        emitter.carry += emitter.ratePerTick * Scalar(static_cast<int32_t>(scalarToTicks(active)));
+        const int spawnCount = scalarFloor(emitter.carry);
+        emitter.carry -= Scalar(spawnCount);
+        spawn(*emitter.desc, emitter.x, emitter.y, spawnCount);
+        emitter.timeLeft -= delta_time;
+        if (emitter.timeLeft <= Scalar(0)) emitters_.erase(emitters_.begin() + e);
+        else ++e;
+    }
+
+    for (ParticleBatch& batch : batches_) {
+        if (batch.count == 0) continue;
+        updateVelocity(batch, delta_time);
+        updatePosition(batch, delta_time);
+        updateLifetime(batch, delta_time);
+        removeDead(batch);
+        updateFade(batch);
+    }
+}
+
+void ParticleSystem::updateVelocity(ParticleBatch& batch, Scalar delta_time) {
+    const size_t count = batch.count;
+    Scalar* vx = batch.velX.data(); Scalar* vy = batch.velY.data();
+    const Scalar* gravity = batch.gravity.data();
+    const Scalar* drag = batch.drag.data();
+    for (size_t i = 0; i < count; ++i) {
+        const Scalar keep = Scalar(1) - drag[i] * delta_time; // Linear drag; fine at frame-sized steps
+        vx[i] = vx[i] * keep;
+        vy[i] = vy[i] * keep + gravity[i] * delta_time;
+    }
+}
+
+void ParticleSystem::updatePosition(ParticleBatch& batch, Scalar delta_time) {
+    const size_t count = batch.count;
+    Scalar* px = batch.posX.data(); Scalar* py = batch.posY.data();
+    const Scalar* vx = batch.velX.data(); const Scalar* vy = batch.velY.data();
+    for (size_t i = 0; i < count; ++i) {
+        px[i] += vx[i] * delta_time;
+        py[i] += vy[i] * delta_time;
+    }
+}
+
+void ParticleSystem::updateLifetime(ParticleBatch& batch, Scalar delta_time) {
+    const size_t count = batch.count;
+    Scalar* age = batch.age.data();
+    for (size_t i = 0; i < count; ++i) {
+        age[i] += delta_time;
+    }
+}
+
+// Particles are dead once age * invLife reaches 1. Swap-remove keeps the columns
+// dense; deaths are a small fraction of a frame's particles.
+void ParticleSystem::removeDead(ParticleBatch& batch) {
+    size_t i = 0;
+    while (i < batch.count) {
+        if (batch.age[i] * batch.invLife[i] < Scalar(1)) { ++i; continue; }
+        const size_t last = --batch.count;
+        if (i == last) break;
+        batch.posX[i] = batch.posX[last];           batch.posY[i] = batch.posY[last];
+        batch.velX[i] = batch.velX[last];           batch.velY[i] = batch.velY[last];
+        batch.gravity[i] = batch.gravity[last];     batch.drag[i] = batch.drag[last];
+        batch.age[i] = batch.age[last];             batch.invLife[i] = batch.invLife[last];
+        batch.sizeStart[i] = batch.sizeStart[last]; batch.sizeDelta[i] = batch.sizeDelta[last];
+        batch.redStart[i] = batch.redStart[last];   batch.redDelta[i] = batch.redDelta[last];
+        batch.greenStart[i] = batch.greenStart[last]; batch.greenDelta[i] = batch.greenDelta[last];
+        batch.blueStart[i] = batch.blueStart[last]; batch.blueDelta[i] = batch.blueDelta[last];
+        batch.alphaStart[i] = batch.alphaStart[last]; batch.alphaDelta[i] = batch.alphaDelta[last];
+        batch.sprite[i] = batch.sprite[last];
+        // size and colour are rewritten by updateFade
+    }
+}
+
+void ParticleSystem::updateFade(ParticleBatch& batch) {
+    const size_t count = batch.count;
+    const Scalar* age = batch.age.data(); const Scalar* invLife = batch.invLife.data();
+    const Scalar* sizeStart = batch.sizeStart.data(); const Scalar* sizeDelta = batch.sizeDelta.data();
+    Scalar* size = batch.size.data();
+    for (size_t i = 0; i < count; ++i) {
+        size[i] = sizeStart[i] + sizeDelta[i] * (age[i] * invLife[i]);
+    }
+    // One loop per channel keeps each a straight Scalar -> byte conversion; t < 1 keeps them in 0..255
+    const Scalar half = Scalar(1) / Scalar(2);
+    const Scalar* starts[4] = { batch.redStart.data(), batch.greenStart.data(), batch.blueStart.data(), batch.alphaStart.data() };
+    const Scalar* deltas[4] = { batch.redDelta.data(), batch.greenDelta.data(), batch.blueDelta.data(), batch.alphaDelta.data() };
+    uint8_t* outs[4] = { batch.red.data(), batch.green.data(), batch.blue.data(), batch.alpha.data() };
+    for (int channel = 0; channel < 4; ++channel) {
+        const Scalar* start = starts[channel];
+        const Scalar* delta = deltas[channel];
+        uint8_t* out = outs[channel];
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = static_cast<uint8_t>(scalarFloor(start[i] + delta[i] * (age[i] * invLife[i]) + half));
+        }
+    }
+}
+
+
+// --- Render ---
+void ParticleSystem::buildVertices(const ParticleBatch& batch) {
+    const size_t count = batch.count;
+    vertices_.resize(count * 4); // Within the capacity reserved by init()
+    SDL_Vertex* v = vertices_.data();
+    const ParticleUV* sprites = batch.sprites.data();
+    for (size_t i = 0; i < count; ++i, v += 4) {
+        // SDL takes float vertices; the only float math left in a frame
+        const float half = scalarToFloat(batch.size[i]) * 0.5f;
+        const float cx = scalarToFloat(batch.posX[i]), cy = scalarToFloat(batch.posY[i]);
+        const float x0 = cx - half, x1 = cx + half;
+        const float y0 = cy - half, y1 = cy + half;
+        const SDL_Color color = { batch.red[i], batch.green[i], batch.blue[i], batch.alpha[i] };
+        const ParticleUV& uv = sprites[batch.sprite[i]];
+        v[0] = { {x0, y0}, color, {uv.u0, uv.v0} };
+        v[1] = { {x1, y0}, color, {uv.u1, uv.v0} };
+        v[2] = { {x0, y1}, color, {uv.u0, uv.v1} };
+        v[3] = { {x1, y1}, color, {uv.u1, uv.v1} };
+    }
+}
+
+void ParticleSystem::render(PCDisplay* display) {
+    if (!display) return;
+    for (const ParticleBatch& batch : batches_) {
+        if (batch.count == 0) continue;
+        buildVertices(batch);
+        display->drawGeometry(batch.texture, vertices_.data(), static_cast<int>(batch.count * 4), quadIndices_.data(), static_cast<int>(batch.count * 6));
+    }
+}
@@ -0,0 +1,72 @@
+// File: src/graphics/RenderList.cpp
+
+#include "graphics/RenderList.h" // Include own header
+
+void RenderList::clear() {
+    commands_.clear();
+    vertices_.clear();
+    indices_.clear();
+}
+
+void RenderList::reserve(size_t commands, size_t vertices, size_t indices) {
+    commands_.reserve(commands);
+    vertices_.reserve(vertices);
+    indices_.reserve(indices);
+}
+
+void RenderList::addClear() {
+    RenderCommand cmd;
+    cmd.op = RenderOp::CLEAR;
+    commands_.push_back(cmd);
+}
+
+void RenderList::addTexture(SDL_Texture* texture, const TextureState& state, const SDL_Rect* srcRect, const SDL_Rect* dstRect, SDL_RendererFlip flip) {
+    RenderCommand cmd;
+    cmd.op = RenderOp::TEXTURE;
+    cmd.texture = texture;
+    cmd.textureState = state;
+    if (srcRect) { cmd.src = *srcRect; cmd.hasSrc = true; }
+    if (dstRect) { cmd.dst = *dstRect; cmd.hasDst = true; }
+    cmd.flip = flip;
+    commands_.push_back(cmd);
+}
+
+void RenderList::addGeometry(SDL_Texture* texture, const TextureState& state, const SDL_Vertex* vertices, int vertexCount, const int* indices, int indexCount) {
+    RenderCommand cmd;
+    cmd.op = RenderOp::GEOMETRY;
+    cmd.texture = texture;
+    cmd.textureState = state;
+    // Indices stay relative to this command's first vertex, so no rebasing is needed
+    cmd.firstVertex = static_cast<int>(vertices_.size());
+    cmd.vertexCount = vertexCount;
+    vertices_.insert(vertices_.end(), vertices, vertices + vertexCount);
+    cmd.firstIndex = static_cast<int>(indices_.size());
+    if (indices && indexCount > 0) {
+        cmd.indexCount = indexCount;
+        indices_.insert(indices_.end(), indices, indices + indexCount);
+    }
+    commands_.push_back(cmd);
+}
+
+void RenderList::addFillRect(const SDL_Rect* rect, SDL_Color color, bool blend) {
+    RenderCommand cmd;
+    cmd.op = RenderOp::FILL_RECT;
+    if (rect) { cmd.dst = *rect; cmd.hasDst = true; }
+    cmd.color = color;
+    cmd.blend = blend;
+    commands_.push_back(cmd);
+}
+
+void RenderList::addClipRect(const SDL_Rect* clipRect) {
+    RenderCommand cmd;
+    cmd.op = RenderOp::CLIP_RECT;
+    if (clipRect) { cmd.dst = *clipRect; cmd.hasDst = true; }
+    commands_.push_back(cmd);
+}
+
+void RenderList::addRenderTarget(SDL_Texture* target) {
+    RenderCommand cmd;
+    cmd.op = RenderOp::RENDER_TARGET;
+    cmd.texture = target;
+    commands_.push_back(cmd);
+}
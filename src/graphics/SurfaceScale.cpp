@@ -0,0 +1,129 @@
+// File: src/graphics/SurfaceScale.cpp
+
+#include "graphics/SurfaceScale.h" // Include own header
+#include <SDL_image.h>             // IMG_Load
+#include <SDL_log.h>               // SDL logging
+#include <algorithm>               // std::min, std::max
+#include <cstring>                 // std::memcpy
+
+namespace {
+    // Output size for one axis; tiny sources still give one pixel
+    int scaledLength(int length, int divisor) {
+        return std::max(1, length / divisor);
+    }
+
+    SDL_Surface* downscaleNearest(SDL_Surface* source, int divisor) {
+        const int width = scaledLength(source->w, divisor);
+        const int height = scaledLength(source->h, divisor);
+        SDL_Surface* scaled = SDL_CreateRGBSurfaceWithFormat(0, width, height, source->format->BitsPerPixel, source->format->format);
+        if (!scaled) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "downscaleSurface: Surface creation failed: %s", SDL_GetError()); return nullptr; }
+        if (source->format->palette) SDL_SetSurfacePalette(scaled, source->format->palette);
+        Uint32 colorKey = 0;
+        if (SDL_GetColorKey(source, &colorKey) == 0) SDL_SetColorKey(scaled, SDL_TRUE, colorKey);
+        SDL_BlendMode blendMode = SDL_BLENDMODE_NONE;
+        if (SDL_GetSurfaceBlendMode(source, &blendMode) == 0) SDL_SetSurfaceBlendMode(scaled, blendMode);
+
+        const int bytesPerPixel = source->format->BytesPerPixel;
+        SDL_LockSurface(source);
+        const Uint8* srcPixels = static_cast<const Uint8*>(source->pixels);
+        Uint8* dstPixels = static_cast<Uint8*>(scaled->pixels);
+        for (int y = 0; y < height; ++y) {
+            const int srcY = std::min(y * divisor + divisor / 2, source->h - 1);
+            const Uint8* srcRow = srcPixels + static_cast<size_t>(srcY) * source->pitch;
+            Uint8* dstRow = dstPixels + static_cast<size_t>(y) * scaled->pitch;
+            for (int x = 0; x < width; ++x) {
+                const int srcX = std::min(x * divisor + divisor / 2, source->w - 1);
+                std::memcpy(dstRow + x * bytesPerPixel, srcRow + srcX * bytesPerPixel, bytesPerPixel);
+            }
+        }
+        SDL_UnlockSurface(source);
+        return scaled;
+    }
+
+    SDL_Surface* downscaleBox(SDL_Surface* source, int divisor) {
+        SDL_Surface* argb = (source->format->format == SDL_PIXELFORMAT_ARGB8888) ? source : SDL_ConvertSurfaceFormat(source, SDL_PIXELFORMAT_ARGB8888, 0);
+        if (!argb) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "downscaleSurface: Conversion to ARGB8888 failed: %s", SDL_GetError()); return nullptr; }
+        const int width = scaledLength(argb->w, divisor);
+        const int height = scaledLength(argb->h, divisor);
+        SDL_Surface* scaled = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_ARGB8888);
+        if (!scaled) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "downscaleSurface: Surface creation failed: %s", SDL_GetError());
+            if (argb != source) SDL_FreeSurface(argb);
+            return nullptr;
+        }
+
+        SDL_LockSurface(argb);
+        for (int y = 0; y < height; ++y) {
+            const int y0 = y * divisor;
+            const int y1 = std::min(y0 + divisor, argb->h);
+            Uint32* dstRow = reinterpret_cast<Uint32*>(static_cast<Uint8*>(scaled->pixels) + static_cast<size_t>(y) * scaled->pitch);
+            for (int x = 0; x < width; ++x) {
+                const int x0 = x * divisor;
+                const int x1 = std::min(x0 + divisor, argb->w);
+                Uint32 alpha = 0, red = 0, green = 0, blue = 0;
+                for (int sy = y0; sy < y1; ++sy) {
+                    const Uint32* srcRow = reinterpret_cast<const Uint32*>(static_cast<const Uint8*>(argb->pixels) + static_cast<size_t>(sy) * argb->pitch);
+                    for (int sx = x0; sx < x1; ++sx) {
+                        const Uint32 pixel = srcRow[sx];
+                        const Uint32 a = pixel >> 24;
+                        alpha += a;
+                        red += ((pixel >> 16) & 0xFF) * a;
+                        green += ((pixel >> 8) & 0xFF) * a;
+                        blue += (pixel & 0xFF) * a;
+                    }
+                }
+                const Uint32 count = static_cast<Uint32>((y1 - y0) * (x1 - x0));
+                Uint32 out = 0;
+                if (alpha > 0) {
+                    const Uint32 half = alpha / 2; // Round to nearest
+                    out = (((alpha + count / 2) / count) << 24) | (((red + half) / alpha) << 16) | (((green + half) / alpha) << 8) | ((blue + half) / alpha);
+                }
+                dstRow[x] = out;
+            }
+        }
+        SDL_UnlockSurface(argb);
+        if (argb != source) SDL_FreeSurface(argb);
+        SDL_SetSurfaceBlendMode(scaled, SDL_BLENDMODE_BLEND);
+        return scaled;
+    }
+
+    bool fileExists(const std::string& path) {
+        SDL_RWops* file = SDL_RWFromFile(path.c_str(), "rb");
+        if (!file) return false;
+        SDL_RWclose(file);
+        return true;
+    }
+} // end anonymous namespace
+
+
+// --- Scaling ---
+SDL_Surface* downscaleSurface(SDL_Surface* source, int divisor, ScaleFilter filter) {
+    if (!source || divisor < 1) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "downscaleSurface: No surface or bad divisor %d.", divisor); return nullptr; }
+    if (filter == ScaleFilter::BOX && !source->format->palette) return downscaleBox(source, divisor);
+    return downscaleNearest(source, divisor); // NONE with divisor 1 is a plain copy
+}
+
+
+// --- Profile Variants ---
+std::string resolveProfilePath(const std::string& path, const DisplayProfile& profile, ScaleFilter filter, bool& preScaled) {
+    preScaled = profile.isFullSize() || filter == ScaleFilter::NONE;
+    if (preScaled || !profile.variantSuffix) return path;
+    const size_t slash = path.find_last_of("/\\");
+    size_t dot = path.find_last_of('.');
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) dot = path.size();
+    std::string variant = path.substr(0, dot) + "@" + profile.variantSuffix + path.substr(dot);
+    if (!fileExists(variant)) return path;
+    preScaled = true;
+    return variant;
+}
+
+SDL_Surface* loadScaledSurface(const std::string& path, const DisplayProfile& profile, ScaleFilter filter) {
+    bool preScaled = false;
+    const std::string file = resolveProfilePath(path, profile, filter, preScaled);
+    SDL_Surface* surface = IMG_Load(file.c_str());
+    if (!surface) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "IMG_Load failed for '%s': %s", file.c_str(), IMG_GetError()); return nullptr; }
+    if (preScaled) return surface;
+    SDL_Surface* scaled = downscaleSurface(surface, profile.divisor, filter);
+    SDL_FreeSurface(surface);
+    return scaled; // Logs its own errors
+}
@@ -0,0 +1,252 @@
+// File: src/graphics/TiledBackground.cpp
+
+#include "graphics/TiledBackground.h" // Include own header
+#include "platform/pc/pc_display.h"   // To draw
+#include "core/JobSystem.h"           // Background decodes
+#include "graphics/SurfaceScale.h"    // Decodes at the profile's size
+#include <SDL_log.h>                  // SDL logging
+#include <fstream>                    // For reading the manifest
+#include "vendor/nlohmann/json.hpp"   // Path to JSON library header
+#include <algorithm>                  // std::min, std::sort
+#include <thread>                     // std::this_thread::yield
+
+// Use the nlohmann::json namespace
+using json = nlohmann::json;
+
+namespace {
+    const size_t MAX_UPLOADS_PER_FRAME = 2;   // Keeps texture uploads from bunching up in one frame
+    const size_t EXTRA_RESIDENT_TILES = 2;    // Slack over the keep window so direction changes don't thrash
+} // end anonymous namespace
+
+
+TiledBackground::~TiledBackground() {
+    shutdown();
+}
+
+bool TiledBackground::load(const std::string& manifestPath, SDL_Renderer* renderer) {
+    if (!renderer) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "TiledBackground: Cannot load '%s' without a renderer.", manifestPath.c_str()); return false; }
+    shutdown();
+    renderer_ = renderer;
+
+    std::string baseDir;
+    size_t slash = manifestPath.find_last_of("/\\");
+    if (slash != std::string::npos) baseDir = manifestPath.substr(0, slash + 1);
+
+    try {
+        std::ifstream jsonFile(manifestPath);
+        if (!jsonFile.is_open()) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to open tile manifest: %s", manifestPath.c_str()); return false; }
+        json data = json::parse(jsonFile);
+        jsonFile.close();
+        if (!data.contains("tiles") || !data["tiles"].is_array() || data["tiles"].empty()) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Missing 'tiles' array in %s", manifestPath.c_str()); return false; }
+
+        tileWidth_ = data.value("tile_width", 0);
+        height_ = data.value("height", 0);
+        for (const auto& tilePath : data["tiles"]) {
+            Tile tile;
+            tile.path = baseDir + tilePath.get<std::string>();
+            tiles_.push_back(tile);
+        }
+        const int fullWidth = tileWidth_ * static_cast<int>(tiles_.size());
+        width_ = std::min(data.value("width", fullWidth), fullWidth);
+    } catch (json::parse_error& e) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to parse tile manifest '%s': %s (at byte %zu)", manifestPath.c_str(), e.what(), e.byte); tiles_.clear(); return false; }
+      catch (const std::exception& e) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Error reading tile manifest '%s': %s", manifestPath.c_str(), e.what()); tiles_.clear(); return false; }
+
+    if (tileWidth_ <= 0 || height_ <= 0 || width_ <= 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "TiledBackground: Invalid dimensions in '%s' (tile_width %d, height %d, width %d).", manifestPath.c_str(), tileWidth_, height_, width_);
+        tiles_.clear();
+        return false;
+    }
+    tiles_.resize(static_cast<size_t>((width_ + tileWidth_ - 1) / tileWidth_)); // Ignore tiles past 'width'
+    // Small screens hold every tile downscaled; the manifest describes the full-size strip
+    const DisplayProfile& profile = getProfile();
+    if (!profile.isFullSize()) {
+        if (tileWidth_ % profile.divisor != 0) SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "TiledBackground: tile_width %d in '%s' isn't a multiple of %d; seams may shift by a pixel.", tileWidth_, manifestPath.c_str(), profile.divisor);
+        tileWidth_ = profile.scaleSize(tileWidth_);
+        height_ = profile.scaleSize(height_);
+        width_ = profile.scaleSize(width_);
+    }
+    // Sized up front so queueing and uploads never grow them mid-frame
+    wanted_.reserve(tiles_.size());
+    decoded_.reserve(tiles_.size());
+    decodeWanted_ = std::make_unique<std::atomic<bool>[]>(tiles_.size());
+    for (size_t i = 0; i < tiles_.size(); ++i) decodeWanted_[i] = false;
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "TiledBackground: Loaded '%s' (%zu tiles of %dpx, %dx%d).", manifestPath.c_str(), tiles_.size(), tileWidth_, width_, height_);
+    return true;
+}
+
+void TiledBackground::shutdown() {
+    // Queued decodes still point at tiles_; let them drain (cancelled ones skip the decode)
+    if (decodeWanted_) {
+        for (size_t i = 0; i < tiles_.size(); ++i) decodeWanted_[i] = false;
+    }
+    while (decodesInFlight_.load() > 0) std::this_thread::yield();
+    decodeWanted_.reset();
+    for (DecodedTile& done : decoded_) SDL_FreeSurface(done.surface);
+    decoded_.clear();
+    for (size_t i = 0; i < tiles_.size(); ++i) evictTile(i);
+    tiles_.clear();
+    wanted_.clear();
+    residentCount_ = 0;
+    renderer_ = nullptr;
+}
+
+
+// --- Background Decoding ---
+void TiledBackground::queueDecode(size_t index) {
+    tiles_[index].pending = true;
+    decodeWanted_[index] = true;
+    decodesInFlight_.fetch_add(1);
+    if (!jobs_) { decodeTile(index); return; }
+    jobs_->run(jobs_->createJob([this, index]() { decodeTile(index); }));
+}
+
+void TiledBackground::decodeTile(size_t index) {
+    // Decoding is the slow part and touches no shared state; tiles_[index].path is immutable after load
+    SDL_Surface* surface = nullptr;
+    if (decodeWanted_[index]) {
+        surface = loadScaledSurface(tiles_[index].path, getProfile(), ScaleFilter::BOX);
+        if (!surface) { SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "TiledBackground: Decode failed for '%s'.", tiles_[index].path.c_str()); }
+    }
+    {
+        std::lock_guard<std::mutex> lock(decodedMutex_);
+        decoded_.push_back({ index, surface }); // Null results still clear 'pending'
+    }
+    decodesInFlight_.fetch_sub(1);
+}
+
+void TiledBackground::uploadDecoded(size_t maxUploads) {
+    FrameVector<DecodedTile> ready{FrameArenaAllocator<DecodedTile>(frameArena_)};
+    {
+        std::lock_guard<std::mutex> lock(decodedMutex_);
+        const size_t take = std::min(maxUploads, decoded_.size());
+        ready.assign(decoded_.begin(), decoded_.begin() + take);
+        decoded_.erase(decoded_.begin(), decoded_.begin() + take);
+    }
+    for (DecodedTile& done : ready) {
+        Tile& tile = tiles_[done.index];
+        tile.pending = false;
+        if (tile.wanted && !tile.texture && done.surface) {
+            uploadSurface(done.index, done.surface);
+        }
+        if (done.surface) SDL_FreeSurface(done.surface);
+    }
+}
+
+bool TiledBackground::loadTileNow(size_t index) {
+    SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "TiledBackground: Visible tile %zu not resident, loading synchronously.", index);
+    SDL_Surface* surface = loadScaledSurface(tiles_[index].path, getProfile(), ScaleFilter::BOX);
+    if (!surface) return false; // Logs its own errors
+    bool ok = uploadSurface(index, surface);
+    SDL_FreeSurface(surface);
+    return ok;
+}
+
+bool TiledBackground::uploadSurface(size_t index, SDL_Surface* surface) {
+    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer_, surface);
+    if (!texture) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "TiledBackground: Texture upload failed for tile %zu: %s", index, SDL_GetError()); return false; }
+    tiles_[index].texture = texture;
+    ++residentCount_;
+    return true;
+}
+
+void TiledBackground::evictTile(size_t index) {
+    Tile& tile = tiles_[index];
+    if (!tile.texture) return;
+    SDL_DestroyTexture(tile.texture);
+    tile.texture = nullptr;
+    --residentCount_;
+}
+
+int TiledBackground::tileWidthAt(size_t index) const {
+    return std::min(tileWidth_, width_ - static_cast<int>(index) * tileWidth_);
+}
+
+
+// --- Residency ---
+void TiledBackground::updateResidency(int leftColumn, int viewW, int direction) {
+    if (tiles_.empty()) return;
+    ++frameCounter_;
+    const size_t count = tiles_.size();
+
+    for (size_t index : wanted_) tiles_[index].wanted = false;
+    wanted_.clear();
+    auto want = [&](size_t index) {
+        Tile& tile = tiles_[index];
+        if (tile.wanted) return;
+        tile.wanted = true;
+        tile.lastWantedFrame = frameCounter_;
+        wanted_.push_back(index);
+    };
+
+    // Visible tiles must be resident this frame
+    int column = leftColumn % width_;
+    if (column < 0) column += width_;
+    const size_t firstVisible = static_cast<size_t>(column / tileWidth_);
+    size_t lastVisible = firstVisible;
+    int inTile = column - static_cast<int>(firstVisible) * tileWidth_;
+    for (int covered = 0; ; ) {
+        want(lastVisible);
+        covered += tileWidthAt(lastVisible) - inTile;
+        inTile = 0;
+        if (covered >= viewW || wanted_.size() >= count) break;
+        lastVisible = (lastVisible + 1) % count;
+    }
+    for (size_t index : wanted_) {
+        if (!tiles_[index].texture) loadTileNow(index);
+    }
+
+    // Tiles ahead of the scroll direction are decoded in the background
+    if (direction != 0) {
+        size_t index = (direction > 0) ? lastVisible : firstVisible;
+        for (size_t i = 0; i < prefetchTiles_ && wanted_.size() < count; ++i) {
+            index = (direction > 0) ? (index + 1) % count : (index + count - 1) % count;
+            want(index);
+            if (tiles_[index].texture) continue;
+            if (!tiles_[index].pending) queueDecode(index);
+            else decodeWanted_[index] = true; // Back in the window before its job ran
+        }
+    }
+
+    // Cancel queued decodes that scrolled out of the window before a worker reached them
+    for (size_t i = 0; i < count; ++i) {
+        if (tiles_[i].pending && !tiles_[i].wanted) decodeWanted_[i] = false;
+    }
+    uploadDecoded(MAX_UPLOADS_PER_FRAME);
+
+    // Evict least recently wanted tiles once over budget
+    const size_t budget = wanted_.size() + EXTRA_RESIDENT_TILES;
+    if (residentCount_ > budget) {
+        FrameVector<size_t> candidates{FrameArenaAllocator<size_t>(frameArena_)};
+        candidates.reserve(residentCount_);
+        for (size_t i = 0; i < count; ++i) {
+            if (tiles_[i].texture && !tiles_[i].wanted) candidates.push_back(i);
+        }
+        std::sort(candidates.begin(), candidates.end(), [this](size_t a, size_t b) { return tiles_[a].lastWantedFrame < tiles_[b].lastWantedFrame; });
+        for (size_t i = 0; i < candidates.size() && residentCount_ > budget; ++i) evictTile(candidates[i]);
+    }
+}
+
+
+// --- Render ---
+void TiledBackground::render(PCDisplay* display, int leftColumn, int viewW, int viewH) {
+    if (!display || tiles_.empty()) return;
+    const int height = std::min(height_, viewH);
+    int column = leftColumn % width_;
+    if (column < 0) column += width_;
+
+    // Same span walk as ParallaxBackground, but spans also break at tile edges
+    int dstX = 0;
+    while (dstX < viewW) {
+        const size_t index = static_cast<size_t>(column / tileWidth_);
+        const int inTile = column - static_cast<int>(index) * tileWidth_;
+        const int span = std::min(tileWidthAt(index) - inTile, viewW - dstX);
+        if (tiles_[index].texture) {
+            SDL_Rect src = { inTile, 0, span, height };
+            SDL_Rect dst = { dstX, 0, span, height };
+            display->drawTexture(tiles_[index].texture, &src, &dst);
+        }
+        dstX += span;
+        column += span;
+        if (column >= width_) column = 0;
+    }
+}
@@ -0,0 +1,94 @@
+// File: src/input/StepDetector.cpp
+
+#include "input/StepDetector.h" // Include own header
+#include <cmath>                // std::sqrt
+
+namespace {
+    const float PEAK_HYSTERESIS = 0.5f;   // A peak ends once the signal falls below this fraction of the threshold
+    const float PEAK_AVERAGE_WEIGHT = 0.25f;
+}
+
+
+StepDetector::StepDetector(const StepDetectorConfig& config) : config_(config) {
+    reset();
+}
+
+void StepDetector::reset() {
+    for (float& m : magnitude_) m = 0.0f;
+    primed_ = false;
+    baseline_ = 0.0f;
+    abovePeak_ = false;
+    peakValue_ = 0.0f;
+    peakTimeMs_ = 0;
+    walking_ = false;
+    lastStepMs_ = 0;
+    peakAverage_ = 0.0f;
+    samplesProcessed_ = 0;
+}
+
+int StepDetector::process(const AccelSample* samples, size_t count, uint32_t* stepTimesMs, size_t maxStepTimes) {
+    if (!samples || count == 0) return 0;
+    if (!stepTimesMs) maxStepTimes = 0;
+    int steps = 0;
+    size_t stepTimesWritten = 0;
+    for (size_t offset = 0; offset < count; offset += BLOCK) {
+        const size_t blockCount = (count - offset < BLOCK) ? count - offset : BLOCK;
+        steps += processBlock(samples + offset, blockCount, stepTimesMs, maxStepTimes, stepTimesWritten);
+    }
+    samplesProcessed_ += count;
+    return steps;
+}
+
+int StepDetector::processBlock(const AccelSample* samples, size_t count, uint32_t* stepTimesMs, size_t maxStepTimes, size_t& stepTimesWritten) {
+    const size_t HISTORY = SMOOTH_TAPS - 1;
+    float* magnitude = magnitude_ + HISTORY;
+
+    // --- Vectorised Pass: |a| and a box filter over the block ---
+    for (size_t i = 0; i < count; ++i) {
+        const float x = samples[i].x, y = samples[i].y, z = samples[i].z;
+        magnitude[i] = std::sqrt(x * x + y * y + z * z);
+    }
+    if (!primed_) {
+        // Start at rest on the first reading instead of ramping up from zero
+        for (size_t h = 0; h < HISTORY; ++h) magnitude_[h] = magnitude[0];
+        baseline_ = magnitude[0];
+        primed_ = true;
+    }
+    const float tapScale = 1.0f / SMOOTH_TAPS;
+    for (size_t i = 0; i < count; ++i) {
+        smoothed_[i] = (magnitude_[i] + magnitude_[i + 1] + magnitude_[i + 2] + magnitude_[i + 3]) * tapScale;
+    }
+    static_assert(SMOOTH_TAPS == 4, "Box filter above is unrolled for 4 taps");
+    for (size_t h = 0; h < HISTORY; ++h) magnitude_[h] = magnitude_[count + h]; // Tail feeds the next block
+
+    // --- Serial Pass: gravity baseline and peak picking ---
+    int steps = 0;
+    const float alpha = config_.baselineAlpha;
+    for (size_t i = 0; i < count; ++i) {
+        const uint32_t timeMs = samples[i].timeMs;
+        baseline_ += alpha * (smoothed_[i] - baseline_);
+        const float signal = smoothed_[i] - baseline_;
+
+        if (walking_ && timeMs - lastStepMs_ > config_.maxStepMs) {
+            walking_ = false;
+            peakAverage_ = 0.0f; // A new walk may be gentler than the last one
+        }
+        const float adaptive = config_.peakRatio * peakAverage_;
+        const float threshold = adaptive > config_.minPeak ? adaptive : config_.minPeak;
+
+        if (signal > threshold) {
+            if (!abovePeak_ || signal > peakValue_) { peakValue_ = signal; peakTimeMs_ = timeMs; }
+            abovePeak_ = true;
+        } else if (abovePeak_ && signal < threshold * PEAK_HYSTERESIS) {
+            // Peak over: count it unless it follows the last step too closely
+            abovePeak_ = false;
+            if (walking_ && peakTimeMs_ - lastStepMs_ < config_.minStepMs) continue;
+            peakAverage_ = walking_ ? peakAverage_ + PEAK_AVERAGE_WEIGHT * (peakValue_ - peakAverage_) : peakValue_;
+            walking_ = true;
+            lastStepMs_ = peakTimeMs_;
+            ++steps;
+            if (stepTimesWritten < maxStepTimes) stepTimesMs[stepTimesWritten++] = peakTimeMs_;
+        }
+    }
+    return steps;
+}
@@ -0,0 +1,239 @@
+// File: src/input/StepPipeline.cpp
+
+#include "input/StepPipeline.h" // Include own header
+#include <SDL_log.h>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <system_error>
+
+namespace {
+    const char TRACE_MAGIC[4] = { 'D', 'A', 'C', 'C' };
+    const uint32_t TRACE_VERSION = 1;
+    const size_t TRACE_RECORD_BYTES = 16;
+    const int FULL_QUEUE_WAIT_MS = 1;
+
+    uint32_t readU32(const unsigned char* p) {
+        return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+               (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+    }
+
+    float readF32(const unsigned char* p) {
+        const uint32_t bits = readU32(p);
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    bool parseBinaryTrace(const std::vector<unsigned char>& bytes, std::vector<AccelSample>& samples) {
+        if (bytes.size() < 12 || readU32(&bytes[4]) != TRACE_VERSION) return false;
+        const size_t count = readU32(&bytes[8]);
+        if ((bytes.size() - 12) / TRACE_RECORD_BYTES < count) return false;
+        samples.resize(count);
+        const unsigned char* p = bytes.data() + 12;
+        for (size_t i = 0; i < count; ++i, p += TRACE_RECORD_BYTES) {
+            samples[i].timeMs = readU32(p);
+            samples[i].x = readF32(p + 4);
+            samples[i].y = readF32(p + 8);
+            samples[i].z = readF32(p + 12);
+        }
+        return true;
+    }
+
+    bool parseCsvTrace(const std::vector<unsigned char>& bytes, std::vector<AccelSample>& samples) {
+        std::string text(bytes.begin(), bytes.end());
+        for (char& c : text) if (c == '\n') c = '\0'; // One C string per line
+        size_t lineStart = 0;
+        int lineNumber = 0;
+        while (lineStart < text.size()) {
+            const char* line = text.c_str() + lineStart;
+            lineStart += std::strlen(line) + 1;
+            ++lineNumber;
+
+            char* end = nullptr;
+            AccelSample sample;
+            const double timeMs = std::strtod(line, &end);
+            if (end == line) {
+                if (lineNumber == 1 || *line == '\0' || *line == '\r' || *line == '#') continue; // Header, blank or comment
+                SDL_LogError(SDL_LOG_CATEGORY_INPUT, "Accel trace line %d is not 'time_ms,x,y,z'", lineNumber);
+                return false;
+            }
+            float* axes[3] = { &sample.x, &sample.y, &sample.z };
+            for (float* axis : axes) {
+                if (*end != ',') { SDL_LogError(SDL_LOG_CATEGORY_INPUT, "Accel trace line %d is not 'time_ms,x,y,z'", lineNumber); return false; }
+                const char* field = end + 1;
+                *axis = std::strtof(field, &end);
+                if (end == field) { SDL_LogError(SDL_LOG_CATEGORY_INPUT, "Accel trace line %d has a bad number", lineNumber); return false; }
+            }
+            sample.timeMs = static_cast<uint32_t>(timeMs);
+            samples.push_back(sample);
+        }
+        return true;
+    }
+} // end anonymous namespace
+
+
+// --- AccelSource ---
+bool AccelSource::sleepUntil(std::chrono::steady_clock::time_point when) {
+    const auto slice = std::chrono::milliseconds(STOP_CHECK_MS);
+    while (!(stopRequested_ && stopRequested_->load(std::memory_order_acquire))) {
+        const auto now = std::chrono::steady_clock::now();
+        if (now >= when) return true;
+        std::this_thread::sleep_until(when - now > slice ? now + slice : when);
+    }
+    return false;
+}
+
+
+// --- TraceAccelSource ---
+TraceAccelSource::TraceAccelSource(const std::string& path, bool realTime)
+    : path_(path), realTime_(realTime) {}
+
+bool TraceAccelSource::loadTrace(const std::string& path, std::vector<AccelSample>& samples) {
+    samples.clear();
+    std::ifstream file(path, std::ios::binary);
+    if (!file) { SDL_LogError(SDL_LOG_CATEGORY_INPUT, "Could not open accel trace '%s'", path.c_str()); return false; }
+    std::vector<unsigned char> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    const bool binary = bytes.size() >= 4 && std::memcmp(bytes.data(), TRACE_MAGIC, 4) == 0;
+    const bool ok = binary ? parseBinaryTrace(bytes, samples) : parseCsvTrace(bytes, samples);
+    if (!ok) {
+        SDL_LogError(SDL_LOG_CATEGORY_INPUT, "Accel trace '%s' is malformed", path.c_str());
+        samples.clear();
+        return false;
+    }
+    SDL_LogInfo(SDL_LOG_CATEGORY_INPUT, "Loaded %s accel trace '%s': %zu samples", binary ? "binary" : "CSV", path.c_str(), samples.size());
+    return true;
+}
+
+bool TraceAccelSource::open() {
+    if (!loadTrace(path_, samples_)) return false;
+    next_ = 0;
+    startTime_ = std::chrono::steady_clock::now();
+    return true;
+}
+
+bool TraceAccelSource::read(AccelSample& out) {
+    if (next_ >= samples_.size()) return false;
+    out = samples_[next_++];
+    if (realTime_) {
+        const uint32_t offsetMs = out.timeMs - samples_[0].timeMs;
+        if (!sleepUntil(startTime_ + std::chrono::milliseconds(offsetMs))) return false;
+    }
+    return true;
+}
+
+
+// --- SensorAccelSource ---
+SensorAccelSource::SensorAccelSource(int rateHz) : rateHz_(rateHz > 0 ? rateHz : 100) {}
+
+bool SensorAccelSource::open() {
+    if (SDL_InitSubSystem(SDL_INIT_SENSOR) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_INPUT, "Sensor subsystem init failed: %s", SDL_GetError());
+        return false;
+    }
+    subsystemStarted_ = true;
+    SDL_EventState(SDL_SENSORUPDATE, SDL_IGNORE);
+    for (int i = 0; i < SDL_NumSensors(); ++i) {
+        if (SDL_SensorGetDeviceType(i) != SDL_SENSOR_ACCEL) continue;
+        sensor_ = SDL_SensorOpen(i);
+        if (sensor_) break;
+    }
+    if (!sensor_) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_INPUT, "No accelerometer found; steps need a trace or the keyboard.");
+        close();
+        return false;
+    }
+    SDL_LogInfo(SDL_LOG_CATEGORY_INPUT, "Reading accelerometer '%s' at %d Hz", SDL_SensorGetName(sensor_), rateHz_);
+    nextPoll_ = std::chrono::steady_clock::now();
+    return true;
+}
+
+bool SensorAccelSource::read(AccelSample& out) {
+    if (!sensor_) return false;
+    nextPoll_ += std::chrono::microseconds(1000000 / rateHz_);
+    const auto now = std::chrono::steady_clock::now();
+    if (nextPoll_ < now) nextPoll_ = now; // Don't burst to catch up after a stall
+    if (!sleepUntil(nextPoll_)) return false;
+
+    SDL_SensorUpdate();
+    float data[3] = {};
+    if (SDL_SensorGetData(sensor_, data, 3) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_INPUT, "Accelerometer read failed: %s", SDL_GetError());
+        return false;
+    }
+    out.timeMs = SDL_GetTicks();
+    out.x = data[0];
+    out.y = data[1];
+    out.z = data[2];
+    return true;
+}
+
+void SensorAccelSource::close() {
+    if (sensor_) { SDL_SensorClose(sensor_); sensor_ = nullptr; }
+    if (subsystemStarted_) { SDL_QuitSubSystem(SDL_INIT_SENSOR); subsystemStarted_ = false; }
+}
+
+
+// --- StepPipeline ---
+StepPipeline::~StepPipeline() {
+    stop();
+}
+
+bool StepPipeline::start(std::unique_ptr<AccelSource> source) {
+    if (!source) return false;
+    stop();
+    source_ = std::move(source);
+    source_->stopRequested_ = &stopRequested_;
+    stopRequested_.store(false, std::memory_order_relaxed);
+    sourceFinished_.store(false, std::memory_order_relaxed);
+    droppedSamples_.store(0, std::memory_order_relaxed);
+    detector_.reset();
+    AccelSample stale;
+    while (queue_.pop(stale)) {} // Samples left over from a previous source
+    try {
+        thread_ = std::thread(&StepPipeline::producerLoop, this);
+    } catch (const std::system_error& e) {
+        SDL_LogError(SDL_LOG_CATEGORY_INPUT, "Could not start step pipeline thread: %s", e.what());
+        source_.reset();
+        return false;
+    }
+    return true;
+}
+
+void StepPipeline::stop() {
+    if (!thread_.joinable()) return;
+    stopRequested_.store(true, std::memory_order_release);
+    thread_.join(); // Sources check the flag at least every STOP_CHECK_MS while sleeping
+    source_.reset();
+}
+
+void StepPipeline::producerLoop() {
+    if (!source_->open()) {
+        sourceFinished_.store(true, std::memory_order_release);
+        return;
+    }
+    SDL_LogInfo(SDL_LOG_CATEGORY_INPUT, "Step pipeline reading from %s source.", source_->getName());
+    const bool live = source_->isLive();
+    AccelSample sample;
+    while (!stopRequested_.load(std::memory_order_acquire)) {
+        if (!source_->read(sample)) break;
+        while (!queue_.push(sample)) {
+            if (live) { droppedSamples_.fetch_add(1, std::memory_order_relaxed); break; }
+            if (stopRequested_.load(std::memory_order_acquire)) break;
+            std::this_thread::sleep_for(std::chrono::milliseconds(FULL_QUEUE_WAIT_MS)); // Offline replay outruns the consumer
+        }
+    }
+    source_->close();
+    sourceFinished_.store(true, std::memory_order_release);
+    SDL_LogInfo(SDL_LOG_CATEGORY_INPUT, "Step pipeline %s source finished.", source_->getName());
+}
+
+int StepPipeline::poll() {
+    int steps = 0;
+    size_t count;
+    while ((count = queue_.popMany(batch_, POLL_BATCH)) > 0) {
+        steps += detector_.process(batch_, count);
+    }
+    return steps;
+}
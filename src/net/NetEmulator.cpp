@@ -0,0 +1,60 @@
+// File: src/net/NetEmulator.cpp
+
+#include "net/NetEmulator.h" // Include own header
+#include "net/UdpSocket.h"
+#include <cstring> // std::memcpy
+
+namespace {
+    uint64_t splitMix64(uint64_t x) {
+        x += 0x9E3779B97F4A7C15ull;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
+    }
+} // end anonymous namespace
+
+
+void NetEmulator::configure(const NetConditions& conditions, uint64_t seed) {
+    conditions_ = conditions;
+    rng_ = splitMix64(seed);
+    if (rng_ == 0) rng_ = 1; // xorshift must not start at zero
+}
+
+uint32_t NetEmulator::nextRandom() {
+    // xorshift64*
+    rng_ ^= rng_ >> 12;
+    rng_ ^= rng_ << 25;
+    rng_ ^= rng_ >> 27;
+    return static_cast<uint32_t>((rng_ * 0x2545F4914F6CDD1Dull) >> 32);
+}
+
+void NetEmulator::send(const uint8_t* data, size_t size, uint64_t nowMs) {
+    const bool lost = conditions_.lossPercent > 0.0f && nextRandom() % 10000u < static_cast<uint32_t>(conditions_.lossPercent * 100.0f);
+    if (lost || size > MAX_DATAGRAM_BYTES || inFlightCount_ == MAX_IN_FLIGHT) { ++dropped_; return; }
+
+    Datagram* slot = inFlight_;
+    while (slot->used) ++slot;
+    slot->dueMs = nowMs + conditions_.latencyMs + (conditions_.jitterMs > 0 ? nextRandom() % (conditions_.jitterMs + 1) : 0);
+    slot->sequence = nextSequence_++;
+    slot->size = static_cast<uint16_t>(size);
+    std::memcpy(slot->bytes, data, size);
+    slot->used = true;
+    ++inFlightCount_;
+}
+
+void NetEmulator::pump(UdpSocket& socket, uint64_t nowMs) {
+    if (inFlightCount_ == 0) return;
+    // Due datagrams go out earliest first, so jitter reorders but equal delays don't
+    for (;;) {
+        Datagram* next = nullptr;
+        for (Datagram& datagram : inFlight_) {
+            if (!datagram.used || datagram.dueMs > nowMs) continue;
+            if (!next || datagram.dueMs < next->dueMs || (datagram.dueMs == next->dueMs && datagram.sequence < next->sequence)) next = &datagram;
+        }
+        if (!next) return;
+        if (socket.send(next->bytes, next->size)) ++sent_;
+        else ++dropped_;
+        next->used = false;
+        --inFlightCount_;
+    }
+}
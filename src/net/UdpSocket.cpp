@@ -0,0 +1,109 @@
+// File: src/net/UdpSocket.cpp
+
+#include "net/UdpSocket.h" // Include own header
+#include <SDL_log.h>
+#include <cstring>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <cerrno>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace {
+#ifdef _WIN32
+    using NativeSocket = SOCKET;
+    bool wouldBlock() { const int error = WSAGetLastError(); return error == WSAEWOULDBLOCK || error == WSAECONNRESET; } // CONNRESET: peer not up yet
+    int lastError() { return WSAGetLastError(); }
+    void closeNative(NativeSocket s) { closesocket(s); }
+#else
+    using NativeSocket = int;
+    bool wouldBlock() { return errno == EAGAIN || errno == EWOULDBLOCK || errno == ECONNREFUSED; }
+    int lastError() { return errno; }
+    void closeNative(NativeSocket s) { ::close(s); }
+#endif
+
+    sockaddr_in loopbackAddress(uint16_t port) {
+        sockaddr_in address;
+        std::memset(&address, 0, sizeof(address));
+        address.sin_family = AF_INET;
+        address.sin_port = htons(port);
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        return address;
+    }
+} // end anonymous namespace
+
+
+UdpSocket::~UdpSocket() {
+    close();
+}
+
+bool UdpSocket::open(uint16_t localPort, uint16_t peerPort) {
+    close();
+#ifdef _WIN32
+    WSADATA wsaData;
+    if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "UdpSocket: WSAStartup failed."); return false; }
+    const NativeSocket s = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (s == INVALID_SOCKET) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "UdpSocket: socket() failed: %d", lastError()); WSACleanup(); return false; }
+    u_long nonBlocking = 1;
+    const bool configured = ioctlsocket(s, FIONBIO, &nonBlocking) == 0;
+#else
+    const NativeSocket s = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (s < 0) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "UdpSocket: socket() failed: %d", lastError()); return false; }
+    const int flags = fcntl(s, F_GETFL, 0);
+    const bool configured = flags >= 0 && fcntl(s, F_SETFL, flags | O_NONBLOCK) == 0;
+#endif
+    const sockaddr_in local = loopbackAddress(localPort);
+    if (!configured || bind(s, reinterpret_cast<const sockaddr*>(&local), sizeof(local)) != 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "UdpSocket: Could not bind 127.0.0.1:%u: %d", localPort, lastError());
+        closeNative(s);
+#ifdef _WIN32
+        WSACleanup();
+#endif
+        return false;
+    }
+    handle_ = static_cast<uintptr_t>(s);
+    peerPort_ = peerPort;
+    open_ = true;
+    return true;
+}
+
+void UdpSocket::close() {
+    if (!open_) return;
+    closeNative(static_cast<NativeSocket>(handle_));
+#ifdef _WIN32
+    WSACleanup();
+#endif
+    open_ = false;
+}
+
+bool UdpSocket::send(const uint8_t* data, size_t size) {
+    if (!open_) return false;
+    const sockaddr_in peer = loopbackAddress(peerPort_);
+    const auto sent = sendto(static_cast<NativeSocket>(handle_), reinterpret_cast<const char*>(data), static_cast<int>(size), 0,
+                             reinterpret_cast<const sockaddr*>(&peer), sizeof(peer));
+    return sent >= 0 && static_cast<size_t>(sent) == size;
+}
+
+int UdpSocket::receive(uint8_t* buffer, size_t capacity) {
+    if (!open_) return -1;
+    for (;;) {
+        sockaddr_in from;
+        socklen_t fromLength = sizeof(from);
+        const auto received = recvfrom(static_cast<NativeSocket>(handle_), reinterpret_cast<char*>(buffer), static_cast<int>(capacity), 0,
+                                       reinterpret_cast<sockaddr*>(&from), &fromLength);
+        if (received < 0) {
+            if (wouldBlock()) return 0;
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "UdpSocket: recvfrom() failed: %d", lastError());
+            return -1;
+        }
+        if (ntohs(from.sin_port) != peerPort_) continue; // Not our peer
+        return static_cast<int>(received);
+    }
+}
@@ -0,0 +1,31 @@
+// File: src/platform/DisplayProfile.cpp
+
+#include "platform/DisplayProfile.h" // Include own header
+#include <SDL_log.h>                 // SDL logging
+#include <cstring>                   // std::strcmp
+
+namespace {
+    const DisplayProfile DISPLAY_PROFILES[] = {
+        { "round466", DESIGN_WIDTH, DESIGN_HEIGHT, 1, nullptr }, // The shipped watch-sized screen
+        { "round240", 240, 240, 2, "half" },                     // Small round panels (233px of content)
+        { "gba", 240, 160, 3, "third" },                         // 240x160 handhelds (155px square of content)
+    };
+} // end anonymous namespace
+
+
+const DisplayProfile& getDefaultDisplayProfile() {
+    return DISPLAY_PROFILES[0];
+}
+
+const DisplayProfile* findDisplayProfile(const char* name) {
+    if (name) {
+        for (const DisplayProfile& profile : DISPLAY_PROFILES) {
+            if (std::strcmp(profile.name, name) == 0) return &profile;
+        }
+    }
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unknown display profile '%s'.", name ? name : "(null)");
+    for (const DisplayProfile& profile : DISPLAY_PROFILES) {
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "  %-10s %dx%d, assets 1/%d", profile.name, profile.width, profile.height, profile.divisor);
+    }
+    return nullptr;
+}
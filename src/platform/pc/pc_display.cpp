@@ -1,11 +1,35 @@
 // File: src/platform/pc/pc_display.cpp
 
 #include "platform/pc/pc_display.h" // Include own header
+#include "graphics/DrawCommand.h"   // For drawCommands
+#include "graphics/RenderList.h"    // For recording / submit
+#include "graphics/PalettedSheet.h" // Indexed sheets on the software renderer
+#include "core/MemoryBudget.h"      // SHEET_SCRATCH_SIZE
 #include <SDL_log.h>                // <<< CORRECTED SDL Include >>>
 #include <stdexcept>                // Standard
 
 // ... (rest of pc_display.cpp implementation remains the same as provided before, including the new drawTexture method) ...
 
+namespace {
+    // Blend mode and mods as the texture has them now (recording)
+    TextureState readTextureState(SDL_Texture* texture) {
+        TextureState state;
+        if (!texture) return state;
+        SDL_GetTextureBlendMode(texture, &state.blendMode);
+        SDL_GetTextureColorMod(texture, &state.mod.r, &state.mod.g, &state.mod.b);
+        SDL_GetTextureAlphaMod(texture, &state.mod.a);
+        return state;
+    }
+
+    // Puts them back before a recorded draw is replayed (submit)
+    void applyTextureState(SDL_Texture* texture, const TextureState& state) {
+        if (!texture) return;
+        SDL_SetTextureBlendMode(texture, state.blendMode);
+        SDL_SetTextureColorMod(texture, state.mod.r, state.mod.g, state.mod.b);
+        SDL_SetTextureAlphaMod(texture, state.mod.a);
+    }
+} // end anonymous namespace
+
 PCDisplay::PCDisplay() : window_(nullptr), renderer_(nullptr), initialized_(false) {}
 
 PCDisplay::~PCDisplay() {
@@ -26,13 +50,37 @@ bool PCDisplay::init(const char* title, int width, int height) {
     if (!renderer_) { /* ... error log ... */ SDL_DestroyWindow(window_); window_ = nullptr; return false; }
 
     SDL_SetRenderDrawColor(renderer_, 0x00, 0x00, 0x00, 0xFF);
+    createSheetScratch(); // SDL may still have picked the software renderer
     initialized_ = true;
     SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "PCDisplay initialized window and renderer.");
     return true;
 }
 
+bool PCDisplay::initHeadless(int width, int height) {
+    if (initialized_) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "PCDisplay::initHeadless called when already initialized.");
+        return true;
+    }
+    headlessSurface_ = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_ARGB8888);
+    if (!headlessSurface_) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "PCDisplay::initHeadless surface error: %s", SDL_GetError()); return false; }
+
+    renderer_ = SDL_CreateSoftwareRenderer(headlessSurface_);
+    if (!renderer_) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "PCDisplay::initHeadless renderer error: %s", SDL_GetError());
+        SDL_FreeSurface(headlessSurface_); headlessSurface_ = nullptr;
+        return false;
+    }
+
+    SDL_SetRenderDrawColor(renderer_, 0x00, 0x00, 0x00, 0xFF);
+    createSheetScratch();
+    initialized_ = true;
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "PCDisplay initialized headless software renderer (%dx%d).", width, height);
+    return true;
+}
+
 void PCDisplay::clear(uint16_t color) {
     if (!initialized_ || !renderer_) return;
+    if (recording_) { recording_->addClear(); return; }
     SDL_SetRenderDrawColor(renderer_, 0x00, 0x00, 0x00, 0xFF);
     SDL_RenderClear(renderer_);
 }
@@ -47,10 +95,163 @@ void PCDisplay::drawPixels(int dstX, int dstY, int width, int height, const uint
 // --- ADDED Texture Drawing Method ---
 void PCDisplay::drawTexture(SDL_Texture* texture, const SDL_Rect* srcRect, const SDL_Rect* dstRect, SDL_RendererFlip flip) {
     if (!initialized_ || !renderer_ || !texture) return;
+    if (recording_) { recording_->addTexture(texture, readTextureState(texture), srcRect, dstRect, flip); return; }
+    if (const PalettedSheet* sheet = PalettedSheet::findIndexed(texture)) { drawIndexed(*sheet, texture, srcRect, dstRect, flip); return; }
     SDL_RenderCopyEx(renderer_, texture, srcRect, dstRect, 0.0, NULL, flip);
 }
+
+void PCDisplay::drawCommands(const DrawCommand* commands, size_t count) {
+    if (!initialized_ || !renderer_ || !commands) return;
+    for (size_t i = 0; i < count; ++i) {
+        const DrawCommand& cmd = commands[i];
+        if (!cmd.texture) continue;
+        if (recording_) { recording_->addTexture(cmd.texture, readTextureState(cmd.texture), &cmd.srcRect, &cmd.dstRect, cmd.flip); continue; }
+        if (const PalettedSheet* sheet = PalettedSheet::findIndexed(cmd.texture)) { drawIndexed(*sheet, cmd.texture, &cmd.srcRect, &cmd.dstRect, cmd.flip); continue; }
+        if (cmd.flip == SDL_FLIP_NONE) {
+            SDL_RenderCopy(renderer_, cmd.texture, &cmd.srcRect, &cmd.dstRect);
+        } else {
+            SDL_RenderCopyEx(renderer_, cmd.texture, &cmd.srcRect, &cmd.dstRect, 0.0, NULL, cmd.flip);
+        }
+    }
+}
+
+// --- Indexed Sheets ---
+// The software renderer keeps PalettedSheets as indices (see graphics/PalettedSheet.h);
+// their textures are 1x1 handles. Each frame drawn from one is expanded through the
+// sheet's palette into one shared scratch texture and drawn from there with the
+// handle's blend mode and mods. Recording stores the handle, so the expansion
+// happens at submit on the render thread.
+void PCDisplay::createSheetScratch() {
+    SDL_RendererInfo info;
+    if (SDL_GetRendererInfo(renderer_, &info) != 0 || !(info.flags & SDL_RENDERER_SOFTWARE)) return; // GPU sheets keep full textures
+    const int size = static_cast<int>(SHEET_SCRATCH_SIZE);
+    sheetScratch_ = SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, size, size);
+    if (!sheetScratch_) SDL_LogError(SDL_LOG_CATEGORY_RENDER, "PCDisplay: Sheet scratch texture failed: %s", SDL_GetError());
+}
+
+void PCDisplay::drawIndexed(const PalettedSheet& sheet, SDL_Texture* handle, const SDL_Rect* srcRect, const SDL_Rect* dstRect, SDL_RendererFlip flip) {
+    const SDL_Rect src = srcRect ? *srcRect : SDL_Rect{0, 0, sheet.getWidth(), sheet.getHeight()};
+    const int size = static_cast<int>(SHEET_SCRATCH_SIZE);
+    if (!sheetScratch_ || src.w > size || src.h > size) {
+        if (!warnedScratch_) SDL_LogWarn(SDL_LOG_CATEGORY_RENDER, "PCDisplay: Cannot expand a %dx%d sheet frame (scratch is %dx%d); skipping.", src.w, src.h, size, size);
+        warnedScratch_ = true;
+        return;
+    }
+    if (src.w <= 0 || src.h <= 0) return;
+    const SDL_Rect area = {0, 0, src.w, src.h};
+    void* pixels = nullptr;
+    int pitch = 0;
+    // SDL flushes queued draws still reading the scratch before handing it out
+    if (SDL_LockTexture(sheetScratch_, &area, &pixels, &pitch) != 0) { SDL_LogWarn(SDL_LOG_CATEGORY_RENDER, "PCDisplay: Sheet scratch lock failed: %s", SDL_GetError()); return; }
+    sheet.expandToARGB8888(src, pixels, pitch);
+    SDL_UnlockTexture(sheetScratch_);
+    applyTextureState(sheetScratch_, readTextureState(handle));
+    SDL_RenderCopyEx(renderer_, sheetScratch_, &area, dstRect, 0.0, NULL, flip);
+}
+
+void PCDisplay::fillRect(const SDL_Rect* rect, SDL_Color color, bool blend) {
+    if (!initialized_ || !renderer_) return;
+    if (recording_) { recording_->addFillRect(rect, color, blend); return; }
+    SDL_SetRenderDrawBlendMode(renderer_, blend ? SDL_BLENDMODE_BLEND : SDL_BLENDMODE_NONE);
+    SDL_SetRenderDrawColor(renderer_, color.r, color.g, color.b, color.a);
+    SDL_RenderFillRect(renderer_, rect);
+}
+
+bool PCDisplay::supportsRenderTargets() const {
+    return initialized_ && renderer_ && SDL_RenderTargetSupported(renderer_) == SDL_TRUE;
+}
+
+SDL_Texture* PCDisplay::createRenderTarget(int width, int height) {
+    if (!initialized_ || !renderer_ || width <= 0 || height <= 0) return nullptr;
+    SDL_Texture* target = SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, width, height);
+    if (!target) { SDL_LogError(SDL_LOG_CATEGORY_RENDER, "PCDisplay::createRenderTarget failed (%dx%d): %s", width, height, SDL_GetError()); return nullptr; }
+    SDL_SetTextureBlendMode(target, SDL_BLENDMODE_BLEND);
+    return target;
+}
+
+SDL_Texture* PCDisplay::getRenderTarget() const {
+    if (!initialized_ || !renderer_) return nullptr;
+    if (recording_) return recordedTarget_;
+    return SDL_GetRenderTarget(renderer_);
+}
+
+bool PCDisplay::setRenderTarget(SDL_Texture* target) {
+    if (!initialized_ || !renderer_) return false;
+    if (recording_) { recording_->addRenderTarget(target); recordedTarget_ = target; return true; }
+    if (SDL_SetRenderTarget(renderer_, target) != 0) { SDL_LogError(SDL_LOG_CATEGORY_RENDER, "PCDisplay::setRenderTarget failed: %s", SDL_GetError()); return false; }
+    return true;
+}
+
+void PCDisplay::setClipRect(const SDL_Rect* clipRect) {
+    if (!initialized_ || !renderer_) return;
+    if (recording_) { recording_->addClipRect(clipRect); return; }
+    SDL_RenderSetClipRect(renderer_, clipRect);
+}
+
+void PCDisplay::drawGeometry(SDL_Texture* texture, const SDL_Vertex* vertices, int vertexCount, const int* indices, int indexCount) {
+    if (!initialized_ || !renderer_ || !vertices || vertexCount <= 0) return;
+    if (recording_) { recording_->addGeometry(texture, readTextureState(texture), vertices, vertexCount, indices, indexCount); return; }
+    if (SDL_RenderGeometry(renderer_, texture, vertices, vertexCount, indices, indexCount) != 0) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_RENDER, "PCDisplay::drawGeometry failed: %s", SDL_GetError());
+    }
+}
 // --- END Added Method ---
 
+// --- Recording ---
+void PCDisplay::beginRecording(RenderList* list) {
+    if (recording_) SDL_LogWarn(SDL_LOG_CATEGORY_RENDER, "PCDisplay::beginRecording called while already recording.");
+    recordedTarget_ = (initialized_ && renderer_) ? SDL_GetRenderTarget(renderer_) : nullptr;
+    recording_ = list;
+}
+
+void PCDisplay::endRecording() {
+    recording_ = nullptr;
+    recordedTarget_ = nullptr;
+}
+
+void PCDisplay::submit(const RenderList& list) {
+    if (!initialized_ || !renderer_) return;
+    if (recording_) { SDL_LogError(SDL_LOG_CATEGORY_RENDER, "PCDisplay::submit called while recording; ignoring."); return; }
+    const SDL_Vertex* vertices = list.getVertices().data();
+    const int* indices = list.getIndices().data();
+    for (const RenderCommand& cmd : list.getCommands()) {
+        const SDL_Rect* src = cmd.hasSrc ? &cmd.src : nullptr;
+        const SDL_Rect* dst = cmd.hasDst ? &cmd.dst : nullptr;
+        switch (cmd.op) {
+            case RenderOp::CLEAR:         clear(0x0000); break;
+            case RenderOp::TEXTURE:       applyTextureState(cmd.texture, cmd.textureState); drawTexture(cmd.texture, src, dst, cmd.flip); break;
+            case RenderOp::GEOMETRY:      applyTextureState(cmd.texture, cmd.textureState); drawGeometry(cmd.texture, vertices + cmd.firstVertex, cmd.vertexCount, cmd.indexCount > 0 ? indices + cmd.firstIndex : nullptr, cmd.indexCount); break;
+            case RenderOp::FILL_RECT:     fillRect(dst, cmd.color, cmd.blend); break;
+            case RenderOp::CLIP_RECT:     setClipRect(dst); break;
+            case RenderOp::RENDER_TARGET: setRenderTarget(cmd.texture); break;
+        }
+    }
+}
+
+bool PCDisplay::readPixels(void* pixels, int pitch, int width, int height) {
+    if (!initialized_ || !renderer_ || !pixels) return false;
+    if (recording_) { SDL_LogWarn(SDL_LOG_CATEGORY_RENDER, "PCDisplay::readPixels called while recording; nothing has been drawn yet."); return false; }
+    if (headlessSurface_ && !SDL_GetRenderTarget(renderer_)) {
+        if (width != headlessSurface_->w || height != headlessSurface_->h) { SDL_LogError(SDL_LOG_CATEGORY_RENDER, "PCDisplay::readPixels size mismatch."); return false; }
+        SDL_RenderFlush(renderer_); // The software renderer batches draws until asked
+        const Uint8* src = static_cast<const Uint8*>(headlessSurface_->pixels);
+        Uint8* dst = static_cast<Uint8*>(pixels);
+        const size_t rowBytes = static_cast<size_t>(width) * 4;
+        if (pitch == headlessSurface_->pitch) {
+            SDL_memcpy(dst, src, rowBytes * height);
+        } else {
+            for (int y = 0; y < height; ++y) SDL_memcpy(dst + static_cast<size_t>(y) * pitch, src + static_cast<size_t>(y) * headlessSurface_->pitch, rowBytes);
+        }
+        return true;
+    }
+    const SDL_Rect area = {0, 0, width, height};
+    if (SDL_RenderReadPixels(renderer_, &area, SDL_PIXELFORMAT_ARGB8888, pixels, pitch) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_RENDER, "PCDisplay::readPixels failed: %s", SDL_GetError());
+        return false;
+    }
+    return true;
+}
+
 void PCDisplay::present() {
     if (!initialized_ || !renderer_) return;
     SDL_RenderPresent(renderer_);
@@ -59,8 +260,10 @@ void PCDisplay::present() {
 void PCDisplay::close() {
     if (!initialized_) return;
     SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Closing PCDisplay...");
+    if (sheetScratch_) { SDL_DestroyTexture(sheetScratch_); sheetScratch_ = nullptr; }
     if (renderer_) { SDL_DestroyRenderer(renderer_); renderer_ = nullptr; }
     if (window_) { SDL_DestroyWindow(window_); window_ = nullptr; }
+    if (headlessSurface_) { SDL_FreeSurface(headlessSurface_); headlessSurface_ = nullptr; }
     initialized_ = false;
     SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "PCDisplay closed.");
 }
@@ -80,6 +283,9 @@ SDL_Window* PCDisplay::getWindow() const {
 void PCDisplay::getWindowSize(int& width, int& height) const { // Added const here too
     if (window_) { // Make sure the window pointer is valid
         SDL_GetWindowSize(window_, &width, &height);
+    } else if (headlessSurface_) {
+        width = headlessSurface_->w;
+        height = headlessSurface_->h;
     } else {
         SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "PCDisplay::getWindowSize called when window_ is null!");
         width = 0; // Indicate error or default
@@ -0,0 +1,127 @@
+// File: src/sim/BattleSim.cpp
+
+#include "sim/BattleSim.h" // Include own header
+#include <cstring>         // std::memcpy
+
+namespace {
+    const uint32_t SCRIPT_BLOCK_FRAMES = 8; // Scripted players hold a choice this long, like real thumbs
+
+    uint32_t nextRandom(uint32_t& state) {
+        // xorshift32; never reaches zero from a non-zero start
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+
+    uint32_t mix32(uint32_t x) {
+        x ^= x >> 16;
+        x *= 0x7FEB352Du;
+        x ^= x >> 15;
+        x *= 0x846CA68Bu;
+        return x ^ (x >> 16);
+    }
+
+    void resetRound(const BattleConfig& config, BattleFighter& fighter) {
+        fighter.hp = config.maxHp;
+        fighter.charge = 0;
+        fighter.cooldown = 0;
+        fighter.stun = 0;
+        fighter.guarding = 0;
+    }
+} // end anonymous namespace
+
+
+BattleState startBattle(const BattleConfig& config, uint8_t partnerA, uint8_t partnerB, uint32_t seed) {
+    BattleState state;
+    state.rng = mix32(seed) | 1u; // xorshift must not start at zero
+    state.fighters[0].partner = partnerA;
+    state.fighters[1].partner = partnerB;
+    for (BattleFighter& fighter : state.fighters) resetRound(config, fighter);
+    return state;
+}
+
+uint32_t stepBattle(const BattleConfig& config, BattleState& state, const BattleInput inputs[2]) {
+    ++state.frame;
+    if (state.roundOverFrames > 0) {
+        if (--state.roundOverFrames > 0) return BATTLE_EVENT_NONE;
+        for (BattleFighter& fighter : state.fighters) resetRound(config, fighter);
+        ++state.round;
+        return BATTLE_EVENT_ROUND_START;
+    }
+
+    // Both fighters act on the same frame; hits are worked out against the
+    // guard state from before either lands, so neither player index goes first.
+    bool attacks[2] = {};
+    bool specials[2] = {};
+    for (int i = 0; i < 2; ++i) {
+        BattleFighter& fighter = state.fighters[i];
+        if (fighter.cooldown > 0) --fighter.cooldown;
+        if (fighter.stun > 0) {
+            --fighter.stun;
+            fighter.guarding = 0;
+            continue;
+        }
+        const BattleInput input = inputs[i];
+        if ((input & (BATTLE_INPUT_ATTACK | BATTLE_INPUT_SPECIAL)) && fighter.cooldown == 0) {
+            attacks[i] = true;
+            specials[i] = (input & BATTLE_INPUT_SPECIAL) && fighter.charge >= config.maxCharge;
+            fighter.guarding = 0; // Swinging drops the guard
+        } else {
+            fighter.guarding = (input & BATTLE_INPUT_GUARD) ? 1 : 0;
+        }
+    }
+
+    uint32_t events = BATTLE_EVENT_NONE;
+    int damage[2] = {};
+    for (int i = 0; i < 2; ++i) {
+        if (!attacks[i]) continue;
+        BattleFighter& attacker = state.fighters[i];
+        BattleFighter& target = state.fighters[1 - i];
+        int amount = specials[i] ? config.specialDamage : config.attackDamage + static_cast<int>(nextRandom(state.rng) & 3u);
+        if (target.guarding) {
+            amount /= config.guardDivisor > 0 ? config.guardDivisor : 1;
+            events |= BATTLE_EVENT_GUARDED;
+        } else {
+            target.stun = config.hitStun;
+            events |= BATTLE_EVENT_HIT;
+        }
+        if (specials[i]) {
+            attacker.charge = 0;
+            events |= BATTLE_EVENT_SPECIAL;
+        } else if (attacker.charge < config.maxCharge) {
+            ++attacker.charge;
+        }
+        attacker.cooldown = config.attackCooldown;
+        damage[1 - i] += amount;
+    }
+
+    for (int i = 0; i < 2; ++i) {
+        const int hp = state.fighters[i].hp - damage[i];
+        state.fighters[i].hp = static_cast<int16_t>(hp > 0 ? hp : 0);
+    }
+    const bool downA = state.fighters[0].hp == 0, downB = state.fighters[1].hp == 0;
+    if (downA || downB) {
+        state.lastWinner = downA == downB ? 0xFF : (downA ? 1 : 0); // Double KO: no winner
+        if (state.lastWinner != 0xFF) ++state.fighters[state.lastWinner].wins;
+        state.roundOverFrames = config.roundOverFrames > 0 ? config.roundOverFrames : 1;
+        events |= BATTLE_EVENT_KO;
+    }
+    return events;
+}
+
+uint32_t hashBattleState(const BattleState& state) {
+    unsigned char bytes[sizeof(BattleState)];
+    std::memcpy(bytes, &state, sizeof(bytes));
+    uint32_t hash = 2166136261u; // FNV-1a
+    for (unsigned char b : bytes) { hash ^= b; hash *= 16777619u; }
+    return hash;
+}
+
+BattleInput scriptedBattleInput(uint32_t seed, int player, uint32_t frame) {
+    const uint32_t roll = mix32(seed ^ mix32(static_cast<uint32_t>(player) * 0x9E3779B9u ^ mix32(frame / SCRIPT_BLOCK_FRAMES))) % 100u;
+    if (roll < 40) return BATTLE_INPUT_ATTACK;
+    if (roll < 65) return BATTLE_INPUT_GUARD;
+    if (roll < 75) return BATTLE_INPUT_SPECIAL;
+    return BATTLE_INPUT_NONE;
+}
@@ -0,0 +1,233 @@
+// File: src/sim/DeviceSim.cpp
+
+#include "sim/DeviceSim.h"  // Include own header
+#include "core/JobSystem.h" // Batch parallelism
+#include <cmath>            // std::log, std::floor
+
+namespace {
+    const double SECONDS_PER_HOUR = 3600.0;
+    const double SECONDS_PER_DAY = 24.0 * SECONDS_PER_HOUR;
+    const size_t SIMULATE_GRAIN = 256;        // Devices per job; each runs thousands of intervals
+    const size_t ADVANCE_GRAIN = 4096;        // Devices per job for input-free lockstep advances
+
+    uint32_t frameTicks(const SimClip& clip, uint8_t frame) {
+        const uint32_t ticks = msToTicks(clip.frameMs[frame]);
+        return ticks > 0 ? ticks : 1; // Zero-length frames would stall the frame loop
+    }
+
+    uint64_t clipTicks(const SimClip& clip) {
+        uint64_t total = 0;
+        for (uint8_t i = 0; i < clip.frameCount; ++i) total += frameTicks(clip, i);
+        return total;
+    }
+
+    // Walker schedules are in seconds; the device clock is in ticks
+    double ticksToSeconds(uint64_t ticks) { return static_cast<double>(ticks) / TICKS_PER_SECOND; }
+    uint64_t secondsToTicks(double seconds) { return seconds > 0.0 ? static_cast<uint64_t>(seconds * TICKS_PER_SECOND + 0.5) : 0; }
+
+    void setMode(DeviceState& device, DeviceMode mode) {
+        device.mode = mode;
+        device.animFrame = 0;
+        device.animTicks = 0;
+    }
+
+    uint32_t countStep(const SimConfig& config, DeviceState& device) {
+        uint32_t events = DEVICE_EVENT_STEP;
+        if (device.queuedSteps > 0) --device.queuedSteps;
+        ++device.totalSteps;
+        ++device.stageSteps;
+        if (device.stage + 1 < SimConfig::STAGE_COUNT && device.stageSteps >= config.stepsToEvolve[device.stage]) {
+            ++device.stage;
+            device.stageSteps = 0;
+            events |= DEVICE_EVENT_EVOLVED;
+        }
+        return events;
+    }
+
+    // --- Walker randomness (per device, so results never depend on scheduling) ---
+    uint64_t splitMix64(uint64_t x) {
+        x += 0x9E3779B97F4A7C15ull;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
+    }
+
+    double random01(uint64_t& state) {
+        // xorshift64*: top 53 bits as a double in [0, 1)
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        return static_cast<double>((state * 0x2545F4914F6CDD1Dull) >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    double randomExponential(uint64_t& state, double mean) {
+        return -mean * std::log(1.0 - random01(state));
+    }
+
+    // Moves a start time that falls while the player sleeps to shortly after waking
+    double clampToWakingHours(const WalkerProfile& profile, WalkerState& walker, double atSec) {
+        const double dayStart = std::floor(atSec / SECONDS_PER_DAY) * SECONDS_PER_DAY;
+        const double wakeSec = dayStart + profile.wakeHour * SECONDS_PER_HOUR;
+        const double sleepSec = dayStart + profile.sleepHour * SECONDS_PER_HOUR;
+        if (atSec >= wakeSec && atSec < sleepSec) return atSec;
+        const double nextWake = atSec < wakeSec ? wakeSec : wakeSec + SECONDS_PER_DAY;
+        return nextWake + random01(walker.rng) * walker.gapMeanSec;
+    }
+
+    void startSession(const WalkerProfile& profile, WalkerState& walker, double nowSec) {
+        walker.sessionLeftSec = static_cast<float>(walker.sessionMeanSec * (0.5 + random01(walker.rng)));
+        const double gap = randomExponential(walker.rng, walker.gapMeanSec);
+        walker.nextSessionSec = clampToWakingHours(profile, walker, nowSec + walker.sessionLeftSec + gap);
+    }
+
+    void advanceTracked(const SimConfig& config, SimDevice& sim, uint64_t deltaTicks) {
+        if (advanceDevice(config, sim.device, deltaTicks) & DEVICE_EVENT_EVOLVED) {
+            sim.stageReachedSec[sim.device.stage] = ticksToSeconds(sim.device.clockTicks); // Within one step interval
+        }
+    }
+
+    void simulateDevice(const SimConfig& config, const WalkerProfile& profile, SimDevice& sim, uint64_t ticks) {
+        DeviceState& device = sim.device;
+        WalkerState& walker = sim.walker;
+        const uint64_t endTicks = device.clockTicks + ticks;
+        const uint64_t stepTicks = secondsToTicks(1.0 / walker.cadence);
+        while (device.clockTicks < endTicks) {
+            if (walker.sessionLeftSec <= 0.0f) {
+                // Between walks nothing is offered: jump straight to the next walk
+                const uint64_t sessionTicks = secondsToTicks(walker.nextSessionSec);
+                const uint64_t untilTicks = sessionTicks < endTicks ? sessionTicks : endTicks;
+                if (untilTicks > device.clockTicks) advanceTracked(config, sim, untilTicks - device.clockTicks);
+                if (device.clockTicks >= sessionTicks) startSession(profile, walker, ticksToSeconds(device.clockTicks));
+                continue;
+            }
+            // Walking: one cadence interval at a time, offering the steps it produced
+            uint64_t deltaTicks = stepTicks;
+            const uint64_t sessionTicks = secondsToTicks(walker.sessionLeftSec);
+            if (deltaTicks > sessionTicks) deltaTicks = sessionTicks;
+            if (deltaTicks > endTicks - device.clockTicks) deltaTicks = endTicks - device.clockTicks;
+            if (deltaTicks == 0) deltaTicks = 1; // A session shorter than a tick still ends
+            advanceTracked(config, sim, deltaTicks);
+            const double deltaSec = ticksToSeconds(deltaTicks);
+            walker.sessionLeftSec -= static_cast<float>(deltaSec);
+            walker.stepCarry += static_cast<float>(deltaSec * walker.cadence);
+            while (walker.stepCarry >= 1.0f) {
+                walker.stepCarry -= 1.0f;
+                ++walker.stepsOffered;
+                if (!offerStep(config, device)) ++walker.stepsDropped;
+            }
+        }
+    }
+} // end anonymous namespace
+
+
+// --- Config ---
+SimConfig defaultSimConfig() {
+    SimConfig config;
+    config.idle.frameMs[0] = 1000; config.idle.frameMs[1] = 1000;
+    config.idle.frameCount = 2;
+    config.idle.loops = true;
+    for (int i = 0; i < 4; ++i) config.walk.frameMs[i] = 300;
+    config.walk.frameCount = 4;
+    config.walk.loops = false;
+    config.maxQueuedSteps = 2;
+    const uint32_t stepsToEvolve[SimConfig::STAGE_COUNT - 1] = { 1000, 5000, 20000, 60000 };
+    for (int i = 0; i < SimConfig::STAGE_COUNT - 1; ++i) config.stepsToEvolve[i] = stepsToEvolve[i];
+    return config;
+}
+
+
+// --- Single Device ---
+bool offerStep(const SimConfig& config, DeviceState& device) {
+    if (device.queuedSteps >= config.maxQueuedSteps) return false;
+    ++device.queuedSteps;
+    return true;
+}
+
+void selectPartner(DeviceState& device, uint16_t partner) {
+    device.partner = partner;
+    device.queuedSteps = 0;
+    setMode(device, DeviceMode::IDLE);
+}
+
+uint32_t advanceDevice(const SimConfig& config, DeviceState& device, uint64_t deltaTicks) {
+    uint32_t events = DEVICE_EVENT_NONE;
+    if (deltaTicks == 0) return events;
+    device.clockTicks += deltaTicks;
+    if (device.mode == DeviceMode::IDLE && device.queuedSteps > 0) {
+        setMode(device, DeviceMode::WALKING);
+        events |= DEVICE_EVENT_MODE_CHANGED;
+    }
+
+    uint64_t remaining = deltaTicks;
+    while (remaining > 0) {
+        const bool walking = device.mode == DeviceMode::WALKING;
+        const SimClip& clip = walking ? config.walk : config.idle;
+        if (clip.frameCount == 0) break;
+        if (!walking && clip.loops) {
+            // Nothing changes while idle, so whole idle loops are skipped
+            const uint64_t cycleTicks = clipTicks(clip);
+            if (remaining > cycleTicks) remaining %= cycleTicks;
+            if (remaining == 0) break;
+        }
+        if (device.animFrame >= clip.frameCount) { device.animFrame = 0; device.animTicks = 0; }
+
+        const uint32_t frameLength = frameTicks(clip, device.animFrame);
+        const uint32_t left = frameLength > device.animTicks ? frameLength - device.animTicks : 0;
+        if (remaining < left) { device.animTicks += static_cast<uint32_t>(remaining); break; }
+        remaining -= left;
+        device.animTicks = 0;
+        if (device.animFrame + 1 < clip.frameCount) { ++device.animFrame; continue; }
+
+        // Clip finished: a walk cycle counts one step, then walks again or rests
+        if (walking) {
+            events |= countStep(config, device);
+            if (device.queuedSteps == 0) { setMode(device, DeviceMode::IDLE); events |= DEVICE_EVENT_MODE_CHANGED; }
+            else device.animFrame = 0;
+        } else if (clip.loops) {
+            device.animFrame = 0;
+        } else {
+            device.animTicks = frameLength; // Non-looping idle holds its last frame
+            break;
+        }
+    }
+    return events;
+}
+
+
+// --- Batches ---
+void initSimDevices(SimDevice* devices, size_t count, uint64_t seed, const WalkerProfile& profile, size_t firstIndex) {
+    const double wakingSec = (profile.sleepHour - profile.wakeHour) * SECONDS_PER_HOUR;
+    for (size_t i = 0; i < count; ++i) {
+        SimDevice& sim = devices[i];
+        sim = SimDevice();
+        for (double& reached : sim.stageReachedSec) reached = -1.0;
+        sim.stageReachedSec[0] = 0.0;
+
+        WalkerState& walker = sim.walker;
+        walker.rng = splitMix64(seed ^ splitMix64(firstIndex + i));
+        if (walker.rng == 0) walker.rng = 1; // xorshift must not start at zero
+        const double stepsPerDay = profile.stepsPerDay * (1.0 + profile.stepsPerDaySpread * (2.0 * random01(walker.rng) - 1.0));
+        walker.cadence = static_cast<float>(profile.cadence * (1.0 + profile.cadenceSpread * (2.0 * random01(walker.rng) - 1.0)));
+        if (walker.cadence < 0.1f) walker.cadence = 0.1f;
+        walker.sessionMeanSec = static_cast<float>(stepsPerDay / (profile.sessionsPerDay * walker.cadence));
+        const double gapSec = wakingSec / profile.sessionsPerDay - walker.sessionMeanSec;
+        walker.gapMeanSec = static_cast<float>(gapSec > 60.0 ? gapSec : 60.0);
+        walker.nextSessionSec = clampToWakingHours(profile, walker, 0.0);
+    }
+}
+
+void simulateDevices(JobSystem* jobs, const SimConfig& config, const WalkerProfile& profile, SimDevice* devices, size_t count, uint64_t ticks) {
+    auto body = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) simulateDevice(config, profile, devices[i], ticks);
+    };
+    if (jobs && jobs->isInitialized()) jobs->parallelFor(count, SIMULATE_GRAIN, body);
+    else body(0, count);
+}
+
+void advanceDevices(JobSystem* jobs, const SimConfig& config, DeviceState* devices, size_t count, uint64_t deltaTicks) {
+    auto body = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) advanceDevice(config, devices[i], deltaTicks);
+    };
+    if (jobs && jobs->isInitialized()) jobs->parallelFor(count, ADVANCE_GRAIN, body);
+    else body(0, count);
+}
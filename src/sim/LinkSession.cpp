@@ -0,0 +1,277 @@
+// File: src/sim/LinkSession.cpp
+
+#include "sim/LinkSession.h" // Include own header
+#include <cstring>           // std::memcpy, std::memcmp
+
+namespace {
+    // Packet: magic(2) version(1) flags(1) ack(4) syncAck(4) firstFrame(4) count(1) inputs(count/2, two per byte)
+    //   [SYNC] syncFrame(4) baselineFrame(4) checksum(4) deltaLength(1) delta(deltaLength)
+    // Multi-byte fields are little-endian.
+    const uint16_t PACKET_MAGIC = 0x4C44; // "DL"
+    const uint8_t PACKET_VERSION = 1;
+    const uint8_t FLAG_SYNC = 1u << 0;
+    const size_t HEADER_BYTES = 17;
+    const size_t SYNC_HEADER_BYTES = 13;
+    const size_t STATE_BYTES = sizeof(BattleState);
+    const size_t MAX_DELTA_BYTES = STATE_BYTES + STATE_BYTES / 2 + 2; // Worst case: alternating zero / non-zero bytes
+
+    void put32(uint8_t* out, uint32_t value) {
+        out[0] = static_cast<uint8_t>(value);
+        out[1] = static_cast<uint8_t>(value >> 8);
+        out[2] = static_cast<uint8_t>(value >> 16);
+        out[3] = static_cast<uint8_t>(value >> 24);
+    }
+
+    uint32_t get32(const uint8_t* in) {
+        return static_cast<uint32_t>(in[0]) | static_cast<uint32_t>(in[1]) << 8 | static_cast<uint32_t>(in[2]) << 16 | static_cast<uint32_t>(in[3]) << 24;
+    }
+
+    // XOR against the baseline leaves zeros wherever nothing changed (partners,
+    // wins, most of the frame counter), so the delta is a list of
+    // [zero run][literal count][literal bytes...]; trailing zeros are implied.
+    size_t encodeDelta(const BattleState& state, const BattleState& baseline, uint8_t* out) {
+        uint8_t current[STATE_BYTES], base[STATE_BYTES];
+        std::memcpy(current, &state, STATE_BYTES);
+        std::memcpy(base, &baseline, STATE_BYTES);
+        for (size_t i = 0; i < STATE_BYTES; ++i) current[i] ^= base[i];
+
+        size_t length = 0, i = 0;
+        while (i < STATE_BYTES) {
+            uint8_t zeros = 0, literals = 0;
+            while (i < STATE_BYTES && current[i] == 0) { ++zeros; ++i; }
+            if (i == STATE_BYTES) break;
+            out[length++] = zeros;
+            const size_t countAt = length++;
+            while (i < STATE_BYTES && current[i] != 0) { out[length++] = current[i++]; ++literals; }
+            out[countAt] = literals;
+        }
+        return length;
+    }
+
+    bool decodeDelta(const uint8_t* delta, size_t length, const BattleState& baseline, BattleState& state) {
+        uint8_t bytes[STATE_BYTES];
+        std::memcpy(bytes, &baseline, STATE_BYTES);
+        size_t in = 0, at = 0;
+        while (in < length) {
+            if (length - in < 2) return false;
+            const size_t zeros = delta[in], literals = delta[in + 1];
+            in += 2;
+            if (at + zeros + literals > STATE_BYTES || in + literals > length) return false;
+            at += zeros;
+            for (size_t i = 0; i < literals; ++i) bytes[at++] ^= delta[in++];
+        }
+        std::memcpy(&state, bytes, STATE_BYTES);
+        return true;
+    }
+} // end anonymous namespace
+
+
+void LinkSession::start(const BattleConfig& config, const BattleState& initial, int localPlayer) {
+    *this = LinkSession();
+    config_ = config;
+    localPlayer_ = localPlayer == 0 ? 0 : 1;
+    state_ = initial;
+    frame_ = initial.frame;
+    // The first INPUT_DELAY frames have no inputs on either side
+    localQueued_ = remoteReceived_ = remoteAcked_ = frame_ + INPUT_DELAY;
+    // Both sides hold the starting state, so it serves as the first delta baseline
+    storeSync(frame_, initial);
+    syncAcked_ = syncReceived_ = frame_;
+    nextSyncFrame_ = frame_ + SYNC_INTERVAL;
+}
+
+bool LinkSession::advance(BattleInput localInput) {
+    resolve();
+    if (frame_ >= remoteReceived_ + MAX_PREDICTION) {
+        ++stats_.stalls;
+        return false;
+    }
+    localInputs_[slot(frame_ + INPUT_DELAY)] = localInput;
+    localQueued_ = frame_ + INPUT_DELAY + 1;
+    simulateFrame();
+    ++stats_.frames;
+    return true;
+}
+
+void LinkSession::resolve() {
+    rollback();
+    if (localPlayer_ == 0) captureSync();
+    else checkPendingSync();
+}
+
+BattleInput LinkSession::remoteInputFor(uint32_t frame) const {
+    if (frame < remoteReceived_) return remoteInputs_[slot(frame)];
+    return remoteInputs_[slot(remoteReceived_ - 1)]; // Prediction: the remote keeps doing what it did last
+}
+
+void LinkSession::simulateFrame() {
+    const uint32_t index = slot(frame_);
+    snapshots_[index] = state_;
+    usedRemote_[index] = remoteInputFor(frame_);
+    BattleInput inputs[2];
+    inputs[localPlayer_] = localInputs_[index];
+    inputs[1 - localPlayer_] = usedRemote_[index];
+    stepBattle(config_, state_, inputs);
+    ++frame_;
+}
+
+void LinkSession::rollback() {
+    if (rollbackFrom_ == NO_FRAME) return;
+    const uint32_t target = frame_;
+    const uint32_t depth = target - rollbackFrom_;
+    state_ = snapshots_[slot(rollbackFrom_)];
+    frame_ = rollbackFrom_;
+    rollbackFrom_ = NO_FRAME;
+    while (frame_ < target) simulateFrame();
+
+    ++stats_.rollbacks;
+    stats_.rolledBackFrames += depth;
+    if (depth > stats_.maxRollback) stats_.maxRollback = depth;
+}
+
+// --- State Sync ---
+void LinkSession::captureSync() {
+    if (syncSending_ != NO_FRAME) return; // One delta in flight at a time keeps the baseline known to both sides
+    const uint32_t confirmed = getConfirmedFrame();
+    const uint32_t frame = confirmed - confirmed % SYNC_INTERVAL;
+    if (frame < nextSyncFrame_) return;
+    storeSync(frame, frame == frame_ ? state_ : snapshots_[slot(frame)]);
+    syncSending_ = frame;
+    nextSyncFrame_ = frame + SYNC_INTERVAL;
+}
+
+void LinkSession::checkPendingSync() {
+    if (syncPending_ == NO_FRAME || syncPending_ > getConfirmedFrame()) return;
+    const uint32_t frame = syncPending_;
+    syncPending_ = NO_FRAME;
+    const SyncRecord* host = findSync(frame);
+    if (!host || frame_ - frame >= HISTORY) { ++stats_.syncsSkipped; return; }
+
+    ++stats_.syncsChecked;
+    BattleState& local = frame == frame_ ? state_ : snapshots_[slot(frame)];
+    if (std::memcmp(&local, &host->state, STATE_BYTES) == 0) return;
+    ++stats_.desyncs;
+    local = host->state;
+    if (frame < frame_) { rollbackFrom_ = frame; rollback(); }
+}
+
+const LinkSession::SyncRecord* LinkSession::findSync(uint32_t frame) const {
+    for (const SyncRecord& record : syncHistory_) {
+        if (record.frame == frame) return &record;
+    }
+    return nullptr;
+}
+
+void LinkSession::storeSync(uint32_t frame, const BattleState& state) {
+    // Replace the oldest record; the baseline in use is always one of the two newest
+    SyncRecord* oldest = &syncHistory_[0];
+    for (SyncRecord& record : syncHistory_) {
+        if (record.frame == NO_FRAME) { oldest = &record; break; }
+        if (record.frame < oldest->frame) oldest = &record;
+    }
+    oldest->frame = frame;
+    oldest->state = state;
+}
+
+// --- Packets ---
+size_t LinkSession::writePacket(uint8_t* out, size_t capacity) {
+    if (capacity < MAX_PACKET_BYTES) return 0;
+    uint32_t first = remoteAcked_;
+    if (localQueued_ - first > MAX_PACKET_INPUTS) first = localQueued_ - MAX_PACKET_INPUTS;
+    const uint32_t count = localQueued_ - first;
+
+    const SyncRecord* sync = syncSending_ != NO_FRAME ? findSync(syncSending_) : nullptr;
+    const SyncRecord* baseline = sync ? findSync(syncAcked_) : nullptr;
+
+    out[0] = static_cast<uint8_t>(PACKET_MAGIC);
+    out[1] = static_cast<uint8_t>(PACKET_MAGIC >> 8);
+    out[2] = PACKET_VERSION;
+    out[3] = baseline ? FLAG_SYNC : 0;
+    put32(out + 4, remoteReceived_);
+    put32(out + 8, localPlayer_ == 0 ? NO_FRAME : syncReceived_);
+    put32(out + 12, first);
+    out[16] = static_cast<uint8_t>(count);
+    size_t length = HEADER_BYTES;
+    for (uint32_t i = 0; i < count; i += 2) {
+        const uint8_t low = localInputs_[slot(first + i)] & 0x0F;
+        const uint8_t high = i + 1 < count ? localInputs_[slot(first + i + 1)] & 0x0F : 0;
+        out[length++] = static_cast<uint8_t>(low | high << 4);
+    }
+
+    if (baseline) {
+        uint8_t* header = out + length;
+        put32(header, sync->frame);
+        put32(header + 4, baseline->frame);
+        put32(header + 8, hashBattleState(sync->state));
+        const size_t deltaLength = encodeDelta(sync->state, baseline->state, header + SYNC_HEADER_BYTES);
+        header[12] = static_cast<uint8_t>(deltaLength);
+        length += SYNC_HEADER_BYTES + deltaLength;
+        stats_.syncBytesSent += SYNC_HEADER_BYTES + deltaLength;
+    }
+    ++stats_.packetsSent;
+    stats_.bytesSent += length;
+    return length;
+}
+
+bool LinkSession::readPacket(const uint8_t* data, size_t size) {
+    if (size < HEADER_BYTES || (data[0] | data[1] << 8) != PACKET_MAGIC || data[2] != PACKET_VERSION) {
+        ++stats_.packetsRejected;
+        return false;
+    }
+    const uint32_t count = data[16];
+    const size_t inputBytes = (count + 1) / 2;
+    size_t length = HEADER_BYTES + inputBytes;
+    const bool hasSync = (data[3] & FLAG_SYNC) != 0;
+    if (size < length || (hasSync && size < length + SYNC_HEADER_BYTES)) { ++stats_.packetsRejected; return false; }
+    ++stats_.packetsReceived;
+    stats_.bytesReceived += size;
+
+    // Acks only ever move forward; packets may arrive out of order
+    const uint32_t ack = get32(data + 4);
+    if (ack > remoteAcked_ && ack <= localQueued_) remoteAcked_ = ack;
+    const uint32_t syncAck = get32(data + 8);
+    if (localPlayer_ == 0 && syncAck != NO_FRAME && syncAck == syncSending_) {
+        syncAcked_ = syncSending_;
+        syncSending_ = NO_FRAME;
+    }
+
+    // Inputs must arrive in order; anything past a gap is resent in the next packet
+    const uint32_t first = get32(data + 12);
+    for (uint32_t i = 0; i < count; ++i) {
+        const uint32_t frame = first + i;
+        if (frame < remoteReceived_) continue;
+        if (frame > remoteReceived_ || frame >= frame_ + HISTORY / 2) break;
+        const uint8_t packed = data[HEADER_BYTES + i / 2];
+        const BattleInput input = static_cast<BattleInput>((i & 1) ? packed >> 4 : packed & 0x0F);
+        remoteInputs_[slot(frame)] = input;
+        if (frame < frame_ && usedRemote_[slot(frame)] != input && frame < rollbackFrom_) rollbackFrom_ = frame;
+        ++remoteReceived_;
+    }
+
+    if (hasSync && localPlayer_ == 1) {
+        const uint8_t* header = data + length;
+        const uint32_t syncFrame = get32(header);
+        const uint32_t baselineFrame = get32(header + 4);
+        const uint32_t checksum = get32(header + 8);
+        const size_t deltaLength = header[12];
+        if (size < length + SYNC_HEADER_BYTES + deltaLength || deltaLength > MAX_DELTA_BYTES) { ++stats_.packetsRejected; return false; }
+        const SyncRecord* baseline = findSync(baselineFrame);
+        if (syncFrame > syncReceived_ && baseline) {
+            BattleState hostState;
+            if (!decodeDelta(header + SYNC_HEADER_BYTES, deltaLength, baseline->state, hostState) || hashBattleState(hostState) != checksum) {
+                ++stats_.packetsRejected;
+                return false;
+            }
+            storeSync(syncFrame, hostState);
+            syncReceived_ = syncFrame;
+            if (syncPending_ != NO_FRAME) ++stats_.syncsSkipped; // Superseded before we could check it
+            syncPending_ = syncFrame;
+        }
+    }
+    return true;
+}
+
+void LinkSession::injectDesync() {
+    state_.fighters[0].hp ^= 1;
+    for (BattleState& snapshot : snapshots_) snapshot.fighters[0].hp ^= 1;
+}
@@ -5,202 +5,207 @@
 #include "core/AssetManager.h"      // To get assets
 #include "platform/pc/pc_display.h" // To draw
 #include "graphics/Animation.h"     // Uses Animation/SpriteFrame
+#include "ui/BitmapFont.h"          // HUD text
 #include "states/MenuState.h"       // Needed for creating MenuState instance (for menu options, maybe remove later)
 #include "states/TransitionState.h" // Needed for creating TransitionState instance
+#include "core/SaveSnapshot.h"      // Save/resume
+#include "entities/RosterSheets.h"  // Partner sheets
+#include "graphics/PalettedSheet.h" // Evolution flash
 #include <SDL_log.h>                // SDL logging
 #include <stdexcept>                // For exceptions
-#include <fstream>                  // For reading files
-#include "vendor/nlohmann/json.hpp" // Path to JSON library header
 #include <cstddef>                  // For size_t
 #include <vector>
 #include <string>
-#include <map>
-#include <cmath>                    // For std::fmod
-
-// Use the nlohmann::json namespace
-using json = nlohmann::json;
-
 
 // --- Anonymous Namespace for Helpers and Constants ---
 namespace {
 
-// --- Helper Function to Create Animation from Indices ---
-// <<< ENSURE ALL 5 ARGUMENTS ARE PRESENT >>>
-Animation createAnimationFromIndices(
-    SDL_Texture* texture,
-    const std::vector<SDL_Rect>& allFrameRects,
-    const std::vector<int>& indices,
-    const std::vector<Uint32>& durations,
-    bool loops) // <<< This 'loops' argument is essential
-{
-    Animation anim;
-    anim.loops = loops; // Assign loops parameter
-    if (!texture) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Cannot create animation: Null texture provided."); return anim; }
-    if (indices.size() != durations.size()) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Animation creation error: Indices count (%zu) does not match durations count (%zu).", indices.size(), durations.size()); return anim; }
-    if (allFrameRects.empty()) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Cannot create animation: Provided frame rectangle list is empty."); return anim; }
-
-    for (size_t i = 0; i < indices.size(); ++i) {
-        int frameIndex = indices[i];
-        Uint32 duration = durations[i];
-        if (frameIndex >= 0 && static_cast<size_t>(frameIndex) < allFrameRects.size()) {
-            anim.addFrame(SpriteFrame(texture, allFrameRects[frameIndex]), duration);
-        } else {
-            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Anim Creation: Index %d out of bounds (%zu). Using frame 0.", frameIndex, allFrameRects.size());
-            anim.addFrame(SpriteFrame(texture, allFrameRects[0]), duration); // Placeholder
-        }
-    }
-    return anim;
-}
-
 // --- Animation Sequence Templates ---
+// Sheet frames per clip; their timings come from the device rules (SimConfig)
 const std::vector<int> IDLE_INDICES = {0, 1};
-const std::vector<Uint32> IDLE_DURATIONS = {1000, 1000};
 const std::vector<int> WALK_INDICES = {2, 3, 2, 3};
-const std::vector<Uint32> WALK_DURATIONS = {300, 300, 300, 300};
 const std::vector<int> ATTACK_INDICES = {1, 0, 3, 8}; // Example, indices likely need adjustment
 const std::vector<Uint32> ATTACK_DURATIONS = {200, 150, 150, 400}; // Example
 
 // Constants (consider moving some later)
-const int MAX_QUEUED_STEPS = 2;
-// Scroll speeds defined in Pixels Per Second
-const float SCROLL_SPEED_0 = 3.0f * 60.0f; // ~180 pixels/sec
-const float SCROLL_SPEED_1 = 1.0f * 60.0f; // ~60 pixels/sec
-const float SCROLL_SPEED_2 = 0.5f * 60.0f; // ~30 pixels/sec
-// Window dimensions (Temporary - get from Game/Display later)
-const int WINDOW_WIDTH = 466;
-const int WINDOW_HEIGHT = 466;
-
+// Scenery layers and their scroll speeds
+const char* const SCENE_PATH = "assets/scenes/castle.json";
+// Particle effects, and the most particles one texture's batch may hold
+const char* const EFFECTS_PATH = "assets/effects/effects.json";
+const size_t MAX_EFFECT_PARTICLES = 2048;
+// Layout below is in design pixels (platform/DisplayProfile.h), scaled per profile
+// Where the partner stands (pivot), relative to the screen centre
+const int PARTNER_OFFSET_Y = -30;
+// Attack sparks fly from just in front of the partner (sheets face left)
+const float ATTACK_ORIGIN_X = -40.0f;
+// HUD placement (inside the round screen's visible area)
+const int HUD_TEXT_SCALE = 2;
+const int HUD_MARGIN_X = 160;
+const int HUD_MARGIN_Y = 40;
+// Evolution flash: lit and dark phases, starting and ending lit
+const int EVOLVE_FLASH_PHASES = 5;
+const uint32_t EVOLVE_FLASH_PHASE_MS = 80;
+const SDL_Color EVOLVE_FLASH_COLOR = {255, 255, 255, 255};
+// Number keys 1-9 pick the first nine roster entries; LEFT/RIGHT page through the rest
+const int PARTNER_NUMBER_KEYS = 9;
+
+
+static_assert(SimClip::MAX_FRAMES <= MAX_ANIMATION_FRAMES, "Device clips must fit an Animation");
+
+// Save/resume chunk layout; bump when fields change (older chunks are then ignored)
+// v2: the partner is saved by roster key, so manifest edits don't swap it
+// v3: device time in ticks (sim/DeviceSim.h)
+const uint16_t SNAPSHOT_VERSION = 3;
+const size_t MAX_PARTNER_KEY = 256; // writeString() limit, terminator included
+
+std::vector<Uint32> clipDurations(const SimClip& clip) {
+    return std::vector<Uint32>(clip.frameMs, clip.frameMs + clip.frameCount);
+}
 
 } // end anonymous namespace
 
 
 // --- Constructor ---
 AdventureState::AdventureState(Game* game) :
-    bgTexture0_(nullptr),
-    bgTexture1_(nullptr),
-    bgTexture2_(nullptr),
-    active_anim_(nullptr),
-    current_digimon_(DIGI_AGUMON),
-    current_state_(STATE_IDLE),
-    current_anim_frame_idx_(0),
-    current_frame_elapsed_time_(0.0f),
-    queued_steps_(0)
+    active_anim_(nullptr)
     // Removed transitioningToMenu_ initializer
 {
     this->game_ptr = game;
-    if (!game_ptr || !game_ptr->getAssetManager() || !game_ptr->get_display()) {
+    if (!game_ptr || !game_ptr->getAssetManager() || !game_ptr->get_display() || game_ptr->getRoster().size() == 0) {
         throw std::runtime_error("AdventureState requires valid Game pointer with initialized systems!");
     }
+    selectPartner(device_, 0); // First in the roster
+    idleDurations_ = clipDurations(simConfig_.idle);
+    walkDurations_ = clipDurations(simConfig_.walk);
     SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "AdventureState Constructor: Initializing...");
 
     AssetManager* assets = game_ptr->getAssetManager();
-    bgTexture0_ = assets->getTexture("castle_bg_0");
-    bgTexture1_ = assets->getTexture("castle_bg_1");
-    bgTexture2_ = assets->getTexture("castle_bg_2");
-    if (!bgTexture0_ || !bgTexture1_ || !bgTexture2_) { SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,"AdventureState: Background texture(s) missing!"); }
-
-    initializeAnimations(); // Load animation data
-    setActiveAnimation(); // Set the initial animation
-
-    if (!active_anim_) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,"CONSTRUCTOR FAIL: Failed to set initial active animation! active_anim_ is NULL.");
-    } else {
-         SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION,"CONSTRUCTOR OK: Initial active_anim_ set in constructor: %p", (void*)active_anim_);
+    background_.setFrameArena(game_ptr->getFrameArena());
+    background_.setJobSystem(game_ptr->getJobSystem());
+    if (!background_.loadFromJson(SCENE_PATH, assets)) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,"AdventureState: Background layer(s) missing from '%s'!", SCENE_PATH);
     }
 
+    // The partner's clips are built by the first render, after any resume has picked the partner
+    updateWantedSheets();
+    initializeEffects();
+
     SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "AdventureState Initialized Successfully.");
 }
 
 
 // --- Destructor ---
-AdventureState::~AdventureState() { SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "AdventureState Destructor called."); }
+AdventureState::~AdventureState() {
+    if (flashPhasesLeft_ > 0) showFlash(false); // The sheet outlives the state
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "AdventureState Destructor called.");
+}
 
 
-// --- Initialize Animations ---
-void AdventureState::initializeAnimations() {
-    AssetManager* assets = game_ptr->getAssetManager();
-    if (!assets) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Cannot init anims: AssetManager null"); return; }
-    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Initializing animations using JSON data...");
-    std::map<DigimonType, std::pair<std::string, std::string>> digimonAssets = {
-        {DIGI_AGUMON, {"agumon_sheet", "assets/sprites/agumon_sheet.json"}},
-        {DIGI_GABUMON, {"gabumon_sheet", "assets/sprites/gabumon_sheet.json"}},
-        {DIGI_BIYOMON, {"biyomon_sheet", "assets/sprites/biyomon_sheet.json"}},
-        {DIGI_GATOMON, {"gatomon_sheet", "assets/sprites/gatomon_sheet.json"}},
-        {DIGI_GOMAMON, {"gomamon_sheet", "assets/sprites/gomamon_sheet.json"}},
-        {DIGI_PALMON, {"palmon_sheet", "assets/sprites/palmon_sheet.json"}},
-        {DIGI_TENTOMON, {"tentomon_sheet", "assets/sprites/tentomon_sheet.json"}},
-        {DIGI_PATAMON, {"patamon_sheet", "assets/sprites/patamon_sheet.json"}}
-    };
-
-    for (const auto& pair : digimonAssets) {
-        DigimonType type = pair.first;
-        const std::string& textureId = pair.second.first;
-        const std::string& jsonPath = pair.second.second;
-        SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "Processing animations for %s...", textureId.c_str());
-        SDL_Texture* texture = assets->getTexture(textureId);
-        if (!texture) { SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Tex '%s' not found for type %d.", textureId.c_str(), type); continue; }
-        std::vector<SDL_Rect> frameRects;
-        try {
-            std::ifstream jsonFile(jsonPath);
-             if (!jsonFile.is_open()) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to open JSON: %s", jsonPath.c_str()); continue; }
-             json data = json::parse(jsonFile);
-             jsonFile.close();
-             if (data.contains("frames")) {
-                 const auto& framesNode = data["frames"];
-                 // --- Handle BOTH Array and Object formats ---
-                 if (framesNode.is_array()) {
-                      SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION,"  Parsing '%s' as ARRAY", jsonPath.c_str());
-                      for (const auto& frameData : framesNode) {
-                          if (frameData.contains("frame")) {
-                             const auto& rectData = frameData["frame"];
-                             if (rectData.contains("x") && rectData.contains("y") && rectData.contains("w") && rectData.contains("h")) {
-                                frameRects.push_back({ rectData["x"].get<int>(), rectData["y"].get<int>(), rectData["w"].get<int>(), rectData["h"].get<int>() });
-                             } else { SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "JSON frame missing x,y,w, or h in %s (array item)", jsonPath.c_str()); }
-                          } else { SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "JSON frame missing 'frame' object in %s (array item)", jsonPath.c_str()); }
-                      }
-                 } else if (framesNode.is_object()) {
-                      SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION,"  Parsing '%s' as OBJECT", jsonPath.c_str());
-                      for (auto it = framesNode.begin(); it != framesNode.end(); ++it) {
-                           const auto& frameData = it.value();
-                           if (frameData.contains("frame")) {
-                                const auto& rectData = frameData["frame"];
-                                if (rectData.contains("x") && rectData.contains("y") && rectData.contains("w") && rectData.contains("h")) {
-                                    frameRects.push_back({ rectData["x"].get<int>(), rectData["y"].get<int>(), rectData["w"].get<int>(), rectData["h"].get<int>() });
-                                } else { SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "JSON frame missing x,y,w, or h in %s (object key: %s)", jsonPath.c_str(), it.key().c_str()); }
-                           } else { SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "JSON frame missing 'frame' object in %s (object key: %s)", jsonPath.c_str(), it.key().c_str()); }
-                      }
-                 } else { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "'frames' not array/object in %s", jsonPath.c_str()); continue; }
-             } else { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Missing 'frames' in %s", jsonPath.c_str()); continue; }
-        } catch (json::parse_error& e) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to parse JSON file '%s': %s (at byte %zu)", jsonPath.c_str(), e.what(), e.byte); (void)e; continue; } // Mark e as unused
-          catch (const std::exception& e) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Error reading/processing JSON file '%s': %s", jsonPath.c_str(), e.what()); (void)e; continue; } // Mark e as unused
-
-        if (frameRects.empty()) { SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "No frames loaded from %s.", jsonPath.c_str()); continue; }
-        SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "Loaded %zu frame rectangles for %s.", frameRects.size(), textureId.c_str());
-        // <<< Ensure 5th argument (loops) is passed >>>
-        idleAnimations_[type] = createAnimationFromIndices(texture, frameRects, IDLE_INDICES, IDLE_DURATIONS, true);
-        walkAnimations_[type] = createAnimationFromIndices(texture, frameRects, WALK_INDICES, WALK_DURATIONS, false);
-        SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "Created animations for type %d.", type);
+// --- Partner Animations ---
+// Normally the sheet was prefetched; the first frame (and a resume) may have to load it here
+void AdventureState::ensurePartnerAnimations() {
+    if (builtPartner_ == device_.partner) return;
+    RosterSheets* sheets = game_ptr->getRosterSheets();
+    if (!sheets->hasFailed(device_.partner)) sheets->loadNow(device_.partner); // Logs its own errors
+    buildAnimations();
+    setActiveAnimation();
+}
+
+bool AdventureState::buildAnimations() {
+    const RosterSheets* sheets = game_ptr->getRosterSheets();
+    const RosterEntry& entry = game_ptr->getRoster().get(device_.partner);
+    builtPartner_ = device_.partner; // Even on failure; a failed sheet is not retried
+    idleAnimation_ = Animation();
+    walkAnimation_ = Animation();
+    attackAnimation_ = Animation();
+    SDL_Texture* texture = sheets->getTexture(device_.partner);
+    if (!texture) { SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Sheet for '%s' not resident; partner has no animations.", entry.key.c_str()); return false; }
+    const std::vector<SpriteFrame>& sheetFrames = sheets->getFrames(device_.partner);
+
+    // <<< Ensure 5th argument (loops) is passed >>>
+    idleAnimation_ = createAnimationFromIndices(texture, sheetFrames, IDLE_INDICES, idleDurations_, simConfig_.idle.loops);
+    walkAnimation_ = createAnimationFromIndices(texture, sheetFrames, WALK_INDICES, walkDurations_, simConfig_.walk.loops);
+    attackAnimation_ = createAnimationFromIndices(texture, sheetFrames, ATTACK_INDICES, ATTACK_DURATIONS, false);
+    SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "Created animations for '%s' (%zu sheet frames).", entry.key.c_str(), sheetFrames.size());
+    return true;
+}
+
+
+// --- Partner Selection ---
+// Picking a partner whose sheet is still on disk keeps the current one on screen
+// until the decode lands, so a switch never stalls a frame.
+void AdventureState::requestPartner(DigimonId id) {
+    RosterSheets* sheets = game_ptr->getRosterSheets();
+    if (!game_ptr->getRoster().isValid(id)) return;
+    if (id == device_.partner) { pendingPartner_ = NO_DIGIMON; updateWantedSheets(); return; } // Changed their mind
+    if (sheets->hasFailed(id)) { SDL_LogWarn(SDL_LOG_CATEGORY_INPUT, "Partner '%s' is unavailable (sheet failed to load).", game_ptr->getRoster().get(id).key.c_str()); return; }
+    if (sheets->isResident(id)) { switchPartner(id); return; }
+    pendingPartner_ = id;
+    updateWantedSheets();
+}
+
+void AdventureState::switchPartner(DigimonId id) {
+    if (flashPhasesLeft_ > 0) { showFlash(false); flashPhasesLeft_ = 0; } // Leaves the old sheet unlit
+    selectPartner(device_, id);
+    pendingPartner_ = NO_DIGIMON;
+    attacking_ = false; // The new partner starts fresh
+    buildAnimations();
+    setActiveAnimation();
+    updateWantedSheets(); // Lets the old partner's sheet go, prefetches the new neighbours
+    SDL_LogInfo(SDL_LOG_CATEGORY_INPUT, "Switched character to '%s'", game_ptr->getRoster().get(id).key.c_str());
+}
+
+void AdventureState::updateWantedSheets() {
+    const Roster& roster = game_ptr->getRoster();
+    DigimonId wanted[RosterSheets::MAX_WANTED];
+    size_t count = 0;
+    wanted[count++] = device_.partner;
+    if (pendingPartner_ != NO_DIGIMON) wanted[count++] = pendingPartner_;
+    // Likely next picks: paging either way, then what the partner evolves into
+    wanted[count++] = roster.next(device_.partner);
+    wanted[count++] = roster.previous(device_.partner);
+    for (DigimonId target : roster.get(device_.partner).evolvesTo) {
+        if (count == RosterSheets::MAX_WANTED) break;
+        wanted[count++] = target;
+    }
+    game_ptr->getRosterSheets()->setWanted(wanted, count); // Duplicates are ignored
+}
+
+
+// --- Initialize Effects ---
+// Without effects the game still plays; attacks and evolutions just lose their sparkle
+void AdventureState::initializeEffects() {
+    PCDisplay* display = game_ptr->get_display();
+    if (!particles_.init(display->getRenderer(), game_ptr->getAssetManager(), MAX_EFFECT_PARTICLES) || !particles_.loadFromJson(EFFECTS_PATH)) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "AdventureState: Effects unavailable ('%s').", EFFECTS_PATH);
+        return;
     }
-    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Finished initializing animations from JSON.");
+    attackEffect_ = particles_.findEffect("attack");
+    evolveEffect_ = particles_.findEffect("evolve");
+}
+
+
+// --- Attack ---
+void AdventureState::startAttack() {
+    if (attacking_) return;
+    if (attackAnimation_.getFrameCount() == 0) return;
+    attacking_ = true;
+    attackFrame_ = 0;
+    attackElapsed_ = 0;
+    const DisplayProfile& profile = game_ptr->getDisplayProfile();
+    particles_.start(attackEffect_, profile.width / 2 + profile.scale(ATTACK_ORIGIN_X), static_cast<float>(profile.height / 2 + profile.scale(PARTNER_OFFSET_Y)));
 }
 
 
 // --- Set Active Animation ---
+// Playback position lives in device_ (animFrame); this only picks the clip to draw.
 void AdventureState::setActiveAnimation() {
-     Animation* previous_anim = active_anim_;
-     if (current_state_ == STATE_IDLE) {
-         auto it = idleAnimations_.find(current_digimon_);
-         active_anim_ = (it != idleAnimations_.end()) ? &(it->second) : nullptr;
-     } else { // STATE_WALKING
-         auto it = walkAnimations_.find(current_digimon_);
-         active_anim_ = (it != walkAnimations_.end()) ? &(it->second) : nullptr;
+     active_anim_ = nullptr;
+     if (builtPartner_ == device_.partner) {
+         Animation& anim = (device_.mode == DeviceMode::IDLE) ? idleAnimation_ : walkAnimation_; // else WALKING
+         if (anim.getFrameCount() > 0) active_anim_ = &anim; // Empty: the sheet failed to load
      }
-     if (active_anim_ != previous_anim) {
-        current_anim_frame_idx_ = 0;
-        current_frame_elapsed_time_ = 0.0f;
-        SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "Animation changed, reset frame index/timer.");
-     }
-     if (!active_anim_) { SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "setActiveAnimation: Could not find animation for state %d, digi %d", current_state_, current_digimon_); }
+     if (!active_anim_) { SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "setActiveAnimation: No animation (yet) for mode %d, digi %d", static_cast<int>(device_.mode), device_.partner); }
      else { SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "Set active animation to %p", (void*)active_anim_); }
 }
 
@@ -211,7 +216,6 @@ void AdventureState::handle_input() {
         return;
     }
     const Uint8* keystates = SDL_GetKeyboardState(NULL);
-    bool stateOrDigiChanged = false;
 
     // Menu Activation
     static bool menu_key_pressed_last_frame = false;
@@ -223,114 +227,216 @@ void AdventureState::handle_input() {
 
     if (menu_requested_this_frame && game_ptr) {
         SDL_LogInfo(SDL_LOG_CATEGORY_INPUT, "Menu key pressed, requesting transition...");
-        const float desired_transition_duration = 0.75f;
-        game_ptr->requestPushState(std::make_unique<TransitionState>(game_ptr, this, desired_transition_duration, TransitionType::BOX_IN_TO_MENU));
+        const Scalar desired_transition_duration = scalarFromMs(750);
+        game_ptr->requestPushState(makeState<TransitionState>(game_ptr, this, desired_transition_duration, TransitionType::BOX_IN_TO_MENU));
     }
 
-    // Step Input
+    // Step Input: detected by the accelerometer pipeline
+    const int detectedSteps = game_ptr ? game_ptr->takeDetectedSteps() : 0;
+    for (int i = 0; i < detectedSteps; ++i) {
+        if (offerStep(simConfig_, device_)) {
+            SDL_LogDebug(SDL_LOG_CATEGORY_INPUT, "Step detected. Queued: %d", device_.queuedSteps);
+        }
+    }
+    // SPACE stands in for a step on desktops without an accelerometer
     static bool space_pressed_last_frame = false;
     if(keystates[SDL_SCANCODE_SPACE]) {
-        if (!space_pressed_last_frame && queued_steps_ < MAX_QUEUED_STEPS) {
-            queued_steps_++;
-            SDL_LogDebug(SDL_LOG_CATEGORY_INPUT, "Step added. Queued: %d", queued_steps_);
+        if (!space_pressed_last_frame && offerStep(simConfig_, device_)) {
+            SDL_LogDebug(SDL_LOG_CATEGORY_INPUT, "Step added. Queued: %d", device_.queuedSteps);
         }
         space_pressed_last_frame = true;
     } else {
         space_pressed_last_frame = false;
     }
 
+    // Attack (A)
+    static bool attack_pressed_last_frame = false;
+    if (keystates[SDL_SCANCODE_A]) {
+        if (!attack_pressed_last_frame) startAttack();
+        attack_pressed_last_frame = true;
+    } else {
+        attack_pressed_last_frame = false;
+    }
+
     // Switch Digimon
-    static bool num_pressed_last_frame[DIGI_COUNT] = {false};
-    for(int i=0; i<DIGI_COUNT; ++i) {
+    static bool num_pressed_last_frame[PARTNER_NUMBER_KEYS] = {false};
+    for(int i=0; i<PARTNER_NUMBER_KEYS; ++i) {
          SDL_Scancode scancode = (SDL_Scancode)(SDL_SCANCODE_1 + i);
          if(keystates[scancode]) {
-             if (!num_pressed_last_frame[i]) {
-                 DigimonType selected = static_cast<DigimonType>(i);
-                 if (selected != current_digimon_) {
-                     current_digimon_ = selected;
-                     current_state_ = STATE_IDLE;
-                     queued_steps_ = 0;
-                     stateOrDigiChanged = true;
-                     SDL_LogInfo(SDL_LOG_CATEGORY_INPUT, "Switched character to %d", current_digimon_);
-                 }
-                 num_pressed_last_frame[i] = true;
-             }
+             if (!num_pressed_last_frame[i]) requestPartner(static_cast<DigimonId>(i)); // Ignored past the roster's end
+             num_pressed_last_frame[i] = true;
          } else {
              num_pressed_last_frame[i] = false;
          }
     }
-
-    if(stateOrDigiChanged) {
-        setActiveAnimation();
+    // Paging walks on from the pending pick, so quick presses skip ahead
+    static bool page_pressed_last_frame = false;
+    const bool pageNext = keystates[SDL_SCANCODE_RIGHT] != 0;
+    const bool pagePrevious = keystates[SDL_SCANCODE_LEFT] != 0;
+    if (pageNext || pagePrevious) {
+        if (!page_pressed_last_frame) {
+            const Roster& roster = game_ptr->getRoster();
+            const DigimonId from = pendingPartner_ != NO_DIGIMON ? pendingPartner_ : device_.partner;
+            requestPartner(pageNext ? roster.next(from) : roster.previous(from));
+        }
+        page_pressed_last_frame = true;
+    } else {
+        page_pressed_last_frame = false;
     }
 }
 
 
 // --- Update ---
-void AdventureState::update(float delta_time) {
-    bool stateNeedsAnimUpdate = false;
+void AdventureState::update(Scalar delta_time) {
+    // A pick waiting on its sheet takes over once the sheet is resident
+    if (pendingPartner_ != NO_DIGIMON) {
+        RosterSheets* sheets = game_ptr->getRosterSheets();
+        if (sheets->isResident(pendingPartner_)) {
+            switchPartner(pendingPartner_);
+        } else if (sheets->hasFailed(pendingPartner_)) {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Partner '%s' is unavailable (sheet failed to load).", game_ptr->getRoster().get(pendingPartner_).key.c_str());
+            pendingPartner_ = NO_DIGIMON;
+            updateWantedSheets();
+        }
+    }
     // Scroll Background
-    if (current_state_ == STATE_WALKING) {
-        float scrollAmount0 = SCROLL_SPEED_0 * delta_time; float scrollAmount1 = SCROLL_SPEED_1 * delta_time; float scrollAmount2 = SCROLL_SPEED_2 * delta_time;
-        int effW0=0, effW1=0, effW2=0;
-        if(bgTexture0_) {int w; SDL_QueryTexture(bgTexture0_,0,0,&w,0); effW0=w*2/3; if(effW0<=0)effW0=w;}
-        if(bgTexture1_) {int w; SDL_QueryTexture(bgTexture1_,0,0,&w,0); effW1=w*2/3; if(effW1<=0)effW1=w;}
-        if(bgTexture2_) {int w; SDL_QueryTexture(bgTexture2_,0,0,&w,0); effW2=w*2/3; if(effW2<=0)effW2=w;}
-        if(effW0 > 0) { bg_scroll_offset_0_ -= scrollAmount0; bg_scroll_offset_0_ = std::fmod(bg_scroll_offset_0_ + effW0, (float)effW0); }
-        if(effW1 > 0) { bg_scroll_offset_1_ -= scrollAmount1; bg_scroll_offset_1_ = std::fmod(bg_scroll_offset_1_ + effW1, (float)effW1); }
-        if(effW2 > 0) { bg_scroll_offset_2_ -= scrollAmount2; bg_scroll_offset_2_ = std::fmod(bg_scroll_offset_2_ + effW2, (float)effW2); }
-     }
-    // State Change: Idle -> Walking
-    if (current_state_ == STATE_IDLE && queued_steps_ > 0) {
-        current_state_ = STATE_WALKING; stateNeedsAnimUpdate = true;
-        SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "State -> WALKING (Steps queued: %d)", queued_steps_);
+    if (device_.mode == DeviceMode::WALKING) {
+        background_.update(delta_time);
     }
-    // Advance Animation Frame
-    bool animation_cycle_finished = false;
-    if (active_anim_ && active_anim_->getFrameCount() > 0) {
-         size_t frameCount = active_anim_->getFrameCount();
-         if (current_anim_frame_idx_ >= frameCount) { current_anim_frame_idx_ = 0; current_frame_elapsed_time_ = 0.0f; SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Animation frame index OOB, reset."); }
-
-         if (current_anim_frame_idx_ < active_anim_->frame_durations_ms.size()) {
-            float duration_sec = active_anim_->frame_durations_ms[current_anim_frame_idx_] / 1000.0f;
-            if (duration_sec <= 0.0f) {
-                 SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Zero duration found for frame %zu, skipping.", current_anim_frame_idx_);
-                 current_anim_frame_idx_++; current_frame_elapsed_time_ = 0.0f;
-                 if (current_anim_frame_idx_ >= frameCount) { animation_cycle_finished = true; current_anim_frame_idx_ = active_anim_->loops ? 0 : frameCount - 1; }
-            } else {
-                current_frame_elapsed_time_ += delta_time;
-                while (current_frame_elapsed_time_ >= duration_sec) {
-                    current_frame_elapsed_time_ -= duration_sec; current_anim_frame_idx_++;
-                    if (current_anim_frame_idx_ >= frameCount) {
-                        animation_cycle_finished = true;
-                        if (active_anim_->loops) { current_anim_frame_idx_ = 0; }
-                        else { current_anim_frame_idx_ = frameCount - 1; current_frame_elapsed_time_ = duration_sec; break; }
-                    }
-                    if (current_anim_frame_idx_ < active_anim_->frame_durations_ms.size()) {
-                        duration_sec = active_anim_->frame_durations_ms[current_anim_frame_idx_] / 1000.0f;
-                        if (duration_sec <= 0.0f) { SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Zero duration frame %zu encountered during step.", current_anim_frame_idx_); continue; }
-                    } else { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Anim index OOB during step!"); current_anim_frame_idx_ = 0; current_frame_elapsed_time_ = 0.0f; break; }
-                }
-            }
-         } else { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Anim index OOB of durations!"); current_anim_frame_idx_ = 0; current_frame_elapsed_time_ = 0.0f; }
+    // Steps, idle/walk switches and animation frames all follow the device rules
+    const uint32_t events = advanceDevice(simConfig_, device_, static_cast<uint64_t>(scalarToTicks(delta_time))); // Whole ticks, as Game::run produces
+    if (events & DEVICE_EVENT_STEP) {
+        SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "Walk cycle finished. Steps remaining: %d", device_.queuedSteps);
+        game_ptr->getAudio()->play(game_ptr->getAssetManager()->getSound("step"));
     }
-    // State Change: Walking -> Idle
-    if (current_state_ == STATE_WALKING && animation_cycle_finished && active_anim_ && !active_anim_->loops) {
-         queued_steps_--;
-         SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "Walk cycle finished. Steps remaining: %d", queued_steps_);
-         if (queued_steps_ <= 0) {
-             queued_steps_ = 0; current_state_ = STATE_IDLE; stateNeedsAnimUpdate = true;
-             SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "State -> IDLE (Walk finished, no steps left)");
-         } else {
-             current_anim_frame_idx_ = 0; current_frame_elapsed_time_ = 0.0f;
-             SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "Restarting walk cycle for next step.");
-         }
+    if (events & DEVICE_EVENT_EVOLVED) {
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Partner reached stage %d after %llu steps.", device_.stage, (unsigned long long)device_.totalSteps);
+        const DisplayProfile& profile = game_ptr->getDisplayProfile();
+        particles_.start(evolveEffect_, profile.width / 2.0f, static_cast<float>(profile.height / 2 + profile.scale(PARTNER_OFFSET_Y)));
+        startEvolveFlash();
     }
-    if (stateNeedsAnimUpdate) {
+    if (events & DEVICE_EVENT_MODE_CHANGED) {
+        SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "State -> %s", device_.mode == DeviceMode::WALKING ? "WALKING" : "IDLE");
         setActiveAnimation();
     }
+    if (attacking_ && stepAnimation(attackAnimation_, attackFrame_, attackElapsed_, delta_time)) {
+        attacking_ = false; // Played once; back to the device's clip
+    }
+    updateEvolveFlash(delta_time);
+    particles_.update(delta_time);
+}
+
+
+// --- Evolution Flash ---
+void AdventureState::startEvolveFlash() {
+    flashPhasesLeft_ = EVOLVE_FLASH_PHASES;
+    flashElapsed_ = 0;
+    showFlash(true);
+}
+
+void AdventureState::updateEvolveFlash(Scalar delta_time) {
+    if (flashPhasesLeft_ == 0) return;
+    const Scalar phase = scalarFromMs(EVOLVE_FLASH_PHASE_MS);
+    const int before = flashPhasesLeft_;
+    flashElapsed_ += delta_time;
+    while (flashPhasesLeft_ > 0 && flashElapsed_ >= phase) {
+        flashElapsed_ -= phase;
+        --flashPhasesLeft_;
+    }
+    if (flashPhasesLeft_ != before) showFlash(flashPhasesLeft_ % 2 == 1); // Only touch the palette on a phase change
+}
+
+void AdventureState::showFlash(bool lit) {
+    PalettedSheet* sheet = game_ptr->getAssetManager()->getPalettedSheet(game_ptr->getRoster().get(device_.partner).textureId.c_str());
+    if (!sheet) return; // Not resident, or loaded as a plain texture (not recolourable)
+    if (lit) {
+        sheet->setPalette(makeFlashPalette(sheet->getBasePalette(), EVOLVE_FLASH_COLOR));
+    } else {
+        sheet->resetPalette();
+    }
+}
+
+
+// --- Save/Resume ---
+void AdventureState::saveSnapshot(SnapshotWriter& writer) const {
+    writer.beginChunk(SNAPSHOT_ID, SNAPSHOT_VERSION);
+    // Device: partner (by roster key), progress and the idle/walk animation cursor
+    writer.writeString(game_ptr->getRoster().get(device_.partner).key.c_str());
+    writer.write(static_cast<uint8_t>(device_.mode));
+    writer.write(device_.queuedSteps);
+    writer.write(device_.animFrame);
+    writer.write(device_.animTicks);
+    writer.write(device_.stage);
+    writer.write(device_.stageSteps);
+    writer.write(device_.totalSteps);
+    writer.write(device_.clockTicks);
+    // Attack playback
+    writer.write(static_cast<uint8_t>(attacking_ ? 1 : 0));
+    writer.write(static_cast<uint32_t>(attackFrame_));
+    writer.write(scalarToDouble(attackElapsed_));
+    // Scenery scroll offsets, back to front, in design pixels so saves move between profiles
+    const int divisor = game_ptr->getDisplayProfile().divisor;
+    writer.write(static_cast<uint8_t>(background_.getLayerCount()));
+    for (size_t i = 0; i < background_.getLayerCount(); ++i) writer.write(scalarToDouble(background_.getLayer(i).offset) * divisor);
+    writer.endChunk();
 }
 
+bool AdventureState::restoreSnapshot(SnapshotChunk& chunk) {
+    if (chunk.getVersion() != SNAPSHOT_VERSION) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "AdventureState: Snapshot chunk version %u not supported; starting fresh.", chunk.getVersion());
+        return false;
+    }
+    DeviceState device;
+    char partnerKey[MAX_PARTNER_KEY] = {};
+    uint8_t mode = 0, attacking = 0, layerCount = 0;
+    uint32_t attackFrame = 0;
+    double attackElapsed = 0.0;
+    chunk.readString(partnerKey, sizeof(partnerKey));
+    chunk.read(mode);
+    chunk.read(device.queuedSteps);
+    chunk.read(device.animFrame);
+    chunk.read(device.animTicks);
+    chunk.read(device.stage);
+    chunk.read(device.stageSteps);
+    chunk.read(device.totalSteps);
+    chunk.read(device.clockTicks);
+    chunk.read(attacking);
+    chunk.read(attackFrame);
+    chunk.read(attackElapsed);
+    chunk.read(layerCount);
+    if (!chunk.isValid() || mode > static_cast<uint8_t>(DeviceMode::WALKING) || device.stage >= SimConfig::STAGE_COUNT) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "AdventureState: Snapshot chunk is malformed; starting fresh.");
+        return false;
+    }
+    device.mode = static_cast<DeviceMode>(mode);
+    // A partner dropped from the roster since the save hands its progress to the first entry
+    const Roster& roster = game_ptr->getRoster();
+    device.partner = roster.find(partnerKey);
+    if (device.partner == NO_DIGIMON) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "AdventureState: Saved partner '%s' is not in the roster; using '%s'.", partnerKey, roster.get(0).key.c_str());
+        device.partner = 0;
+    }
+    const SimClip& clip = device.mode == DeviceMode::IDLE ? simConfig_.idle : simConfig_.walk;
+    if (device.animFrame >= clip.frameCount) { device.animFrame = 0; device.animTicks = 0; } // Clip shortened since the save
+    device_ = device;
+    pendingPartner_ = NO_DIGIMON;
+    updateWantedSheets();
+    ensurePartnerAnimations(); // Needed now to validate the attack cursor; the first frame draws it anyway
+
+    attacking_ = attacking != 0 && attackFrame < attackAnimation_.getFrameCount();
+    attackFrame_ = attacking_ ? attackFrame : 0;
+    attackElapsed_ = attacking_ ? scalarFromDouble<Scalar>(attackElapsed) : Scalar(0);
+
+    // A scene edited since the save keeps fresh offsets for the layers it added
+    const int divisor = game_ptr->getDisplayProfile().divisor;
+    for (uint8_t i = 0; i < layerCount; ++i) {
+        double offset = 0.0;
+        if (!chunk.read(offset)) break;
+        background_.setLayerOffset(i, scalarFromDouble<Scalar>(offset / divisor));
+    }
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "AdventureState: Resumed partner '%s', stage %d, %llu steps.", roster.get(device_.partner).key.c_str(), device_.stage, (unsigned long long)device_.totalSteps);
+    return true;
+}
 
 // --- Render ---
 // <<< Includes verticalOffset fix AND corrected drawTexture call >>>
@@ -342,49 +448,51 @@ void AdventureState::render() {
     // Get Window Dimensions
     int windowW = 0; int windowH = 0;
     display->getWindowSize(windowW, windowH);
-    if (windowW <= 0 || windowH <= 0) { windowW = 466; windowH = 466; /* Fallback */ }
-
-    // Draw Backgrounds
-    auto drawTiledBg = [&](SDL_Texture* tex, float offset, int texW, int texH, int effectiveWidth, const char* layerName) {
-        if (!tex || texW <= 0 || effectiveWidth <= 0) { return; }
-        int drawX1 = -static_cast<int>(std::fmod(offset, (float)effectiveWidth));
-        if (drawX1 > 0) drawX1 -= effectiveWidth;
-        SDL_Rect dst1 = { drawX1, 0, texW, texH }; display->drawTexture(tex, NULL, &dst1);
-        int drawX2 = drawX1 + effectiveWidth; SDL_Rect dst2 = { drawX2, 0, texW, texH }; display->drawTexture(tex, NULL, &dst2);
-        if (drawX2 + texW < windowW) { int drawX3 = drawX2 + effectiveWidth; SDL_Rect dst3 = { drawX3, 0, texW, texH }; display->drawTexture(tex, NULL, &dst3); }
-    };
-    int bgW0=0,bgH0=0,effW0=0, bgW1=0,bgH1=0,effW1=0, bgW2=0,bgH2=0,effW2=0;
-    if(bgTexture0_) { SDL_QueryTexture(bgTexture0_,0,0,&bgW0,&bgH0); effW0=bgW0*2/3; if(effW0<=0)effW0=bgW0;}
-    if(bgTexture1_) { SDL_QueryTexture(bgTexture1_,0,0,&bgW1,&bgH1); effW1=bgW1*2/3; if(effW1<=0)effW1=bgW1;}
-    if(bgTexture2_) { SDL_QueryTexture(bgTexture2_,0,0,&bgW2,&bgH2); effW2=bgW2*2/3; if(effW2<=0)effW2=bgW2;}
-
-    drawTiledBg(bgTexture2_, bg_scroll_offset_2_, bgW2, bgH2, effW2, "Layer 2");
-    drawTiledBg(bgTexture1_, bg_scroll_offset_1_, bgW1, bgH1, effW1, "Layer 1");
-
-    // Draw Character
+    const DisplayProfile& profile = game_ptr->getDisplayProfile();
+    if (windowW <= 0 || windowH <= 0) { windowW = profile.width; windowH = profile.height; /* Fallback */ }
+
+    ensurePartnerAnimations();
+
+    // Draw Backgrounds (everything behind the character)
+    background_.renderBackground(display, windowW, windowH);
+
+    // Draw Character (the attack clip, while one plays)
     if (active_anim_) {
-        const SpriteFrame* currentFrame = active_anim_->getFrame(current_anim_frame_idx_);
+        const SpriteFrame* currentFrame = attacking_ ? attackAnimation_.getFrame(attackFrame_) : active_anim_->getFrame(device_.animFrame);
         if (currentFrame && currentFrame->texturePtr && currentFrame->sourceRect.w > 0 && currentFrame->sourceRect.h > 0) {
-            int drawX = (windowW / 2) - (currentFrame->sourceRect.w / 2);
-            // Apply vertical offset
-            int verticalOffset = 30; // Adjust as needed
-            int drawY = (windowH / 2) - (currentFrame->sourceRect.h / 2) - verticalOffset;
-            SDL_Rect dstRect = { drawX, drawY, currentFrame->sourceRect.w, currentFrame->sourceRect.h };
+            // Pivot goes to screen centre, raised by the vertical offset; trimmed frames
+            // only cover their visible pixels
+            SDL_Rect dstRect = currentFrame->placeAt(windowW / 2, (windowH / 2) + profile.scale(PARTNER_OFFSET_Y));
 
             // --- <<< CORRECTED drawTexture CALL >>> ---
             display->drawTexture(currentFrame->texturePtr, &currentFrame->sourceRect, &dstRect);
             // --- <<< ---------------------------- >>>
 
         } else {
-             if (!currentFrame) SDL_LogWarn(SDL_LOG_CATEGORY_RENDER, "AS Render FAIL: CurrentFrame is null for anim frame index %zu!", current_anim_frame_idx_);
-             else if (!currentFrame->texturePtr) SDL_LogWarn(SDL_LOG_CATEGORY_RENDER, "AS Render FAIL: Frame TexPtr is null for anim frame index %zu!", current_anim_frame_idx_);
-             else SDL_LogWarn(SDL_LOG_CATEGORY_RENDER, "AS Render FAIL: Frame SrcRect has zero W/H (%d, %d) for anim frame index %zu!", currentFrame->sourceRect.w, currentFrame->sourceRect.h, current_anim_frame_idx_);
+             if (!currentFrame) SDL_LogWarn(SDL_LOG_CATEGORY_RENDER, "AS Render FAIL: CurrentFrame is null for anim frame index %d!", device_.animFrame);
+             else if (!currentFrame->texturePtr) SDL_LogWarn(SDL_LOG_CATEGORY_RENDER, "AS Render FAIL: Frame TexPtr is null for anim frame index %d!", device_.animFrame);
+             else SDL_LogWarn(SDL_LOG_CATEGORY_RENDER, "AS Render FAIL: Frame SrcRect has zero W/H (%d, %d) for anim frame index %d!", currentFrame->sourceRect.w, currentFrame->sourceRect.h, device_.animFrame);
         }
     } else {
         static bool logged_no_anim = false; if (!logged_no_anim) { SDL_LogWarn(SDL_LOG_CATEGORY_RENDER, "AS Render: No active animation set!"); logged_no_anim = true; }
      }
 
     // Draw Foreground
-    drawTiledBg(bgTexture0_, bg_scroll_offset_0_, bgW0, bgH0, effW0, "Layer 0");
+    background_.renderForeground(display, windowW, windowH);
+
+    // Draw Effects (one batched draw per particle texture)
+    particles_.render(display);
+
+    // Draw HUD (step counter; the number changes every step so it takes the digit path)
+    BitmapFont* font = game_ptr->getFont();
+    if (font && font->isLoaded()) {
+        // Margins are measured from the design screen's corner; keep them centred on smaller panels
+        const int hudX = windowW / 2 + profile.scale(HUD_MARGIN_X - DESIGN_WIDTH / 2);
+        const int hudY = windowH / 2 + profile.scale(HUD_MARGIN_Y - DESIGN_HEIGHT / 2);
+        TextStyle hudStyle;
+        hudStyle.scale = profile.scaleSize(HUD_TEXT_SCALE);
+        font->drawText(display, "STEPS", hudX, hudY, hudStyle);
+        font->drawNumber(display, static_cast<long long>(device_.totalSteps), hudX + font->measureText("STEPS ", hudStyle.scale), hudY, hudStyle);
+    }
 
 } // End of AdventureState::render() function
\ No newline at end of file
@@ -5,18 +5,23 @@
 #include "core/AssetManager.h"      // Needed for asset loading
 #include "platform/pc/pc_display.h" // Needed for display pointer
 #include "states/TransitionState.h" // <<< NEEDED to call parent->requestExit() >>>
+#include "ui/BitmapFont.h"          // Menu text
 #include <SDL_log.h>
 #include <SDL.h>
 #include <stdexcept>
-#include <vector>                   // <<< Need for stack access >>>
-#include <memory>                   // <<< Need for unique_ptr access >>>
+#include <cstdio>                   // std::snprintf
 
+namespace {
+    const char* const FILTER_PREFIX = "FIND: ";
+} // end anonymous namespace
 
-MenuState::MenuState(Game* game, const std::vector<std::string>& options) :
-    menuOptions_(options),
-    currentSelection_(0),
+
+MenuState::MenuState(Game* game, std::shared_ptr<const MenuIndex> index) :
     backgroundTexture_(nullptr), // Still load it, just don't draw it here
-    fontTexture_(nullptr),
+    header_(LayoutDirection::VERTICAL),
+    title_(game ? game->getFont() : nullptr, "MENU"),
+    filterLabel_(game ? game->getFont() : nullptr, ""),
+    list_(game ? game->getFont() : nullptr, std::move(index), (game ? game->getDisplayProfile() : getDefaultDisplayProfile()).scaleSize(MENU_ITEM_HEIGHT)),
     cursorTexture_(nullptr)
 {
     this->game_ptr = game;
@@ -29,9 +34,47 @@ MenuState::MenuState(Game* game, const std::vector<std::string>& options) :
         if (!backgroundTexture_) {
             SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "MenuState: Background texture 'menu_bg_blue' not found!");
         }
-        // TODO: Load font/cursor textures
+        // TODO: Load cursor texture
     }
-    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "MenuState Created with %zu options.", options.size());
+    buildWidgets();
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "MenuState Created with %zu options.", list_.getList().getRowCount());
+}
+
+// Styles, sizes and the tree links; the widgets themselves are members
+void MenuState::buildWidgets() {
+    const DisplayProfile& profile = game_ptr ? game_ptr->getDisplayProfile() : getDefaultDisplayProfile();
+    int windowW = profile.width, windowH = profile.height;
+    if (game_ptr && game_ptr->get_display()) game_ptr->get_display()->getWindowSize(windowW, windowH);
+
+    TextStyle textStyle;
+    textStyle.scale = profile.scaleSize(MENU_TEXT_SCALE);
+    TextStyle titleStyle = textStyle;
+    titleStyle.scale = profile.scaleSize(MENU_TITLE_SCALE);
+    TextStyle selectedStyle = textStyle;
+    selectedStyle.color = {255, 220, 64, 255};
+
+    root_.setFixedSize(windowW, windowH);
+    root_.setPadding(profile.scale(MENU_SAFE_INSET));
+    root_.setSpacing(profile.scale(MENU_SPACING));
+
+    // The header only changes while typing, so it is drawn from a cached texture
+    root_.addChild(header_);
+    header_.setSpacing(profile.scale(MENU_SPACING));
+    header_.setCached(true);
+    title_.setStyle(titleStyle);
+    header_.addChild(title_);
+    filterLabel_.setStyle(textStyle);
+    header_.addChild(filterLabel_);
+
+    root_.addChild(list_);
+    list_.setStyles(textStyle, selectedStyle);
+}
+
+void MenuState::refreshFilterLabel() {
+    const MenuList& menu = list_.getList();
+    char text[MAX_TEXT_RUN_CHARS + 1];
+    std::snprintf(text, sizeof(text), "%s%s", menu.hasFilter() ? FILTER_PREFIX : "", menu.getFilter());
+    filterLabel_.setText(text);
 }
 
 MenuState::~MenuState() {
@@ -48,30 +91,12 @@ void MenuState::handle_input() {
     static bool down_pressed_last_frame = false;
     static bool select_pressed_last_frame = false;
 
-    // Exit Menu (Escape or Backspace)
-    if (keys[SDL_SCANCODE_ESCAPE] || keys[SDL_SCANCODE_BACKSPACE]) {
+    // Exit Menu (Escape; Backspace exits from handle_event once the filter is empty)
+    if (keys[SDL_SCANCODE_ESCAPE]) {
         if (!esc_pressed_last_frame) {
-            SDL_LogInfo(SDL_LOG_CATEGORY_INPUT, "Exit key pressed in MenuState, signalling TransitionState parent.");
-            if(game_ptr) {
-                // <<< --- MODIFIED: Signal the TransitionState above to exit --- >>>
-                auto& stack = game_ptr->DEBUG_getStack(); // Get stack via helper
-                if (stack.size() >= 2) {
-                    // Get the state below us (index size-2) and try casting
-                    TransitionState* parent = dynamic_cast<TransitionState*>(stack[stack.size() - 2].get());
-                    if (parent) {
-                         parent->requestExit(); // Tell parent TransitionState to handle popping
-                    } else {
-                         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "MenuState Error: State below is not TransitionState! Cannot signal exit.");
-                         // Perhaps do nothing, as popping self would leave parent stuck
-                    }
-                } else {
-                     SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "MenuState Error: Stack size < 2, cannot get parent TransitionState!");
-                     // Perhaps do nothing
-                }
-                // <<< --- END MODIFICATION --- >>>
-                esc_pressed_last_frame = true; // Prevent re-triggering
-                return; // Exit input handling for this frame
-            }
+            esc_pressed_last_frame = true; // Prevent re-triggering
+            requestMenuExit();
+            return; // Exit input handling for this frame
         }
     } else {
         esc_pressed_last_frame = false;
@@ -79,9 +104,10 @@ void MenuState::handle_input() {
 
     // Navigate Up
     if (keys[SDL_SCANCODE_UP]) {
-        if (!up_pressed_last_frame && !menuOptions_.empty()) {
-             currentSelection_ = (currentSelection_ == 0) ? menuOptions_.size() - 1 : currentSelection_ - 1;
-             SDL_LogDebug(SDL_LOG_CATEGORY_INPUT, "Menu: Selected option %zu - '%s'", currentSelection_, menuOptions_[currentSelection_].c_str());
+        if (!up_pressed_last_frame) {
+             list_.getList().moveSelection(-1);
+             SDL_LogDebug(SDL_LOG_CATEGORY_INPUT, "Menu: Selected row %zu", list_.getList().getSelectedRow());
+             playSound("menu_move");
         }
         up_pressed_last_frame = true;
     } else {
@@ -90,9 +116,10 @@ void MenuState::handle_input() {
 
     // Navigate Down
     if (keys[SDL_SCANCODE_DOWN]) {
-        if (!down_pressed_last_frame && !menuOptions_.empty()) {
-            currentSelection_ = (currentSelection_ + 1) % menuOptions_.size();
-            SDL_LogDebug(SDL_LOG_CATEGORY_INPUT, "Menu: Selected option %zu - '%s'", currentSelection_, menuOptions_[currentSelection_].c_str());
+        if (!down_pressed_last_frame) {
+            list_.getList().moveSelection(1);
+            SDL_LogDebug(SDL_LOG_CATEGORY_INPUT, "Menu: Selected row %zu", list_.getList().getSelectedRow());
+            playSound("menu_move");
         }
         down_pressed_last_frame = true;
     } else {
@@ -101,9 +128,10 @@ void MenuState::handle_input() {
 
     // Handle Selection (Enter key)
     if (keys[SDL_SCANCODE_RETURN]) {
-        if (!select_pressed_last_frame && !menuOptions_.empty()) {
-            const std::string& selectedOption = menuOptions_[currentSelection_];
-            SDL_LogInfo(SDL_LOG_CATEGORY_INPUT, "Menu: Selected '%s'", selectedOption.c_str());
+        const std::string* selectedOption = list_.getList().getSelectedItem();
+        if (!select_pressed_last_frame && selectedOption) {
+            SDL_LogInfo(SDL_LOG_CATEGORY_INPUT, "Menu: Selected '%s'", selectedOption->c_str());
+            playSound("menu_select");
             // TODO: Implement actions (e.g., push another state, call game quit)
             select_pressed_last_frame = true;
         }
@@ -112,8 +140,25 @@ void MenuState::handle_input() {
     }
 }
 
-void MenuState::update(float delta_time) {
-    // Nothing state-specific to update here yet
+void MenuState::handle_event(const SDL_Event& event) {
+    MenuList& menu = list_.getList();
+    if (event.type == SDL_TEXTINPUT) {
+        // Typing filters the list; each extra character narrows the previous results
+        menu.appendToFilter(event.text.text);
+        refreshFilterLabel();
+        SDL_LogDebug(SDL_LOG_CATEGORY_INPUT, "Menu: Filter '%s' -> %zu rows", menu.getFilter(), menu.getRowCount());
+    } else if (event.type == SDL_KEYDOWN && event.key.keysym.scancode == SDL_SCANCODE_BACKSPACE) {
+        if (menu.hasFilter()) {
+            menu.popFilterChar();
+            refreshFilterLabel();
+        } else if (!event.key.repeat) {
+            requestMenuExit();
+        }
+    }
+}
+
+void MenuState::update(Scalar delta_time) {
+    root_.update(scalarToFloat(delta_time)); // Smooth scrolling (widgets still use float)
 }
 
 
@@ -128,21 +173,31 @@ void MenuState::render() {
     // The TransitionState below this one is responsible for drawing the background (AdventureState)
     // and the border frame on top of it. This state only needs to draw its contents.
 
-    // --- Draw Menu Options (Placeholder - Requires Font Rendering) ---
-    // Ensure MENU_START_X/Y constants are appropriate for drawing *inside* the border
-    for (size_t i = 0; i < menuOptions_.size(); ++i) {
-         if (i == currentSelection_) {
-              SDL_LogDebug(SDL_LOG_CATEGORY_RENDER, "> %s at (%d, %d)", menuOptions_[i].c_str(), MENU_START_X, MENU_START_Y + (int)(i * MENU_ITEM_HEIGHT));
-             // TODO: drawText(...) or draw cursor texture
-         } else {
-              SDL_LogDebug(SDL_LOG_CATEGORY_RENDER, "  %s at (%d, %d)", menuOptions_[i].c_str(), MENU_START_X, MENU_START_Y + (int)(i * MENU_ITEM_HEIGHT));
-             // TODO: drawText(...)
-         }
-    }
-    // --- TODO: Draw Cursor Texture ---
+    // --- Draw Widget Tree (lays out only what changed) ---
+    root_.render(display);
+}
+
+// --- requestMenuExit ---
+// Signals the TransitionState below us, which pops itself and this menu
+// Menu feedback beeps (silent if the device or the clip is missing)
+void MenuState::playSound(const char* soundId) {
+    if (!game_ptr || !game_ptr->getAudio() || !game_ptr->getAssetManager()) return;
+    game_ptr->getAudio()->play(game_ptr->getAssetManager()->getSound(soundId));
 }
 
-// Placeholder text drawing function (Implementation still needed)
-void MenuState::drawText(const std::string& text, int x, int y) {
-     SDL_LogWarn(SDL_LOG_CATEGORY_RENDER, "drawText not implemented! Text: '%s' at (%d,%d)", text.c_str(), x, y);
-}
\ No newline at end of file
+void MenuState::requestMenuExit() {
+    SDL_LogInfo(SDL_LOG_CATEGORY_INPUT, "Exit requested in MenuState, signalling TransitionState parent.");
+    if (!game_ptr) return;
+    auto& stack = game_ptr->DEBUG_getStack(); // Get stack via helper
+    if (stack.size() >= 2) {
+        // Get the state below us (index size-2) and try casting
+        TransitionState* parent = dynamic_cast<TransitionState*>(stack[stack.size() - 2].get());
+        if (parent) {
+             parent->requestExit(); // Tell parent TransitionState to handle popping
+        } else {
+             SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "MenuState Error: State below is not TransitionState! Cannot signal exit.");
+        }
+    } else {
+         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "MenuState Error: Stack size < 2, cannot get parent TransitionState!");
+    }
+}
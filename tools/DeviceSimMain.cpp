@@ -0,0 +1,179 @@
+// File: tools/DeviceSimMain.cpp
+// digivice_sim: headless balance runs. Plays weeks of simulated walking into a
+// population of virtual Digivices (sim/DeviceSim.h) and reports how fast steps are
+// counted and partners evolve. Needs no display or assets.
+// Usage: digivice_sim [--devices=100000] [--days=28] [--seed=1] [--threads=0]
+//                     [--steps-per-day=6000] [--steps-spread=0.5] [--sessions=6]
+//                     [--cadence=1.8] [--queue=2] [--evolve=1000,5000,20000,60000]
+//                     [--csv=daily.csv]
+
+#include "sim/DeviceSim.h"
+#include "core/JobSystem.h"
+#include <SDL_log.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+const double SECONDS_PER_DAY = 86400.0;
+const uint64_t TICKS_PER_DAY = 86400ull * TICKS_PER_SECOND; // Device clocks count ticks (sim/DeviceSim.h)
+
+struct Options {
+    size_t devices = 100000;
+    int days = 28;
+    uint64_t seed = 1;
+    unsigned threads = 0; // 0 = one per hardware thread
+    std::string csvPath;
+};
+
+bool readFlag(const char* arg, const char* name, const char*& value) {
+    const size_t length = std::strlen(name);
+    if (std::strncmp(arg, name, length) != 0 || arg[length] != '=') return false;
+    value = arg + length + 1;
+    return true;
+}
+
+bool parseEvolve(const char* list, SimConfig& config) {
+    int stage = 0;
+    for (const char* p = list; *p && stage < SimConfig::STAGE_COUNT - 1; ++stage) {
+        char* end = nullptr;
+        const unsigned long steps = std::strtoul(p, &end, 10);
+        if (end == p || steps == 0) return false;
+        config.stepsToEvolve[stage] = static_cast<uint32_t>(steps);
+        p = (*end == ',') ? end + 1 : end;
+    }
+    return stage == SimConfig::STAGE_COUNT - 1;
+}
+
+bool parseArgs(int argc, char* argv[], Options& options, SimConfig& config, WalkerProfile& profile) {
+    for (int i = 1; i < argc; ++i) {
+        const char* value = nullptr;
+        if (readFlag(argv[i], "--devices", value)) options.devices = std::strtoull(value, nullptr, 10);
+        else if (readFlag(argv[i], "--days", value)) options.days = std::atoi(value);
+        else if (readFlag(argv[i], "--seed", value)) options.seed = std::strtoull(value, nullptr, 10);
+        else if (readFlag(argv[i], "--threads", value)) options.threads = static_cast<unsigned>(std::atoi(value));
+        else if (readFlag(argv[i], "--steps-per-day", value)) profile.stepsPerDay = static_cast<float>(std::atof(value));
+        else if (readFlag(argv[i], "--steps-spread", value)) profile.stepsPerDaySpread = static_cast<float>(std::atof(value));
+        else if (readFlag(argv[i], "--sessions", value)) profile.sessionsPerDay = static_cast<float>(std::atof(value));
+        else if (readFlag(argv[i], "--cadence", value)) profile.cadence = static_cast<float>(std::atof(value));
+        else if (readFlag(argv[i], "--queue", value)) config.maxQueuedSteps = std::atoi(value);
+        else if (readFlag(argv[i], "--evolve", value)) { if (!parseEvolve(value, config)) { std::fprintf(stderr, "--evolve needs %d comma-separated step counts\n", SimConfig::STAGE_COUNT - 1); return false; } }
+        else if (readFlag(argv[i], "--csv", value)) options.csvPath = value;
+        else { std::fprintf(stderr, "Unknown argument '%s'\n", argv[i]); return false; }
+    }
+    if (options.devices == 0 || options.days <= 0 || profile.sessionsPerDay <= 0.0f || profile.cadence <= 0.0f || config.maxQueuedSteps <= 0) {
+        std::fprintf(stderr, "--devices, --days, --sessions, --cadence and --queue must be positive\n");
+        return false;
+    }
+    if (config.maxQueuedSteps > SimConfig::MAX_QUEUE_LIMIT) {
+        std::fprintf(stderr, "--queue must be at most %d\n", SimConfig::MAX_QUEUE_LIMIT);
+        return false;
+    }
+    return true;
+}
+
+// Days (from the start of the run) by which fraction q of the devices that reached 'stage' got there
+double percentileDays(std::vector<double>& reachedSec, double q) {
+    if (reachedSec.empty()) return -1.0;
+    const size_t index = static_cast<size_t>(q * (reachedSec.size() - 1));
+    std::nth_element(reachedSec.begin(), reachedSec.begin() + index, reachedSec.end());
+    return reachedSec[index] / SECONDS_PER_DAY;
+}
+
+// Order-independent summary so runs with different thread counts can be compared
+uint64_t checksum(const std::vector<SimDevice>& devices) {
+    uint64_t hash = 1469598103934665603ull; // FNV-1a
+    for (const SimDevice& sim : devices) {
+        const uint64_t values[] = { sim.device.totalSteps, sim.device.stage, sim.walker.stepsOffered, sim.walker.stepsDropped };
+        for (uint64_t v : values) { hash ^= v; hash *= 1099511628211ull; }
+    }
+    return hash;
+}
+
+} // end anonymous namespace
+
+int main(int argc, char* argv[]) {
+    SDL_LogSetAllPriority(SDL_LOG_PRIORITY_WARN);
+    Options options;
+    SimConfig config = defaultSimConfig();
+    WalkerProfile profile;
+    if (!parseArgs(argc, argv, options, config, profile)) return 1;
+
+    // --threads=1 runs inline; JobSystem::init(0) would mean "one worker per spare core"
+    JobSystem jobs;
+    JobSystem* jobsPtr = nullptr;
+    if (options.threads != 1) { jobs.init(options.threads > 1 ? options.threads - 1 : 0); jobsPtr = &jobs; }
+    std::printf("digivice_sim: %zu devices, %d days, seed %llu, %u threads\n", options.devices, options.days, (unsigned long long)options.seed, jobsPtr ? jobs.getThreadCount() : 1u);
+    std::printf("  walkers: %.0f steps/day (+-%.0f%%), %.1f walks/day, %.2f steps/s | device: queue %d, evolve at",
+                profile.stepsPerDay, profile.stepsPerDaySpread * 100.0f, profile.sessionsPerDay, profile.cadence, config.maxQueuedSteps);
+    for (uint32_t steps : config.stepsToEvolve) std::printf(" %u", steps);
+    std::printf(" steps\n\n");
+
+    std::vector<SimDevice> devices(options.devices);
+    initSimDevices(devices.data(), devices.size(), options.seed, profile);
+
+    FILE* csv = options.csvPath.empty() ? nullptr : std::fopen(options.csvPath.c_str(), "w");
+    if (!options.csvPath.empty() && !csv) std::fprintf(stderr, "Could not open '%s' for writing\n", options.csvPath.c_str());
+    if (csv) {
+        std::fprintf(csv, "day,counted_per_device,offered_per_device,dropped_pct");
+        for (int s = 0; s < SimConfig::STAGE_COUNT; ++s) std::fprintf(csv, ",stage%d_pct", s);
+        std::fprintf(csv, "\n");
+    }
+
+    std::printf("%4s %12s %12s %8s", "day", "counted/dev", "offered/dev", "drop%");
+    for (int s = 0; s < SimConfig::STAGE_COUNT; ++s) std::printf("  stage%d%%", s);
+    std::printf("\n");
+
+    const auto wallStart = std::chrono::steady_clock::now();
+    uint64_t prevCounted = 0, prevOffered = 0, prevDropped = 0;
+    for (int day = 1; day <= options.days; ++day) {
+        simulateDevices(jobsPtr, config, profile, devices.data(), devices.size(), TICKS_PER_DAY);
+
+        uint64_t counted = 0, offered = 0, dropped = 0;
+        size_t stageCounts[SimConfig::STAGE_COUNT] = {};
+        for (const SimDevice& sim : devices) {
+            counted += sim.device.totalSteps;
+            offered += sim.walker.stepsOffered;
+            dropped += sim.walker.stepsDropped;
+            ++stageCounts[sim.device.stage];
+        }
+        const double perDevice = 1.0 / devices.size();
+        const uint64_t dayOffered = offered - prevOffered;
+        const double dropPct = dayOffered ? 100.0 * (dropped - prevDropped) / dayOffered : 0.0;
+        std::printf("%4d %12.0f %12.0f %7.1f%%", day, (counted - prevCounted) * perDevice, dayOffered * perDevice, dropPct);
+        for (size_t c : stageCounts) std::printf(" %7.1f%%", 100.0 * c * perDevice);
+        std::printf("\n");
+        if (csv) {
+            std::fprintf(csv, "%d,%.2f,%.2f,%.3f", day, (counted - prevCounted) * perDevice, dayOffered * perDevice, dropPct);
+            for (size_t c : stageCounts) std::fprintf(csv, ",%.3f", 100.0 * c * perDevice);
+            std::fprintf(csv, "\n");
+        }
+        prevCounted = counted; prevOffered = offered; prevDropped = dropped;
+    }
+    if (csv) std::fclose(csv);
+    const double wallSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+
+    std::printf("\nDays to reach each stage (devices that got there):\n");
+    std::printf("%6s %9s %8s %8s %8s\n", "stage", "reached", "p10", "p50", "p90");
+    for (int s = 1; s < SimConfig::STAGE_COUNT; ++s) {
+        std::vector<double> reachedSec;
+        for (const SimDevice& sim : devices) {
+            if (sim.stageReachedSec[s] >= 0.0) reachedSec.push_back(sim.stageReachedSec[s]);
+        }
+        const double reachedPct = 100.0 * reachedSec.size() / devices.size();
+        const double p10 = percentileDays(reachedSec, 0.1), p50 = percentileDays(reachedSec, 0.5), p90 = percentileDays(reachedSec, 0.9);
+        if (reachedSec.empty()) std::printf("%6d %8.1f%% %8s %8s %8s\n", s, reachedPct, "-", "-", "-");
+        else std::printf("%6d %8.1f%% %8.1f %8.1f %8.1f\n", s, reachedPct, p10, p50, p90);
+    }
+
+    const double deviceDays = static_cast<double>(devices.size()) * options.days;
+    std::printf("\nSimulated %.0f device-days in %.2f s (%.0f device-days/s), checksum %016llx\n",
+                deviceDays, wallSec, wallSec > 0.0 ? deviceDays / wallSec : 0.0, (unsigned long long)checksum(devices));
+    jobs.shutdown();
+    return 0;
+}
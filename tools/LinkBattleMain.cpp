@@ -0,0 +1,187 @@
+// File: tools/LinkBattleMain.cpp
+// digivice_link: two Digivices battling over a loopback link. Each process is
+// one device; both run a scripted battle at 60 Hz through LinkSession
+// (sim/LinkSession.h), exchanging only inputs over UDP, with NetEmulator adding
+// latency, jitter and loss on the way out. At the end each device checks its
+// final state against an offline replay of the same inputs and reports how much
+// it rolled back and how many bytes it sent.
+// Usage: digivice_link --player=0 --port=7000 --peer-port=7001 [options]   (and --player=1 with the ports swapped)
+//        digivice_link --local [options]                                 (both devices in one process)
+// Options: [--frames=1800] [--seed=1] [--latency=0] [--jitter=0] [--loss=0] [--inject-desync=<frame>]
+
+#include "sim/BattleSim.h"
+#include "sim/LinkSession.h"
+#include "net/NetEmulator.h"
+#include "net/UdpSocket.h"
+#include <SDL_log.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+namespace {
+
+const double FRAME_SEC = 1.0 / 60.0;
+const uint64_t LINGER_MS = 500;          // Keep sending after finishing so the peer gets our last inputs
+const uint64_t PEER_WAIT_MS = 30000;     // On top of the battle's length: time to start the other process
+const size_t UDP_IP_HEADER_BYTES = 28;   // IPv4 + UDP, for on-the-wire bandwidth
+const uint32_t NO_FRAME = 0xFFFFFFFFu;
+
+struct Options {
+    int player = 0;
+    bool local = false;
+    uint16_t port = 7000;
+    uint16_t peerPort = 7001;
+    uint32_t frames = 1800;
+    uint32_t seed = 1;
+    uint32_t injectDesyncFrame = NO_FRAME;
+    NetConditions conditions;
+};
+
+struct Device {
+    int player = 0;
+    LinkSession session;
+    UdpSocket socket;
+    NetEmulator emulator;
+    double maxTickMs = 0.0;              // advance() including any rollback it ran
+    uint64_t finishedAtMs = 0;           // 0 until all frames are simulated and confirmed
+};
+
+bool readFlag(const char* arg, const char* name, const char*& value) {
+    const size_t length = std::strlen(name);
+    if (std::strncmp(arg, name, length) != 0 || arg[length] != '=') return false;
+    value = arg + length + 1;
+    return true;
+}
+
+bool parseArgs(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const char* value = nullptr;
+        if (std::strcmp(argv[i], "--local") == 0) options.local = true;
+        else if (readFlag(argv[i], "--player", value)) options.player = std::atoi(value);
+        else if (readFlag(argv[i], "--port", value)) options.port = static_cast<uint16_t>(std::atoi(value));
+        else if (readFlag(argv[i], "--peer-port", value)) options.peerPort = static_cast<uint16_t>(std::atoi(value));
+        else if (readFlag(argv[i], "--frames", value)) options.frames = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        else if (readFlag(argv[i], "--seed", value)) options.seed = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        else if (readFlag(argv[i], "--latency", value)) options.conditions.latencyMs = static_cast<uint32_t>(std::atoi(value));
+        else if (readFlag(argv[i], "--jitter", value)) options.conditions.jitterMs = static_cast<uint32_t>(std::atoi(value));
+        else if (readFlag(argv[i], "--loss", value)) options.conditions.lossPercent = static_cast<float>(std::atof(value));
+        else if (readFlag(argv[i], "--inject-desync", value)) options.injectDesyncFrame = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        else { std::fprintf(stderr, "Unknown argument '%s'\n", argv[i]); return false; }
+    }
+    if (options.frames == 0 || (options.player != 0 && options.player != 1) || options.conditions.lossPercent < 0.0f || options.conditions.lossPercent > 100.0f) {
+        std::fprintf(stderr, "--frames must be positive, --player 0 or 1 and --loss a percentage\n");
+        return false;
+    }
+    if (options.local && options.peerPort == options.port) options.peerPort = static_cast<uint16_t>(options.port + 1);
+    return true;
+}
+
+// The same battle with every input known up front
+uint32_t offlineReplayHash(const BattleConfig& config, const BattleState& initial, const Options& options) {
+    BattleState state = initial;
+    for (uint32_t frame = 0; frame < options.frames; ++frame) {
+        BattleInput inputs[2] = {};
+        if (frame >= LinkSession::INPUT_DELAY) {
+            for (int p = 0; p < 2; ++p) inputs[p] = scriptedBattleInput(options.seed, p, frame);
+        }
+        stepBattle(config, state, inputs);
+    }
+    return hashBattleState(state);
+}
+
+void tick(Device& device, const Options& options, uint64_t nowMs) {
+    uint8_t packet[NetEmulator::MAX_DATAGRAM_BYTES];
+    int received;
+    while ((received = device.socket.receive(packet, sizeof(packet))) > 0) {
+        device.session.readPacket(packet, static_cast<size_t>(received));
+    }
+
+    LinkSession& session = device.session;
+    if (session.getFrame() < options.frames) {
+        // The input pressed now lands INPUT_DELAY frames later
+        const BattleInput input = scriptedBattleInput(options.seed, device.player, session.getFrame() + LinkSession::INPUT_DELAY);
+        const auto start = std::chrono::steady_clock::now();
+        session.advance(input);
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if (ms > device.maxTickMs) device.maxTickMs = ms;
+        if (session.getFrame() == options.injectDesyncFrame && device.player == 1) session.injectDesync();
+    } else {
+        session.resolve();
+        if (device.finishedAtMs == 0 && session.getConfirmedFrame() >= options.frames) device.finishedAtMs = nowMs;
+    }
+
+    const size_t length = session.writePacket(packet, sizeof(packet));
+    if (length > 0) device.emulator.send(packet, length, nowMs);
+    device.emulator.pump(device.socket, nowMs);
+}
+
+void printReport(const Device& device, const Options& options, uint32_t replayHash) {
+    const LinkStats& stats = device.session.getStats();
+    const double battleSec = options.frames * FRAME_SEC;
+    const double kbpsUp = stats.bytesSent * 8.0 / 1000.0 / battleSec;
+    const double kbpsWire = (stats.bytesSent + stats.packetsSent * UDP_IP_HEADER_BYTES) * 8.0 / 1000.0 / battleSec;
+    std::printf("%6d %8llu %9llu %9llu %7.2f %6u %7llu %8llu %7llu %8llu %8llu %9.1f %8.2f %9.2f %9.2f %11.3f\n", device.player,
+                (unsigned long long)stats.frames, (unsigned long long)stats.rollbacks, (unsigned long long)stats.rolledBackFrames,
+                stats.rollbacks ? static_cast<double>(stats.rolledBackFrames) / stats.rollbacks : 0.0, stats.maxRollback,
+                (unsigned long long)stats.stalls, (unsigned long long)stats.syncsChecked, (unsigned long long)stats.desyncs,
+                (unsigned long long)stats.packetsSent, (unsigned long long)device.emulator.getDropped(),
+                stats.packetsSent ? static_cast<double>(stats.bytesSent) / stats.packetsSent : 0.0,
+                stats.packetsSent ? static_cast<double>(stats.syncBytesSent) / stats.packetsSent : 0.0, kbpsUp, kbpsWire, device.maxTickMs);
+    const uint32_t hash = hashBattleState(device.session.getState());
+    const bool confirmed = device.session.getConfirmedFrame() >= options.frames;
+    std::printf("       player %d final frame %u hash %08x, offline replay %08x: %s\n", device.player, device.session.getFrame(), hash, replayHash,
+                !confirmed ? "UNCONFIRMED (peer gone?)" : hash == replayHash ? "match" : "MISMATCH");
+}
+
+} // end anonymous namespace
+
+int main(int argc, char* argv[]) {
+    SDL_LogSetAllPriority(SDL_LOG_PRIORITY_WARN);
+    Options options;
+    if (!parseArgs(argc, argv, options)) return 1;
+
+    const BattleConfig config;
+    const BattleState initial = startBattle(config, 0, 1, options.seed);
+    const int deviceCount = options.local ? 2 : 1;
+    Device devices[2];
+    for (int i = 0; i < deviceCount; ++i) {
+        Device& device = devices[i];
+        device.player = options.local ? i : options.player;
+        const uint16_t localPort = options.local && i == 1 ? options.peerPort : options.port;
+        const uint16_t peerPort = options.local && i == 1 ? options.port : options.peerPort;
+        if (!device.socket.open(localPort, peerPort)) return 1;
+        device.session.start(config, initial, device.player);
+        device.emulator.configure(options.conditions, options.seed * 2654435761u + static_cast<uint32_t>(device.player));
+    }
+    std::printf("digivice_link: %s, port %u <-> %u, %u frames, seed %u, latency %u+0..%u ms one way, loss %.1f%%\n",
+                options.local ? "both players" : (options.player == 0 ? "player 0 (host)" : "player 1"), options.port, options.peerPort,
+                options.frames, options.seed, options.conditions.latencyMs, options.conditions.jitterMs, options.conditions.lossPercent);
+
+    const auto wallStart = std::chrono::steady_clock::now();
+    const auto tickLength = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(FRAME_SEC));
+    const uint64_t timeoutMs = static_cast<uint64_t>(options.frames * FRAME_SEC * 1000.0) + PEER_WAIT_MS;
+    auto nextTick = wallStart;
+    for (;;) {
+        const uint64_t nowMs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - wallStart).count());
+        bool done = true;
+        for (int i = 0; i < deviceCount; ++i) {
+            tick(devices[i], options, nowMs);
+            done = done && devices[i].finishedAtMs != 0 && nowMs - devices[i].finishedAtMs >= LINGER_MS;
+        }
+        if (done || nowMs > timeoutMs) break;
+        nextTick += tickLength;
+        std::this_thread::sleep_until(nextTick);
+    }
+
+    const uint32_t replayHash = offlineReplayHash(config, initial, options);
+    std::printf("\n%6s %8s %9s %9s %7s %6s %7s %8s %7s %8s %8s %9s %8s %9s %9s %11s\n", "player", "frames", "rollbacks", "rb_frames", "avg_rb",
+                "max_rb", "stalls", "syncs", "desyncs", "packets", "lost", "bytes/pkt", "sync/pkt", "kbps_up", "kbps_wire", "max_tick_ms");
+    bool allMatch = true;
+    for (int i = 0; i < deviceCount; ++i) {
+        printReport(devices[i], options, replayHash);
+        allMatch = allMatch && devices[i].session.getConfirmedFrame() >= options.frames && hashBattleState(devices[i].session.getState()) == replayHash;
+    }
+    return allMatch ? 0 : 2;
+}
@@ -0,0 +1,119 @@
+# Python Script: trim_sprite_sheets.py
+# Crops every frame of the Digimon sprite sheets to its visible pixels and repacks
+# the sheets tightly. The sheet JSON keeps the TexturePacker trim fields so the
+# engine (SpriteFrame::placeAt) still draws each frame where its full cell was:
+#   "frame":            tight rect on the new sheet
+#   "trimmed":          true when the rect is smaller than the cell
+#   "spriteSourceSize": where the tight rect sits inside the original cell
+#   "sourceSize":       original cell size (unchanged)
+# Safe to re-run: already-trimmed sheets are measured from their current rects.
+
+import os
+import glob
+import json
+from PIL import Image
+
+# --- Configuration ---
+sprites_folder = "assets/sprites"
+sheet_pattern = "*_sheet.json"
+
+# Pixels with alpha at or below this count as empty when measuring a frame
+alpha_threshold = 0
+# Transparent gap left around each packed frame (stops filtering bleed)
+padding = 1
+# Widest sheet the packer may produce
+max_sheet_width = 1024
+# ---------------------
+
+def visible_bounds(frame_img):
+    # Bounding box of pixels above the threshold, or None if fully transparent
+    alpha = frame_img.getchannel("A").point(lambda a: 255 if a > alpha_threshold else 0)
+    return alpha.getbbox()
+
+def pack_shelves(sizes, max_width):
+    # Shelf packer: tallest first, left to right, new shelf when the row is full.
+    # Returns {index: (x, y)} and the sheet size.
+    order = sorted(range(len(sizes)), key=lambda i: (-sizes[i][1], -sizes[i][0]))
+    widest = max(w for (w, h) in sizes) + padding
+    # Aim for a roughly square sheet so neither side balloons
+    area = sum((w + padding) * (h + padding) for (w, h) in sizes)
+    side = int(area ** 0.5) + 1
+    sheet_width = max(widest, min(max_width, side))
+
+    positions = {}
+    x = y = shelf_height = 0
+    used_width = 0
+    for i in order:
+        w, h = sizes[i]
+        if x > 0 and x + w + padding > sheet_width:
+            y += shelf_height
+            x = shelf_height = 0
+        positions[i] = (x, y)
+        x += w + padding
+        used_width = max(used_width, x)
+        shelf_height = max(shelf_height, h + padding)
+    return positions, (used_width, y + shelf_height)
+
+def trim_sheet(json_path):
+    with open(json_path) as f:
+        data = json.load(f)
+    frames = data["frames"]
+    # Array-style sheets carry their name in "filename"; object-style use the key
+    entries = list(frames.items()) if isinstance(frames, dict) else [(e.get("filename", str(i)), e) for i, e in enumerate(frames)]
+
+    image_path = os.path.splitext(json_path)[0] + ".png"
+    sheet = Image.open(image_path).convert("RGBA")
+
+    crops, sizes, placements = [], [], []
+    for name, entry in entries:
+        rect = entry["frame"]
+        offset = entry.get("spriteSourceSize", {"x": 0, "y": 0}) if entry.get("trimmed") else {"x": 0, "y": 0}
+        frame_img = sheet.crop((rect["x"], rect["y"], rect["x"] + rect["w"], rect["y"] + rect["h"]))
+        bounds = visible_bounds(frame_img)
+        if bounds is None:
+            bounds = (0, 0, 1, 1) # Keep a 1x1 (transparent) rect so the frame stays drawable
+        crops.append(frame_img.crop(bounds))
+        sizes.append((bounds[2] - bounds[0], bounds[3] - bounds[1]))
+        placements.append((offset["x"] + bounds[0], offset["y"] + bounds[1]))
+
+    positions, (sheet_w, sheet_h) = pack_shelves(sizes, max_sheet_width)
+    packed = Image.new("RGBA", (sheet_w, sheet_h), (0, 0, 0, 0))
+    for i, (name, entry) in enumerate(entries):
+        x, y = positions[i]
+        w, h = sizes[i]
+        packed.paste(crops[i], (x, y))
+        source = entry.get("sourceSize", {"w": entry["frame"]["w"], "h": entry["frame"]["h"]})
+        entry["frame"] = {"x": x, "y": y, "w": w, "h": h}
+        entry["rotated"] = False
+        entry["trimmed"] = (w, h) != (source["w"], source["h"])
+        entry["spriteSourceSize"] = {"x": placements[i][0], "y": placements[i][1], "w": w, "h": h}
+        entry["sourceSize"] = source
+
+    old_size = sheet.size
+    packed.save(image_path)
+    data.setdefault("meta", {})["size"] = {"w": sheet_w, "h": sheet_h}
+    with open(json_path, "w") as f:
+        json.dump(data, f, indent=2)
+
+    before = old_size[0] * old_size[1]
+    after = sheet_w * sheet_h
+    drawn_before = sum(e["sourceSize"]["w"] * e["sourceSize"]["h"] for _, e in entries)
+    drawn_after = sum(w * h for (w, h) in sizes)
+    print(f"  {os.path.basename(json_path)}: sheet {old_size[0]}x{old_size[1]} -> {sheet_w}x{sheet_h} "
+          f"({100.0 * after / before:.0f}%), pixels drawn per frame {100.0 * drawn_after / drawn_before:.0f}%")
+
+try:
+    script_dir = os.path.dirname(os.path.abspath(__file__))
+    folder = os.path.join(script_dir, sprites_folder)
+    sheets = sorted(glob.glob(os.path.join(folder, sheet_pattern)))
+    if not sheets:
+        print(f"Error: No sheets matching '{sheet_pattern}' in '{os.path.abspath(folder)}'")
+    else:
+        print(f"Trimming {len(sheets)} sheet(s) in {os.path.abspath(folder)}")
+    for json_path in sheets:
+        trim_sheet(json_path)
+
+except FileNotFoundError as e:
+    print(f"Error: {e}")
+except Exception as e:
+    print(f"Unexpected error: {e}")